@@ -0,0 +1,94 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "test.hpp"
+#include "bench.hpp"
+#include "fnx/fnx.hpp"
+
+namespace
+{
+constexpr size_t num_files = 2000;
+const std::string asset_dir = "bench_archive_assets";
+const std::string archive_path = "bench_archive.fnxpak";
+
+/// @brief Write a tree of small assets, mostly text like OBJ, MTL, fonts and layouts with some binary images.
+std::vector<std::string> make_assets()
+{
+    fnx::rng::default_engine engine(3u);
+    std::vector<std::string> names;
+    for (size_t i = 0; i < num_files; ++i)
+    {
+        const bool binary = i % 4 == 0;
+        const auto name = asset_dir + "/" + std::to_string(i % 20) + "/asset" + std::to_string(i) +
+                          (binary ? ".bin" : ".txt");
+        const auto size = static_cast<size_t>(fnx::rng::uniform(engine, 512.f, 32768.f));
+        std::string content;
+        while (content.size() < size)
+        {
+            content += binary ? std::string(1, static_cast<char>(fnx::rng::uniform(engine, 0.f, 255.f))) :
+                       "v " + std::to_string(content.size() % 251) + " 0.25 1.0\n";
+        }
+        std::filesystem::create_directories(std::filesystem::path(name).parent_path());
+        std::ofstream(name, std::ios::binary) << content;
+        names.push_back(name);
+    }
+    return names;
+}
+}
+
+TEST(archive, startup)
+{
+    const auto names = make_assets();
+    std::vector<fnx::mapped_file> files;
+    std::vector<fnx::archive_input> inputs;
+    size_t total_size = 0;
+    for (const auto& name : names)
+    {
+        files.emplace_back(name);
+        inputs.push_back({name, files.back().data(), files.back().size(), name.back() == 't'});
+        total_size += files.back().size();
+    }
+    std::vector<char> bytes;
+    bench::measure("pack " + std::to_string(num_files) + " files", 3, [&]() {
+        bytes = fnx::archive::serialize(inputs);
+    });
+    std::ofstream(archive_path, std::ios::binary).write(bytes.data(), bytes.size());
+    files.clear();
+    std::cout << "[ BENCH    ] " << total_size / 1024 << " KB of files in a " << bytes.size() / 1024 << " KB archive"
+              << std::endl;
+
+    // what the loaders did before, an ifstream read of each file
+    bench::measure("read loose files with ifstream", 5, [&]() {
+        for (const auto& name : names)
+        {
+            std::ifstream in(name, std::ios::binary);
+            std::ostringstream out;
+            out << in.rdbuf();
+            const auto content = out.str();
+            bench::keep(fnx::hash_bytes(content.data(), content.size()));
+        }
+    });
+    bench::measure("read loose files with read_file", 5, [&]() {
+        for (const auto& name : names)
+        {
+            const auto file = fnx::read_file(name);
+            bench::keep(fnx::hash_bytes(file.data(), file.size()));
+        }
+    });
+    bench::measure("mount and read the archive", 5, [&]() {
+        {
+            auto [file_system, _] = fnx::singleton<fnx::file_system>::acquire();
+            file_system.mount(archive_path);
+        }
+        for (const auto& name : names)
+        {
+            const auto file = fnx::read_file(name);
+            bench::keep(fnx::hash_bytes(file.data(), file.size()));
+        }
+        auto [file_system, _] = fnx::singleton<fnx::file_system>::acquire();
+        file_system.unmount_all();
+    });
+
+    std::filesystem::remove_all(asset_dir);
+    std::remove(archive_path.c_str());
+}
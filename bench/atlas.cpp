@@ -0,0 +1,74 @@
+#include "test.hpp"
+#include "bench.hpp"
+#include "fnx/fnx.hpp"
+
+namespace
+{
+constexpr uint32_t page_size = 2048;
+constexpr uint32_t padding = 2;
+constexpr size_t num_icons = 1000;
+
+/// @brief Sizes of UI images, mostly small icons with a few larger panels.
+std::vector<std::pair<uint32_t, uint32_t>> make_icons()
+{
+    fnx::rng::default_engine engine(11u);
+    std::vector<std::pair<uint32_t, uint32_t>> icons(num_icons);
+    for (auto& [width, height] : icons)
+    {
+        const bool panel = fnx::rng::uniform(engine, 0.f, 1.f) < .1f;
+        const float max_size = panel ? 256.f : 64.f;
+        width = static_cast<uint32_t>(fnx::rng::uniform(engine, 16.f, max_size));
+        height = panel ? static_cast<uint32_t>(fnx::rng::uniform(engine, 16.f, max_size)) : width;
+    }
+    return icons;
+}
+
+/// @brief Pack every icon into as many pages as needed.
+/// @return page of each icon
+std::vector<size_t> pack(const std::vector<std::pair<uint32_t, uint32_t>>& icons, std::vector<fnx::rect_packer>& pages)
+{
+    std::vector<size_t> placed;
+    placed.reserve(icons.size());
+    fnx::packed_rect rect;
+    for (const auto& [width, height] : icons)
+    {
+        size_t page = 0;
+        while (page < pages.size() && !pages[page].insert(width + 2 * padding, height + 2 * padding, rect))
+        {
+            ++page;
+        }
+        if (page == pages.size())
+        {
+            pages.emplace_back(page_size, page_size);
+            pages.back().insert(width + 2 * padding, height + 2 * padding, rect);
+        }
+        placed.push_back(page);
+    }
+    return placed;
+}
+}
+
+TEST(atlas, binds)
+{
+    const auto icons = make_icons();
+    std::vector<fnx::rect_packer> pages;
+    bench::measure(std::to_string(num_icons) + " ui images into " + std::to_string(page_size) + "^2 pages", 20, [&]() {
+        pages.clear();
+        bench::keep(pack(icons, pages).size());
+    });
+
+    // widgets are drawn in layout order, a bind happens when the texture differs from the previous widget's
+    const auto placed = pack(icons, pages = {});
+    size_t atlas_binds = 1;
+    for (size_t i = 1; i < placed.size(); ++i)
+    {
+        atlas_binds += placed[i] != placed[i - 1] ? 1 : 0;
+    }
+    std::cout << "[ BENCH    ] texture binds per frame: " << icons.size() << " with a texture per image, "
+              << atlas_binds << " with " << pages.size() << " atlas pages" << std::endl;
+    for (size_t i = 0; i < pages.size(); ++i)
+    {
+        std::cout << "[ BENCH    ] page " << i << " occupancy " << std::setprecision(1)
+                  << pages[i].get_occupancy() * 100.f << "%" << std::endl;
+    }
+}
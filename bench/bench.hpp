@@ -0,0 +1,41 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+namespace bench
+{
+/// @brief Prevent the optimizer from discarding a computed value.
+template<typename T>
+inline void keep(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+    _ReadWriteBarrier();
+#endif
+}
+
+/// @brief Run a function a number of times and report the average time per call.
+/// @return average nanoseconds per call
+template<typename Func>
+double measure(const std::string& name, size_t iterations, Func&& f)
+{
+    // warm up caches and lazily built tables
+    f();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        f();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto ns = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+    std::cout << "[ BENCH    ] " << std::left << std::setw(48) << name << std::right << std::setw(14)
+              << std::fixed << std::setprecision(1) << ns << " ns" << std::endl;
+    return ns;
+}
+}
@@ -0,0 +1,192 @@
+#include "test.hpp"
+#include "bench.hpp"
+#include "fnx/fnx.hpp"
+
+namespace
+{
+constexpr size_t num_widgets = 10000;
+constexpr size_t num_frames = 20;
+
+/// @brief Same layout as font::CharInfo.
+struct glyph
+{
+    short x, y, width, height, xoffset, yoffset, xadvance;
+};
+
+template<typename Map>
+/// @brief Material parameters written and resolved to uniform locations for every widget, as in block::render.
+struct material_frame
+{
+    std::vector<Map> materials;
+    typename Map::template rebind<int> uniform_locations;
+
+    material_frame()
+        : materials(num_widgets)
+    {
+        auto loc = 0;
+        for (auto name : uniforms())
+        {
+            uniform_locations[fnx::string_id(name)] = loc++;
+        }
+    }
+
+    static const std::array<const char*, 9>& uniforms()
+    {
+        static const std::array<const char*, 9> names{ fnx::UNIFORM_COLOR, fnx::UNIFORM_SIZE, fnx::UNIFORM_CENTER,
+            fnx::UNIFORM_RADIUS, fnx::UNIFORM_RESOLUTION, fnx::UNIFORM_OUTLINE_THICKNESS, fnx::UNIFORM_OUTLINE_COLOR,
+            fnx::UNIFORM_NUM_GRADIENT, fnx::UNIFORM_GRADIENT_DIRECTION };
+        return names;
+    }
+
+    int render()
+    {
+        auto total = 0;
+        for (auto& material : materials)
+        {
+            for (auto name : uniforms())
+            {
+                material[fnx::string_id(name)] = fnx::vector4(1.f, 1.f, 1.f, 1.f);
+            }
+            for (const auto& param : material)
+            {
+                total += uniform_locations.find(param.first)->second;
+            }
+        }
+        return total;
+    }
+};
+
+template<typename Value>
+struct std_material : std::unordered_map<fnx::string_id, Value>
+{
+    template<typename V>
+    using rebind = std::unordered_map<fnx::string_id, V>;
+};
+
+template<typename Value>
+struct flat_material : fnx::flat_map<fnx::string_id, Value>
+{
+    template<typename V>
+    using rebind = fnx::flat_map<fnx::string_id, V>;
+};
+
+/// @brief Printable ascii text as laid out by font::calculate_texture_model_info.
+std::string make_text()
+{
+    std::string text;
+    uint32_t state = 7u;
+    for (size_t i = 0; i < 1u << 18; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        text += static_cast<char>(0x20 + (state >> 16) % 95);
+    }
+    return text;
+}
+
+template<typename Map>
+int layout(Map& glyphs, const std::string& text)
+{
+    auto total = 0;
+    for (auto c : text)
+    {
+        total += glyphs[c].xadvance;
+    }
+    return total;
+}
+
+template<typename Map>
+size_t lookup_widgets(Map& widgets, const std::vector<fnx::widget_id>& ids)
+{
+    size_t total = 0u;
+    for (auto id : ids)
+    {
+        total += reinterpret_cast<size_t>(widgets.find(id)->second);
+    }
+    return total;
+}
+
+void report(double baseline, double flat)
+{
+    std::cout << "[ BENCH    ] speedup " << std::setprecision(2) << baseline / flat << "x" << std::endl;
+}
+}
+
+TEST(flat_map, material_parameters)
+{
+    material_frame<std_material<fnx::vector4>> node_maps;
+    material_frame<flat_material<fnx::vector4>> flat_maps;
+    EXPECT_EQ(node_maps.render(), flat_maps.render());
+
+    auto std_ns = bench::measure("material frame, std::unordered_map", num_frames, [&]() { bench::keep(node_maps.render()); });
+    auto flat_ns = bench::measure("material frame, fnx::flat_map", num_frames, [&]() { bench::keep(flat_maps.render()); });
+    report(std_ns, flat_ns);
+}
+
+TEST(flat_map, font_glyphs)
+{
+    std::unordered_map<char, glyph> node_glyphs;
+    fnx::flat_map<char, glyph> flat_glyphs;
+    for (char c = 0x20; c < 0x7f; ++c)
+    {
+        glyph g{ c, c, 8, 16, 0, 0, static_cast<short>(c % 13) };
+        node_glyphs[c] = g;
+        flat_glyphs[c] = g;
+    }
+    auto text = make_text();
+    EXPECT_EQ(layout(node_glyphs, text), layout(flat_glyphs, text));
+
+    auto std_ns = bench::measure("256k glyphs, std::unordered_map", num_frames, [&]() { bench::keep(layout(node_glyphs, text)); });
+    auto flat_ns = bench::measure("256k glyphs, fnx::flat_map", num_frames, [&]() { bench::keep(layout(flat_glyphs, text)); });
+    report(std_ns, flat_ns);
+}
+
+TEST(flat_map, widget_ids)
+{
+    std::unordered_map<fnx::widget_id, void*> node_widgets;
+    fnx::flat_map<fnx::widget_id, void*> flat_widgets;
+    std::vector<fnx::widget_id> ids;
+    for (fnx::widget_id id = 1; id <= num_widgets; ++id)
+    {
+        node_widgets[id] = reinterpret_cast<void*>(static_cast<size_t>(id) * 64u);
+        flat_widgets[id] = reinterpret_cast<void*>(static_cast<size_t>(id) * 64u);
+    }
+    uint32_t state = 3u;
+    for (size_t i = 0; i < 100000; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        ids.emplace_back(1u + (state >> 8) % num_widgets);
+    }
+    EXPECT_EQ(lookup_widgets(node_widgets, ids), lookup_widgets(flat_widgets, ids));
+
+    auto std_ns = bench::measure("100k widget lookups, std::unordered_map", num_frames, [&]() { bench::keep(lookup_widgets(node_widgets, ids)); });
+    auto flat_ns = bench::measure("100k widget lookups, fnx::flat_map", num_frames, [&]() { bench::keep(lookup_widgets(flat_widgets, ids)); });
+    report(std_ns, flat_ns);
+}
+
+TEST(flat_map, string_keys_by_literal)
+{
+    std::unordered_map<std::string, int> node_names;
+    fnx::flat_map<std::string, int> flat_names;
+    std::vector<std::string> names;
+    for (size_t i = 0; i < 512; ++i)
+    {
+        names.emplace_back("widgets/panel_" + std::to_string(i) + "/background_texture");
+        node_names[names.back()] = static_cast<int>(i);
+        flat_names[names.back()] = static_cast<int>(i);
+    }
+
+    auto lookup = [&](auto& map) {
+        auto total = 0;
+        for (const auto& name : names)
+        {
+            // c strings are what the ui passes around, std::unordered_map has to build a std::string
+            total += map.find(name.c_str())->second;
+        }
+        return total;
+    };
+    EXPECT_EQ(lookup(node_names), lookup(flat_names));
+
+    auto std_ns = bench::measure("512 const char* lookups, std::unordered_map", 2000, [&]() { bench::keep(lookup(node_names)); });
+    auto flat_ns = bench::measure("512 const char* lookups, fnx::flat_map", 2000, [&]() { bench::keep(lookup(flat_names)); });
+    report(std_ns, flat_ns);
+}
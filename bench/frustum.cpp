@@ -0,0 +1,91 @@
+#include "test.hpp"
+#include "bench.hpp"
+#include "fnx/fnx.hpp"
+
+namespace
+{
+constexpr size_t num_objects = 100000;
+constexpr size_t num_frames = 50;
+
+fnx::frustum make_frustum()
+{
+    auto view = fnx::matrix_look_at(fnx::vector3{0.f, 10.f, 0.f}, fnx::vector3{30.f, 0.f, -40.f}, fnx::vector3{0.f, 1.f, 0.f});
+    auto projection = fnx::matrix_perspective(fnx::angle{fnx::Degree(60.0)}, 16.f / 9.f, .1f, 500.f);
+    return fnx::frustum::from_view_projection(view * projection);
+}
+
+/// @brief Centers scattered around the camera so that part of the objects are visible.
+std::vector<fnx::vector4> make_spheres()
+{
+    fnx::rng::default_engine engine(42u);
+    std::vector<fnx::vector4> spheres;
+    for (size_t i = 0; i < num_objects; ++i)
+    {
+        spheres.emplace_back(fnx::rng::uniform(engine, -500.f, 500.f), fnx::rng::uniform(engine, -50.f, 50.f),
+                             fnx::rng::uniform(engine, -500.f, 500.f), fnx::rng::uniform(engine, .5f, 5.f));
+    }
+    return spheres;
+}
+
+void report(size_t visible, double baseline, double batched)
+{
+    std::cout << "[ BENCH    ] " << visible << " of " << num_objects << " visible, " << std::setprecision(1)
+              << static_cast<double>(num_objects) * 1000. / batched << " M/s, speedup " << std::setprecision(2)
+              << baseline / batched << "x (" << fnx::simd::backend() << ")" << std::endl;
+}
+}
+
+TEST(frustum, aabbs)
+{
+    auto frustum = make_frustum();
+    std::vector<reactphysics3d::AABB> boxes;
+    for (const auto& s : make_spheres())
+    {
+        boxes.emplace_back(fnx::vector3{s.x - s.w, s.y - s.w, s.z - s.w}, fnx::vector3{s.x + s.w, s.y + s.w, s.z + s.w});
+    }
+    std::vector<uint32_t> visible;
+    visible.reserve(boxes.size());
+    auto single_ns = bench::measure("100k aabbs, one at a time", num_frames, [&]() {
+        visible.clear();
+        for (uint32_t i = 0; i < boxes.size(); ++i)
+        {
+            if (frustum.intersects(boxes[i]))
+            {
+                visible.push_back(i);
+            }
+        }
+        bench::keep(visible.size());
+    });
+    auto expected = visible;
+    auto batched_ns = bench::measure("100k aabbs, cull_aabbs", num_frames, [&]() {
+        bench::keep(fnx::cull_aabbs(frustum, boxes, visible));
+    });
+    EXPECT_TRUE(expected == visible);
+    report(visible.size(), single_ns, batched_ns);
+}
+
+TEST(frustum, spheres)
+{
+    auto frustum = make_frustum();
+    auto spheres = make_spheres();
+    std::vector<uint32_t> visible;
+    visible.reserve(spheres.size());
+    auto single_ns = bench::measure("100k spheres, one at a time", num_frames, [&]() {
+        visible.clear();
+        for (uint32_t i = 0; i < spheres.size(); ++i)
+        {
+            const auto& s = spheres[i];
+            if (frustum.intersects(fnx::vector3{s.x, s.y, s.z}, s.w))
+            {
+                visible.push_back(i);
+            }
+        }
+        bench::keep(visible.size());
+    });
+    auto expected = visible;
+    auto batched_ns = bench::measure("100k spheres, cull_spheres", num_frames, [&]() {
+        bench::keep(fnx::cull_spheres(frustum, spheres, visible));
+    });
+    EXPECT_TRUE(expected == visible);
+    report(visible.size(), single_ns, batched_ns);
+}
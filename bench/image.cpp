@@ -0,0 +1,99 @@
+#include "test.hpp"
+#include "bench.hpp"
+#include "fnx/fnx.hpp"
+
+namespace
+{
+constexpr uint32_t image_size = 1024;
+constexpr size_t num_runs = 5;
+
+/// @brief An RGBA image of noise, like a photographed texture.
+std::vector<unsigned char> make_image()
+{
+    fnx::rng::default_engine engine(42u);
+    std::vector<unsigned char> pixels(image_size * image_size * 4);
+    for (auto& value : pixels)
+    {
+        value = static_cast<unsigned char>(fnx::rng::uniform(engine, 0.f, 255.f));
+    }
+    return pixels;
+}
+
+/// @brief An RGBA cutout of soft shapes and fine grain, closer to painted texture content than noise.
+std::vector<unsigned char> make_painted_image()
+{
+    fnx::rng::default_engine engine(7u);
+    std::vector<unsigned char> pixels(image_size * image_size * 4);
+    for (uint32_t y = 0; y < image_size; ++y)
+    {
+        for (uint32_t x = 0; x < image_size; ++x)
+        {
+            const float u = x / float(image_size);
+            const float v = y / float(image_size);
+            const float grain = fnx::rng::uniform(engine, -4.f, 4.f);
+            const float shape = std::sin(u * 19.f) * std::cos(v * 13.f);
+            auto* pixel = &pixels[(y * image_size + x) * 4];
+            pixel[0] = static_cast<unsigned char>(std::clamp(128.f + 90.f * shape + grain, 0.f, 255.f));
+            pixel[1] = static_cast<unsigned char>(std::clamp(200.f * v + grain, 0.f, 255.f));
+            pixel[2] = static_cast<unsigned char>(std::clamp(60.f + 120.f * u * v, 0.f, 255.f));
+            pixel[3] = static_cast<unsigned char>(shape > -.6f ? 255 : 0);
+            if (pixel[3] == 0)
+            {
+                // premultiplied, like cutouts drawn with blending
+                pixel[0] = pixel[1] = pixel[2] = 0;
+            }
+        }
+    }
+    return pixels;
+}
+}
+
+TEST(image, mips)
+{
+    const auto pixels = make_image();
+    const std::string size = std::to_string(image_size) + "^2 rgba ";
+    for (auto filter : {fnx::mip_filter::box, fnx::mip_filter::kaiser})
+    {
+        const std::string name = size + (filter == fnx::mip_filter::box ? "box" : "kaiser");
+        fnx::image_options options;
+        options.filter = filter;
+        bench::measure(name, num_runs, [&]() {
+            bench::keep(fnx::build_mips(pixels.data(), image_size, image_size, 4, options).size());
+        });
+        options.srgb = true;
+        options.alpha_cutoff = .5f;
+        bench::measure(name + ", srgb and alpha coverage", num_runs, [&]() {
+            bench::keep(fnx::build_mips(pixels.data(), image_size, image_size, 4, options).size());
+        });
+    }
+    std::cout << "[ BENCH    ] filter kernels: " << fnx::simd::backend() << std::endl;
+}
+
+TEST(image, compression)
+{
+    // the quality and memory of each block format, measured on the CPU without a GPU
+    const auto pixels = make_painted_image();
+    const auto mips = fnx::build_mips(pixels.data(), image_size, image_size, 4, {});
+    const std::string size = std::to_string(image_size) + "^2 rgba ";
+    for (auto format : {fnx::block_format::bc1, fnx::block_format::bc3, fnx::block_format::bc4, fnx::block_format::bc5,
+                        fnx::block_format::bc7})
+    {
+        std::vector<unsigned char> blocks;
+        bench::measure(size + fnx::get_block_format_name(format), 2, [&]() {
+            blocks = fnx::compress_blocks(pixels.data(), image_size, image_size, format);
+        });
+        const auto decoded = fnx::decompress_blocks(blocks.data(), image_size, image_size, format);
+        const uint32_t channels = format == fnx::block_format::bc4 ? 1 : format == fnx::block_format::bc5 ? 2 : 4;
+        size_t raw_bytes = fnx::get_compressed_size(fnx::block_format::none, image_size, image_size);
+        size_t compressed_bytes = blocks.size();
+        for (const auto& mip : mips)
+        {
+            raw_bytes += fnx::get_compressed_size(fnx::block_format::none, mip._width, mip._height);
+            compressed_bytes += fnx::get_compressed_size(format, mip._width, mip._height);
+        }
+        std::cout << "[ BENCH    ] " << fnx::get_block_format_name(format) << ": PSNR " << std::setprecision(2)
+                  << fnx::compute_psnr(pixels.data(), decoded.data(), pixels.size() / 4, channels) << " dB, "
+                  << raw_bytes / (1024.0 * 1024.0) << " MB to " << compressed_bytes / (1024.0 * 1024.0)
+                  << " MB with mips" << std::endl;
+    }
+}
@@ -0,0 +1,7 @@
+#include "test.hpp"
+
+int main(int argc, char* argv[])
+{
+    auto& reg = test::Registry::inst();
+    return reg.run_all_tests(argc, argv);
+}
@@ -0,0 +1,113 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "test.hpp"
+#include "bench.hpp"
+#include "fnx/fnx.hpp"
+
+namespace
+{
+constexpr size_t num_materials = 5000;
+constexpr size_t num_runs = 10;
+const std::string mtl_path = "bench_materials.mtl";
+
+/// @brief A material library like the ones exported with a large scene, most materials have a diffuse map.
+std::string make_mtl()
+{
+    fnx::rng::default_engine engine(7u);
+    std::string text = "# exported materials\n";
+    char line[128];
+    for (size_t i = 0; i < num_materials; ++i)
+    {
+        text += "\nnewmtl material_" + std::to_string(i) + "\n";
+        std::snprintf(line, sizeof(line), "Ns %.6f\nKa 1.000000 1.000000 1.000000\n", fnx::rng::uniform(engine, 0.f, 1000.f));
+        text += line;
+        std::snprintf(line, sizeof(line), "Kd %.6f %.6f %.6f\n", fnx::rng::uniform(engine, 0.f, 1.f),
+                      fnx::rng::uniform(engine, 0.f, 1.f), fnx::rng::uniform(engine, 0.f, 1.f));
+        text += line;
+        text += "Ks 0.500000 0.500000 0.500000\nKe 0.000000 0.000000 0.000000\nNi 1.450000\nd 1.000000\nillum 2\n";
+        if (i % 4 != 0)
+        {
+            text += "map_Kd textures/diffuse_" + std::to_string(i % 300) + ".png\n";
+        }
+    }
+    return text;
+}
+
+/// @brief What parse_material_file did before, a getline and a stringstream for each line.
+size_t parse_with_streams(const std::string& text)
+{
+    std::istringstream in(text);
+    std::string line;
+    std::vector<fnx::mtl_material> materials;
+    std::vector<std::string> names;
+    std::vector<std::string> paths;
+    while (getline(in, line))
+    {
+        std::stringstream str(line);
+        std::string cmd;
+        std::string word;
+        str >> cmd;
+        if ("newmtl" == cmd)
+        {
+            str >> word;
+            names.push_back(word);
+            materials.emplace_back();
+        }
+        else if ("Ns" == cmd)
+        {
+            str >> materials.back().values.ns;
+        }
+        else if ("Ni" == cmd)
+        {
+            str >> materials.back().values.ni;
+        }
+        else if ("d" == cmd)
+        {
+            str >> materials.back().values.d;
+        }
+        else if ("illum" == cmd)
+        {
+            str >> materials.back().values.illum;
+        }
+        else if ("Ka" == cmd || "Kd" == cmd || "Ks" == cmd || "Ke" == cmd)
+        {
+            auto& values = materials.back().values;
+            auto* color = "Ka" == cmd ? values.ka : "Kd" == cmd ? values.kd : "Ks" == cmd ? values.ks : values.ke;
+            str >> color[0] >> color[1] >> color[2];
+        }
+        else if ("map_Kd" == cmd)
+        {
+            str >> word;
+            paths.push_back(word);
+        }
+    }
+    return materials.size() + paths.size();
+}
+}
+
+TEST(material, parse)
+{
+    const auto text = make_mtl();
+    std::ofstream(mtl_path, std::ios::binary) << text;
+    std::remove(fnx::get_material_cache_path(mtl_path).c_str());
+
+    bench::measure("parse " + std::to_string(num_materials) + " materials with streams", num_runs, [&]() {
+        bench::keep(parse_with_streams(text));
+    });
+    bench::measure("parse_mtl", num_runs, [&]() {
+        bench::keep(fnx::parse_mtl(text).size());
+    });
+    bench::measure("load_material_cache, no cache", num_runs, [&]() {
+        std::remove(fnx::get_material_cache_path(mtl_path).c_str());
+        bench::keep(fnx::load_material_cache(mtl_path).get_materials().size());
+    });
+    fnx::load_material_cache(mtl_path);
+    bench::measure("load_material_cache, cached", num_runs, [&]() {
+        bench::keep(fnx::load_material_cache(mtl_path).get_materials().size());
+    });
+    EXPECT_EQ(num_materials, fnx::load_material_cache(mtl_path).get_materials().size());
+
+    std::remove(fnx::get_material_cache_path(mtl_path).c_str());
+    std::remove(mtl_path.c_str());
+}
@@ -0,0 +1,119 @@
+#include "test.hpp"
+#include "bench.hpp"
+#include "fnx/fnx.hpp"
+
+namespace
+{
+constexpr size_t num_matrices = 1024;
+constexpr size_t num_frames = 2000;
+
+/// @brief Invertible transforms like the ones built for every widget and model.
+std::vector<fnx::matrix4x4> make_transforms()
+{
+    std::vector<fnx::matrix4x4> transforms;
+    for (size_t i = 0; i < num_matrices; ++i)
+    {
+        auto f = static_cast<fnx::decimal>(i % 97);
+        transforms.emplace_back(fnx::calculate_transform_matrix(f, -f, f * .5f, f * 3.f, f * 5.f, f * 7.f,
+                                                                1.f + f / 64.f, 1.f, 2.f));
+    }
+    return transforms;
+}
+
+template<typename Func>
+fnx::decimal for_each_pair(const std::vector<fnx::matrix4x4>& in, std::vector<fnx::matrix4x4>& out, Func&& func)
+{
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        func(in[i], in[(i + 1) % in.size()], out[i]);
+    }
+    return out.back()[0][0];
+}
+
+void report(double baseline, double simd)
+{
+    std::cout << "[ BENCH    ] speedup " << std::setprecision(2) << baseline / simd << "x (" << fnx::simd::backend()
+              << ")" << std::endl;
+}
+}
+
+TEST(matrix4x4, multiply)
+{
+    auto in = make_transforms();
+    std::vector<fnx::matrix4x4> out(in.size());
+    auto scalar_ns = bench::measure("1k multiply, scalar", num_frames, [&]() {
+        bench::keep(for_each_pair(in, out, [](const auto& a, const auto& b, auto& r) {
+            fnx::simd::scalar::mat4_multiply(a.data(), b.data(), r.data());
+        }));
+    });
+    auto simd_ns = bench::measure("1k multiply, operator*", num_frames, [&]() {
+        bench::keep(for_each_pair(in, out, [](const auto& a, const auto& b, auto& r) { r = a * b; }));
+    });
+    report(scalar_ns, simd_ns);
+}
+
+TEST(matrix4x4, inverse)
+{
+    auto in = make_transforms();
+    std::vector<fnx::matrix4x4> out(in.size());
+    auto scalar_ns = bench::measure("1k inverse, scalar", num_frames, [&]() {
+        bench::keep(for_each_pair(in, out, [](const auto& a, const auto&, auto& r) {
+            fnx::simd::scalar::mat4_inverse(a.data(), r.data());
+        }));
+    });
+    auto simd_ns = bench::measure("1k inverse, matrix_inverse", num_frames, [&]() {
+        bench::keep(for_each_pair(in, out, [](const auto& a, const auto&, auto& r) { r = fnx::matrix_inverse(a); }));
+    });
+    report(scalar_ns, simd_ns);
+}
+
+TEST(matrix4x4, transpose)
+{
+    auto in = make_transforms();
+    std::vector<fnx::matrix4x4> out(in.size());
+    auto scalar_ns = bench::measure("1k transpose, scalar", num_frames, [&]() {
+        bench::keep(for_each_pair(in, out, [](const auto& a, const auto&, auto& r) {
+            fnx::simd::scalar::mat4_transpose(a.data(), r.data());
+        }));
+    });
+    auto simd_ns = bench::measure("1k transpose, matrix_transpose", num_frames, [&]() {
+        bench::keep(for_each_pair(in, out, [](const auto& a, const auto&, auto& r) { r = fnx::matrix_transpose(a); }));
+    });
+    report(scalar_ns, simd_ns);
+}
+
+TEST(matrix4x4, affine_compose)
+{
+    // the per widget transform built in block::render
+    auto in = make_transforms();
+    std::vector<fnx::matrix4x4> out(in.size());
+    const fnx::vector3 scale{2.f, 3.f, 1.f};
+    auto scalar_ns = bench::measure("1k widget transforms, scalar", num_frames, [&]() {
+        bench::keep(for_each_pair(in, out, [&](const auto& parent, const auto&, auto& r) {
+            fnx::matrix4x4 mat_scale, mat_translate, mat_center;
+            fnx::simd::scalar::mat4_scale_rows(fnx::matrix4x4::identity().data(), scale.x, scale.y, scale.z,
+                                               mat_scale.data());
+            fnx::simd::scalar::mat4_multiply(parent.data(), fnx::matrix_translate(fnx::vector3{10.f, 20.f, 0.f}).data(),
+                                             mat_translate.data());
+            fnx::simd::scalar::mat4_multiply(mat_translate.data(), fnx::matrix_translate(fnx::vector3{5.f, 5.f, 0.f}).data(),
+                                             mat_center.data());
+            fnx::simd::scalar::mat4_multiply(mat_scale.data(), mat_center.data(), r.data());
+        }));
+    });
+    auto simd_ns = bench::measure("1k widget transforms, simd", num_frames, [&]() {
+        bench::keep(for_each_pair(in, out, [&](const auto& parent, const auto&, auto& r) {
+            auto mat_scale = fnx::matrix_scale(fnx::matrix4x4::identity(), scale);
+            auto mat_translate = fnx::matrix_translate(parent, 10.f, 20.f, 0.f);
+            r = mat_scale * fnx::matrix_translate(mat_translate, 5.f, 5.f, 0.f);
+        }));
+    });
+    report(scalar_ns, simd_ns);
+
+    auto multiply_ns = bench::measure("1k affine compose, operator*", num_frames, [&]() {
+        bench::keep(for_each_pair(in, out, [](const auto& a, const auto& b, auto& r) { r = a * b; }));
+    });
+    auto affine_ns = bench::measure("1k affine compose, matrix_affine_multiply", num_frames, [&]() {
+        bench::keep(for_each_pair(in, out, [](const auto& a, const auto& b, auto& r) { r = fnx::matrix_affine_multiply(a, b); }));
+    });
+    report(multiply_ns, affine_ns);
+}
@@ -0,0 +1,182 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include "test.hpp"
+#include "bench.hpp"
+#include "fnx/fnx.hpp"
+
+namespace
+{
+constexpr size_t grid_size = 256;
+constexpr size_t num_runs = 10;
+
+/// @brief A height field of grid_size^2 quads written as v/vt/vn triangles, like an exported terrain.
+std::string make_obj()
+{
+    fnx::rng::default_engine engine(42u);
+    std::string text = "o terrain\n";
+    char line[128];
+    const auto side = grid_size + 1;
+    for (size_t i = 0; i < side * side; ++i)
+    {
+        std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n", (i % side) * .01f, fnx::rng::uniform(engine, 0.f, .1f), (i / side) * .01f);
+        text += line;
+    }
+    for (size_t i = 0; i < side * side; ++i)
+    {
+        std::snprintf(line, sizeof(line), "vt %.6f %.6f\n", (i % side) / float(grid_size), (i / side) / float(grid_size));
+        text += line;
+    }
+    for (size_t i = 0; i < side * side; ++i)
+    {
+        text += "vn 0.000000 1.000000 0.000000\n";
+    }
+    for (size_t y = 0; y < grid_size; ++y)
+    {
+        for (size_t x = 0; x < grid_size; ++x)
+        {
+            auto a = y * side + x + 1, b = a + 1, c = a + side, d = c + 1;
+            std::snprintf(line, sizeof(line), "f %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu\n", a, a, a, c, c, c, b, b, b);
+            text += line;
+            std::snprintf(line, sizeof(line), "f %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu\n", b, b, b, c, c, c, d, d, d);
+            text += line;
+        }
+    }
+    return text;
+}
+}
+
+TEST(obj, parse)
+{
+    auto text = make_obj();
+    // tokenizing alone the way the line based parser did, before any vertex is assembled
+    auto getline_ns = bench::measure("getline, split and stof", num_runs, [&]() {
+        std::istringstream in(text);
+        std::string line;
+        float sum = 0.f;
+        while (std::getline(in, line))
+        {
+            auto tokens = fnx::split(fnx::trim(line), " ");
+            for (size_t i = 1; i < tokens.size() && tokens[0] != "o"; ++i)
+            {
+                for (const auto& value : fnx::split(tokens[i], "/"))
+                {
+                    sum += value.empty() ? 0.f : std::stof(value);
+                }
+            }
+        }
+        bench::keep(sum);
+    });
+    size_t num_floats = 0;
+    auto parse_ns = bench::measure("parse_obj", num_runs, [&]() {
+        auto data = fnx::parse_obj(text);
+        num_floats = data.objects.back().vertices.size();
+        bench::keep(num_floats);
+    });
+    EXPECT_EQ(grid_size * grid_size * 6 * 8, num_floats);
+    std::cout << "[ BENCH    ] " << text.size() / 1048576 << " MB, " << std::setprecision(0)
+              << static_cast<double>(text.size()) * 1000. / parse_ns << " MB/s, speedup over tokenizing "
+              << std::setprecision(2) << getline_ns / parse_ns << "x" << std::endl;
+}
+
+TEST(obj, threads)
+{
+    auto text = make_obj();
+    auto expected = fnx::parse_obj(text);
+    double serial_ns = 0.;
+    for (size_t threads : {1, 2, 4, 8, 16})
+    {
+        auto ns = bench::measure("parse_obj, " + std::to_string(threads) + " threads", num_runs, [&]() {
+            bench::keep(fnx::parse_obj(text, threads).objects.size());
+        });
+        serial_ns = threads == 1 ? ns : serial_ns;
+        EXPECT_TRUE(expected.objects.back().vertices == fnx::parse_obj(text, threads).objects.back().vertices);
+        std::cout << "[ BENCH    ] speedup " << std::setprecision(2) << serial_ns / ns << "x on "
+                  << std::thread::hardware_concurrency() << " cores" << std::endl;
+    }
+}
+
+TEST(obj, cache)
+{
+    const std::string path = "bench_cache.obj";
+    std::ofstream(path, std::ios::binary) << make_obj();
+    auto import_ns = bench::measure("load_obj", num_runs, [&]() {
+        bench::keep(fnx::load_obj(path).objects.size());
+    });
+    bench::keep(fnx::load_mesh_cache(path).get_meshes().size());	// writes the cache
+    size_t num_indices = 0;
+    auto cache_ns = bench::measure("load_mesh_cache, hash and map", num_runs, [&]() {
+        auto cache = fnx::load_mesh_cache(path);
+        const auto& mesh = cache.get_meshes().back();
+        num_indices = mesh.lods.empty() ? mesh.indices_32.size() : mesh.lods.front().start;	// without the levels of detail
+        bench::keep(num_indices);
+    });
+    EXPECT_EQ(grid_size * grid_size * 6, num_indices);
+    std::cout << "[ BENCH    ] speedup over importing " << std::setprecision(2) << import_ns / cache_ns << "x" << std::endl;
+    std::remove(path.c_str());
+    std::remove(fnx::get_mesh_cache_path(path).c_str());
+}
+
+TEST(obj, index)
+{
+    auto text = make_obj();
+    auto data = fnx::parse_obj(text);
+    const auto& terrain = data.objects.back();
+    const size_t stride = 8;
+    const auto num_vertices = terrain.vertices.size() / stride;
+    fnx::indexed_vertices indexed;
+    bench::measure("index_vertices", num_runs, [&]() {
+        indexed = fnx::index_vertices(terrain.vertices.data(), num_vertices, stride);
+        bench::keep(indexed.vertices.size());
+    });
+    EXPECT_EQ(num_vertices, indexed.get_num_indices());
+    const auto unindexed_bytes = terrain.vertices.size() * sizeof(float);
+    const auto vbo_bytes = indexed.vertices.size() * sizeof(float);
+    const auto ibo_bytes = indexed.indices.size() * sizeof(unsigned short) + indexed.indices_32.size() * sizeof(unsigned int);
+    std::cout << "[ BENCH    ] " << (indexed.indices.empty() ? 32 : 16) << " bit indices, VBO " << std::setprecision(2)
+              << static_cast<double>(unindexed_bytes) / vbo_bytes << "x smaller, VBO and IBO "
+              << static_cast<double>(unindexed_bytes) / (vbo_bytes + ibo_bytes) << "x smaller" << std::endl;
+}
+
+TEST(obj, optimize)
+{
+    auto text = make_obj();
+    auto data = fnx::parse_obj(text);
+    const auto& terrain = data.objects.back();
+    const size_t stride = 8;
+    const auto indexed = fnx::index_vertices(terrain.vertices.data(), terrain.vertices.size() / stride, stride);
+    fnx::mesh_optimization_report report;
+    bench::measure("optimize_mesh", 3, [&]() {
+        auto mesh = indexed;
+        report = fnx::optimize_mesh(mesh, stride, terrain.materials);
+        bench::keep(mesh.vertices.size());
+    });
+    std::cout << "[ BENCH    ] ACMR " << std::setprecision(3) << report.input.acmr << " -> " << report.vertex_cache.acmr
+              << " -> " << report.overdraw.acmr << ", ATVR " << report.input.atvr << " -> " << report.vertex_cache.atvr
+              << " -> " << report.overdraw.atvr << ", overfetch " << report.input_overfetch << " -> " << report.overfetch
+              << std::endl;
+}
+
+TEST(obj, lod)
+{
+    auto text = make_obj();
+    auto data = fnx::parse_obj(text);
+    const auto& terrain = data.objects.back();
+    const size_t stride = 8;
+    auto indexed = fnx::index_vertices(terrain.vertices.data(), terrain.vertices.size() / stride, stride);
+    fnx::optimize_mesh(indexed, stride, terrain.materials);
+    const auto num_triangles = indexed.get_num_indices() / 3;
+    const auto extent = std::max(terrain.aabb.getMax().x - terrain.aabb.getMin().x, terrain.aabb.getMax().z - terrain.aabb.getMin().z);
+    std::vector<fnx::mesh_lod> lods;
+    bench::measure("build_lods", 3, [&]() {
+        auto mesh = indexed;
+        lods = fnx::build_lods(mesh, stride, terrain.materials);
+        bench::keep(lods.size());
+    });
+    for (size_t l = 0; l < lods.size(); ++l)
+    {
+        std::cout << "[ BENCH    ] LOD " << l + 1 << ": " << (lods[l].end - lods[l].start) / 3 << " of " << num_triangles
+                  << " triangles, error " << std::setprecision(3) << lods[l].error / extent * 100.f << "% of the extent" << std::endl;
+    }
+}
@@ -0,0 +1,104 @@
+#include <random>
+#include "test.hpp"
+#include "bench.hpp"
+#include "fnx/fnx.hpp"
+
+namespace
+{
+constexpr size_t num_values = 1024;
+constexpr size_t num_frames = 2000;
+
+/// @brief fnx::random before it used a per thread engine.
+float seeded_per_call(float min, float max)
+{
+    auto seed = std::chrono::system_clock::now().time_since_epoch().count();
+    std::uniform_real_distribution<double> dist(min, max);
+    std::mt19937_64 rng(seed);
+    return static_cast<float>(dist(rng));
+}
+
+void report(double baseline, double faster)
+{
+    std::cout << "[ BENCH    ] speedup " << std::setprecision(2) << baseline / faster << "x" << std::endl;
+}
+}
+
+TEST(rng, random)
+{
+    std::vector<float> values(num_values);
+    auto old_ns = bench::measure("1k random, mt19937_64 seeded per call", 20, [&]() {
+        for (auto& v : values)
+        {
+            v = seeded_per_call(0.f, 1.f);
+        }
+        bench::keep(values.back());
+    });
+    auto new_ns = bench::measure("1k random, fnx::random", num_frames, [&]() {
+        for (auto& v : values)
+        {
+            v = fnx::random(0.f, 1.f);
+        }
+        bench::keep(values.back());
+    });
+    report(old_ns, new_ns);
+}
+
+TEST(rng, engines)
+{
+    fnx::rng::pcg32 pcg(1u);
+    fnx::rng::xoshiro256ss xoshiro(1u);
+    std::mt19937 mt(1u);
+    uint64_t sum = 0u;
+    bench::measure("1k std::mt19937", num_frames, [&]() {
+        for (size_t i = 0; i < num_values; ++i)
+        {
+            sum += mt();
+        }
+        bench::keep(sum);
+    });
+    bench::measure("1k pcg32", num_frames, [&]() {
+        for (size_t i = 0; i < num_values; ++i)
+        {
+            sum += pcg();
+        }
+        bench::keep(sum);
+    });
+    bench::measure("1k xoshiro256**", num_frames, [&]() {
+        for (size_t i = 0; i < num_values; ++i)
+        {
+            sum += xoshiro();
+        }
+        bench::keep(sum);
+    });
+}
+
+TEST(rng, fill)
+{
+    std::vector<float> values(num_values);
+    auto& engine = fnx::rng::thread_engine();
+    auto single_ns = bench::measure("1k uniform, one at a time", num_frames, [&]() {
+        for (auto& v : values)
+        {
+            v = fnx::rng::uniform(engine, -1.f, 1.f);
+        }
+        bench::keep(values.back());
+    });
+    auto fill_ns = bench::measure("1k uniform, fill_uniform", num_frames, [&]() {
+        fnx::rng::fill_uniform(values, -1.f, 1.f);
+        bench::keep(values.back());
+    });
+    report(single_ns, fill_ns);
+
+    single_ns = bench::measure("1k normal, one at a time", num_frames, [&]() {
+        for (auto& v : values)
+        {
+            v = fnx::rng::normal(engine, 0.f, 1.f);
+        }
+        bench::keep(values.back());
+    });
+    fill_ns = bench::measure("1k normal, fill_normal", num_frames, [&]() {
+        fnx::rng::fill_normal(values, 0.f, 1.f);
+        bench::keep(values.back());
+    });
+    report(single_ns, fill_ns);
+}
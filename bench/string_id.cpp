@@ -0,0 +1,76 @@
+#include "test.hpp"
+#include "bench.hpp"
+#include "fnx/fnx.hpp"
+
+namespace
+{
+constexpr size_t num_widgets = 10000;
+constexpr size_t num_frames = 20;
+
+/// @brief Stand in for the per widget material and shader state touched by block::render.
+template<typename Key>
+struct ui_frame
+{
+    std::unordered_map<Key, float> properties;
+    std::unordered_map<Key, int> uniform_locations;
+    std::vector<std::unordered_map<Key, fnx::vector4>> materials;
+
+    ui_frame()
+        : materials(num_widgets)
+    {
+        properties[Key(fnx::PROPERTY_UI_SCALE)] = 1.f;
+        auto loc = 0;
+        for (auto name : uniforms())
+        {
+            uniform_locations[Key(name)] = loc++;
+        }
+    }
+
+    static const std::array<const char*, 9>& uniforms()
+    {
+        static const std::array<const char*, 9> names{ fnx::UNIFORM_COLOR, fnx::UNIFORM_SIZE, fnx::UNIFORM_CENTER,
+            fnx::UNIFORM_RADIUS, fnx::UNIFORM_RESOLUTION, fnx::UNIFORM_OUTLINE_THICKNESS, fnx::UNIFORM_OUTLINE_COLOR,
+            fnx::UNIFORM_NUM_GRADIENT, fnx::UNIFORM_GRADIENT_DIRECTION };
+        return names;
+    }
+
+    int render()
+    {
+        auto total = 0;
+        for (auto& material : materials)
+        {
+            // block::render reads the scale and writes its material parameters by name
+            auto scale = properties[Key(fnx::PROPERTY_UI_SCALE)];
+            for (auto name : uniforms())
+            {
+                material[Key(name)] = fnx::vector4(scale, scale, scale, 1.f);
+            }
+            // renderer::apply_material resolves every parameter to a uniform location
+            for (const auto& param : material)
+            {
+                total += uniform_locations.find(param.first)->second;
+            }
+        }
+        return total;
+    }
+};
+}
+
+TEST(string_id, compile_time)
+{
+    using namespace fnx::literals;
+    constexpr auto id = "u_Color"_sid;
+    static_assert(id == fnx::string_id("u_Color"), "literal ids must match runtime ids");
+    EXPECT_EQ(fnx::string_id(std::string("u_Color")), id);
+}
+
+TEST(string_id, ui_frame_10k_widgets)
+{
+    ui_frame<std::string> strings;
+    ui_frame<fnx::string_id> ids;
+    EXPECT_EQ(strings.render(), ids.render());
+
+    auto string_ns = bench::measure("ui frame, std::string keys", num_frames, [&]() { bench::keep(strings.render()); });
+    auto id_ns = bench::measure("ui frame, fnx::string_id keys", num_frames, [&]() { bench::keep(ids.render()); });
+    std::cout << "[ BENCH    ] speedup " << std::setprecision(2) << string_ns / id_ns << "x" << std::endl;
+}
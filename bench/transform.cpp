@@ -0,0 +1,108 @@
+#include "test.hpp"
+#include "bench.hpp"
+#include "fnx/fnx.hpp"
+
+namespace
+{
+constexpr size_t element_counts[] = { 16, 256, 4096, 65536 };
+constexpr size_t elements_per_run = 8 * 1024 * 1024;
+
+fnx::matrix4x4 make_transform(size_t i)
+{
+    auto f = static_cast<fnx::decimal>(i % 97);
+    return fnx::calculate_transform_matrix(f, -f, f * .5f, f * 3.f, f * 5.f, f * 7.f, 1.f + f / 64.f, 1.f, 2.f);
+}
+
+size_t iterations(size_t count)
+{
+    return elements_per_run / count;
+}
+
+void report(size_t count, double baseline, double batched)
+{
+    std::cout << "[ BENCH    ] " << count << " elements: " << std::setprecision(1)
+              << static_cast<double>(count) * 1000. / batched << " M/s, speedup " << std::setprecision(2)
+              << baseline / batched << "x (" << fnx::simd::backend() << ")" << std::endl;
+}
+}
+
+TEST(transform, points)
+{
+    auto m = make_transform(42);
+    for (auto count : element_counts)
+    {
+        std::vector<fnx::vector3> in, out(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto f = static_cast<fnx::decimal>(i);
+            in.emplace_back(f, f * .5f, -f);
+        }
+        auto name = std::to_string(count) + " points";
+        auto single_ns = bench::measure(name + ", one at a time", iterations(count), [&]() {
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto p = m * fnx::vector4(in[i].x, in[i].y, in[i].z, 1.f);
+                out[i] = fnx::vector3{p.x, p.y, p.z};
+            }
+            bench::keep(out.back());
+        });
+        auto batched_ns = bench::measure(name + ", transform_points", iterations(count), [&]() {
+            fnx::transform_points(m, in, out);
+            bench::keep(out.back());
+        });
+        report(count, single_ns, batched_ns);
+    }
+}
+
+TEST(transform, matrices)
+{
+    for (auto count : element_counts)
+    {
+        std::vector<fnx::matrix4x4> parents, locals, out(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            parents.emplace_back(make_transform(i));
+            locals.emplace_back(make_transform(i + 1));
+        }
+        auto name = std::to_string(count) + " matrices";
+        auto single_ns = bench::measure(name + ", one at a time", iterations(count), [&]() {
+            for (size_t i = 0; i < count; ++i)
+            {
+                out[i] = parents[i] * locals[i];
+            }
+            bench::keep(out.back());
+        });
+        auto batched_ns = bench::measure(name + ", transform_matrices", iterations(count), [&]() {
+            fnx::transform_matrices(parents, locals, out);
+            bench::keep(out.back());
+        });
+        report(count, single_ns, batched_ns);
+    }
+}
+
+TEST(transform, aabbs)
+{
+    auto m = make_transform(42);
+    for (auto count : element_counts)
+    {
+        std::vector<reactphysics3d::AABB> in, out(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto f = static_cast<fnx::decimal>(i);
+            in.emplace_back(fnx::vector3{f, -f, f * .5f}, fnx::vector3{f + 1.f, 2.f - f, f});
+        }
+        auto name = std::to_string(count) + " aabbs";
+        auto single_ns = bench::measure(name + ", one at a time", iterations(count), [&]() {
+            for (size_t i = 0; i < count; ++i)
+            {
+                fnx::simd::scalar::transform_aabbs(m.data(), &in[i].getMin().x, const_cast<fnx::decimal*>(&out[i].getMin().x), 1);
+            }
+            bench::keep(out.back());
+        });
+        auto batched_ns = bench::measure(name + ", transform_aabbs", iterations(count), [&]() {
+            fnx::transform_aabbs(m, in, out);
+            bench::keep(out.back());
+        });
+        report(count, single_ns, batched_ns);
+    }
+}
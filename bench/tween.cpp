@@ -0,0 +1,93 @@
+#include "test.hpp"
+#include "bench.hpp"
+#include "fnx/fnx.hpp"
+
+namespace
+{
+constexpr size_t num_values = 1024;
+constexpr size_t num_frames = 2000;
+
+std::vector<float> make_times()
+{
+    std::vector<float> t;
+    for (size_t i = 0; i < num_values; ++i)
+    {
+        t.emplace_back(static_cast<float>((i * 37) % num_values) / static_cast<float>(num_values - 1));
+    }
+    return t;
+}
+
+void report(double baseline, double baked)
+{
+    std::cout << "[ BENCH    ] speedup " << std::setprecision(2) << baseline / baked << "x" << std::endl;
+}
+
+template<typename T>
+void compare(const std::string& name, fnx::tween<T> tween)
+{
+    auto t = make_times();
+    std::vector<T> out(t.size());
+    auto exact_ns = bench::measure(name + ", get", num_frames, [&]() {
+        for (size_t i = 0; i < t.size(); ++i)
+        {
+            out[i] = tween.get(t[i]);
+        }
+        bench::keep(out.back());
+    });
+    tween.bake();
+    auto baked_ns = bench::measure(name + ", baked get", num_frames, [&]() {
+        for (size_t i = 0; i < t.size(); ++i)
+        {
+            out[i] = tween.get(t[i]);
+        }
+        bench::keep(out.back());
+    });
+    report(exact_ns, baked_ns);
+    auto batch_ns = bench::measure(name + ", baked batch get", num_frames, [&]() {
+        tween.get(t, out);
+        bench::keep(out.back());
+    });
+    report(exact_ns, batch_ns);
+}
+}
+
+TEST(tween, float)
+{
+    compare("1k float", fnx::tween<float>(.43f, .4f, .19f, .04f));
+}
+
+TEST(tween, gradient)
+{
+    compare("1k gradient", fnx::tween<fnx::vector4>(fnx::vector4(1.f, 0.f, 0.f, 1.f), fnx::vector4(0.f, 1.f, 0.f, 1.f),
+                                                    fnx::vector4(0.f, 0.f, 1.f, 1.f), fnx::vector4(1.f, 1.f, 1.f, 0.f)));
+}
+
+TEST(tween, many)
+{
+    // one fade per widget, each at its own point in the animation
+    std::vector<fnx::tween<float>> fades;
+    for (size_t i = 0; i < num_values; ++i)
+    {
+        fades.emplace_back(0.f, static_cast<float>(i % 7) / 7.f, 1.f);
+    }
+    std::vector<const fnx::tween<float>*> tweens;
+    for (const auto& fade : fades)
+    {
+        tweens.emplace_back(&fade);
+    }
+    auto t = make_times();
+    std::vector<float> out(t.size());
+    auto exact_ns = bench::measure("1k tweens, evaluate", num_frames, [&]() {
+        fnx::evaluate<float>(tweens, t, out);
+        bench::keep(out.back());
+    });
+    for (auto& fade : fades)
+    {
+        fade.bake();
+    }
+    auto baked_ns = bench::measure("1k baked tweens, evaluate", num_frames, [&]() {
+        fnx::evaluate<float>(tweens, t, out);
+        bench::keep(out.back());
+    });
+    report(exact_ns, baked_ns);
+}
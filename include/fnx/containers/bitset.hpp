@@ -1,10 +1,62 @@
 #pragma once
 
+#include <cstdint>
+#include <cstring>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace fnx
 {
+namespace detail
+{
+/// @brief Returns the number of set bits within the word.
+inline unsigned int popcount64( uint64_t x )
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<unsigned int>( __popcnt64( x ) );
+#elif defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned int>( __builtin_popcountll( x ) );
+#else
+    x = x - ( ( x >> 1 ) & 0x5555555555555555ull );
+    x = ( x & 0x3333333333333333ull ) + ( ( x >> 2 ) & 0x3333333333333333ull );
+    x = ( x + ( x >> 4 ) ) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<unsigned int>( ( x * 0x0101010101010101ull ) >> 56 );
+#endif
+}
+
+/// @brief Returns the index of the lowest set bit within the word.
+/// @note The result is undefined for 0.
+inline unsigned int ctz64( uint64_t x )
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64( &index, x );
+    return static_cast<unsigned int>( index );
+#elif defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned int>( __builtin_ctzll( x ) );
+#else
+    unsigned int index = 0u;
+    while ( ( x & 1u ) == 0u )
+    {
+        x >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+}
+
+/// @brief Fixed size set of bits stored in 64 bit words.
+/// @note Bulk operations (count, find, ranges, comparisons) work on a whole word at a time.
 template<size_t total>
 struct bitset
 {
+    using word_type = uint64_t;
+
+    /// @brief Value returned from the find functions when no bit matches.
+    static constexpr size_t npos = total;
+
     bitset() = default;
     ~bitset() = default;
     bitset( const bitset<total>& other )
@@ -14,40 +66,51 @@ struct bitset
 
     inline bool is_set( size_t index ) const
     {
-        auto div = index / _bits_per_section;
-        auto l_index = index % _bits_per_section;
-        return _bits[div] >> l_index & 1;
+        return ( _bits[index / _bits_per_section] >> ( index % _bits_per_section ) ) & 1u;
     }
 
     inline auto& set( size_t index )
     {
-        auto div = index / _bits_per_section;
-        auto l_index = index % _bits_per_section;
-        _bits[div] |= 1 << l_index;
+        _bits[index / _bits_per_section] |= mask( index );
         return *this;
     }
 
     inline auto& unset( size_t index )
     {
-        auto div = index / _bits_per_section;
-        auto l_index = index % _bits_per_section;
-        _bits[div] &= ~( 1UL << l_index );
+        _bits[index / _bits_per_section] &= ~mask( index );
         return *this;
     }
 
     inline auto& toggle( size_t index )
     {
-        auto div = index / _bits_per_section;
-        auto l_index = index % _bits_per_section;
-        _bits[div] ^= 1 << l_index;
+        _bits[index / _bits_per_section] ^= mask( index );
         return *this;
     }
 
     inline auto& set( size_t index, int x )
     {
-        auto div = index / _bits_per_section;
-        auto l_index = index % _bits_per_section;
-        _bits[div] ^= ( -x ^ _bits[div] ) & ( 1UL << l_index );
+        auto& word = _bits[index / _bits_per_section];
+        word ^= ( static_cast<word_type>( -static_cast<int64_t>( x != 0 ) ) ^ word ) & mask( index );
+        return *this;
+    }
+
+    /// @brief Set all bits within [first, last).
+    auto& set_range( size_t first, size_t last )
+    {
+        apply_range( first, last, []( word_type & word, word_type m )
+        {
+            word |= m;
+        } );
+        return *this;
+    }
+
+    /// @brief Clear all bits within [first, last).
+    auto& unset_range( size_t first, size_t last )
+    {
+        apply_range( first, last, []( word_type & word, word_type m )
+        {
+            word &= ~m;
+        } );
         return *this;
     }
 
@@ -63,7 +126,8 @@ struct bitset
 
     inline void set()
     {
-        memset( _bits, 1, sizeof( _bits ) );
+        memset( _bits, 0xff, sizeof( _bits ) );
+        trim();
     }
 
     inline auto size() const
@@ -80,6 +144,69 @@ struct bitset
         return is_set( index );
     }
 
+    /// @brief Return the index of the first set bit at or after start, npos if there is none.
+    size_t find_first_set( size_t start = 0 ) const
+    {
+        if ( start >= _total )
+        {
+            return npos;
+        }
+        auto div = start / _bits_per_section;
+        auto word = _bits[div] & ( ~word_type{ 0 } << ( start % _bits_per_section ) );
+        while ( true )
+        {
+            if ( word )
+            {
+                auto index = div * _bits_per_section + detail::ctz64( word );
+                return index < _total ? index : npos;
+            }
+            if ( ++div >= _divisions )
+            {
+                return npos;
+            }
+            word = _bits[div];
+        }
+    }
+
+    /// @brief Return the index of the first clear bit at or after start, npos if there is none.
+    size_t find_first_unset( size_t start = 0 ) const
+    {
+        if ( start >= _total )
+        {
+            return npos;
+        }
+        auto div = start / _bits_per_section;
+        auto word = ~_bits[div] & ( ~word_type{ 0 } << ( start % _bits_per_section ) );
+        while ( true )
+        {
+            if ( word )
+            {
+                auto index = div * _bits_per_section + detail::ctz64( word );
+                return index < _total ? index : npos;
+            }
+            if ( ++div >= _divisions )
+            {
+                return npos;
+            }
+            word = ~_bits[div];
+        }
+    }
+
+    /// @brief Invoke func( size_t index ) for every set bit in ascending order.
+    template<typename Func>
+    void for_each_set( Func&& func ) const
+    {
+        for ( size_t i = 0; i < _divisions; i++ )
+        {
+            auto word = _bits[i];
+            while ( word )
+            {
+                func( i * _bits_per_section + detail::ctz64( word ) );
+                word &= word - 1;
+            }
+        }
+    }
+
     auto& operator=( const fnx::bitset<total>& other )
     {
         memcpy( _bits, other._bits, sizeof( _bits ) );
@@ -91,68 +218,149 @@ struct bitset
         return std::memcmp( _bits, other._bits, sizeof( _bits ) ) == 0;
     }
 
+    auto operator!=( const fnx::bitset<total>& other ) const
+    {
+        return !( *this == other );
+    }
+
     auto operator|( const fnx::bitset<total>& other ) const
     {
         fnx::bitset<total> ret = *this;
+        ret |= other;
+        return ret;
+    }
 
+    auto operator&( const fnx::bitset<total>& other ) const
+    {
+        fnx::bitset<total> ret = *this;
+        ret &= other;
+        return ret;
+    }
+
+    auto& operator|=( const fnx::bitset<total>& other )
+    {
         for ( size_t i = 0; i < _divisions; i++ )
         {
-            ret._bits[i] |= other._bits[i];
+            _bits[i] |= other._bits[i];
         }
+        return *this;
+    }
 
-        return ret;
+    auto& operator&=( const fnx::bitset<total>& other )
+    {
+        for ( size_t i = 0; i < _divisions; i++ )
+        {
+            _bits[i] &= other._bits[i];
+        }
+        return *this;
     }
 
     auto count() const
     {
-        // Brian Kernighan Algorithm
         unsigned int count{ 0 };
         for ( size_t i = 0; i < _divisions; i++ )
         {
-            auto n = _bits[i];
-            while ( n )
+            count += detail::popcount64( _bits[i] );
+        }
+        return count;
+    }
+
+    /// @brief Return whether any bit is set.
+    bool any() const
+    {
+        for ( size_t i = 0; i < _divisions; i++ )
+        {
+            if ( _bits[i] )
             {
-                n &= ( n - 1 );
-                count++;
+                return true;
             }
         }
-        return count;
+        return false;
+    }
+
+    /// @brief Return whether no bits are set.
+    bool none() const
+    {
+        return !any();
+    }
+
+    /// @brief Return whether every bit is set.
+    bool all() const
+    {
+        return count() == _total;
+    }
+
+    /// @brief Return the number of storage words.
+    static constexpr size_t num_words()
+    {
+        return _divisions;
+    }
+
+    /// @brief Return a storage word, bit n of word i is bit ( i * 64 + n ) of the set.
+    word_type word( size_t index ) const
+    {
+        return _bits[index];
     }
 
 private:
 
     static const size_t _total = total;
-    static const size_t _divisions = total / ( sizeof( uint32_t ) * 8 ) + 1;
-    static const size_t _bits_per_section = sizeof( uint32_t ) * 8;
+    static const size_t _bits_per_section = sizeof( word_type ) * 8;
+    static const size_t _divisions = total / _bits_per_section + 1; // add 1 to account for truncation on int division
+
+    word_type _bits[_divisions] { 0 };
+
+    static inline word_type mask( size_t index )
+    {
+        return word_type{ 1 } << ( index % _bits_per_section );
+    }
 
-    uint32_t _bits[total / ( sizeof( uint32_t ) * 8 ) + 1] { 0 }; // add 1 to account for truncation on int division
+    /// @brief Clear the unused bits past the end of the set so that whole word operations stay exact.
+    inline void trim()
+    {
+        _bits[_divisions - 1] &= ( word_type{ 1 } << ( _total % _bits_per_section ) ) - 1u;
+    }
+
+    template<typename Op>
+    void apply_range( size_t first, size_t last, Op op )
+    {
+        last = last < _total ? last : _total;
+        if ( first >= last )
+        {
+            return;
+        }
+        auto first_div = first / _bits_per_section;
+        auto last_div = ( last - 1 ) / _bits_per_section;
+        auto first_mask = ~word_type{ 0 } << ( first % _bits_per_section );
+        auto last_mask = ~word_type{ 0 } >> ( _bits_per_section - 1 - ( ( last - 1 ) % _bits_per_section ) );
+        if ( first_div == last_div )
+        {
+            op( _bits[first_div], first_mask & last_mask );
+            return;
+        }
+        op( _bits[first_div], first_mask );
+        for ( auto i = first_div + 1; i < last_div; i++ )
+        {
+            op( _bits[i], ~word_type{ 0 } );
+        }
+        op( _bits[last_div], last_mask );
+    }
 };
 
-template<unsigned int A, unsigned int B>
+template<size_t A, size_t B>
 bool includes( const fnx::bitset<A>& set, const fnx::bitset<B>& subset )
 {
-    bool ret = true;
-    if ( subset.size() <= set.size() && subset.count() <= set.count() )
+    if ( subset.size() > set.size() )
     {
-        auto matches = 0u;
-        auto total = subset.count();
-        for ( auto i = 0u; ( i < subset.size() ) && ret && ( matches != total ); ++i )
-        {
-            if ( subset[i] && !set[i] )
-            {
-                // early out
-                ret = false;
-            }
-            else if ( subset[i] && set[i] )
-            {
-                ++matches;
-            }
-        }
+        return false;
     }
-    else
+    for ( size_t i = 0; i < subset.num_words(); ++i )
     {
-        ret = false;
+        if ( subset.word( i ) & ~set.word( i ) )
+        {
+            return false;
+        }
     }
-    return ret;
+    return true;
+}
 }
-}
\ No newline at end of file
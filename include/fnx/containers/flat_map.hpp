@@ -0,0 +1,749 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace fnx
+{
+/// @brief Default hash used by flat_map.
+/// @note Strings are hashed as std::string_view so std::string, std::string_view and const char* can all be
+///     used to look up a std::string key without constructing a temporary.
+template<typename Key>
+struct flat_hash : std::hash<Key>
+{
+};
+
+template<>
+struct flat_hash<std::string>
+{
+    using is_transparent = void;
+
+    size_t operator()( std::string_view str ) const noexcept
+    {
+        return std::hash<std::string_view> {}( str );
+    }
+};
+
+template<typename Key, typename Value, typename Hash = fnx::flat_hash<Key>, typename KeyEqual = std::equal_to<>>
+/// @brief Open addressing hash map using Robin Hood probing and backward shift deletion.
+/// @note Elements are stored in a single contiguous array so lookups touch one or two cache lines and inserts
+///     only allocate when the table grows.
+/// @note References and iterators are invalidated by any insert that grows the table and by erase.
+/// @note Keys may be looked up with any type the Hash and KeyEqual accept when Hash defines is_transparent.
+class flat_map
+{
+    using dist_type = uint8_t;
+    static constexpr dist_type max_dist = 255u;	/// probe length limit before the table is forced to grow
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;	/// the key must not be modified through an iterator
+    using size_type = size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+    template<bool is_const>
+    class iter
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = flat_map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<is_const, const value_type*, value_type*>;
+        using reference = std::conditional_t<is_const, const value_type&, value_type&>;
+
+        iter() = default;
+        iter( value_type* slots, const dist_type* dist, size_t index )
+            : _slots{ slots }
+            , _dist{ dist }
+            , _index{ index }
+        {}
+
+        /// @brief Allow iterator to const_iterator conversions.
+        operator iter<true>() const
+        {
+            return { _slots, _dist, _index };
+        }
+
+        reference operator*() const
+        {
+            return _slots[_index];
+        }
+
+        pointer operator->() const
+        {
+            return &_slots[_index];
+        }
+
+        iter& operator++()
+        {
+            // the table ends with a non empty sentinel so this never runs off the end
+            while ( 0u == _dist[++_index] )
+            {
+            }
+            return *this;
+        }
+
+        iter operator++( int )
+        {
+            auto ret = *this;
+            ++( *this );
+            return ret;
+        }
+
+        bool operator==( const iter& other ) const
+        {
+            return _index == other._index && _dist == other._dist;
+        }
+
+        bool operator!=( const iter& other ) const
+        {
+            return !( *this == other );
+        }
+
+    private:
+        friend class flat_map;
+        value_type* _slots{ nullptr };
+        const dist_type* _dist{ nullptr };
+        size_t _index{ 0u };
+    };
+
+    using iterator = iter<false>;
+    using const_iterator = iter<true>;
+
+    flat_map() = default;
+
+    explicit flat_map( size_t count )
+    {
+        reserve( count );
+    }
+
+    flat_map( std::initializer_list<value_type> init )
+    {
+        reserve( init.size() );
+        for ( const auto& v : init )
+        {
+            insert( v );
+        }
+    }
+
+    flat_map( const flat_map& other )
+        : _hash{ other._hash }
+        , _equal{ other._equal }
+    {
+        reserve( other._size );
+        for ( const auto& v : other )
+        {
+            insert_unique( value_type( v ) );
+        }
+    }
+
+    flat_map( flat_map&& other ) noexcept
+    {
+        swap( other );
+    }
+
+    ~flat_map()
+    {
+        release();
+    }
+
+    flat_map& operator=( const flat_map& other )
+    {
+        if ( this != &other )
+        {
+            flat_map tmp( other );
+            swap( tmp );
+        }
+        return *this;
+    }
+
+    flat_map& operator=( flat_map&& other ) noexcept
+    {
+        if ( this != &other )
+        {
+            release();
+            swap( other );
+        }
+        return *this;
+    }
+
+    void swap( flat_map& other ) noexcept
+    {
+        std::swap( _slots, other._slots );
+        std::swap( _dist, other._dist );
+        std::swap( _capacity, other._capacity );
+        std::swap( _size, other._size );
+        std::swap( _max_size, other._max_size );
+        std::swap( _shift, other._shift );
+        std::swap( _hash, other._hash );
+        std::swap( _equal, other._equal );
+    }
+
+    iterator begin()
+    {
+        return make_begin<iterator>();
+    }
+
+    const_iterator begin() const
+    {
+        return make_begin<const_iterator>();
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    iterator end()
+    {
+        return { _slots, _dist, _capacity };
+    }
+
+    const_iterator end() const
+    {
+        return { _slots, _dist, _capacity };
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    bool empty() const
+    {
+        return 0u == _size;
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+    /// @brief Return the number of slots, including empty ones.
+    size_t capacity() const
+    {
+        return _capacity;
+    }
+
+    float load_factor() const
+    {
+        return _capacity ? static_cast<float>( _size ) / static_cast<float>( _capacity ) : 0.f;
+    }
+
+    /// @brief Destroy all elements but keep the allocated slots.
+    void clear()
+    {
+        for ( size_t i = 0; i < _capacity; ++i )
+        {
+            if ( _dist[i] )
+            {
+                _slots[i].~value_type();
+                _dist[i] = 0u;
+            }
+        }
+        _size = 0u;
+    }
+
+    /// @brief Make room for count elements without growing.
+    void reserve( size_t count )
+    {
+        size_t capacity = min_capacity;
+        while ( capacity - capacity / 8u < count )
+        {
+            capacity *= 2u;
+        }
+        if ( capacity > _capacity )
+        {
+            rehash( capacity );
+        }
+    }
+
+    std::pair<iterator, bool> insert( const value_type& value )
+    {
+        return try_emplace( value.first, value.second );
+    }
+
+    std::pair<iterator, bool> insert( value_type&& value )
+    {
+        return emplace( std::move( value ) );
+    }
+
+    template<typename... TArgs>
+    /// @brief Construct an element in place if the key does not exist.
+    /// @note The element is constructed before the lookup, prefer try_emplace when the key is known.
+    std::pair<iterator, bool> emplace( TArgs&& ... args )
+    {
+        value_type value( std::forward<TArgs>( args )... );
+        auto [index, inserted] = find_or_insert( value.first, [&value]()
+        {
+            return std::move( value );
+        } );
+        return { make_iterator( index ), inserted };
+    }
+
+    template<typename... TArgs>
+    /// @brief Construct the value in place only when the key does not exist.
+    std::pair<iterator, bool> try_emplace( const Key& key, TArgs&& ... args )
+    {
+        auto [index, inserted] = find_or_insert( key, [&]()
+        {
+            return value_type( std::piecewise_construct, std::forward_as_tuple( key ),
+                               std::forward_as_tuple( std::forward<TArgs>( args )... ) );
+        } );
+        return { make_iterator( index ), inserted };
+    }
+
+    template<typename... TArgs>
+    /// @brief Construct the value in place only when the key does not exist.
+    std::pair<iterator, bool> try_emplace( Key&& key, TArgs&& ... args )
+    {
+        auto [index, inserted] = find_or_insert( key, [&]()
+        {
+            return value_type( std::piecewise_construct, std::forward_as_tuple( std::move( key ) ),
+                               std::forward_as_tuple( std::forward<TArgs>( args )... ) );
+        } );
+        return { make_iterator( index ), inserted };
+    }
+
+    Value& operator[]( const Key& key )
+    {
+        return try_emplace( key ).first->second;
+    }
+
+    Value& operator[]( Key&& key )
+    {
+        return try_emplace( std::move( key ) ).first->second;
+    }
+
+    template < typename K, typename H = Hash, typename = typename H::is_transparent,
+               typename = std::enable_if_t < !std::is_same<std::decay_t<K>, Key>::value >>
+    /// @brief Return the value for a key, constructing the key from K only when it is inserted.
+    Value & operator[]( const K& key )
+    {
+        auto [index, inserted] = find_or_insert( key, [&key]()
+        {
+            return value_type( Key( key ), Value() );
+        } );
+        return _slots[index].second;
+    }
+
+    Value& at( const Key& key )
+    {
+        return at_impl( *this, key );
+    }
+
+    const Value& at( const Key& key ) const
+    {
+        return at_impl( *this, key );
+    }
+
+    iterator find( const Key& key )
+    {
+        return make_iterator( find_index( key ) );
+    }
+
+    const_iterator find( const Key& key ) const
+    {
+        return make_iterator( find_index( key ) );
+    }
+
+    template<typename K, typename H = Hash, typename = typename H::is_transparent>
+    iterator find( const K& key )
+    {
+        return make_iterator( find_index( key ) );
+    }
+
+    template<typename K, typename H = Hash, typename = typename H::is_transparent>
+    const_iterator find( const K& key ) const
+    {
+        return make_iterator( find_index( key ) );
+    }
+
+    size_t count( const Key& key ) const
+    {
+        return find_index( key ) != _capacity ? 1u : 0u;
+    }
+
+    template<typename K, typename H = Hash, typename = typename H::is_transparent>
+    size_t count( const K& key ) const
+    {
+        return find_index( key ) != _capacity ? 1u : 0u;
+    }
+
+    bool contains( const Key& key ) const
+    {
+        return find_index( key ) != _capacity;
+    }
+
+    template<typename K, typename H = Hash, typename = typename H::is_transparent>
+    bool contains( const K& key ) const
+    {
+        return find_index( key ) != _capacity;
+    }
+
+    /// @brief Remove a key.
+    /// @return number of elements removed
+    size_t erase( const Key& key )
+    {
+        auto index = find_index( key );
+        if ( index == _capacity )
+        {
+            return 0u;
+        }
+        erase_index( index );
+        return 1u;
+    }
+
+    template<typename K, typename H = Hash, typename = typename H::is_transparent>
+    size_t erase( const K& key )
+    {
+        auto index = find_index( key );
+        if ( index == _capacity )
+        {
+            return 0u;
+        }
+        erase_index( index );
+        return 1u;
+    }
+
+    /// @brief Remove the element at the iterator.
+    /// @return iterator to the next element
+    /// @note An element that wrapped around the end of the table can be shifted into the erased slot
+    ///     and visited a second time when erasing while iterating.
+    iterator erase( const_iterator it )
+    {
+        auto index = it._index;
+        erase_index( index );
+        if ( 0u == _dist[index] )
+        {
+            // nothing shifted back into the slot
+            return ++make_iterator( index );
+        }
+        return make_iterator( index );
+    }
+
+private:
+    static constexpr size_t min_capacity = 8u;
+
+    value_type* _slots{ nullptr };
+    dist_type* _dist{ empty_dist() };	/// probe distance + 1 for each slot, 0 is empty. _dist[_capacity] is a sentinel
+    size_t _capacity{ 0u };
+    size_t _size{ 0u };
+    size_t _max_size{ 0u };				/// grow before exceeding a load factor of 7/8
+    unsigned int _shift{ 64u };
+    Hash _hash;
+    KeyEqual _equal;
+
+    /// @brief Sentinel used by tables that have never allocated so that begin() == end().
+    static dist_type* empty_dist()
+    {
+        static dist_type sentinel[1] = { 1u };
+        return sentinel;
+    }
+
+    /// @brief Map a hash to a slot with fibonacci hashing to spread out poorly distributed hashes.
+    size_t bucket( size_t hash ) const
+    {
+        return static_cast<size_t>( ( static_cast<uint64_t>( hash ) * 11400714819323198485ull ) >> _shift );
+    }
+
+    size_t next( size_t index ) const
+    {
+        return ( index + 1u ) & ( _capacity - 1u );
+    }
+
+    template<typename I>
+    I make_begin() const
+    {
+        I it{ _slots, _dist, 0u };
+        if ( 0u == _dist[0] )
+        {
+            ++it;
+        }
+        return it;
+    }
+
+    iterator make_iterator( size_t index )
+    {
+        return { _slots, _dist, index };
+    }
+
+    const_iterator make_iterator( size_t index ) const
+    {
+        return { _slots, _dist, index };
+    }
+
+    template<typename Self>
+    static auto& at_impl( Self& self, const Key& key )
+    {
+        auto index = self.find_index( key );
+        if ( index == self._capacity )
+        {
+            throw std::out_of_range( "flat_map key not found" );
+        }
+        return self._slots[index].second;
+    }
+
+    template<typename K>
+    /// @brief Convert c strings to std::string_view once so the length isn't recomputed for every comparison.
+    static decltype( auto ) lookup_key( const K& key )
+    {
+        if constexpr( std::is_same<Key, std::string>::value && !std::is_same<K, std::string>::value &&
+                      std::is_convertible<const K&, std::string_view>::value )
+        {
+            return std::string_view( key );
+        }
+        else
+        {
+            return ( key );
+        }
+    }
+
+    template<typename K>
+    size_t find_index( const K& k ) const
+    {
+        if ( 0u == _size )
+        {
+            return _capacity;
+        }
+        const auto& key = lookup_key( k );
+        auto index = bucket( _hash( key ) );
+        for ( dist_type dist = 1u; dist <= _dist[index]; ++dist )
+        {
+            if ( dist == _dist[index] && _equal( _slots[index].first, key ) )
+            {
+                return index;
+            }
+            index = next( index );
+        }
+        return _capacity;
+    }
+
+    template<typename K, typename MakeValue>
+    /// @brief Return the slot of a key, inserting the value created by make if it is missing.
+    /// @note make is only called once the value is known to stay at the returned slot, so the key can be moved into it.
+    std::pair<size_t, bool> find_or_insert( const K& k, MakeValue&& make )
+    {
+        const auto& key = lookup_key( k );
+        if ( _size >= _max_size )
+        {
+            grow();
+        }
+
+        const auto hash = _hash( key );
+        while ( true )
+        {
+            auto index = bucket( hash );
+            dist_type dist = 1u;
+            // robin hood invariant: the key can't be past a slot that is closer to its own bucket
+            while ( dist <= _dist[index] )
+            {
+                if ( dist == _dist[index] && _equal( _slots[index].first, key ) )
+                {
+                    return { index, false };
+                }
+                index = next( index );
+                ++dist;
+            }
+
+            if ( dist == max_dist )
+            {
+                check_probe( hash, index );
+            }
+            else if ( fits( index ) )
+            {
+                place( index, dist, make() );
+                return { index, true };
+            }
+            grow();
+        }
+    }
+
+    /// @brief Return whether a value can be put at a slot without pushing an element max_dist from its bucket.
+    bool fits( size_t index ) const
+    {
+        if ( 0u == _dist[index] )
+        {
+            return true;
+        }
+        auto carry_dist = _dist[index];
+        while ( true )
+        {
+            index = next( index );
+            if ( ++carry_dist == max_dist )
+            {
+                return false;
+            }
+            if ( 0u == _dist[index] )
+            {
+                return true;
+            }
+            // place() carries the element that is closer to its bucket
+            carry_dist = std::min( carry_dist, _dist[index] );
+        }
+    }
+
+    /// @brief Throw if a probe is too long because its max_dist - 1 slots hold keys of the same hash.
+    /// @param[in] index : slot the key would be put at, max_dist from its bucket
+    /// @note Growing separates different hashes, it can never shorten the probe of equal ones.
+    void check_probe( size_t hash, size_t index ) const
+    {
+        for ( dist_type dist = 1u; dist < max_dist; ++dist )
+        {
+            index = ( index - 1u ) & ( _capacity - 1u );
+            if ( _hash( _slots[index].first ) != hash )
+            {
+                return;
+            }
+        }
+        throw std::length_error( "flat_map has too many keys with the same hash" );
+    }
+
+    /// @brief Put a value at a slot and shift richer elements forward.
+    /// @note fits() must be true for the slot.
+    void place( size_t index, dist_type dist, value_type&& value )
+    {
+        ++_size;
+        if ( 0u == _dist[index] )
+        {
+            new( &_slots[index] ) value_type( std::move( value ) );
+            _dist[index] = dist;
+            return;
+        }
+
+        value_type carry( std::move( _slots[index] ) );
+        auto carry_dist = _dist[index];
+        _slots[index].~value_type();
+        new( &_slots[index] ) value_type( std::move( value ) );
+        _dist[index] = dist;
+
+        while ( true )
+        {
+            index = next( index );
+            ++carry_dist;
+            assert( carry_dist < max_dist );
+            if ( 0u == _dist[index] )
+            {
+                new( &_slots[index] ) value_type( std::move( carry ) );
+                _dist[index] = carry_dist;
+                return;
+            }
+            if ( _dist[index] < carry_dist )
+            {
+                std::swap( carry, _slots[index] );
+                std::swap( carry_dist, _dist[index] );
+            }
+        }
+    }
+
+    /// @brief Insert a value whose key is known to be missing.
+    void insert_unique( value_type&& value )
+    {
+        while ( true )
+        {
+            if ( _size >= _max_size )
+            {
+                grow();
+            }
+            auto index = bucket( _hash( value.first ) );
+            dist_type dist = 1u;
+            while ( dist <= _dist[index] )
+            {
+                index = next( index );
+                ++dist;
+            }
+            if ( dist < max_dist && fits( index ) )
+            {
+                place( index, dist, std::move( value ) );
+                return;
+            }
+            grow();
+        }
+    }
+
+    /// @brief Destroy the element at a slot and shift the following displaced elements back.
+    void erase_index( size_t index )
+    {
+        _slots[index].~value_type();
+        _dist[index] = 0u;
+        --_size;
+
+        auto following = next( index );
+        while ( _dist[following] > 1u )
+        {
+            new( &_slots[index] ) value_type( std::move( _slots[following] ) );
+            _slots[following].~value_type();
+            _dist[index] = _dist[following] - 1u;
+            _dist[following] = 0u;
+            index = following;
+            following = next( index );
+        }
+    }
+
+    void grow()
+    {
+        rehash( _capacity ? _capacity * 2u : min_capacity );
+    }
+
+    void rehash( size_t capacity )
+    {
+        auto old_slots = _slots;
+        auto old_dist = _dist;
+        auto old_capacity = _capacity;
+
+        _slots = std::allocator<value_type>().allocate( capacity );
+        _dist = new dist_type[capacity + 1u];
+        std::memset( _dist, 0, capacity );
+        _dist[capacity] = 1u;	// sentinel to stop iteration
+        _capacity = capacity;
+        _max_size = capacity - capacity / 8u;
+        _size = 0u;
+        _shift = 64u;
+        for ( auto c = capacity; c > 1u; c >>= 1 )
+        {
+            --_shift;
+        }
+
+        for ( size_t i = 0; i < old_capacity; ++i )
+        {
+            if ( old_dist[i] )
+            {
+                insert_unique( std::move( old_slots[i] ) );
+                old_slots[i].~value_type();
+            }
+        }
+
+        if ( old_capacity )
+        {
+            std::allocator<value_type>().deallocate( old_slots, old_capacity );
+            delete[] old_dist;
+        }
+    }
+
+    void release()
+    {
+        if ( _capacity )
+        {
+            clear();
+            std::allocator<value_type>().deallocate( _slots, _capacity );
+            delete[] _dist;
+        }
+        _slots = nullptr;
+        _dist = empty_dist();
+        _capacity = 0u;
+        _size = 0u;
+        _max_size = 0u;
+        _shift = 64u;
+    }
+};
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace fnx
+{
+template<typename Type>
+/// @brief Non owning view of contiguous objects, a subset of C++20 std::span.
+/// @note Views of const objects are made from mutable containers and views implicitly.
+struct span
+{
+public:
+    using element_type = Type;
+    using value_type = typename std::remove_cv<Type>::type;
+    using iterator = Type*;
+
+    span() = default;
+
+    span( Type* data, size_t size )
+        : _data( data )
+        , _size( size )
+    {
+    }
+
+    template<typename Other, typename std::enable_if<std::is_convertible<Other( * )[], Type( * )[]>::value, int>::type = 0>
+    span( const span<Other>& other )
+        : _data( other.data() )
+        , _size( other.size() )
+    {
+    }
+
+    template<typename Alloc>
+    span( std::vector<value_type, Alloc>& vec )
+        : _data( vec.data() )
+        , _size( vec.size() )
+    {
+    }
+
+    template<typename Alloc, typename Self = Type, typename std::enable_if<std::is_const<Self>::value, int>::type = 0>
+    span( const std::vector<value_type, Alloc>& vec )
+        : _data( vec.data() )
+        , _size( vec.size() )
+    {
+    }
+
+    template<size_t Size>
+    span( std::array<value_type, Size>& arr )
+        : _data( arr.data() )
+        , _size( Size )
+    {
+    }
+
+    template<size_t Size, typename Self = Type, typename std::enable_if<std::is_const<Self>::value, int>::type = 0>
+    span( const std::array<value_type, Size>& arr )
+        : _data( arr.data() )
+        , _size( Size )
+    {
+    }
+
+    template<size_t Size>
+    span( Type( &arr )[Size] )
+        : _data( arr )
+        , _size( Size )
+    {
+    }
+
+    Type* data() const
+    {
+        return _data;
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+    bool empty() const
+    {
+        return _size == 0u;
+    }
+
+    Type& operator[]( size_t index ) const
+    {
+        return _data[index];
+    }
+
+    iterator begin() const
+    {
+        return _data;
+    }
+
+    iterator end() const
+    {
+        return _data + _size;
+    }
+
+    /// @brief Return a view of count objects starting at offset.
+    span subspan( size_t offset, size_t count ) const
+    {
+        return { _data + offset, count };
+    }
+
+private:
+    Type* _data{ nullptr };
+    size_t _size{ 0u };
+};
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace fnx
+{
+/// @brief Content of a versioned binary cache written next to an asset, such as a mesh_cache or material_cache.
+/// @note The content is read from disk or an archive, or kept in memory when the cache has just been written. Derived
+///     caches parse it in read() and hand out views of it, which stay valid while the cache is held, moves included.
+class cache_file
+{
+public:
+    virtual ~cache_file() = default;
+
+    bool is_open() const
+    {
+        return _open;
+    }
+
+protected:
+    cache_file() = default;
+    cache_file( cache_file&& other ) = default;
+    cache_file& operator=( cache_file&& other ) = default;
+
+    /// @brief Read a cache file, it is closed if read() rejects its content.
+    void open( const std::string& file_path, uint64_t content_hash );
+
+    /// @brief Read a cache from memory.
+    void open( std::vector<char>&& bytes, uint64_t content_hash );
+
+    /// @brief Parse the content of the cache.
+    /// @param[in] content_hash : hash_bytes of the source asset
+    /// @return false if the cache was written for other content, by another version, or if it is damaged
+    virtual bool read( const char* data, size_t size, uint64_t content_hash ) = 0;
+
+private:
+    fnx::file_data _file;
+    std::vector<char> _bytes;	/// content when the cache was not read from a file
+    bool _open{ false };
+
+    cache_file( const cache_file& other ) = delete;
+    cache_file& operator=( const cache_file& other ) = delete;
+};
+
+/// @brief Write the content of a cache, a warning is logged when the file cannot be written.
+/// @return false if the cache was not written
+extern bool write_cache_file( const std::string& cache_path, const std::vector<char>& bytes );
+
+template<typename T, typename F>
+/// @brief Open the cache of an asset, or build and write it when it is missing or out of date.
+/// @param[in] build : returns the content of the cache, called only when the cache file cannot be used
+/// @note A cache that cannot be written is still served from memory, e.g. when the asset directory is read only.
+T load_cache_file( const std::string& cache_path, uint64_t content_hash, F&& build )
+{
+    T cache( cache_path, content_hash );
+    if ( cache.is_open() )
+    {
+        return cache;
+    }
+    auto bytes = build();
+    fnx::write_cache_file( cache_path, bytes );
+    return T( std::move( bytes ), content_hash );
+}
+}
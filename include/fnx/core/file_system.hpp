@@ -0,0 +1,184 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fnx
+{
+/// @brief Read only content of a file opened with read_file(), from an archive or from disk.
+/// @note Files stored uncompressed in an archive are views of the archive mapping, which stays mapped while the
+///     content is held. Compressed ones are decompressed to the heap.
+class file_data
+{
+public:
+    file_data() = default;
+    explicit file_data( fnx::mapped_file&& file );
+    explicit file_data( std::vector<char>&& buffer );
+    file_data( const char* data, size_t size, std::shared_ptr<const void> owner );
+
+    file_data( file_data&& other ) noexcept;
+    file_data& operator=( file_data&& other ) noexcept;
+
+    /// @brief Return false if the file could not be found or read.
+    bool is_open() const
+    {
+        return _open;
+    }
+
+    const char* data() const
+    {
+        return _data;
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+    std::string_view view() const
+    {
+        return std::string_view( _data, _size );
+    }
+
+    /// @brief Release the content, views of it are no longer valid.
+    void close();
+
+private:
+    fnx::mapped_file _file;
+    std::vector<char> _buffer;
+    std::shared_ptr<const void> _owner;	/// keeps the archive mapped
+    const char* _data{ nullptr };
+    size_t _size{ 0u };
+    bool _open{ false };
+
+    file_data( const file_data& other ) = delete;
+    file_data& operator=( const file_data& other ) = delete;
+};
+
+/// @brief Compression of a file stored in an archive.
+enum class archive_compression : uint8_t
+{
+    none,
+    lz4
+};
+
+/// @brief File given to archive::serialize().
+struct archive_input
+{
+    std::string name;	/// path the file is read with, relative to the directory the game runs from
+    const char* data{ nullptr };
+    size_t size{ 0u };
+    bool compress{ true };	/// stored compressed when it saves space, files that are already compressed should not be
+};
+
+/// @brief Many files packed in one, opened once and memory mapped so that reading a file is a lookup.
+/// @note The file holds a header, the directory sorted by the hash of each name then the names, then the content of
+///     each file. Content stored as is starts on a 4 KB page so that its view is page aligned, compressed content is
+///     aligned to 16 bytes. The directory is searched in place in the mapping.
+class archive : public std::enable_shared_from_this<archive>
+{
+public:
+    static constexpr uint32_t format_version = 1u;
+    static constexpr size_t page_alignment = 4096u;
+
+    /// @brief Directory record of a file.
+    struct entry
+    {
+        uint64_t hash;	/// hash_bytes of the name
+        uint64_t offset;
+        uint64_t size;	/// size of the file
+        uint64_t stored_size;	/// size of the content in the archive
+        uint32_t name_offset;	/// from the start of the names
+        uint16_t name_length;
+        fnx::archive_compression compression;
+        uint8_t reserved;
+    };
+
+    archive() = default;
+
+    /// @brief Map an archive file.
+    explicit archive( const std::string& file_path );
+
+    /// @brief Return false if the archive is missing, of another version or damaged.
+    bool is_open() const
+    {
+        return _open;
+    }
+
+    size_t get_num_entries() const
+    {
+        return _num_entries;
+    }
+
+    /// @brief Return the record of a file.
+    /// @return nullptr if the archive does not hold it
+    const entry* find( std::string_view name ) const;
+
+    /// @brief Return the name of a record.
+    std::string_view get_name( const entry& record ) const;
+
+    /// @brief Return the content of a record, decompressed if it was compressed.
+    fnx::file_data read( const entry& record ) const;
+
+    /// @brief Return the content of an archive holding files.
+    /// @param[in] inputs : files with unique names
+    static std::vector<char> serialize( const std::vector<fnx::archive_input>& inputs );
+
+private:
+    fnx::mapped_file _file;
+    const entry* _entries{ nullptr };
+    const char* _names{ nullptr };
+    size_t _num_entries{ 0u };
+    bool _open{ false };
+
+    archive( const archive& other ) = delete;
+    archive& operator=( const archive& other ) = delete;
+};
+
+/// @brief Archives that files are read from before they are looked for on disk.
+/// @usage auto [files, _] = singleton<file_system>::acquire(); files.mount( "assets.fnxpak" );
+class file_system
+{
+public:
+    /// @brief Read files from an archive, files of archives mounted later hide those of earlier ones.
+    /// @return false if the archive could not be opened
+    bool mount( const std::string& archive_path );
+
+    void unmount_all();
+
+    size_t get_num_archives() const
+    {
+        return _archives.size();
+    }
+
+    /// @brief Return the mounted archive that holds a file.
+    /// @return nullptr if the file is only on disk
+    std::shared_ptr<const fnx::archive> find( std::string_view name ) const;
+
+private:
+    std::vector<std::shared_ptr<fnx::archive>> _archives;
+};
+
+/// @brief Return a path the way archives name files, with forward slashes and no leading "./".
+extern std::string normalize_path( std::string_view file_path );
+
+/// @brief Read a file from the mounted archives, or from disk when no archive holds it.
+/// @note Every asset loader reads through this, it can be called from any thread.
+/// @return content that is not open if the file cannot be found
+extern fnx::file_data read_file( const std::string& file_path );
+
+/// @brief Write a file aside and rename it over file_path, so that it is never read half written.
+/// @note The temporary file is named after the process and thread, concurrent writers of a path don't share it.
+/// @return false if the file could not be written, file_path is then left as it was or removed
+extern bool write_file_replacing( const std::string& file_path, const char* data, size_t size );
+
+/// @brief Alignment of the blobs of cache files and archives, enough for SIMD loads and direct GPU uploads.
+constexpr size_t file_blob_alignment = 16u;
+
+/// @brief Round an offset in a file up to a power of two alignment.
+constexpr size_t align_offset( size_t offset, size_t alignment = file_blob_alignment )
+{
+    return ( offset + alignment - 1u ) & ~( alignment - 1u );
+}
+}
@@ -2,8 +2,8 @@
 
 namespace fnx
 {
-/// @brief Manages unique identifiers. Valid idents are from 1 to the max_handles provided at creation.
-/// @note 0 is considered invalid. If using this class for indexing, adjust by 1
+/// @brief Manages unique identifiers. Valid idents are from 0 to max_handles - 1.
+/// @note max_handles is considered invalid. The lowest available id is always handed out first.
 template<typename T, size_t max_handles, typename = typename std::enable_if<std::is_arithmetic<T>::value, T>::type>
 class id_manager
 {
@@ -14,29 +14,24 @@ public:
 
     /// @brief Construct the handle_id_t manager with a specific maximum number of handles
     id_manager()
-        : _available()
     {
-        _available.reserve( max_handles );
         assert( max_handles > 0 );
-        for ( auto id = max_handles; id > 0; --id )
-        {
-            _available.emplace_back( static_cast<T>( id - 1 ) );
-        }
     }
 
     ~id_manager() {}
 
-    /// @brief Return a handle if one is available.
-    /// @return 0 indicates an invalid id
+    /// @brief Return the lowest handle available.
+    /// @return invalid_id when all handles are in use
     T get_handle()
     {
         auto ret = invalid_id;
-        if ( !_available.empty() )
+        auto id = _used.find_first_unset( _hint );
+        if ( id != _used.npos )
         {
-            auto id = _available.back();
-            _available.pop_back();
-            _used.set( id, 1 );
-            ret = id;
+            _used.set( id );
+            _hint = id + 1;
+            ++_num_used;
+            ret = static_cast<T>( id );
         }
 
         return ret;
@@ -46,48 +41,49 @@ public:
     /// @param[in] id: id to reuse
     void reclaim( T id )
     {
-        if ( max_handles > id &&	// must have enough handles
-                1 == _used[id] )		// must be in use
+        if ( max_handles > static_cast<size_t>( id ) &&	// must have enough handles
+                _used[id] )		// must be in use
         {
-            _available.push_back( id );
-            _used.set( id, 0 );
+            _used.unset( id );
+            --_num_used;
+            if ( static_cast<size_t>( id ) < _hint )
+            {
+                _hint = id;
+            }
         }
     }
 
     /// @brief Reclaim all handles to be used again.
     void reclaim_all()
     {
-        _available.clear();
         _used.reset();
-        for ( auto id = max_handles; id > 0; --id )
-        {
-            _available.emplace_back( id - 1 );
-        }
-    }
-
-    /// @brief Sorts the avaiable handles. This is useful to ensure the lowest number is always
-    ///		returned to the caller.
-    void sort()
-    {
-        std::qsort( _available.begin(), _available.end(), std::greater<T>() );
+        _num_used = 0;
+        _hint = 0;
     }
 
     /// @brief Return the number of available handles.
-    size_t num_available()
+    size_t num_available() const
     {
-        return _available.size();
+        return max_handles - _num_used;
     }
 
     /// @brief Return the nubmer of used handles.
     size_t num_used() const
     {
-        return max_handles - _available.size();
+        return _num_used;
     }
 
-    /// @brief Return all available ids.
-    auto& available()
+    /// @brief Return all available ids in ascending order.
+    /// @note Builds a new list on each call, prefer num_available when only the count is needed.
+    std::vector<T> available() const
     {
-        return _available;
+        std::vector<T> ret;
+        ret.reserve( num_available() );
+        for ( auto id = _used.find_first_unset(); id != _used.npos; id = _used.find_first_unset( id + 1 ) )
+        {
+            ret.emplace_back( static_cast<T>( id ) );
+        }
+        return ret;
     }
 
     /// @brief Return whether a specific id is in use.
@@ -104,7 +100,8 @@ public:
         return _used;
     }
 private:
-    std::vector<T> _available;		/// list of all currently available ids
-    fnx::bitset<max_handles> _used;
+    fnx::bitset<max_handles> _used;	/// set bits are ids in use
+    size_t _num_used{ 0 };
+    size_t _hint{ 0 };				/// no id below this is available
 };
 }
\ No newline at end of file
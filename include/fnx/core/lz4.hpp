@@ -0,0 +1,15 @@
+#pragma once
+#include <vector>
+
+namespace fnx
+{
+/// @brief Compress a buffer to an LZ4 block.
+/// @note This is the LZ4 block format without the frame around it, so the size of the content must be stored next to
+///     the block. It favours decompression speed over ratio, a greedy match finder with a single hash table.
+extern std::vector<char> lz4_compress( const char* data, size_t size );
+
+/// @brief Decompress an LZ4 block made by lz4_compress() or any LZ4 block encoder.
+/// @param[in] dst_size : size of the content, the block must decompress to exactly that many bytes
+/// @return false if the block is damaged
+extern bool lz4_decompress( const char* src, size_t src_size, char* dst, size_t dst_size );
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <string>
+#include <string_view>
+
+namespace fnx
+{
+/// @brief Read only view of a whole file.
+/// @note The file is memory mapped so that its content is never copied to the heap, pages are loaded by the OS as
+///     they are read.
+class mapped_file
+{
+public:
+    mapped_file() = default;
+    explicit mapped_file( const std::string& file_path );
+    ~mapped_file();
+
+    mapped_file( mapped_file&& other ) noexcept;
+    mapped_file& operator=( mapped_file&& other ) noexcept;
+
+    /// @brief Return false if the file could not be opened.
+    bool is_open() const
+    {
+        return _open;
+    }
+
+    const char* data() const
+    {
+        return _data;
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+    std::string_view view() const
+    {
+        return std::string_view( _data, _size );
+    }
+
+    /// @brief Unmap the file, views of the content are no longer valid.
+    void close();
+
+private:
+    const char* _data{ nullptr };
+    size_t _size{ 0u };
+    void* _mapping{ nullptr };	/// platform handle of the mapping
+    bool _open{ false };
+
+    mapped_file( const mapped_file& other ) = delete;
+    mapped_file& operator=( const mapped_file& other ) = delete;
+};
+}
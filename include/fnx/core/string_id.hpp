@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace fnx
+{
+namespace detail
+{
+constexpr uint64_t fnv1a_offset_basis = 14695981039346656037ull;
+constexpr uint64_t fnv1a_prime = 1099511628211ull;
+
+/// @brief 64 bit FNV-1a hash, usable at compile time.
+constexpr uint64_t fnv1a_64( const char* str, size_t len )
+{
+    auto hash = fnv1a_offset_basis;
+    for ( size_t i = 0; i < len; ++i )
+    {
+        hash ^= static_cast<uint64_t>( static_cast<unsigned char>( str[i] ) );
+        hash *= fnv1a_prime;
+    }
+    return hash;
+}
+}
+
+/// @brief Hashed identifier of a string used as a cheap key for lookup tables.
+/// @note String literals are hashed at compile time. Runtime strings are hashed without allocating.
+/// @note Use fnx::intern to record the original string so it can be recovered for debugging.
+class string_id
+{
+public:
+    using value_type = uint64_t;
+
+    constexpr string_id() = default;
+
+    constexpr string_id( std::string_view str )
+        : _value{ detail::fnv1a_64( str.data(), str.size() ) }
+    {}
+
+    constexpr string_id( const char* str )
+        : _value{ str ? detail::fnv1a_64( str, std::char_traits<char>::length( str ) ) : 0u }
+    {}
+
+    string_id( const std::string& str )
+        : _value{ detail::fnv1a_64( str.data(), str.size() ) }
+    {
+#ifdef _DEBUG
+        remember( str );
+#endif
+    }
+
+    /// @brief Construct an id from a previously computed hash value.
+    static constexpr string_id from_value( value_type value )
+    {
+        string_id ret;
+        ret._value = value;
+        return ret;
+    }
+
+    /// @brief Returns the hash value.
+    constexpr value_type value() const
+    {
+        return _value;
+    }
+
+    /// @brief Returns whether the id was created from a string.
+    constexpr bool is_valid() const
+    {
+        return _value != 0u;
+    }
+
+    /// @brief Returns the interned string for this id or an empty string if it was never interned.
+    const std::string& str() const;
+
+    constexpr bool operator==( const string_id& other ) const
+    {
+        return _value == other._value;
+    }
+
+    constexpr bool operator!=( const string_id& other ) const
+    {
+        return _value != other._value;
+    }
+
+    constexpr bool operator<( const string_id& other ) const
+    {
+        return _value < other._value;
+    }
+
+private:
+    value_type _value{ 0u };
+
+    void remember( std::string_view str ) const;
+};
+
+/// @brief Global table of every string that has been interned.
+/// @note Used to recover strings from ids, e.g. uniform names or debug output.
+class string_id_table
+{
+public:
+    /// @brief Record a string and return its id.
+    static string_id intern( std::string_view str )
+    {
+        string_id id( str );
+        auto& table = instance();
+        std::lock_guard<std::mutex> guard( table._lock );
+        auto it = table._strings.find( id.value() );
+        if ( it == table._strings.end() )
+        {
+            table._strings.emplace( id.value(), std::string( str ) );
+        }
+        else
+        {
+            // two different strings produced the same id
+            assert( it->second == str );
+        }
+        return id;
+    }
+
+    /// @brief Returns the string used to create the id or an empty string if it was never interned.
+    static const std::string& lookup( string_id id )
+    {
+        static const std::string empty;
+        auto& table = instance();
+        std::lock_guard<std::mutex> guard( table._lock );
+        auto it = table._strings.find( id.value() );
+        return it != table._strings.end() ? it->second : empty;
+    }
+
+    /// @brief Returns the number of interned strings.
+    static size_t size()
+    {
+        auto& table = instance();
+        std::lock_guard<std::mutex> guard( table._lock );
+        return table._strings.size();
+    }
+
+private:
+    std::mutex _lock;
+    std::unordered_map<string_id::value_type, std::string> _strings;
+
+    static string_id_table& instance()
+    {
+        static string_id_table table;
+        return table;
+    }
+};
+
+/// @brief Record a runtime string within the global table and return its id.
+inline string_id intern( std::string_view str )
+{
+    return string_id_table::intern( str );
+}
+
+inline const std::string& string_id::str() const
+{
+    return string_id_table::lookup( *this );
+}
+
+inline void string_id::remember( std::string_view str ) const
+{
+    string_id_table::intern( str );
+}
+
+template<>
+inline std::string to_string( const string_id& in )
+{
+    const auto& str = in.str();
+    if ( !str.empty() )
+    {
+        return str;
+    }
+    char buffer[20] = { 0 };
+    snprintf( buffer, sizeof( buffer ), "#%016llx", static_cast<unsigned long long>( in.value() ) );
+    return buffer;
+}
+
+namespace literals
+{
+constexpr string_id operator""_sid( const char* str, size_t len )
+{
+    return string_id( std::string_view( str, len ) );
+}
+}
+}
+
+namespace std
+{
+template<>
+struct hash<fnx::string_id>
+{
+    size_t operator()( const fnx::string_id& id ) const noexcept
+    {
+        return static_cast<size_t>( id.value() );
+    }
+};
+}
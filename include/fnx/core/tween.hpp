@@ -1,12 +1,22 @@
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
 namespace fnx
 {
 template<typename T>
 /// @brief Creates a gradient of values that allows weighting certain values more than others.
+/// @note A baked tween samples the gradient into a lookup table when it changes and interpolates the table.
+///     The table is exact when ( resolution - 1 ) is a multiple of ( number of values - 1 ), otherwise the error
+///     is at most | change in slope | / ( 4 * ( resolution - 1 ) ) around each value, see max_bake_error().
 class tween
 {
 public:
+    static constexpr size_t default_resolution = 256u;
+
     tween() = default;
 
     template<typename... TArgs>
@@ -19,9 +29,119 @@ public:
     void add( const T& val )
     {
         _vectors.emplace_back( val );
+        if ( is_baked() )
+        {
+            bake( _lut.size() );
+        }
+    }
+
+    /// @brief Sample the gradient into a lookup table used by get() until unbake() is called.
+    /// @param[in] resolution : number of samples, at least 2
+    /// @note Integral values are truncated when they are sampled.
+    void bake( size_t resolution = default_resolution )
+    {
+        assert( resolution > 1u );
+        _lut.resize( resolution );
+        const double step = 1.0 / static_cast<double>( resolution - 1u );
+        for ( size_t i = 0; i < resolution; ++i )
+        {
+            _lut[i] = get_exact( static_cast<double>( i ) * step );
+        }
+    }
+
+    void unbake()
+    {
+        _lut.clear();
+        _lut.shrink_to_fit();
+    }
+
+    bool is_baked() const
+    {
+        return !_lut.empty();
+    }
+
+    /// @brief Return the number of samples in the lookup table, 0 if the tween is not baked.
+    size_t get_resolution() const
+    {
+        return _lut.size();
+    }
+
+    /// @brief Bound of | get( t ) - get_exact( t ) | for a baked tween of scalar values.
+    /// @note Assumes the resolution is at least the number of values so that each sample interval has one value.
+    double max_bake_error() const
+    {
+        if ( !is_baked() || _vectors.size() < 3u )
+        {
+            return 0.0;
+        }
+        const double segments = static_cast<double>( _vectors.size() - 1u );
+        const double samples = static_cast<double>( _lut.size() - 1u );
+        if ( std::fmod( samples, segments ) == 0.0 )
+        {
+            return 0.0;
+        }
+        double max_kink = 0.0;
+        for ( size_t i = 1; i + 1 < _vectors.size(); ++i )
+        {
+            const double before = static_cast<double>( _vectors[i] - _vectors[i - 1] );
+            const double after = static_cast<double>( _vectors[i + 1] - _vectors[i] );
+            max_kink = std::max( max_kink, std::abs( after - before ) * segments );
+        }
+        return max_kink / ( 4.0 * samples );
     }
 
+    /// @brief Return the value at t, interpolating the lookup table when the tween is baked.
+    /// @note A baked tween clamps t to [0, 1].
     virtual T get( double t ) const
+    {
+        if ( !is_baked() )
+        {
+            return get_exact( t );
+        }
+        const double position = std::min( std::max( t, 0.0 ), 1.0 ) * static_cast<double>( _lut.size() - 1u );
+        const size_t index = std::min( static_cast<size_t>( position ), _lut.size() - 2u );
+        const auto& left = _lut[index];
+        return static_cast<T>( ( _lut[index + 1] - left ) * ( position - static_cast<double>( index ) ) + left );
+    }
+
+    /// @brief Evaluate the tween at many points, out[i] = get( t[i] ).
+    /// @note Baked tweens compute every table position before interpolating so that the first pass vectorizes.
+    void get( fnx::span<const float> t, fnx::span<T> out ) const
+    {
+        assert( out.size() >= t.size() );
+        if ( !is_baked() )
+        {
+            for ( size_t i = 0; i < t.size(); ++i )
+            {
+                out[i] = get( t[i] );
+            }
+            return;
+        }
+
+        constexpr size_t block = 64u;
+        int32_t index[block];
+        float weight[block];
+        const float scale = static_cast<float>( _lut.size() - 1u );
+        const int32_t last = static_cast<int32_t>( _lut.size() - 2u );
+        for ( size_t begin = 0; begin < t.size(); begin += block )
+        {
+            const size_t count = std::min( block, t.size() - begin );
+            for ( size_t i = 0; i < count; ++i )
+            {
+                const float position = std::min( std::max( t[begin + i], 0.f ), 1.f ) * scale;
+                index[i] = std::min( static_cast<int32_t>( position ), last );
+                weight[i] = position - static_cast<float>( index[i] );
+            }
+            for ( size_t i = 0; i < count; ++i )
+            {
+                const auto& left = _lut[index[i]];
+                out[begin + i] = static_cast<T>( ( _lut[index[i] + 1] - left ) * weight[i] + left );
+            }
+        }
+    }
+
+    /// @brief Return the value at t from the values of the tween, ignoring the lookup table.
+    T get_exact( double t ) const
     {
         // find out where in the tween we are
         // find out point between the two scales
@@ -73,5 +193,18 @@ public:
     }
 private:
     std::vector<T> _vectors;
+    std::vector<T> _lut;	/// samples of a baked tween, empty otherwise
 };
+
+template<typename T>
+/// @brief Evaluate many tweens, out[i] = tweens[i]->get( t[i] ).
+/// @note Call bake() on the tweens first when they are evaluated every frame.
+inline void evaluate( fnx::span<const fnx::tween<T>* const> tweens, fnx::span<const float> t, fnx::span<T> out )
+{
+    assert( t.size() >= tweens.size() && out.size() >= tweens.size() );
+    for ( size_t i = 0; i < tweens.size(); ++i )
+    {
+        out[i] = tweens[i]->get( t[i] );
+    }
+}
 }
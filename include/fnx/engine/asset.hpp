@@ -35,6 +35,13 @@ public:
         _loaded = false;
     }
 
+    /// @brief Return the number of bytes of CPU and GPU memory held by the asset.
+    /// @note Used by the asset_manager to enforce memory budgets. Assets reporting 0 are never evicted.
+    virtual size_t get_memory_usage() const
+    {
+        return 0u;
+    }
+
     /// @brief Return whether the asset is loaded.
     /// @note deprecated
     auto is_loaded()
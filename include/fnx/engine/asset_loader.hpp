@@ -0,0 +1,236 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fnx
+{
+/// @brief Progress of an asset requested with asset_manager::get_async().
+enum class load_state
+{
+    reading,	/// waiting for or running on a worker thread
+    creating,	/// waiting for the main thread to create it
+    loaded,
+    failed
+};
+
+/// @brief Work of an asynchronous load, split between a worker thread and the main thread.
+class load_job
+{
+public:
+    virtual ~load_job() = default;
+
+    /// @brief Read and decode, runs on a worker thread and must not throw.
+    virtual void read() = 0;
+
+    /// @brief Create the asset from what read() produced, runs on the main thread and must not throw.
+    virtual void create() = 0;
+};
+
+/// @brief Runs the reading and decoding of asynchronous loads on worker threads, then creates the assets on the main
+///     thread within a time budget so that GPU uploads do not stall a frame.
+/// @usage auto [loader, _] = singleton<asset_loader>::acquire(); loader.update(); once per frame on the main thread
+class asset_loader
+{
+public:
+    asset_loader() = default;
+    ~asset_loader();
+
+    /// @brief Queue a job for a worker thread, the workers are started by the first job.
+    void submit( std::shared_ptr<fnx::load_job> job );
+
+    /// @brief Create the assets whose reading is done until the budget is spent, call it on the main thread.
+    /// @return number of assets created
+    /// @note One asset is created per call even when it takes longer than the budget, so loading always progresses.
+    size_t update( std::chrono::microseconds budget );
+
+    /// @brief Create the assets whose reading is done within the budget set with set_budget().
+    size_t update()
+    {
+        return update( _budget );
+    }
+
+    /// @brief Wait for every submitted job and create its asset, for loading screens.
+    void finish();
+
+    /// @brief Set the time update() may spend creating assets each frame.
+    void set_budget( std::chrono::microseconds budget )
+    {
+        _budget = budget;
+    }
+
+    std::chrono::microseconds get_budget() const
+    {
+        return _budget;
+    }
+
+    /// @brief Return the number of submitted jobs whose asset is not created yet.
+    size_t num_pending() const
+    {
+        return _num_pending;
+    }
+
+private:
+    std::mutex _lock;	/// protects the queues and the workers
+    std::condition_variable _wake;	/// a job was submitted or the loader is stopping
+    std::condition_variable _read;	/// a job finished reading
+    std::deque<std::shared_ptr<fnx::load_job>> _reads;
+    std::deque<std::shared_ptr<fnx::load_job>> _creates;
+    std::vector<std::thread> _workers;
+    std::atomic<size_t> _num_pending{ 0u };
+    std::chrono::microseconds _budget{ 2000 };
+    bool _stopping{ false };
+
+    asset_loader( const asset_loader& other ) = delete;
+    asset_loader& operator=( const asset_loader& other ) = delete;
+
+    void work();
+};
+
+template<typename T>
+/// @brief Splits the loading of assets of type T between a worker thread and the main thread for get_async().
+/// @note The default reads nothing and constructs the whole asset on the main thread like get() does, which keeps
+///     assets that use the GPU in their constructor safe. Specialize it with a staged type, a read() that runs on a
+///     worker thread without touching the GPU or any asset_handle, and a create() that finishes the asset.
+struct asset_staging
+{
+    struct staged {};
+
+    template<typename... TArgs>
+    static staged read( const std::string& /*asset_name*/, const TArgs& ... /*args*/ )
+    {
+        return {};
+    }
+
+    template<typename... TArgs>
+    static fnx::asset_handle<T> create( const std::string& asset_name, staged&& /*data*/, TArgs& ... args )
+    {
+        return fnx::make_shared_ref<T>( asset_name, args... );
+    }
+};
+
+template<typename T>
+/// @brief Progress and result of an asynchronous load, shared by every request of the same asset.
+class async_state : public fnx::load_job
+{
+public:
+    using callback = fnx::unique_inplace_function<void( const fnx::asset_handle<T>& )>;
+
+    load_state get_state() const
+    {
+        return _state;
+    }
+
+    /// @brief Return the asset once it is loaded.
+    fnx::asset_handle<T> get_asset()
+    {
+        std::lock_guard<std::mutex> guard( _lock );
+        return _asset;
+    }
+
+    /// @brief Call func with the asset when it is created, or with nullptr if it failed.
+    /// @note func runs on the main thread, right away if the load is already complete.
+    void on_complete( callback&& func )
+    {
+        fnx::asset_handle<T> asset;
+        {
+            std::lock_guard<std::mutex> guard( _lock );
+            if ( _state != load_state::loaded && _state != load_state::failed )
+            {
+                _callbacks.emplace_back( std::move( func ) );
+                return;
+            }
+            asset = _asset;
+        }
+        func( asset );
+    }
+
+protected:
+    std::atomic<load_state> _state{ load_state::reading };
+
+    /// @brief Record the result and run the callbacks, on the main thread.
+    void complete( const fnx::asset_handle<T>& asset )
+    {
+        std::vector<callback> callbacks;
+        {
+            std::lock_guard<std::mutex> guard( _lock );
+            _asset = asset;
+            _state = nullptr != asset.get() ? load_state::loaded : load_state::failed;
+            callbacks.swap( _callbacks );
+        }
+        for ( auto& func : callbacks )
+        {
+            func( asset );
+        }
+    }
+
+private:
+    std::mutex _lock;	/// protects the asset and callbacks
+    fnx::asset_handle<T> _asset;
+    std::vector<callback> _callbacks;
+};
+
+template<typename T>
+/// @brief Asset requested with asset_manager::get_async().
+/// @note Like every asset_handle, the asset itself is only used from the main thread.
+class async_asset
+{
+public:
+    async_asset() = default;
+
+    explicit async_asset( std::shared_ptr<fnx::async_state<T>> state )
+        : _state( std::move( state ) )
+    {
+    }
+
+    /// @brief An asset that was already loaded.
+    explicit async_asset( const fnx::asset_handle<T>& asset )
+        : _asset( asset )
+    {
+    }
+
+    load_state get_state() const
+    {
+        if ( _state )
+        {
+            return _state->get_state();
+        }
+        return nullptr != _asset.get() ? load_state::loaded : load_state::failed;
+    }
+
+    bool is_loaded() const
+    {
+        return get_state() == load_state::loaded;
+    }
+
+    /// @brief Return the asset, nullptr until it is loaded or if loading failed.
+    fnx::asset_handle<T> get() const
+    {
+        return _state ? _state->get_asset() : _asset;
+    }
+
+    /// @brief Call func with the asset when it is created, or with nullptr if it failed.
+    /// @note func runs on the main thread, right away if the load is already complete.
+    void on_complete( typename fnx::async_state<T>::callback func ) const
+    {
+        if ( _state )
+        {
+            _state->on_complete( std::move( func ) );
+        }
+        else
+        {
+            func( _asset );
+        }
+    }
+
+private:
+    std::shared_ptr<fnx::async_state<T>> _state;
+    fnx::asset_handle<T> _asset;
+};
+}
@@ -1,19 +1,244 @@
 #pragma once
 
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <tuple>
 #include <type_traits>
+#include <unordered_set>
 
 namespace fnx
 {
+/// @brief Interface the asset_budget uses to evict assets from any manager.
+class asset_cache
+{
+public:
+    virtual ~asset_cache() = default;
+
+    /// @brief Return the last use of the least recently used asset that nothing else references.
+    /// @return false if there is nothing that can be evicted
+    virtual bool oldest_evictable( uint64_t& last_used ) = 0;
+
+    /// @brief Evict the least recently used asset that nothing else references.
+    /// @return number of bytes released
+    virtual size_t evict_oldest() = 0;
+};
+
+/// @brief Tracks memory usage across every asset manager and enforces a global budget.
+/// @usage auto [budget, _] = singleton<asset_budget>::acquire(); budget.set_budget( 256 * 1024 * 1024 );
+class asset_budget
+{
+public:
+    /// @brief Set the maximum number of bytes all assets may use.
+    /// @note 0 means unlimited.
+    void set_budget( size_t bytes )
+    {
+        _budget = bytes;
+        enforce();
+    }
+
+    /// @brief Return the maximum number of bytes all assets may use.
+    size_t get_budget() const
+    {
+        return _budget;
+    }
+
+    /// @brief Return the number of bytes used by all managed assets.
+    size_t memory_usage() const
+    {
+        return _usage;
+    }
+
+    /// @brief Return a new timestamp to order asset usage across every manager.
+    uint64_t tick()
+    {
+        return ++_tick;
+    }
+
+    /// @brief Adjust the number of bytes used.
+    void add_usage( size_t bytes )
+    {
+        _usage += bytes;
+    }
+
+    /// @brief Adjust the number of bytes used.
+    void remove_usage( size_t bytes )
+    {
+        _usage -= bytes;
+    }
+
+    void register_cache( asset_cache* cache )
+    {
+        std::lock_guard<std::mutex> guard( _lock );
+        _caches.emplace_back( cache );
+    }
+
+    void unregister_cache( asset_cache* cache )
+    {
+        std::lock_guard<std::mutex> guard( _lock );
+        _caches.erase( std::remove( _caches.begin(), _caches.end(), cache ), _caches.end() );
+    }
+
+    /// @brief Evict the least recently used unreferenced assets of any type until usage is within the budget.
+    /// @note Must not be called while holding an asset manager lock.
+    void enforce()
+    {
+        std::lock_guard<std::mutex> guard( _lock );
+        while ( _budget != 0u && _usage > _budget )
+        {
+            asset_cache* oldest = nullptr;
+            uint64_t oldest_tick = std::numeric_limits<uint64_t>::max();
+            for ( auto* cache : _caches )
+            {
+                uint64_t last_used;
+                if ( cache->oldest_evictable( last_used ) && last_used < oldest_tick )
+                {
+                    oldest_tick = last_used;
+                    oldest = cache;
+                }
+            }
+
+            if ( nullptr == oldest || 0u == oldest->evict_oldest() )
+            {
+                // everything remaining is in use
+                break;
+            }
+        }
+    }
+
+private:
+    std::mutex _lock;	/// protects the cache list
+    std::vector<asset_cache*> _caches;
+    std::atomic<size_t> _budget{ 0u };
+    std::atomic<size_t> _usage{ 0u };
+    std::atomic<uint64_t> _tick{ 0u };
+};
+
 template<typename T, typename std::enable_if<std::is_base_of<fnx::asset, T>::value, T>::type* = nullptr>
 /// @brief Manage assets of a particular type.
-class asset_manager
+/// @note Assets that are only referenced by the manager are evicted least recently used first when the
+///     per type budget or the global asset_budget is exceeded. They are reloaded on the next get().
+class asset_manager : public asset_cache
 {
+    /// @brief Book keeping used to pick which asset to evict.
+    /// @note Assets that cost memory are linked from the least to the most recently used.
+    struct usage
+    {
+        size_t _bytes{ 0u };		/// memory reported by the asset
+        uint64_t _last_used{ 0u };	/// asset_budget tick of the last get()
+        fnx::string_id _older;		/// previous asset in the eviction order
+        fnx::string_id _newer;		/// next asset in the eviction order
+        bool _linked{ false };
+    };
+
+    /// @brief Load started by get_async(), it keeps the construction arguments until the asset is created.
+    template<typename... TArgs>
+    class async_load : public fnx::async_state<T>
+    {
+    public:
+        async_load( asset_manager* manager, const std::string& asset_name, TArgs&& ... args )
+            : _manager( manager )
+            , _name( asset_name )
+            , _args( std::forward<TArgs>( args )... )
+        {
+        }
+
+        /// @brief Forget the manager, it is being destroyed.
+        void detach()
+        {
+            _manager = nullptr;
+        }
+
+        void read() override
+        {
+            try
+            {
+                _staged = std::apply( [this]( const auto & ... args )
+                {
+                    return asset_staging<T>::read( _name, args... );
+                }, _args );
+            }
+            catch ( const std::exception& e )
+            {
+                FNX_ERROR( fnx::format_string( "unable to read %s: %s", _name.c_str(), e.what() ) );
+                _failed = true;
+            }
+            this->_state = load_state::creating;
+        }
+
+        void create() override
+        {
+            fnx::asset_handle<T> asset;
+            auto* manager = _manager.load();
+            if ( !_failed && nullptr != manager )
+            {
+                try
+                {
+                    asset = std::apply( [this]( auto & ... args )
+                    {
+                        return asset_staging<T>::create( _name, std::move( _staged ), args... );
+                    }, _args );
+                }
+                catch ( const std::exception& e )
+                {
+                    FNX_ERROR( fnx::format_string( "unable to create %s: %s", _name.c_str(), e.what() ) );
+                }
+            }
+            if ( nullptr != manager )
+            {
+                asset = manager->finish_load( fnx::string_id( _name ), asset );
+            }
+            this->complete( asset );
+        }
+
+    private:
+        std::atomic<asset_manager*> _manager;
+        std::string _name;
+        std::tuple<std::decay_t<TArgs>...> _args;
+        typename asset_staging<T>::staged _staged;
+        bool _failed{ false };
+    };
+
+    /// @brief Load of get_async() that the manager can detach from.
+    struct pending_load
+    {
+        std::shared_ptr<fnx::async_state<T>> _state;
+        void ( *_detach )( fnx::async_state<T>& state ) { nullptr };
+    };
+
     std::mutex _lock;
-    std::unordered_map<std::string, fnx::reference_ptr<T>> _assets;
+    fnx::flat_map<fnx::string_id, fnx::reference_ptr<T>> _assets;    /// keyed by the hashed asset name
+    fnx::flat_map<fnx::string_id, usage> _usage;
+    fnx::string_id _oldest;	/// first asset to evict
+    fnx::string_id _newest;
+    fnx::flat_map<fnx::string_id, pending_load> _loading;	/// started by get_async() and not yet created
+    std::unordered_set<fnx::string_id> _evicted;	/// evicted assets, used to count reloads
+    asset_budget& _global;
+    asset_loader& _loader;
+    size_t _memory_usage{ 0u };
+    size_t _budget{ 0u };
+    size_t _evictions{ 0u };
+    size_t _reloads{ 0u };
 public:
-    asset_manager() = default;
+    asset_manager()
+        : _global( singleton<asset_budget>::acquire().data )
+        , _loader( singleton<asset_loader>::acquire().data )
+    {
+        _global.register_cache( this );
+    }
+
     ~asset_manager()
     {
+        _global.unregister_cache( this );
+        {
+            // loads still in flight complete without an asset
+            std::lock_guard<std::mutex> guard( _lock );
+            for ( auto& [id, load] : _loading )
+            {
+                load._detach( *load._state );
+            }
+            _loading.clear();
+        }
         release_all();
     };
 
@@ -30,41 +255,88 @@ public:
     /// @note args is ignored if the asset is already created
     fnx::asset_handle<T> get( const std::string& asset_name, TArgs&& ... args )
     {
-        std::lock_guard<std::mutex> guard( _lock );
-        auto& ref = _assets[asset_name];
-        if ( nullptr == ref.get() )
+        fnx::asset_handle<T> ret;
         {
-            // not yet constructed, construct a new asset
-            ref = fnx::make_shared_ref<T>( asset_name, std::forward<TArgs>( args )... );
-            ref->load();
+            std::lock_guard<std::mutex> guard( _lock );
+            fnx::string_id id( asset_name );
+            auto& ref = _assets[id];
+            if ( nullptr == ref.get() || !ref->is_loaded() )
+            {
+                // not yet constructed or no longer loaded, construct a new asset
+                ref = fnx::make_shared_ref<T>( asset_name, std::forward<TArgs>( args )... );
+                ref->load();
+                if ( _evicted.erase( id ) )
+                {
+                    ++_reloads;
+                }
+            }
+            touch( id, ref );
+            ret = ref;
         }
-        else if ( !ref->is_loaded() )
+        enforce_budget();
+        return ret;
+    }
+
+    template<typename... TArgs>
+    /// @brief Return an asset, loading it in the background if it doesn't exist.
+    /// @param[in] asset_name : unique name of an asset of a given type
+    /// @param[in] args : construction arguments, copied until the asset is created
+    /// @note Files are read and decoded by asset_staging<T>::read() on a worker thread without holding the manager
+    ///     lock, the asset is then created on the main thread by asset_loader::update() within its time budget.
+    ///     Requests for an asset that is already loading share that load and ignore args.
+    fnx::async_asset<T> get_async( const std::string& asset_name, TArgs&& ... args )
+    {
+        std::shared_ptr<async_load<TArgs...>> load;
         {
-            release( asset_name );
-            ref = get( asset_name, std::forward<TArgs>( args )... );
+            std::lock_guard<std::mutex> guard( _lock );
+            fnx::string_id id( asset_name );
+            auto it = _assets.find( id );
+            if ( it != _assets.end() && nullptr != it->second.get() && it->second->is_loaded() )
+            {
+                touch( id, it->second );
+                return fnx::async_asset<T>( it->second );
+            }
+            auto loading = _loading.find( id );
+            if ( loading != _loading.end() )
+            {
+                return fnx::async_asset<T>( loading->second._state );
+            }
+            load = std::make_shared<async_load<TArgs...>>( this, asset_name, std::forward<TArgs>( args )... );
+            _loading[id] = pending_load{ load, []( fnx::async_state<T>& state )
+            {
+                static_cast<async_load<TArgs...>&>( state ).detach();
+            } };
         }
-        return ref;
+        _loader.submit( load );
+        return fnx::async_asset<T>( load );
     }
 
     /// @brief Returns an asset or copies a provided asset
     /// @param[in] asset_name : unique name of an asset of a given type
     /// @param[in] base : asset to be copied
-    /// @note args is ignored if the asset is already created
+    /// @note base is ignored if the asset is already created
     fnx::asset_handle<T> provide( const std::string& asset_name, const T& base )
     {
-        std::lock_guard<std::mutex> guard( _lock );
-        auto& ref = _assets[asset_name];
-        if ( nullptr == ref.get() )
-        {
-            // copy construct a new object matching the provided struct
-            ref = fnx::make_shared_ref<T>( asset_name, base );
-            ref->load();
-        }
-        else if ( !ref->is_loaded() )
+        fnx::asset_handle<T> ret;
         {
-            ref = get( asset_name, std::forward<TArgs>( args )... );
+            std::lock_guard<std::mutex> guard( _lock );
+            fnx::string_id id( asset_name );
+            auto& ref = _assets[id];
+            if ( nullptr == ref.get() || !ref->is_loaded() )
+            {
+                // copy construct a new object matching the provided struct
+                ref = fnx::make_shared_ref<T>( asset_name, base );
+                ref->load();
+                if ( _evicted.erase( id ) )
+                {
+                    ++_reloads;
+                }
+            }
+            touch( id, ref );
+            ret = ref;
         }
-        return ref;
+        enforce_budget();
+        return ret;
     }
 
     /// @brief Creates a default asset in the asset map. This is an unloaded asset.
@@ -73,7 +345,7 @@ public:
     fnx::asset_handle<fnx::asset> reserve( const std::string& asset_name )
     {
         std::lock_guard<std::mutex> guard( _lock );
-        auto& ref = _assets[asset_name];
+        auto& ref = _assets[fnx::string_id( asset_name )];
         if ( nullptr == ref.get() )
         {
             // creates an unloaded asset
@@ -82,27 +354,51 @@ public:
         return ref;
     }
 
+    /// @brief Return an existing asset without creating it.
+    /// @param[in] asset_id : hashed unique name of an asset of a given type
+    /// @return nullptr if the asset does not exist
+    fnx::asset_handle<T> find( fnx::string_id asset_id )
+    {
+        std::lock_guard<std::mutex> guard( _lock );
+        auto it = _assets.find( asset_id );
+        return it != _assets.end() ? it->second : nullptr;
+    }
+
+    /// @brief Measure again the memory of an asset that was filled after it was returned.
+    /// @param[in] asset_id : hashed unique name of an asset of a given type
+    /// @note get() measures the asset as it was constructed, call this once its content is in place.
+    void refresh( fnx::string_id asset_id )
+    {
+        {
+            std::lock_guard<std::mutex> guard( _lock );
+            auto it = _assets.find( asset_id );
+            if ( it == _assets.end() || nullptr == it->second.get() )
+            {
+                return;
+            }
+            touch( asset_id, it->second );
+        }
+        enforce_budget();
+    }
+
     /// @brief Reclaim handles and memory for a single asset.
-    /// @param[in] asset_name : unique name of an asset of a given type
-    void release( const std::string& asset_name )
+    /// @param[in] asset_id : unique name of an asset of a given type
+    void release( fnx::string_id asset_id )
     {
         std::lock_guard<std::mutex> guard( _lock );
-        _assets.erase( asset_name );
+        erase( asset_id );
     }
 
     /// @brief Reclaim handles and memory for any unused assets.
     void release_not_used()
     {
         std::lock_guard<std::mutex> guard( _lock );
-        auto it_end = _assets.end();
-        auto it = _assets.begin();
-
-        for ( ; it != it_end; )
+        for ( auto it = _assets.begin(); it != _assets.end(); )
         {
-            if ( it->second.use_count() == 1 )
+            if ( it->second.ref_count() == 1 )
             {
+                forget( it->first );
                 it = _assets.erase( it );
-                it_end = _assets.end();
                 continue;
             }
 
@@ -116,14 +412,236 @@ public:
     void release_all()
     {
         std::lock_guard<std::mutex> guard( _lock );
+        _global.remove_usage( _memory_usage );
+        _memory_usage = 0u;
+        _usage.clear();
+        _oldest = fnx::string_id();
+        _newest = fnx::string_id();
+        _evicted.clear();
         _assets.clear();
     }
 
+    /// @brief Set the maximum number of bytes assets of this type may use.
+    /// @note 0 means unlimited. The global asset_budget still applies.
+    void set_budget( size_t bytes )
+    {
+        {
+            std::lock_guard<std::mutex> guard( _lock );
+            _budget = bytes;
+        }
+        enforce_budget();
+    }
+
+    /// @brief Return the maximum number of bytes assets of this type may use.
+    size_t get_budget()
+    {
+        std::lock_guard<std::mutex> guard( _lock );
+        return _budget;
+    }
+
+    /// @brief Return the number of bytes used by assets of this type.
+    size_t memory_usage()
+    {
+        std::lock_guard<std::mutex> guard( _lock );
+        return _memory_usage;
+    }
+
+    /// @brief Return the number of assets evicted to stay within a budget.
+    size_t num_evictions()
+    {
+        std::lock_guard<std::mutex> guard( _lock );
+        return _evictions;
+    }
+
+    /// @brief Return the number of evicted assets that were requested and loaded again.
+    /// @note A high number compared to num_evictions means the budget is too small for the working set.
+    size_t num_reloads()
+    {
+        std::lock_guard<std::mutex> guard( _lock );
+        return _reloads;
+    }
+
+    /// @brief Evict unreferenced assets until both the per type and global budgets are met.
+    void enforce_budget()
+    {
+        {
+            std::lock_guard<std::mutex> guard( _lock );
+            while ( _budget != 0u && _memory_usage > _budget && evict_oldest_locked() )
+            {
+            }
+        }
+        _global.enforce();
+    }
+
+    bool oldest_evictable( uint64_t& last_used ) override
+    {
+        std::lock_guard<std::mutex> guard( _lock );
+        auto it = find_oldest_evictable();
+        if ( it == _usage.end() )
+        {
+            return false;
+        }
+        last_used = it->second._last_used;
+        return true;
+    }
+
+    size_t evict_oldest() override
+    {
+        std::lock_guard<std::mutex> guard( _lock );
+        return evict_oldest_locked();
+    }
+
     /// @brief Return all assets.
     /// @note use this carefully
     auto& get_all()
     {
         return _assets;
     }
+
+private:
+    /// @brief Store an asset created by get_async(), on the main thread.
+    /// @return the asset to hand out, one loaded by get() in the meantime wins
+    fnx::asset_handle<T> finish_load( fnx::string_id id, fnx::asset_handle<T> asset )
+    {
+        {
+            std::lock_guard<std::mutex> guard( _lock );
+            _loading.erase( id );
+            if ( nullptr == asset.get() )
+            {
+                return asset;
+            }
+            auto& ref = _assets[id];
+            if ( nullptr == ref.get() || !ref->is_loaded() )
+            {
+                ref = asset;
+                ref->load();
+                if ( _evicted.erase( id ) )
+                {
+                    ++_reloads;
+                }
+            }
+            touch( id, ref );
+            asset = ref;
+        }
+        enforce_budget();
+        return asset;
+    }
+
+    /// @brief Record usage and refresh the memory cost of an asset.
+    void touch( fnx::string_id id, const fnx::reference_ptr<T>& ref )
+    {
+        auto& entry = _usage[id];
+        auto bytes = ref->get_memory_usage();
+        _memory_usage = _memory_usage - entry._bytes + bytes;
+        _global.remove_usage( entry._bytes );
+        _global.add_usage( bytes );
+        entry._bytes = bytes;
+        entry._last_used = _global.tick();
+        unlink( entry );
+        if ( bytes > 0u )
+        {
+            link_newest( id, entry );
+        }
+    }
+
+    /// @brief Remove an asset from the eviction order.
+    void unlink( usage& entry )
+    {
+        if ( !entry._linked )
+        {
+            return;
+        }
+        if ( entry._older.is_valid() )
+        {
+            _usage.find( entry._older )->second._newer = entry._newer;
+        }
+        else
+        {
+            _oldest = entry._newer;
+        }
+        if ( entry._newer.is_valid() )
+        {
+            _usage.find( entry._newer )->second._older = entry._older;
+        }
+        else
+        {
+            _newest = entry._older;
+        }
+        entry._older = fnx::string_id();
+        entry._newer = fnx::string_id();
+        entry._linked = false;
+    }
+
+    /// @brief Add an asset to the end of the eviction order.
+    void link_newest( fnx::string_id id, usage& entry )
+    {
+        entry._older = _newest;
+        entry._newer = fnx::string_id();
+        if ( _newest.is_valid() )
+        {
+            _usage.find( _newest )->second._newer = id;
+        }
+        else
+        {
+            _oldest = id;
+        }
+        _newest = id;
+        entry._linked = true;
+    }
+
+    /// @brief Remove the book keeping for an asset.
+    void forget( fnx::string_id id )
+    {
+        auto it = _usage.find( id );
+        if ( it != _usage.end() )
+        {
+            unlink( it->second );
+            _memory_usage -= it->second._bytes;
+            _global.remove_usage( it->second._bytes );
+            _usage.erase( it );
+        }
+    }
+
+    void erase( fnx::string_id id )
+    {
+        forget( id );
+        _assets.erase( id );
+    }
+
+    /// @brief Return the least recently used asset that costs memory and is only referenced by this manager.
+    /// @note Assets at the front that are still referenced are in use, they move to the end of the order so each
+    ///     one is stepped over once rather than on every eviction.
+    auto find_oldest_evictable()
+    {
+        for ( auto remaining = _usage.size(); remaining > 0u && _oldest.is_valid(); --remaining )
+        {
+            auto it = _usage.find( _oldest );
+            auto asset = _assets.find( _oldest );
+            if ( asset != _assets.end() && asset->second.ref_count() == 1 )
+            {
+                return it;
+            }
+            it->second._last_used = _global.tick();
+            unlink( it->second );
+            link_newest( it->first, it->second );
+        }
+        return _usage.end();
+    }
+
+    size_t evict_oldest_locked()
+    {
+        auto it = find_oldest_evictable();
+        if ( it == _usage.end() )
+        {
+            return 0u;
+        }
+        auto id = it->first;
+        auto bytes = it->second._bytes;
+        FNX_DEBUG( fnx::format_string( "evicting %s (%zu bytes)", _assets[id]->get_name().c_str(), bytes ) );
+        erase( id );
+        _evicted.emplace( id );
+        ++_evictions;
+        return bytes;
+    }
 };
-}
\ No newline at end of file
+}
@@ -47,5 +47,8 @@ protected:
     float _master_volume_right{ 1.f };		/// volume multiplier for all sounds
     bool _initialized{ false };				/// flag telling the system that the window should play sound
     std::vector<sound_evt> _event_queue;	/// ordered list of all events to be processed
+    subscription_token _sound_token{ invalid_subscription };
+    subscription_token _window_init_token{ invalid_subscription };
+    subscription_token _window_close_token{ invalid_subscription };
 };
 }
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+#include <vector>
+
+namespace fnx
+{
+/// @brief GPU texture formats that store each block of 4x4 texels in a fixed number of bytes.
+enum class block_format : uint32_t
+{
+    none,	/// uncompressed pixels
+    bc1,	/// RGB and 1 bit alpha in 8 bytes, a sixth of the size of RGBA8
+    bc3,	/// RGBA in 16 bytes, BC1 colors with BC4 alpha
+    bc4,	/// red in 8 bytes, for masks and height maps
+    bc5,	/// red and green in 16 bytes, for normal maps
+    bc7	/// RGBA in 16 bytes, better quality than BC1 and BC3
+};
+
+/// @brief Return the number of bytes of a block, 0 for uncompressed pixels.
+extern size_t get_block_bytes( fnx::block_format format );
+
+/// @brief Return the number of bytes of an image of width by height texels, RGBA8 for uncompressed pixels.
+/// @note Partial blocks on the right and bottom edges take a whole block.
+extern size_t get_compressed_size( fnx::block_format format, uint32_t width, uint32_t height );
+
+/// @brief Return the name of a format, as used in logs and cache paths.
+extern const char* get_block_format_name( fnx::block_format format );
+
+/// @brief Compress RGBA8 pixels to blocks, row by row of blocks.
+/// @note BC4 keeps red and BC5 red and green. BC1 blocks with texels of alpha below 128 use the 3 color mode with
+///     these texels transparent. BC7 blocks are all encoded in mode 6, one subset of RGBA endpoints with 4 bit indices.
+///     Endpoints are fitted along the principal axis of the block colors then refined by least squares.
+extern std::vector<unsigned char> compress_blocks( const unsigned char* pixels, uint32_t width, uint32_t height,
+        fnx::block_format format );
+
+/// @brief Decompress blocks to RGBA8 pixels, as the GPU samples them.
+/// @note Channels missing from the format are 0, alpha is 255. BC7 blocks of other modes than 6 are decoded to 0.
+extern std::vector<unsigned char> decompress_blocks( const unsigned char* blocks, uint32_t width, uint32_t height,
+        fnx::block_format format );
+
+/// @brief Return the peak signal to noise ratio in dB of the first channels of two RGBA8 images.
+/// @note Identical images return 100 dB. Around 35 dB and above the compression is hard to notice.
+extern float compute_psnr( const unsigned char* pixels, const unsigned char* other, size_t num_pixels,
+                           uint32_t channels = 4u );
+}
@@ -7,6 +7,10 @@ enum class camera_type
     ortho = 0,
     perspective = 1
 };
+/// @brief Base of the cameras, keeps the view and projection matrices and the products derived from them.
+/// @note Changing a parameter only marks the matrices as dirty, they are recalculated the next time one is read.
+///     Every change also gives the camera a new version, unique across all cameras, so that users of the matrices
+///     can tell whether they are still current.
 class camera
 {
 public:
@@ -17,7 +21,7 @@ public:
     virtual void set_position( const fnx::vector3& position )
     {
         _position = position;
-        update_view_matrix();
+        invalidate_view();
     }
 
     virtual void set_position( float x, float y, float z )
@@ -25,7 +29,7 @@ public:
         _position.x = x;
         _position.y = y;
         _position.z = z;
-        update_view_matrix();
+        invalidate_view();
     }
 
     void look_at( const fnx::vector3& target, const fnx::vector3& up )
@@ -33,21 +37,47 @@ public:
         _target = target;
         _front = _target - _position;
         _up = up;
-        update_view_matrix();
+        invalidate_view();
     }
 
-    const auto& get_projection_matrix()
+    const fnx::matrix4x4& get_projection_matrix() const
     {
+        update();
         return _projection_matrix;
     }
-    const auto& get_view_matrix()
+    const fnx::matrix4x4& get_view_matrix() const
     {
+        update();
         return _view_matrix;
     }
-    const auto& get_view_projection_matrix()
+    /// @brief Projection * view, stored in OpenGL column order like the other camera matrices.
+    const fnx::matrix4x4& get_view_projection_matrix() const
     {
+        update();
         return _view_projection_matrix;
     }
+    const fnx::matrix4x4& get_inverse_view_matrix() const
+    {
+        update();
+        return _inverse_view_matrix;
+    }
+    const fnx::matrix4x4& get_inverse_projection_matrix() const
+    {
+        update();
+        return _inverse_projection_matrix;
+    }
+    /// @brief Maps clip space back to world space, used to unproject screen positions.
+    const fnx::matrix4x4& get_inverse_view_projection_matrix() const
+    {
+        update();
+        return _inverse_view_projection_matrix;
+    }
+    /// @brief Changes every time a parameter of the camera changes.
+    /// @note Two cameras only have the same version when one is an unchanged copy of the other.
+    uint64_t get_version() const
+    {
+        return _version;
+    }
     const auto& get_position()
     {
         return _position;
@@ -85,12 +115,12 @@ public:
     virtual void set_up( const fnx::vector3& up )
     {
         _up = up;
-        update_view_matrix();
+        invalidate_view();
     }
     virtual void set_front( const fnx::vector3& front )
     {
         _front = front;
-        update_view_matrix();
+        invalidate_view();
     }
     virtual void set_front( fnx::decimal x, fnx::decimal y, fnx::decimal z)
     {
@@ -99,20 +129,46 @@ public:
     virtual void set_aspect_ratio( float ratio )
     {
         _aspect_ratio = ratio;
-        update_view_matrix();
+        invalidate_projection();
     }
 
 protected:
-    virtual void update_view_matrix();
-    fnx::matrix4x4 _projection_matrix{};
-    fnx::matrix4x4 _view_matrix{};
-    fnx::matrix4x4 _view_projection_matrix{};
+    /// @brief Call after changing the position or orientation.
+    void invalidate_view();
+    /// @brief Call after changing a parameter of the projection.
+    void invalidate_projection();
+    /// @brief Calculate _view_matrix from the position and orientation.
+    virtual void update_view_matrix() const;
+    /// @brief Calculate _projection_matrix from the projection parameters.
+    virtual void update_projection_matrix() const;
+
+    mutable fnx::matrix4x4 _projection_matrix{};
+    mutable fnx::matrix4x4 _view_matrix{};
     fnx::vector3 _position{ 0.f, 0.f, 0.f };
     fnx::angle _rotation{ fnx::Degree( 0.f ) };
     fnx::vector3 _up{ 0.f, 1.f, 0.f };
     fnx::vector3 _front{ 0.f, 0.f, -1.f };
     fnx::vector3 _target{ 0.f, 0.f, 0.f };
     float _aspect_ratio{ 1.f };
+
+private:
+    mutable fnx::matrix4x4 _view_projection_matrix{};
+    mutable fnx::matrix4x4 _inverse_view_matrix{};
+    mutable fnx::matrix4x4 _inverse_projection_matrix{};
+    mutable fnx::matrix4x4 _inverse_view_projection_matrix{};
+    mutable bool _view_dirty{ true };
+    mutable bool _projection_dirty{ true };
+    uint64_t _version{ 0u };
+
+    /// @brief Recalculate the dirty matrices and everything derived from them.
+    void update() const
+    {
+        if ( _view_dirty || _projection_dirty )
+        {
+            recalculate();
+        }
+    }
+    void recalculate() const;
 };
 
 using camera_handle = fnx::reference_ptr<camera>;
@@ -2,6 +2,10 @@
 
 namespace fnx
 {
+/// @brief Identifies a single subscription made with a dispatcher.
+using subscription_token = unsigned int;
+constexpr subscription_token invalid_subscription = 0u;
+
 class dispatcher_interface
 {
 public:
@@ -31,9 +35,17 @@ class dispatcher : public dispatcher_interface
         double _time_left{ 0.0 };
     };
 
+    /// @brief Used internally to pair a subscriber with the token handed back to the caller.
+    struct subscription
+    {
+        subscription_token _token{ invalid_subscription };
+        fnx::inplace_function<bool( const T& )> _func;
+        bool _removed{ false };	/// unsubscribed during an emission, destroyed once it ends
+    };
+
 public:
 
-    using subscriber = fnx::function_ref<bool( const T& )>;
+    using subscriber = fnx::inplace_function<bool( const T& )>;
 
     dispatcher() = default;
     ~dispatcher() = default;
@@ -51,27 +63,64 @@ public:
     }
 
     /// @brief Subscribe for event notifications of a certain payload type.
-    void subscribe( const subscriber& func )
+    /// @return token used to unsubscribe
+    /// @note Subscribers added while an event is being emitted will not receive that event.
+    subscription_token subscribe( subscriber func )
     {
-        auto it_end = _subscribers.end();
-        auto it = std::find( _subscribers.begin(), it_end, func );
-        if ( it == it_end )
+        auto token = _next_token++;
+        if ( _emitting > 0 )
         {
-            _subscribers.emplace_back( func );
+            _pending.push_back( { token, std::move( func ) } );
         }
+        else
+        {
+            _subscribers.push_back( { token, std::move( func ) } );
+        }
+        return token;
     }
 
     /// @brief Unsubscribe from event notifications of a certain payload type.
-    void unsubscribe( const subscriber& func )
+    /// @param[in] token : value returned when subscribing
+    /// @note Safe to call from within a subscriber.
+    void unsubscribe( subscription_token token )
     {
-        auto it_end = _subscribers.end();
-        auto it = std::find( _subscribers.begin(), it_end, func );
-        if ( it != it_end )
+        auto by_token = []( const subscription & sub, subscription_token t )
+        {
+            return sub._token < t;
+        };
+        // tokens are handed out in increasing order so both containers remain sorted
+        auto it = std::lower_bound( _subscribers.begin(), _subscribers.end(), token, by_token );
+        if ( it != _subscribers.end() && it->_token == token )
+        {
+            if ( _emitting > 0 )
+            {
+                // defer the erase so that the emitting loop isn't invalidated, the subscriber may be the one running
+                if ( !it->_removed )
+                {
+                    it->_removed = true;
+                    ++_num_removed;
+                }
+            }
+            else
+            {
+                _subscribers.erase( it );
+            }
+            return;
+        }
+
+        auto pending = std::lower_bound( _pending.begin(), _pending.end(), token, by_token );
+        if ( pending != _pending.end() && pending->_token == token )
         {
-            _subscribers.erase( it );
+            _pending.erase( pending );
         }
     }
 
+    /// @brief Return the number of active subscribers.
+    auto count() const
+    {
+        return _subscribers.size() - _num_removed + _pending.size();
+    }
+
     /// @brief Emit all queued events who's delay has expired.
     void update( double delta ) override
     {
@@ -93,32 +142,69 @@ public:
     }
 
 private:
-    std::vector<subscriber> _subscribers;
+    std::vector<subscription> _subscribers;
+    std::vector<subscription> _pending;     /// subscribers added during emission
     fnx::ring_buffer<message<T>> _messages;
+    subscription_token _next_token{ invalid_subscription + 1u };
+    unsigned int _emitting{ 0u };           /// depth of nested emissions
+    size_t _num_removed{ 0u };              /// subscribers removed during emission
 
-    void emit( const T& event ) const
+    void emit( const T& event )
     {
-        for ( const auto& sub : _subscribers )
+        ++_emitting;
+        // index based as subscribers may be removed while iterating
+        auto total = _subscribers.size();
+        for ( size_t i = 0; i < total; ++i )
         {
-            if ( sub( event ) )
+            auto& sub = _subscribers[i];
+            if ( !sub._removed && sub._func && sub._func( event ) )
             {
                 // was absorbed
                 break;
             }
         }
+        finish_emit();
     }
 
-    void emit_reverse( const T& event ) const
+    void emit_reverse( const T& event )
     {
-        auto it_end = _subscribers.rend();
-        for ( auto it = _subscribers.rbegin(); it != it_end; ++it )
+        ++_emitting;
+        auto i = _subscribers.size();
+        while ( i > 0 )
         {
-            if ( ( *it )( event ) )
+            --i;
+            auto& sub = _subscribers[i];
+            if ( !sub._removed && sub._func && sub._func( event ) )
             {
                 // was absorbed
                 break;
             }
         }
+        finish_emit();
+    }
+
+    /// @brief Apply any subscription changes that were made while emitting.
+    void finish_emit()
+    {
+        if ( --_emitting > 0 )
+        {
+            return;
+        }
+
+        if ( _num_removed > 0u )
+        {
+            _subscribers.erase( std::remove_if( _subscribers.begin(), _subscribers.end(), []( const subscription & sub )
+            {
+                return sub._removed;
+            } ), _subscribers.end() );
+            _num_removed = 0u;
+        }
+
+        if ( !_pending.empty() )
+        {
+            std::move( _pending.begin(), _pending.end(), std::back_inserter( _subscribers ) );
+            _pending.clear();
+        }
     }
 };
-}
+}
\ No newline at end of file
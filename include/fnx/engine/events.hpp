@@ -49,18 +49,20 @@ public:
 
     template<typename T>
     /// @brief Register a callback function to be called when events of a given type are triggered.
-    void subscribe( const typename fnx::dispatcher<T>::subscriber& f )
+    /// @return token required to unsubscribe the callback
+    subscription_token subscribe( typename fnx::dispatcher<T>::subscriber f )
     {
         auto& d = get_dispatcher<T>();
-        d.subscribe( f );
+        return d.subscribe( std::move( f ) );
     }
 
     template<typename T>
     /// @brief Remove callback function for the event type.
-    void unsubscribe( const typename fnx::dispatcher<T>::subscriber& f )
+    /// @param[in] token : value returned by subscribe
+    void unsubscribe( subscription_token token )
     {
         auto& d = get_dispatcher<T>();
-        d.unsubscribe( f );
+        d.unsubscribe( token );
     }
 
 private:
@@ -58,7 +58,7 @@ protected:
     fnx::texture_handle _texture;
     short _line_height;
     short _base;
-    std::unordered_map<char, CharInfo> _character_info;
+    fnx::flat_map<char, CharInfo> _character_info;
 
     fnx::vector2 calculate_string_size( const fnx::vector2& size_limits, const std::string& text,
                                         float font_height_in_pixels,
@@ -0,0 +1,59 @@
+#pragma once
+#include <array>
+#include <vector>
+
+namespace fnx
+{
+/// @brief Filter that builds each mip level from the one above it.
+enum class mip_filter
+{
+    box,	/// average of the texels covered, cheap and soft
+    kaiser	/// Kaiser windowed sinc, sharper levels with less aliasing
+};
+
+/// @brief How an image is prepared on a worker thread before its upload.
+struct image_options
+{
+    std::array<uint8_t, 4> swizzle{ { 0u, 1u, 2u, 3u } };	/// source channel of each channel
+    bool premultiply_alpha{ false };	/// multiply the colors by alpha, for images blended as premultiplied
+    bool srgb{ false };	/// colors are sRGB encoded, they are filtered and premultiplied in linear space
+    bool mips{ true };	/// build the mip chain down to 1x1
+    fnx::mip_filter filter{ fnx::mip_filter::kaiser };
+    float alpha_cutoff{ 0.f };	/// alpha test reference of cutouts whose coverage every level keeps, 0 to disable
+};
+
+/// @brief Reorder the channels of num_pixels pixels, channel c takes the value of channel order[c].
+extern void swizzle_channels( unsigned char* pixels, size_t num_pixels, uint32_t channels,
+                              const std::array<uint8_t, 4>& order );
+
+/// @brief Multiply the colors of num_pixels RGBA pixels by their alpha.
+/// @param[in] srgb : the colors are sRGB encoded and multiplied in linear space
+extern void premultiply_alpha( unsigned char* pixels, size_t num_pixels, bool srgb );
+
+/// @brief Return the fraction of the RGBA pixels whose alpha times scale is above cutoff.
+extern float alpha_coverage( const unsigned char* pixels, size_t num_pixels, float cutoff, float scale = 1.f );
+
+/// @brief Build the levels below an image of 1 to 4 channels, down to 1x1.
+/// @note Each level is half the size of the one above, rounded down, and is filtered from the unrounded floats of
+///     the level above with SIMD kernels. Alpha is always linear. With an alpha cutoff, the alpha of each level
+///     is scaled so that as many texels pass the alpha test as in the image, which keeps cutouts from fading out in
+///     the distance.
+extern std::vector<fnx::raw_image::mip> build_mips( const unsigned char* pixels, uint32_t width, uint32_t height,
+        uint32_t channels, const fnx::image_options& options );
+
+/// @brief Swizzle, premultiply and build the mip chain of an image as set by options.
+/// @note Images are prepared on a worker thread, so that the main thread only uploads the levels.
+extern void prepare_image( fnx::raw_image& image, const fnx::image_options& options );
+
+/// @brief Sizes and quality of an image compressed with compress_image().
+struct compression_report
+{
+    size_t input_bytes{ 0u };	/// bytes of the pixels and mips before compression
+    size_t output_bytes{ 0u };	/// bytes of the blocks of every level
+    float psnr{ 0.f };	/// of the decompressed image in dB, over the channels the format keeps
+};
+
+/// @brief Compress an image and its mips to a block format, the pixels are released.
+/// @note Images of less than 4 channels are compressed as RGBA with the missing colors 0 and alpha 255.
+extern fnx::compression_report compress_image( fnx::raw_image& image, fnx::block_format format );
+}
@@ -12,37 +12,46 @@ public:
         FNX_DEBUG( fnx::format_string( "initializing material %s", get_name() ) );
     }
 
-    void add_texture( const std::string& name, fnx::texture_handle value )
+    void add_texture( fnx::string_id name, fnx::texture_handle value )
     {
+        _texture_files.erase( name );
         _textures[name] = value;
     }
-    void add_float( const std::string& name, float value )
+
+    /// @brief Set a texture by its file, which is loaded the first time the textures of the material are used.
+    void add_texture_file( fnx::string_id name, const std::string& file_path )
+    {
+        _textures.erase( name );
+        _texture_files[name] = file_path;
+    }
+    void add_float( fnx::string_id name, float value )
     {
         _floats[name] = value;
     }
-    void add_int( const std::string& name, int value )
+    void add_int( fnx::string_id name, int value )
     {
         _ints[name] = value;
     }
-    void add_vector2( const std::string& name, const fnx::vector2& value )
+    void add_vector2( fnx::string_id name, const fnx::vector2& value )
     {
         _vector2s[name] = value;
     }
-    void add_vector3( const std::string& name, const fnx::vector3& value )
+    void add_vector3( fnx::string_id name, const fnx::vector3& value )
     {
         _vector3s[name] = value;
     }
-    void add_vector4( const std::string& name, const fnx::vector4& value )
+    void add_vector4( fnx::string_id name, const fnx::vector4& value )
     {
         _vector4s[name] = value;
     }
-    void add_matrix4x4( const std::string& name, const fnx::matrix4x4& value )
+    void add_matrix4x4( fnx::string_id name, const fnx::matrix4x4& value )
     {
         _matrix4x4s[name] = value;
     }
 
     const auto& get_textures() const
     {
+        resolve_textures();
         return _textures;
     }
     const auto& get_floats() const
@@ -70,36 +79,37 @@ public:
         return _matrix4x4s;
     }
 
-    bool get( const std::string& name, fnx::texture_handle& out )
+    bool get( fnx::string_id name, fnx::texture_handle& out )
     {
+        resolve_textures();
         return get( name, _textures, out );
     }
-    bool get( const std::string& name, float& out )
+    bool get( fnx::string_id name, float& out )
     {
         return get( name, _floats, out );
     }
-    bool get( const std::string& name, int& out )
+    bool get( fnx::string_id name, int& out )
     {
         return get( name, _ints, out );
     }
-    bool get( const std::string& name, fnx::vector2& out )
+    bool get( fnx::string_id name, fnx::vector2& out )
     {
         return get( name, _vector2s, out );
     }
-    bool get( const std::string& name, fnx::vector3& out )
+    bool get( fnx::string_id name, fnx::vector3& out )
     {
         return get( name, _vector3s, out );
     }
-    bool get( const std::string& name, fnx::vector4& out )
+    bool get( fnx::string_id name, fnx::vector4& out )
     {
         return get( name, _vector4s, out );
     }
-    bool get( const std::string& name, fnx::matrix4x4& out )
+    bool get( fnx::string_id name, fnx::matrix4x4& out )
     {
         return get( name, _matrix4x4s, out );
     }
 
-    void add_array_vector4s( const std::string& name, const std::vector<fnx::vector4>& src )
+    void add_array_vector4s( fnx::string_id name, const std::vector<fnx::vector4>& src )
     {
         _arr_vector4s[name] = src;
     }
@@ -109,18 +119,31 @@ public:
     }
 
 private:
-    std::unordered_map<std::string, fnx::texture_handle> _textures;
-    std::unordered_map<std::string, float> _floats;
-    std::unordered_map<std::string, int> _ints;
-    std::unordered_map<std::string, fnx::vector2> _vector2s;
-    std::unordered_map<std::string, fnx::vector3> _vector3s;
-    std::unordered_map<std::string, fnx::vector4> _vector4s;
-    std::unordered_map<std::string, fnx::matrix4x4> _matrix4x4s;
+    // parameters are keyed by the hashed uniform name to avoid string allocations when set every frame
+    mutable fnx::flat_map<fnx::string_id, fnx::texture_handle> _textures;
+    mutable fnx::flat_map<fnx::string_id, std::string> _texture_files;	/// textures not loaded yet
+    fnx::flat_map<fnx::string_id, float> _floats;
+    fnx::flat_map<fnx::string_id, int> _ints;
+    fnx::flat_map<fnx::string_id, fnx::vector2> _vector2s;
+    fnx::flat_map<fnx::string_id, fnx::vector3> _vector3s;
+    fnx::flat_map<fnx::string_id, fnx::vector4> _vector4s;
+    fnx::flat_map<fnx::string_id, fnx::matrix4x4> _matrix4x4s;
+
+    fnx::flat_map<fnx::string_id, std::vector<fnx::vector4>> _arr_vector4s;
+
+    /// @brief Load the textures set by add_texture_file().
+    void resolve_textures() const
+    {
+        if ( !_texture_files.empty() )
+        {
+            load_texture_files();
+        }
+    }
 
-    std::unordered_map<std::string, std::vector<fnx::vector4>> _arr_vector4s;
+    void load_texture_files() const;
 
     template<typename ReturnType, typename SourceType>
-    const bool get( const std::string& name, const SourceType& lookup, ReturnType& out )
+    const bool get( fnx::string_id name, const SourceType& lookup, ReturnType& out )
     {
         auto it = lookup.find( name );
         if ( it != std::end( lookup ) )
@@ -136,5 +159,7 @@ using material_handle = fnx::asset_handle<fnx::material>;
 
 /// @brief Parses a file and puts all of the material assets into the asset manager.
 /// @param[in] file_path : local file system path
+/// @note The materials are read from the material_cache of the file. Their texture maps are loaded when the material
+///     is first drawn.
 extern void parse_material_file( const std::string& file_path );
 }
@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace fnx
+{
+/// @brief Versioned binary copy of the materials of an MTL file, loaded without parsing.
+/// @note The file holds a header, a fixed size record of each material, then the names and texture paths. The names
+///     and paths of the materials are views of the cache content.
+class material_cache : public fnx::cache_file
+{
+public:
+    static constexpr uint32_t format_version = 1u;
+
+    material_cache() = default;
+
+    /// @brief Read a cache file.
+    /// @param[in] content_hash : hash_bytes of the MTL file, the cache is not open if it was written for other
+    ///     content, by another version, or if it is damaged
+    material_cache( const std::string& file_path, uint64_t content_hash );
+
+    /// @brief Read a cache from memory.
+    material_cache( std::vector<char>&& bytes, uint64_t content_hash );
+
+    material_cache( material_cache&& other ) = default;
+    material_cache& operator=( material_cache&& other ) = default;
+
+    const std::vector<fnx::mtl_material>& get_materials() const
+    {
+        return _materials;
+    }
+
+    /// @brief Return the content of a cache file for the materials.
+    static std::vector<char> serialize( uint64_t content_hash, const std::vector<fnx::mtl_material>& materials );
+
+private:
+    std::vector<fnx::mtl_material> _materials;
+
+    bool read( const char* data, size_t size, uint64_t content_hash ) override;
+};
+
+/// @brief Path of the cache written next to an MTL file.
+extern std::string get_material_cache_path( const std::string& mtl_path );
+
+/// @brief Load the materials of an MTL file from its cache.
+/// @note The MTL file is parsed and its cache rewritten when the cache is missing or out of date. The MTL file is
+///     still read to hash its content.
+/// @return a cache that is not open if the MTL file cannot be read
+extern fnx::material_cache load_material_cache( const std::string& mtl_path );
+}
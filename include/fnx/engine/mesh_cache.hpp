@@ -0,0 +1,118 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fnx
+{
+/// @brief Mesh of a mesh_cache, the vertices and indices are views of the cache content.
+struct cached_mesh
+{
+    std::string_view name;
+    int flags{ 0 };		/// raw_model::data_bit of the vertex layout
+    fnx::span<const float> vertices;
+    fnx::span<const unsigned short> indices;
+    fnx::span<const unsigned int> indices_32;	/// used instead of indices by meshes of more than 65535 vertices
+    fnx::material_map materials;
+    reactphysics3d::AABB aabb;
+    std::vector<fnx::mesh_lod> lods;	/// their triangles follow those of the full mesh in the indices
+};
+
+/// @brief Versioned binary copy of the meshes imported from a model file, loaded without parsing.
+/// @note The file holds a header, the mesh, material, level of detail and library tables, the names, then the vertex
+///     and index blobs each aligned to 16 bytes. The blobs are used in place from the mapped file so they can be handed to
+///     the GPU without being copied to the heap first.
+class mesh_cache : public fnx::cache_file
+{
+public:
+    static constexpr uint32_t format_version = 3u;
+    static constexpr uint32_t importer_version = 4u;	/// bump when the imported meshes change
+
+    mesh_cache() = default;
+
+    /// @brief Map a cache file, or read it from the archive that holds it.
+    /// @param[in] content_hash : hash_bytes of the model file, the cache is not open if it was written for other
+    ///     content, by another version, or if it is damaged
+    mesh_cache( const std::string& file_path, uint64_t content_hash );
+
+    /// @brief Read a cache from memory.
+    mesh_cache( std::vector<char>&& bytes, uint64_t content_hash );
+
+    mesh_cache( mesh_cache&& other ) = default;
+    mesh_cache& operator=( mesh_cache&& other ) = default;
+
+    const std::vector<fnx::cached_mesh>& get_meshes() const
+    {
+        return _meshes;
+    }
+
+    /// @brief Material files referenced by the model file.
+    const std::vector<std::string_view>& get_material_libraries() const
+    {
+        return _material_libraries;
+    }
+
+    /// @brief Return the content of a cache file for the meshes.
+    static std::vector<char> serialize( uint64_t content_hash, const std::vector<fnx::cached_mesh>& meshes,
+                                        const std::vector<std::string>& material_libraries );
+
+private:
+    std::vector<fnx::cached_mesh> _meshes;
+    std::vector<std::string_view> _material_libraries;
+
+    bool read( const char* data, size_t size, uint64_t content_hash ) override;
+};
+
+/// @brief Path of the cache written next to a model file.
+extern std::string get_mesh_cache_path( const std::string& model_path );
+
+/// @brief Load the meshes of an OBJ file from its cache.
+/// @note The model file is imported and its cache rewritten when the cache is missing or out of date. The model
+///     file is still read to hash its content, so loading is bound by I/O instead of parsing.
+/// @note Imported meshes are indexed and optimized for the vertex cache, overdraw and vertex fetch, the statistics
+///     of each stage are logged. Objects of the same name are merged into one mesh. Levels of detail are built for
+///     every mesh with build_lods.
+/// @exception std::runtime_error if the model file cannot be opened
+extern mesh_cache load_mesh_cache( const std::string& model_path );
+
+/// @brief Mesh of a model file read with its mesh cache, ready to be created on the main thread.
+struct staged_mesh
+{
+    std::shared_ptr<const fnx::mesh_cache> cache;
+    size_t index{ 0u };
+
+    const fnx::cached_mesh& get() const
+    {
+        return cache->get_meshes()[index];
+    }
+};
+
+/// @brief Load the mesh cache of a model file with load_mesh_cache and find one of its meshes.
+/// @exception std::runtime_error if the model file cannot be opened or has no mesh of that name
+extern fnx::staged_mesh read_mesh( const std::string& model_path, const std::string& mesh_name );
+
+/// @brief Copy a mesh of a mesh cache to a raw model.
+extern void copy_mesh( const fnx::cached_mesh& mesh, fnx::raw_model& raw );
+
+template<>
+/// @brief Raw models are imported or read from their mesh cache on a worker thread and copied out of it on the main
+///     thread.
+/// @usage raw_models.get_async( "mesh name", "model.obj" ), the materials of the model file are not loaded
+struct asset_staging<fnx::raw_model>
+{
+    using staged = fnx::staged_mesh;
+
+    static staged read( const std::string& mesh_name, const std::string& model_path )
+    {
+        return fnx::read_mesh( model_path, mesh_name );
+    }
+
+    static fnx::raw_model_handle create( const std::string& mesh_name, staged&& mesh, const std::string& /*model_path*/ )
+    {
+        auto raw = fnx::make_shared_ref<fnx::raw_model>( mesh_name );
+        fnx::copy_mesh( mesh.get(), *raw );
+        return raw;
+    }
+};
+}
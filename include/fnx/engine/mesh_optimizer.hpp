@@ -0,0 +1,112 @@
+#pragma once
+#include <vector>
+
+namespace fnx
+{
+/// @brief Vertices shared between triangles and the order to draw them in.
+/// @note Only one of the index buffers is filled, 16 bit indices are used when every vertex fits.
+struct indexed_vertices
+{
+    std::vector<float> vertices;
+    std::vector<unsigned short> indices;
+    std::vector<unsigned int> indices_32;
+
+    size_t get_num_indices() const
+    {
+        return indices.empty() ? indices_32.size() : indices.size();
+    }
+};
+
+/// @brief Largest number of vertices that are indexed with 16 bits.
+constexpr size_t max_vertices_16 = 65535u;
+
+/// @brief Merge the identical vertices of a triangle list.
+/// @param[in] vertices : num_vertices vertices of stride floats each, in draw order
+/// @note Vertices are identical when all their floats are equal, zeros of either sign are stored as 0. Index i
+///     draws the vertex that was at position i, so ranges of vertices such as material ranges become ranges of
+///     indices.
+extern indexed_vertices index_vertices( const float* vertices, size_t num_vertices, size_t stride );
+
+/// @brief Efficiency of the post transform vertex cache, simulated as a FIFO.
+struct vertex_cache_statistics
+{
+    float acmr{ 0.f };	/// average cache miss ratio, vertices transformed per triangle, 0.5 at best and 3 at worst
+    float atvr{ 0.f };	/// average transform to vertex ratio, 1 when each vertex is transformed once
+};
+
+/// @brief Statistics of a mesh after each stage of optimize_mesh.
+struct mesh_optimization_report
+{
+    vertex_cache_statistics input;
+    vertex_cache_statistics vertex_cache;
+    vertex_cache_statistics overdraw;
+    float input_overfetch{ 0.f };
+    float overfetch{ 0.f };
+};
+
+/// @brief Simulated cache size of vertex_cache_statistics.
+constexpr size_t vertex_cache_size = 16u;
+
+/// @brief Simulate the vertex cache while drawing the triangles.
+extern vertex_cache_statistics analyze_vertex_cache( const unsigned int* indices, size_t num_indices,
+        size_t num_vertices, size_t cache_size = vertex_cache_size );
+
+/// @brief Return the bytes read from vertex memory in 64 byte lines over the size of the vertex buffer.
+/// @note 1 when each vertex is read once, vertices missing the vertex cache are read through a cache of 64 lines.
+extern float analyze_vertex_fetch( const unsigned int* indices, size_t num_indices, size_t num_vertices,
+                                   size_t vertex_bytes );
+
+/// @brief Reorder triangles so that they reuse the vertices transformed by the previous ones.
+/// @note Tom Forsyth's linear speed vertex cache optimisation, the triangles keep the winding of their corners.
+extern void optimize_vertex_cache( unsigned int* indices, size_t num_indices, size_t num_vertices );
+
+/// @brief Reorder clusters of triangles so that those facing outward are drawn first and hide the ones behind.
+/// @param[in] positions : xyz of each vertex, stride floats apart
+/// @param[in] threshold : the ACMR of the vertex cache optimised order may grow by this factor
+/// @note Clusters start where the cache is cold, call it after optimize_vertex_cache.
+extern void optimize_overdraw( unsigned int* indices, size_t num_indices, const float* positions,
+                               size_t num_vertices, size_t stride, float threshold = 1.05f );
+
+/// @brief Renumber the vertices in the order the indices first use them so that vertices drawn together are
+///     stored together.
+/// @return number of vertices, those no index uses are removed
+extern size_t optimize_vertex_fetch( unsigned int* indices, size_t num_indices, std::vector<float>& vertices,
+                                     size_t stride );
+
+/// @brief Run every stage on a mesh, triangles stay within their material ranges.
+/// @note The vertices keep their order unless optimize_vertex_fetch reduces the bytes fetched.
+/// @param[in] stride : floats of each vertex, starting with its position
+/// @param[in] overdraw : reorder clusters for overdraw, leave it off for meshes drawn without depth test
+extern mesh_optimization_report optimize_mesh( indexed_vertices& mesh, size_t stride,
+        const fnx::material_map& materials, bool overdraw = true );
+
+/// @brief Collapse edges of a triangle list onto their other vertex while the quadric error allows it.
+/// @param[in] positions : xyz of each vertex, stride floats apart
+/// @param[in] target_indices : stop once the triangles fit in this many indices
+/// @param[in] max_error : stop before moving the surface further than this distance
+/// @param[out] result_error : estimated distance the surface moved, may be null
+/// @return indices of the remaining triangles
+/// @note Vertices on edges used by a single triangle never move. Texture seams and material ranges show up as such
+///     edges after index_vertices, so they keep their shape, as do the borders of open meshes.
+extern std::vector<unsigned int> simplify( const unsigned int* indices, size_t num_indices, const float* positions,
+        size_t num_vertices, size_t stride, size_t target_indices, float max_error, float* result_error = nullptr );
+
+/// @brief Simplified copy of a mesh drawn in place of it when it is small on screen.
+struct mesh_lod
+{
+    size_t start{ 0u };
+    size_t end{ 0u };	/// range of the index buffer, after the triangles of the full mesh
+    float error{ 0.f };	/// estimated distance to the surface of the full mesh, in object space
+    fnx::material_map materials;	/// the material ranges of the full mesh, as ranges of the index buffer
+};
+
+/// @brief Append simplified copies of a mesh to its index buffer, each built from the previous one.
+/// @param[in] stride : floats of each vertex, starting with its position
+/// @param[in] ratio : triangles kept by each level relative to the previous one
+/// @param[in] max_error : largest error of a level relative to the largest extent of the mesh
+/// @return the levels from the most to the least detailed, fewer than max_lods when simplifying stops paying off
+/// @note Levels share the vertices of the full mesh and are simplified per material range. Call it after
+///     optimize_mesh, which renumbers the vertices.
+extern std::vector<mesh_lod> build_lods( indexed_vertices& mesh, size_t stride, const fnx::material_map& materials,
+        size_t max_lods = 3u, float ratio = 0.5f, float max_error = 0.02f );
+}
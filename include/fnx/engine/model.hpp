@@ -1,4 +1,5 @@
 #pragma once
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -30,15 +31,36 @@ public:
     model( const std::string& name, fnx::raw_model& raw_model );
 
     /// @brief Create a model from an existing raw model.
+    /// @note The vertices and indices are sent to the GPU by the upload_queue, the model draws nothing until then.
     model( const std::string& name, fnx::raw_model_handle raw_model );
 
+    /// @brief Create a model from an existing raw model with its vertices stored in the formats of layout.
+    /// @note Shaders must decode snorm16_octahedral normals, every other format is decoded by the GPU.
+    model( const std::string& name, const fnx::raw_model& raw_model, const fnx::vertex_layout& layout );
+
+    /// @brief Create a model from an existing raw model with its vertices stored in the formats of layout.
+    model( const std::string& name, fnx::raw_model_handle raw_model, const fnx::vertex_layout& layout );
+
+    /// @brief Create a model from a mesh of a mesh_cache, the vertices are uploaded straight from the cache.
+    /// @note The upload_queue sends the vertices and indices to the GPU, the model keeps the cache until then.
+    model( const std::string& name, std::shared_ptr<const fnx::mesh_cache> cache, size_t mesh_index );
+
     virtual ~model();
 
+    /// @brief Return the number of bytes uploaded to vertex and index buffers.
+    size_t get_memory_usage() const override;
+
     void render_as_lines()
     {
         _render_as_lines = true;
     }
 
+    /// @brief Return true once the vertices and indices are on the GPU.
+    bool is_resident() const
+    {
+        return nullptr == _upload || _upload->is_done();
+    }
+
     /// @brief Start using the model for rendering.
     virtual void bind() const;
 
@@ -46,8 +68,23 @@ public:
     virtual void render() const;
 
     /// @brief Draw part of the model.
+    /// @note start and end count indices when the model has an index buffer, vertices otherwise.
     virtual void render_partial( int start, int end ) const;
 
+    /// @brief Draw a level of detail, 0 is the full model and lod the level get_lods()[lod - 1].
+    virtual void render_lod( size_t lod ) const;
+
+    /// @brief Simplified levels of detail, copied from the raw model or mesh cache.
+    const auto& get_lods() const
+    {
+        return _lods;
+    }
+
+    /// @brief Return the least detailed level whose error stays under threshold on screen, 0 for the full model.
+    /// @param[in] error_scale : size on screen of one object space unit
+    /// @param[in] threshold : largest error allowed, in the units of error_scale
+    size_t select_lod( fnx::decimal error_scale, fnx::decimal threshold ) const;
+
     /// @brief Stop using the model for rendering.
     virtual void unbind() const;
 
@@ -107,6 +144,10 @@ public:
     /// @note Initial call to populate a VBO buffer. This will tell opengl how to interpret the data.
     ///     Updates to the VBO's buffer content should be done by calling update_vbo().
     void load_to_vbo( VBO_Index vbo_idx, unsigned int num_components, const std::vector<unsigned char>& elements );
+    /// @brief Initialize a VBO buffer from a view, such as the vertices of a mapped mesh_cache.
+    /// @note Initial call to populate a VBO buffer. This will tell opengl how to interpret the data.
+    ///     Updates to the VBO's buffer content should be done by calling update_vbo().
+    void load_to_vbo( VBO_Index vbo_idx, unsigned int num_components, fnx::span<const float> elements );
 
     /// @brief Loads an attribute to an already initialized VBO.
     void load_to_attribute( VBO_Index vbo_idx, Attribute_Index attr_idx, unsigned int num_components,
@@ -119,6 +160,8 @@ public:
     void load_to_ibo( const std::vector<unsigned char>& indices );
     void load_to_ibo( const std::vector<unsigned short>& indices );
     void load_to_ibo( const std::vector<unsigned int>& indices );
+    void load_to_ibo( fnx::span<const unsigned short> indices );
+    void load_to_ibo( fnx::span<const unsigned int> indices );
 
     /// @brief Update an already initialized VBO float buffer's content.
     void update_vbo( VBO_Index vbo_idx, const std::vector<float>& elements );
@@ -144,16 +187,89 @@ public:
         return _raw_model;
     }
 
+    /// @brief Return true when the bounds of the vertices are known, models built without a raw model have none.
+    auto has_bounds() const
+    {
+        return _has_bounds;
+    }
+
+    /// @brief Object space bounds of the vertices, copied from the raw model.
+    const auto& get_bounds() const
+    {
+        return _bounds;
+    }
+
+    /// @brief Return true when the vertex positions are stored normalized within the bounds.
+    auto has_position_decode() const
+    {
+        return _has_position_decode;
+    }
+
+    /// @brief Maps the stored positions back to object space, apply it before the model transform.
+    const auto& get_position_decode() const
+    {
+        return _position_decode;
+    }
+
 private:
     model_impl* _impl{ nullptr };
     fnx::raw_model_handle _raw_model{ nullptr };
+    reactphysics3d::AABB _bounds{};
+    bool _has_bounds{ false };
+    fnx::matrix4x4 _position_decode{ fnx::matrix4x4::identity() };
+    bool _has_position_decode{ false };
     bool _render_as_lines{ false };
+    std::vector<fnx::mesh_lod> _lods;
+    std::shared_ptr<fnx::gpu_upload> _upload;	/// pending upload of the raw model or cached mesh
+    std::shared_ptr<const fnx::mesh_cache> _mesh_cache;	/// holds the cached mesh until it is uploaded
+    size_t _mesh_index{ 0u };
 
     model( const model& other ) = delete;
     model( model&& other ) = delete;
 
     void init();
+
+    /// @brief Create the buffers of a raw model, its data is uploaded later by the upload queue when deferred.
+    void load_raw_model( const fnx::raw_model& raw, bool deferred );
+
+    /// @brief Send the vertices and indices of the raw model to the GPU.
+    void upload_raw_model();
+
+    /// @brief Send the vertices and indices of the cached mesh to the GPU, then release the cache.
+    void upload_cached_mesh();
+
+    /// @brief Run the queued upload now, before the buffers are changed.
+    void complete_upload();
+
+    /// @brief Point the attributes at interleaved float vertices of the bound VBO.
+    /// @return number of floats of each vertex
+    int setup_float_attributes( bool has_texture, bool has_normals, bool has_colors );
 };
 
+/// @brief Create a model asset for each mesh of a model file, named after the mesh.
+/// @note The meshes are read from the mesh cache and uploaded from it without being copied, the cache stays mapped
+///     until the last of them is uploaded. Use parse_model_file for raw models that can be read on the CPU.
+/// @exception std::runtime_error if the model file cannot be opened
+extern void load_model_file( const std::string& file_path );
+
 using model_handle = fnx::asset_handle<fnx::model>;
+
+template<>
+/// @brief Models are imported or read from their mesh cache on a worker thread, the main thread only sets up their
+///     vertex arrays and queues their upload from the cache.
+/// @usage models.get_async( "mesh name", "model.obj" ), the materials of the model file are not loaded
+struct asset_staging<fnx::model>
+{
+    using staged = fnx::staged_mesh;
+
+    static staged read( const std::string& mesh_name, const std::string& model_path )
+    {
+        return fnx::read_mesh( model_path, mesh_name );
+    }
+
+    static fnx::model_handle create( const std::string& mesh_name, staged&& mesh, const std::string& /*model_path*/ )
+    {
+        return fnx::make_shared_ref<fnx::model>( mesh_name, std::move( mesh.cache ), mesh.index );
+    }
+};
 }
\ No newline at end of file
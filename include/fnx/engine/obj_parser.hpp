@@ -0,0 +1,92 @@
+#pragma once
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fnx
+{
+/// @brief One object of a Wavefront OBJ file, de-indexed into the vertex layout of raw_model.
+struct obj_object
+{
+    std::string name;
+    std::vector<float> vertices;	/// position xyz, uv when has_texture, then normal xyz for each triangle corner
+    fnx::material_map materials;	/// usemtl ranges in vertices
+    reactphysics3d::AABB aabb;		/// bounds of the positions used by the faces
+    bool has_texture{ false };
+    bool has_normal{ false };		/// faces without normals get the normal of their triangle
+};
+
+/// @brief Content of a Wavefront OBJ file.
+struct obj_data
+{
+    std::vector<obj_object> objects;	/// in file order, faces before the first o record go to an unnamed object
+    std::vector<std::string> material_libraries;
+};
+
+/// @brief Parse the text of an OBJ file.
+/// @param[in] num_threads : the text is split in as many pieces at line breaks, each parsed by its own thread, the
+///     result does not depend on the number of threads
+/// @note Tokens are read in place and the outputs are sized by a first pass over the text, so the only
+///     allocations are the output buffers. Faces with more than three corners are split into a fan, faces that
+///     reference missing data are skipped.
+extern obj_data parse_obj( std::string_view text, size_t num_threads = 1u );
+
+/// @brief Memory map and parse an OBJ file.
+/// @param[in] num_threads : 0 to use every core, files are only split in pieces of a megabyte or more
+/// @exception std::runtime_error if the file cannot be opened
+extern obj_data load_obj( const std::string& file_path, size_t num_threads = 0u );
+
+/// @brief Numeric parameters of an MTL material, laid out to be copied as is to and from a material_cache.
+struct mtl_values
+{
+    float ns{ 0.f };
+    float ni{ 1.f };
+    float d{ 1.f };
+    float illum{ 0.f };
+    float ka[3]{ 0.f, 0.f, 0.f };
+    float kd[3]{ 0.f, 0.f, 0.f };
+    float ks[3]{ 0.f, 0.f, 0.f };
+    float ke[3]{ 0.f, 0.f, 0.f };
+};
+
+/// @brief One material of a Wavefront MTL file.
+struct mtl_material
+{
+    /// @brief Bits of the parameters the file sets.
+    enum parameter : uint32_t
+    {
+        ns = 0x01u,
+        ni = 0x02u,
+        d = 0x04u,
+        illum = 0x08u,
+        ka = 0x10u,
+        kd = 0x20u,
+        ks = 0x40u,
+        ke = 0x80u
+    };
+
+    /// @brief Texture maps of a material.
+    enum map : size_t
+    {
+        map_ka = 0u,
+        map_kd,
+        map_ks,
+        map_ke,
+        map_ns,
+        map_d,
+        map_count
+    };
+
+    std::string_view name;
+    uint32_t parameters{ 0u };	/// parameter bits of the values read
+    fnx::mtl_values values;
+    std::array<std::string_view, map_count> maps;	/// texture paths, empty for maps the file does not set
+};
+
+/// @brief Parse the text of an MTL file.
+/// @note The names and paths are views of the text. Each line is read in place and its command dispatched on its hash,
+///     records other than newmtl, Ns, Ni, d, illum, Ka, Kd, Ks, Ke and their maps are skipped, as are parameters
+///     before the first newmtl. A map keeps the last word of its line, so options before the path are skipped.
+extern std::vector<fnx::mtl_material> parse_mtl( std::string_view text );
+}
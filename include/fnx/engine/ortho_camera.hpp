@@ -20,19 +20,14 @@ public:
     virtual void rotate_z( const fnx::angle& rotation ) override
     {
         _rotation = rotation;
-        update_view_matrix();
-    }
-
-    virtual void set_aspect_ratio( float ratio ) override
-    {
-        _projection_matrix = fnx::matrix_ortho( _left * ratio, _right * ratio, _bottom, _top );
-        camera::set_aspect_ratio( ratio );	// will update matrix
+        invalidate_view();
     }
 
 protected:
     friend fnx::camera_serializer;
 
-    virtual void update_view_matrix() override;
+    virtual void update_view_matrix() const override;
+    virtual void update_projection_matrix() const override;
 
     float _left{};
     float _right{};
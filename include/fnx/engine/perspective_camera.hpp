@@ -15,7 +15,6 @@ public:
         _up = Vector3( 0.f, 0.f, 1.f );
         _front = Vector3( 0.f, 1.f, 0.f );
         _aspect_ratio = aspect;
-        update_view_matrix();
     }
     virtual ~perspective_camera() = default;
 
@@ -30,11 +29,12 @@ public:
         _field_of_view = fov_y;
         _near = front;
         _far = back;
-        update_view_matrix();
+        invalidate_projection();
     }
 protected:
     friend fnx::camera_serializer;
-    virtual void update_view_matrix() override;
+    virtual void update_view_matrix() const override;
+    virtual void update_projection_matrix() const override;
 
     fnx::angle _field_of_view;
     float _near;
@@ -5,30 +5,16 @@ namespace fnx
 class property_manager
 {
 public:
-    template<typename T> auto get_property( const std::string& key )
+    /// @note Keys are hashed so string literals and std::strings never allocate on lookup.
+    template<typename T> auto get_property( fnx::string_id key )
     {
         return _properties[key].get<T>();
     }
-    template<typename T> auto get_property( const char* key )
-    {
-        return _properties[key].get<T>();
-    }
-    template<typename T> auto set_property( const std::string& key, const T& val )
-    {
-        _properties[key].set<T>( val );
-    }
-    template<typename T> auto set_property( const char* key, const T& val )
+    template<typename T> auto set_property( fnx::string_id key, const T& val )
     {
         _properties[key].set<T>( val );
     }
 private:
-    struct cmp_str
-    {
-        bool operator()( const char* a, const char* b ) const
-        {
-            return std::strcmp( a, b ) < 0;
-        }
-    };
-    std::unordered_map<std::string, fnx::property> _properties;
+    std::unordered_map<fnx::string_id, fnx::property> _properties;
 };
-}
\ No newline at end of file
+}
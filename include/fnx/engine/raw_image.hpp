@@ -1,4 +1,5 @@
 #pragma once
+#include <vector>
 
 namespace fnx
 {
@@ -19,6 +20,14 @@ public:
         bool _is_stb{ false };
     };
 
+    /// @brief Level of the mip chain below the image, with the channels of the image or the blocks of its format.
+    struct mip
+    {
+        uint32_t _width{};
+        uint32_t _height{};
+        std::vector<unsigned char> _data;
+    };
+
     raw_image() = default;
     raw_image( void* data, size_t size, int32_t width, int32_t height, int channels = 4 );
     raw_image( const std::string& file_path, int32_t channels = 4 );
@@ -37,8 +46,7 @@ public:
     /// @param[in] width : width in pixels
     /// @param[in] height : height in pixels
     /// @param[in] channels : number of RGBA channels.
-    /// @note channels of 0 means grab only the channels present in the file. If the image only has RGB channels,
-    ///		and channels value is 4, the Alpha channel will be added to the output buffer.
+    /// @note The image takes the buffer, which is released with free(), its size must be width * height * channels.
     bool load_from_buffer( void* data, size_t size, int32_t width, int32_t height, int channels = 4 );
 
     /// @brief Free memory
@@ -47,13 +55,53 @@ public:
 
     auto operator=( const raw_image& other ) = delete;
     raw_image( const raw_image& other ) = delete;
-    raw_image( raw_image&& other ) = default;
+    /// @brief Take the pixels of another image, which is left empty.
+    raw_image( raw_image&& other ) noexcept;
+    raw_image& operator=( raw_image&& other ) noexcept;
 
     const auto& get_info() const
     {
         return _info;
     }
+
+    /// @brief Return the pixels, to prepare them before the upload.
+    unsigned char* get_pixels()
+    {
+        return static_cast<unsigned char*>( _info._data );
+    }
+
+    /// @brief Levels below the image, empty unless they were built with build_mips().
+    const auto& get_mips() const
+    {
+        return _mips;
+    }
+
+    void set_mips( std::vector<fnx::raw_image::mip>&& mips )
+    {
+        _mips = std::move( mips );
+    }
+
+    /// @brief Replace the pixels and mips by levels compressed to a block format.
+    /// @param[in] channels : channels of the pixels that were compressed
+    /// @note The image has no pixels afterwards, get_pixels() returns nullptr.
+    void load_blocks( uint32_t width, uint32_t height, uint32_t channels, fnx::block_format format,
+                      std::vector<unsigned char>&& blocks, std::vector<fnx::raw_image::mip>&& mips );
+
+    /// @brief Return the block format of the image, none for pixels.
+    fnx::block_format get_format() const
+    {
+        return _format;
+    }
+
+    /// @brief Return the blocks of the image when it is compressed.
+    const auto& get_blocks() const
+    {
+        return _blocks;
+    }
 private:
     fnx::raw_image::info _info;
+    std::vector<fnx::raw_image::mip> _mips;
+    fnx::block_format _format{ fnx::block_format::none };
+    std::vector<unsigned char> _blocks;
 };
 }
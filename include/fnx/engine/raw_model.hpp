@@ -19,25 +19,44 @@ public:
 
     using vbo_data_arr_t = std::vector<float>;
     using ibo_data_arr_t = std::vector<unsigned short>;
+    using ibo_data_32_arr_t = std::vector<unsigned int>;
 
     raw_model( const std::string& name );
     raw_model( const std::string& name, const vbo_data_arr_t& vbo_data );
     raw_model( const std::string& name, const float* vbo_data, size_t size );
     raw_model( const std::string& name, const vbo_data_arr_t& vbo_data, const ibo_data_arr_t& ibo_data );
+    raw_model( const std::string& name, const vbo_data_arr_t& vbo_data, const ibo_data_32_arr_t& ibo_data );
 
     /// @brief creates a quad from two triangles
     raw_model( const std::string& name, float left, float top, float width, float height );
     ~raw_model();
 
+    /// @brief Return the number of bytes held by the vertex and index data.
+    size_t get_memory_usage() const override;
+
     std::vector<float> get_position_data() const;
+
+    /// @brief Copy of the vertices in the formats of layout, unorm16 positions are normalized within their bounds.
+    fnx::packed_vertices pack( const fnx::vertex_layout& layout ) const;
+
+    /// @brief Return the bounds of the vertex positions.
+    /// @note Measured from the vertices, get_aabb is only filled for models read from a file.
+    reactphysics3d::AABB measure_aabb() const;
+
     const auto& get_vertices() const
     {
         return _vbo_data;
     }
+    /// @brief 16 bit indices, empty when the model has no indices or uses 32 bit indices.
     const auto& get_indices() const
     {
         return _ibo_data;
     }
+    /// @brief 32 bit indices, only used when the model has more vertices than 16 bits can index.
+    const auto& get_indices_32() const
+    {
+        return _ibo_data_32;
+    }
     const auto& get_material_map() const
     {
         return _material_map;
@@ -46,6 +65,11 @@ public:
     {
         return _aabb;
     }
+    /// @brief Simplified levels of detail, their triangles follow those of the full mesh in the index buffer.
+    const auto& get_lods() const
+    {
+        return _lods;
+    }
     auto& get_mutable_vertices()
     {
         return _vbo_data;
@@ -54,6 +78,10 @@ public:
     {
         return _ibo_data;
     }
+    auto& get_mutable_indices_32()
+    {
+        return _ibo_data_32;
+    }
     auto& get_mutable_material_map()
     {
         return _material_map;
@@ -62,6 +90,10 @@ public:
     {
         return _aabb;
     }
+    auto& get_mutable_lods()
+    {
+        return _lods;
+    }
     auto get_num_vertices() const
     {
         auto size = _vbo_data.size();
@@ -103,6 +135,10 @@ public:
     {
         return _flags & data_bit::line;
     }
+    bool has_index_data() const
+    {
+        return !_ibo_data.empty() || !_ibo_data_32.empty();
+    }
     bool has_material_map() const
     {
         return _material_map.size();
@@ -147,9 +183,11 @@ public:
 private:
     vbo_data_arr_t _vbo_data;	/// raw vertex data
     ibo_data_arr_t _ibo_data;	/// vertex draw order
+    ibo_data_32_arr_t _ibo_data_32;	/// vertex draw order of models with too many vertices for _ibo_data
     int _flags{ 0 };
     material_map _material_map;
     reactphysics3d::AABB _aabb; /// min and maxes in each axis
+    std::vector<fnx::mesh_lod> _lods;
 };
 
 using raw_model_handle = fnx::asset_handle<fnx::raw_model>;
@@ -167,5 +205,9 @@ extern raw_model_handle raw_model_line( const fnx::vector3& start,
                                         reactphysics3d::decimal start_alpha,
                                         const fnx::vector3& end_color,
                                         reactphysics3d::decimal end_alpha );
+
+/// @brief Create a raw model asset for each mesh of a model file, named after the mesh.
+/// @note The meshes are copied out of the mesh cache so that they can be read on the CPU. Use load_model_file to
+///     draw them, it uploads from the cache without the copy.
 extern void parse_model_file( const std::string& file_path );
 }
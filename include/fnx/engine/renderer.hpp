@@ -20,7 +20,10 @@ class renderer
 {
 public:
 
-    /// @brief Render the current model with the provided transformation.
+    /// @brief Render the current model with the provided transformation, once a shader, camera and material handle
+    ///     have been applied.
+    /// @note Models whose bounds are outside the view of the current camera are skipped. Models with levels of
+    ///     detail draw the least detailed one whose error on screen stays under the LOD threshold.
     void draw_current( const fnx::matrix4x4& transform );
     /// @brief Render the current model assuming the shader and material have been applied.
     void draw_current();
@@ -33,6 +36,31 @@ public:
     void apply_fog( const vector4& color, float density, float gradient ) const;
     void apply_lights( const vector3& gamma, const std::vector<material>& lights ) const;
 
+    /// @brief Planes of the current camera, updated by apply_camera().
+    const fnx::frustum& get_frustum() const
+    {
+        return _frustum;
+    }
+    /// @brief Return false when the current model placed with transform is outside the view of the current camera.
+    bool is_visible( const fnx::matrix4x4& transform ) const;
+    /// @brief Indices of the world space bounds that the current camera may see.
+    /// @param[out] visible : replaced by the indices, keep it between frames to reuse its memory
+    size_t cull( fnx::span<const reactphysics3d::AABB> world_bounds, std::vector<uint32_t>& visible ) const;
+
+    /// @brief Largest error of a level of detail on screen, as a fraction of the screen height.
+    void set_lod_threshold( fnx::decimal threshold )
+    {
+        _lod_threshold = threshold;
+    }
+    fnx::decimal get_lod_threshold() const
+    {
+        return _lod_threshold;
+    }
+    /// @brief Size on screen of one object space unit of the current model placed with transform, as a fraction of
+    ///     the screen height.
+    /// @note Measured at the point of its bounds closest to the camera, very large when the camera is inside them.
+    fnx::decimal get_lod_scale( const fnx::matrix4x4& transform ) const;
+
     //static void draw(camera_handle camera, const fnx::renderable& renderable, const fnx::matrix4x4& transform);
     static void apply_transformation( shader_handle shader, const matrix4x4& transform );
     static void apply_camera( shader_handle shader, camera_handle camera );
@@ -108,7 +136,9 @@ private:
     model_handle _model{};
     material_handle _material{};
     camera_handle _camera{};
-    //frustrum _frustrum{};
+    fnx::frustum _frustum{};
+    uint64_t _frustum_version{ 0u };
+    fnx::decimal _lod_threshold{ 1.f / 1080.f };	/// a pixel at 1080p
     int32_t _current_texture_index{ 0 };
 
     uint32_t _depth_map_fbo{ 0u };
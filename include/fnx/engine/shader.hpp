@@ -93,6 +93,14 @@ public:
     void set_uniform( const char* uniform_name, const fnx::vector3& val ) const;
     void set_uniform( const char* uniform_name, const fnx::vector4& val ) const;
     void set_uniform( const char* uniform_name, const fnx::matrix4x4& val ) const;
+    void set_uniform( fnx::string_id uniform_name, int val ) const;
+    void set_uniform( fnx::string_id uniform_name, unsigned int val ) const;
+    void set_uniform( fnx::string_id uniform_name, float val ) const;
+    void set_uniform( fnx::string_id uniform_name, double val ) const;
+    void set_uniform( fnx::string_id uniform_name, const fnx::vector2& val ) const;
+    void set_uniform( fnx::string_id uniform_name, const fnx::vector3& val ) const;
+    void set_uniform( fnx::string_id uniform_name, const fnx::vector4& val ) const;
+    void set_uniform( fnx::string_id uniform_name, const fnx::matrix4x4& val ) const;
     void set_uniform( const char* uniform_name, unsigned int index, int value ) const;
     void set_uniform( const char* uniform_name, unsigned int index, float value ) const;
     void set_uniform( const char* uniform_name, unsigned int index, int x, int y ) const;
@@ -120,11 +128,24 @@ public:
     void set_uniform( const char* uniform_name, const char* member, unsigned int index, const fnx::vector3& value ) const;
     void set_uniform( const char* uniform_name, const char* member, unsigned int index, const fnx::vector4& value ) const;
 
+    /// @brief Version of the camera whose uniforms were last uploaded to this shader, see camera::get_version().
+    /// @note Set it to 0 after setting the camera uniforms by hand so the next renderer::apply_camera uploads them.
+    uint64_t get_camera_version() const
+    {
+        return _camera_version;
+    }
+    void set_camera_version( uint64_t version ) const
+    {
+        _camera_version = version;
+    }
+
 private:
     shader_impl* _impl{ nullptr };
+    mutable uint64_t _camera_version{ 0u };
 
     void init( const std::string& vert, const std::string& frag );
     void add_all_uniforms( const std::string& source );
+    void add_active_uniforms();
 };
 
 using shader_handle = fnx::asset_handle<fnx::shader>;
@@ -31,6 +31,8 @@ public:
         float _mip_bias{ -.4f };
         unsigned char _rows{ 1 };
         unsigned char _cols{ 1 };
+        fnx::image_options _image_options{};	/// preparation of the image by get_async(), mips only with _enable_mip
+        fnx::block_format _compression{ fnx::block_format::none };	/// format of the GPU copy, read from a texture_cache
     };
 
     texture( const std::string& file_path );
@@ -40,12 +42,26 @@ public:
              fnx::format format, fnx::format internal_format, fnx::filter filter,
              fnx::attachment attachment, bool clamp, bool enable_mip_mapping, float mip_bias, unsigned char rows,
              unsigned char cols );
+    /// @brief Create a texture from an image decoded beforehand, such as on a worker thread.
+    texture( const std::string& file_path, fnx::raw_image&& image );
+    /// @brief Create a texture from an image decoded beforehand with the channels of config.
+    texture( const std::string& file_path, fnx::raw_image&& image, const fnx::texture::config& config );
     texture( unsigned int width, unsigned int height, unsigned int channels,
              fnx::format format, fnx::format internal_format, fnx::filter filter,
              fnx::attachment attachment, bool clamp, bool enable_mip_mapping, float mip_bias, unsigned char rows,
              unsigned char cols );
     ~texture();
 
+    /// @brief Return the number of bytes held by the image and its GPU copy including mip levels.
+    size_t get_memory_usage() const override;
+
+    /// @brief Return true once the pixels are on the GPU.
+    /// @note Textures that are not render targets are uploaded by the upload_queue, until then they sample as black.
+    bool is_resident() const
+    {
+        return nullptr == _upload || _upload->is_done();
+    }
+
     /// @brief Return with width of the texture in pixels.
     inline auto width() const
     {
@@ -95,8 +111,31 @@ public:
     void pixel( unsigned int row, unsigned int col, char& r, char& g, char& b, char& a ) const;
 
     /// @brief Bind the current texture to the context.
+    /// @note Binding the texture already bound to the unit is skipped.
     void bind( unsigned int unit ) const;
 
+    /// @brief Bind a 2D texture created without texture, such as a render target of the renderer.
+    /// @note Use it instead of glBindTexture so the units known to bind() stay up to date.
+    static void bind_external( unsigned int unit, unsigned int texture_id );
+
+    /// @brief Replace the pixels of a region, for textures filled at runtime like texture_atlas pages.
+    /// @param[in] pixels : width by height pixels with the channels of the texture
+    /// @note The region is sent to the GPU right away once the texture is resident, until then the queued upload
+    ///     sends it with the rest of the image.
+    void write_pixels( uint32_t x, uint32_t y, uint32_t width, uint32_t height, const unsigned char* pixels );
+
+    /// @brief Texture binds since the last reset_bind_stats().
+    struct bind_stats
+    {
+        size_t binds{ 0u };	/// done
+        size_t skipped{ 0u };	/// the texture was already bound to the unit
+    };
+
+    static const bind_stats& get_bind_stats();
+
+    /// @brief Start counting binds again, such as at the start of each frame.
+    static void reset_bind_stats();
+
     /// @brief Tell the target to accept subsequent opengl calls.
     void set_render_target();
 
@@ -115,8 +154,50 @@ private:
     unsigned int _tile_height{ 0u };
 
     impl* _impl{ nullptr };
+    std::shared_ptr<fnx::gpu_upload> _upload;	/// pending upload of the pixels
+
     void init();
+    void upload();
+
+    /// @brief Return the number of bytes of the image on the GPU including mip levels.
+    size_t get_upload_bytes() const;
 };
 
 using texture_handle = fnx::asset_handle<fnx::texture>;
+
+template<>
+/// @brief Textures are decoded and prepared on a worker thread and uploaded on the main thread.
+struct asset_staging<fnx::texture>
+{
+    using staged = fnx::raw_image;
+
+    static staged read( const std::string& file_path )
+    {
+        return fnx::raw_image( file_path, 4 );
+    }
+
+    static staged read( const std::string& file_path, const fnx::texture::config& config )
+    {
+        auto options = config._image_options;
+        options.mips = options.mips && config._enable_mip;
+        if ( config._compression != fnx::block_format::none )
+        {
+            return fnx::load_compressed_image( file_path, config._channels, options, config._compression );
+        }
+        fnx::raw_image image( file_path, static_cast<int32_t>( config._channels ) );
+        fnx::prepare_image( image, options );
+        return image;
+    }
+
+    static fnx::texture_handle create( const std::string& file_path, staged&& image )
+    {
+        return fnx::make_shared_ref<fnx::texture>( file_path, std::move( image ) );
+    }
+
+    static fnx::texture_handle create( const std::string& file_path, staged&& image,
+                                       const fnx::texture::config& config )
+    {
+        return fnx::make_shared_ref<fnx::texture>( file_path, std::move( image ), config );
+    }
+};
 }
\ No newline at end of file
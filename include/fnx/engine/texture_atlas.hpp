@@ -0,0 +1,199 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace fnx
+{
+/// @brief Rectangle in pixels, from its top left corner.
+struct packed_rect
+{
+    uint32_t x{ 0u };
+    uint32_t y{ 0u };
+    uint32_t width{ 0u };
+    uint32_t height{ 0u };
+};
+
+/// @brief Packs rectangles into a page with the MaxRects algorithm and frees them again.
+/// @note The free space is kept as the list of the largest free rectangles, which may overlap. Rectangles go to the
+///     free rectangle they fit best by their shorter leftover side. Freed rectangles are merged with free neighbours
+///     of the same edge, the page is only free of fragments again once it is empty.
+class rect_packer
+{
+public:
+    rect_packer() = default;
+    rect_packer( uint32_t width, uint32_t height );
+
+    /// @brief Place a rectangle of width by height pixels.
+    /// @return false if it does not fit in any free rectangle
+    bool insert( uint32_t width, uint32_t height, fnx::packed_rect& rect );
+
+    /// @brief Return a rectangle given by insert() to the free space.
+    void free( const fnx::packed_rect& rect );
+
+    /// @brief Free every rectangle.
+    void clear();
+
+    /// @brief Return the fraction of the page covered by rectangles.
+    float get_occupancy() const
+    {
+        return _width > 0u && _height > 0u ? static_cast<float>( _used_area ) / ( static_cast<float>( _width ) * _height ) :
+               0.f;
+    }
+
+    const std::vector<fnx::packed_rect>& get_free_rects() const
+    {
+        return _free;
+    }
+
+private:
+    std::vector<fnx::packed_rect> _free;
+    uint32_t _width{ 0u };
+    uint32_t _height{ 0u };
+    size_t _used_area{ 0u };
+
+    void split( const fnx::packed_rect& used );
+    void merge();
+    void prune( size_t first_new = 0u );
+};
+
+/// @brief Part of an atlas page that holds one image.
+class atlas_region
+{
+public:
+    /// @brief Return the page texture that holds the image.
+    const fnx::texture_handle& get_texture() const
+    {
+        return _texture;
+    }
+
+    /// @brief Return the texture coordinate of the top left corner of the image in its page.
+    const fnx::vector2& get_uv_offset() const
+    {
+        return _uv_offset;
+    }
+
+    /// @brief Return the size of the image in texture coordinates of its page.
+    const fnx::vector2& get_uv_scale() const
+    {
+        return _uv_scale;
+    }
+
+    uint32_t width() const
+    {
+        return _rect.width - 2u * _padding;
+    }
+
+    uint32_t height() const
+    {
+        return _rect.height - 2u * _padding;
+    }
+
+    uint32_t get_page() const
+    {
+        return _page;
+    }
+
+    /// @brief Return the texture coordinate of a tile when the image is a map of rows by cols tiles, like
+    ///     texture::calc_atlas_offset() does in pixels.
+    fnx::vector2 calc_atlas_offset( unsigned char index, unsigned char rows, unsigned char cols ) const;
+
+private:
+    friend class texture_atlas;
+
+    fnx::texture_handle _texture;
+    fnx::packed_rect _rect;	/// includes the padding
+    fnx::vector2 _uv_offset{ 0.f, 0.f };
+    fnx::vector2 _uv_scale{ 0.f, 0.f };
+    uint32_t _padding{ 0u };
+    uint32_t _page{ 0u };
+    uint64_t _last_used{ 0u };
+};
+
+/// @brief Layout of a texture_atlas.
+struct atlas_config
+{
+    uint32_t page_size{ 2048u };	/// width and height of each page
+    uint32_t padding{ 2u };	/// pixels around each image filled with its edge pixels, so that filtering does not bleed
+    uint32_t max_region_size{ 256u };	/// larger images keep their own texture
+    uint32_t max_pages{ 4u };
+};
+
+/// @brief Packs small images such as UI icons into shared page textures so that they are drawn without a texture
+///     bind each.
+/// @usage auto [atlas, _] = singleton<texture_atlas>::acquire(); auto region = atlas.get( "icon.png" ); on the main thread
+/// @note Pages are RGBA, clamped, linearly filtered and have no mips. A region is in use while a handle to it is held
+///     outside the atlas. Regions that are not in use stay packed until their space is needed, the least recently used
+///     ones are evicted first.
+class texture_atlas
+{
+public:
+    texture_atlas() = default;
+    explicit texture_atlas( const fnx::atlas_config& config )
+        : _config( config )
+    {
+    }
+
+    /// @brief Return the region of an image file, loaded and packed on the first request.
+    /// @return nullptr if the image cannot be loaded, is larger than max_region_size, or the pages are full of regions
+    ///     in use
+    std::shared_ptr<fnx::atlas_region> get( const std::string& file_path );
+
+    /// @brief Pack RGBA pixels as the region of name, replacing the region that had that name.
+    /// @note A replaced region that is still in use keeps its pixels until its last handle is released.
+    std::shared_ptr<fnx::atlas_region> add( const std::string& name, const unsigned char* pixels, uint32_t width,
+                                            uint32_t height );
+
+    /// @brief Free every region that is not in use, replaced ones included.
+    /// @return number of regions freed
+    size_t evict_unused();
+
+    size_t get_num_pages() const
+    {
+        return _pages.size();
+    }
+
+    size_t get_num_regions() const
+    {
+        return _regions.size();
+    }
+
+    /// @brief Return the fraction of a page covered by regions, padding included.
+    float get_occupancy( size_t page ) const
+    {
+        return page < _pages.size() ? _pages[page].packer.get_occupancy() : 0.f;
+    }
+
+    const fnx::atlas_config& get_config() const
+    {
+        return _config;
+    }
+
+private:
+    struct page
+    {
+        fnx::rect_packer packer;
+        fnx::texture_handle texture;
+    };
+
+    fnx::atlas_config _config;
+    std::vector<page> _pages;
+    std::unordered_map<std::string, std::shared_ptr<fnx::atlas_region>> _regions;
+    std::unordered_set<std::string> _unpacked;	/// images that keep their own texture
+    std::vector<std::shared_ptr<fnx::atlas_region>> _replaced;	/// regions replaced by add() while in use
+    uint64_t _tick{ 0u };
+
+    texture_atlas( const texture_atlas& other ) = delete;
+    texture_atlas& operator=( const texture_atlas& other ) = delete;
+
+    /// @brief Place a rectangle in a page, evicting regions not in use when no page has room.
+    bool place( uint32_t width, uint32_t height, fnx::packed_rect& rect, uint32_t& page_index );
+    void remove( const fnx::atlas_region& region );
+
+    /// @brief Free the replaced regions whose last handle was released.
+    /// @return number of regions freed
+    size_t free_replaced();
+};
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace fnx
+{
+/// @brief Versioned binary copy of an image compressed to a block format with its mips, loaded without decoding.
+/// @note The file holds a header and a level table, then the blocks of each level aligned to 16 bytes.
+struct texture_cache
+{
+    static constexpr uint32_t format_version = 1u;
+    static constexpr uint32_t encoder_version = 1u;	/// bump when prepare_image() or compress_blocks() output changes
+
+    /// @brief Return the hash of the settings that change the content of a cache.
+    static uint64_t get_settings_key( uint32_t channels, const fnx::image_options& options, fnx::block_format format );
+
+    /// @brief Return the key of a cache, the hash of the image file and of everything that changes its content.
+    static uint64_t get_key( const char* data, size_t size, uint32_t channels, const fnx::image_options& options,
+                             fnx::block_format format );
+
+    /// @brief Return the content of a cache file for a compressed image.
+    static std::vector<char> serialize( uint64_t key, const fnx::raw_image& image );
+
+    /// @brief Read the compressed image of a cache.
+    /// @return false if the cache was written for another key, by another version, or if it is damaged
+    static bool read( const char* data, size_t size, uint64_t key, fnx::raw_image& image );
+};
+
+/// @brief Path of the cache written next to an image file for a block format and options.
+/// @note The name holds a short hash of the settings, so each configuration of an image keeps its own cache.
+extern std::string get_texture_cache_path( const std::string& image_path, uint32_t channels,
+        const fnx::image_options& options, fnx::block_format format );
+
+/// @brief Load an image prepared with options and compressed to format from its cache.
+/// @note The image file is decoded, prepared, compressed and its cache rewritten when the cache is missing or out of
+///     date, the memory saved and the PSNR are logged. The image file is still read to hash its content.
+/// @return an image that is not ok if the image file cannot be loaded
+extern fnx::raw_image load_compressed_image( const std::string& image_path, uint32_t channels,
+        const fnx::image_options& options, fnx::block_format format );
+}
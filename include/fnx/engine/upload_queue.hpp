@@ -0,0 +1,156 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <memory>
+
+namespace fnx
+{
+/// @brief Order of the queued GPU uploads, visible uploads go first.
+enum class upload_priority
+{
+    background,
+    visible	/// the asset was bound for drawing while its upload waited
+};
+
+/// @brief GPU upload waiting in the upload_queue, owned by the asset that queued it.
+/// @note The queue only keeps a weak reference, so an asset released before its upload cancels it.
+class gpu_upload
+{
+public:
+    using upload_func = fnx::unique_inplace_function<void()>;
+
+    gpu_upload( size_t bytes, upload_func&& func, fnx::upload_priority priority )
+        : _func( std::move( func ) )
+        , _bytes( bytes )
+        , _priority( priority )
+    {
+    }
+
+    /// @brief Return the number of bytes sent to the GPU.
+    size_t get_bytes() const
+    {
+        return _bytes;
+    }
+
+    fnx::upload_priority get_priority() const
+    {
+        return _priority;
+    }
+
+    /// @brief Move the upload ahead of the background uploads once its asset is needed on screen.
+    void set_priority( fnx::upload_priority priority )
+    {
+        _priority = priority;
+    }
+
+    bool is_done() const
+    {
+        return _done;
+    }
+
+    /// @brief Send the data to the GPU, once.
+    void run()
+    {
+        if ( !_done )
+        {
+            _done = true;
+            _func();
+        }
+    }
+
+private:
+    upload_func _func;
+    size_t _bytes{ 0u };
+    fnx::upload_priority _priority{ fnx::upload_priority::background };
+    bool _done{ false };
+};
+
+/// @brief Statistics of the last upload_queue::update().
+struct upload_stats
+{
+    size_t uploads{ 0u };	/// uploads sent to the GPU
+    size_t bytes{ 0u };	/// bytes sent to the GPU
+    std::chrono::microseconds stall{ 0 };	/// time the frame waited on the uploads
+    size_t depth{ 0u };	/// uploads left in the queue
+    size_t queued_bytes{ 0u };	/// bytes left in the queue
+};
+
+/// @brief Defers texture and vertex buffer uploads so that they are spread over frames within a byte and time budget
+///     instead of stalling the frame in which their asset is created.
+/// @usage auto [uploads, _] = singleton<upload_queue>::acquire(); uploads.update(); once per frame on the main thread
+/// @note The queue does not call the GPU itself, the uploads do, so it runs the same without a GPU context.
+class upload_queue
+{
+public:
+    upload_queue() = default;
+
+    /// @brief Queue an upload of bytes done by func on the main thread.
+    /// @return the upload, the caller keeps it for as long as func may run
+    std::shared_ptr<fnx::gpu_upload> push( size_t bytes, fnx::gpu_upload::upload_func&& func,
+                                           fnx::upload_priority priority = fnx::upload_priority::background );
+
+    /// @brief Run the queued uploads, visible ones first, until the byte or time budget is spent.
+    /// @note One upload runs per call even when it is larger than the budget, so uploading always progresses.
+    const fnx::upload_stats& update( size_t byte_budget, std::chrono::microseconds time_budget );
+
+    /// @brief Run the queued uploads within the budgets set with set_byte_budget() and set_time_budget().
+    const fnx::upload_stats& update()
+    {
+        return update( _byte_budget, _time_budget );
+    }
+
+    /// @brief Run every queued upload, for loading screens.
+    const fnx::upload_stats& flush();
+
+    /// @brief Set the number of bytes update() may send to the GPU each frame.
+    void set_byte_budget( size_t bytes )
+    {
+        _byte_budget = bytes;
+    }
+
+    size_t get_byte_budget() const
+    {
+        return _byte_budget;
+    }
+
+    /// @brief Set the time update() may spend uploading each frame.
+    void set_time_budget( std::chrono::microseconds budget )
+    {
+        _time_budget = budget;
+    }
+
+    std::chrono::microseconds get_time_budget() const
+    {
+        return _time_budget;
+    }
+
+    /// @brief Return the statistics of the last update().
+    const fnx::upload_stats& get_stats() const
+    {
+        return _stats;
+    }
+
+    /// @brief Return the number of uploads waiting, including uploads of released assets not skipped yet.
+    size_t get_queue_depth() const
+    {
+        return _uploads.size();
+    }
+
+    /// @brief Return the total time update() and flush() waited on uploads.
+    std::chrono::microseconds get_total_stall() const
+    {
+        return _total_stall;
+    }
+
+private:
+    std::deque<std::weak_ptr<fnx::gpu_upload>> _uploads;
+    fnx::upload_stats _stats;
+    size_t _byte_budget{ 4u * 1024u * 1024u };
+    std::chrono::microseconds _time_budget{ 2000 };
+    std::chrono::microseconds _total_stall{ 0 };
+
+    upload_queue( const upload_queue& other ) = delete;
+    upload_queue& operator=( const upload_queue& other ) = delete;
+};
+}
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace fnx
+{
+/// @brief How one vertex attribute is stored for the GPU.
+enum class vertex_format : uint8_t
+{
+    float32,            /// unchanged 32 bit floats
+    half,               /// 16 bit floats
+    unorm16,            /// 16 bits in [0, 1], positions are normalized within the bounds of the mesh
+    unorm8,             /// 8 bits in [0, 1], meant for colors
+    snorm16_octahedral, /// normals as two 16 bit octahedral components, the shader decodes them
+    snorm_10_10_10_2    /// normals as 10 bits per axis in a single word, decoded by the GPU
+};
+
+/// @brief Storage of each attribute of a vertex.
+struct vertex_layout
+{
+    vertex_format position{ vertex_format::float32 };
+    vertex_format uv{ vertex_format::float32 };
+    vertex_format normal{ vertex_format::float32 };
+    vertex_format color{ vertex_format::float32 };
+
+    /// @brief 20 bytes per vertex instead of 48, uvs must be in [0, 1], use half uvs for tiled textures.
+    static vertex_layout compact()
+    {
+        return { vertex_format::unorm16, vertex_format::unorm16, vertex_format::snorm_10_10_10_2, vertex_format::unorm8 };
+    }
+
+    /// @brief Return false when the format cannot hold the attribute with the given number of components.
+    static bool is_supported( vertex_format format, uint32_t components )
+    {
+        switch ( format )
+        {
+            case vertex_format::snorm16_octahedral:
+            case vertex_format::snorm_10_10_10_2:
+                return components == 3u;
+            default:
+                return true;
+        }
+    }
+};
+
+/// @brief Where an attribute lives inside a packed vertex.
+struct vertex_attribute
+{
+    vertex_format format{ vertex_format::float32 };
+    uint32_t components{ 0u };  /// values read by the GPU, 0 when the vertices do not have the attribute
+    uint32_t offset{ 0u };      /// bytes from the start of the vertex
+
+    bool is_enabled() const
+    {
+        return components != 0u;
+    }
+
+    /// @brief Return true when the GPU reads the values as integers normalized to [0, 1] or [-1, 1].
+    bool is_normalized() const
+    {
+        return format != vertex_format::float32 && format != vertex_format::half;
+    }
+};
+
+/// @brief Interleaved vertices in the formats of a vertex_layout.
+struct packed_vertices
+{
+    std::vector<uint8_t> data;
+    uint32_t stride{ 0u };
+    uint32_t num_vertices{ 0u };
+    vertex_attribute position;
+    vertex_attribute uv;
+    vertex_attribute normal;
+    vertex_attribute color;
+    /// @brief Object space position = position_scale * stored position + position_offset, fold it into the
+    ///     model matrix when positions are unorm16.
+    float position_offset[3]{ 0.f, 0.f, 0.f };
+    float position_scale[3]{ 1.f, 1.f, 1.f };
+};
+
+namespace detail
+{
+/// @brief Components and bytes of an attribute with count values in a format, three values are padded to four so
+///     that every attribute stays aligned to 4 bytes.
+inline vertex_attribute layout_attribute( vertex_format format, uint32_t count, uint32_t& offset )
+{
+    vertex_attribute attribute;
+    attribute.format = format;
+    attribute.offset = offset;
+    switch ( format )
+    {
+        case vertex_format::float32:
+            attribute.components = count;
+            offset += count * 4u;
+            break;
+        case vertex_format::half:
+        case vertex_format::unorm16:
+            attribute.components = count == 3u ? 4u : count;
+            offset += attribute.components * 2u;
+            break;
+        case vertex_format::unorm8:
+            attribute.components = count == 3u ? 4u : count;
+            offset += ( attribute.components + 3u ) & ~3u;
+            break;
+        case vertex_format::snorm16_octahedral:
+            attribute.components = 2u;
+            offset += 4u;
+            break;
+        case vertex_format::snorm_10_10_10_2:
+            attribute.components = 4u;
+            offset += 4u;
+            break;
+    }
+    return attribute;
+}
+
+/// @brief Store count values, padding to the components of the attribute with 1 so positions get w = 1.
+inline void pack_attribute( const vertex_attribute& attribute, const float* in, uint32_t count, uint8_t* out )
+{
+    float values[4] = { 1.f, 1.f, 1.f, 1.f };
+    for ( uint32_t i = 0; i < count; i++ )
+    {
+        values[i] = in[i];
+    }
+    switch ( attribute.format )
+    {
+        case vertex_format::float32:
+            std::memcpy( out, values, count * sizeof( float ) );
+            break;
+        case vertex_format::half:
+        {
+            uint16_t packed[4];
+            for ( uint32_t i = 0; i < attribute.components; i++ )
+            {
+                packed[i] = fnx::quantize::to_half( values[i] );
+            }
+            std::memcpy( out, packed, attribute.components * sizeof( uint16_t ) );
+            break;
+        }
+        case vertex_format::unorm16:
+        {
+            uint16_t packed[4];
+            for ( uint32_t i = 0; i < attribute.components; i++ )
+            {
+                packed[i] = fnx::quantize::to_unorm16( values[i] );
+            }
+            std::memcpy( out, packed, attribute.components * sizeof( uint16_t ) );
+            break;
+        }
+        case vertex_format::unorm8:
+            for ( uint32_t i = 0; i < attribute.components; i++ )
+            {
+                out[i] = fnx::quantize::to_unorm8( values[i] );
+            }
+            break;
+        case vertex_format::snorm16_octahedral:
+        {
+            float uv[2];
+            fnx::quantize::to_octahedral( values[0], values[1], values[2], uv );
+            const int16_t packed[2] = { fnx::quantize::to_snorm16( uv[0] ), fnx::quantize::to_snorm16( uv[1] ) };
+            std::memcpy( out, packed, sizeof( packed ) );
+            break;
+        }
+        case vertex_format::snorm_10_10_10_2:
+        {
+            const float length = std::sqrt( values[0] * values[0] + values[1] * values[1] + values[2] * values[2] );
+            const float inv = length > 0.f ? 1.f / length : 0.f;
+            const uint32_t packed = fnx::quantize::to_snorm_10_10_10_2( values[0] * inv, values[1] * inv,
+                                    values[2] * inv, 0.f );
+            std::memcpy( out, &packed, sizeof( packed ) );
+            break;
+        }
+    }
+}
+}
+
+/// @brief Convert interleaved float vertices to the formats of layout.
+/// @param[in] vertices : position xyz, then uv, normal xyz and color rgba when present, as in raw_model
+/// @param[in] min, max : bounds of the positions, used when positions are unorm16
+inline packed_vertices pack_vertices( const float* vertices, size_t num_vertices, bool has_uv, bool has_normal,
+                                      bool has_color, const vertex_layout& layout, const float* min, const float* max )
+{
+    assert( vertex_layout::is_supported( layout.position, 3u ) && vertex_layout::is_supported( layout.uv, 2u ) &&
+            vertex_layout::is_supported( layout.color, 4u ) );
+    packed_vertices packed;
+    uint32_t offset = 0u;
+    packed.position = detail::layout_attribute( layout.position, 3u, offset );
+    if ( has_uv )
+    {
+        packed.uv = detail::layout_attribute( layout.uv, 2u, offset );
+    }
+    if ( has_normal )
+    {
+        packed.normal = detail::layout_attribute( layout.normal, 3u, offset );
+    }
+    if ( has_color )
+    {
+        packed.color = detail::layout_attribute( layout.color, 4u, offset );
+    }
+    packed.stride = offset;
+    packed.num_vertices = static_cast<uint32_t>( num_vertices );
+    packed.data.resize( num_vertices * packed.stride );
+
+    float scale[3] = { 1.f, 1.f, 1.f };
+    if ( layout.position == vertex_format::unorm16 )
+    {
+        for ( size_t k = 0; k < 3; k++ )
+        {
+            const float extent = max[k] - min[k];
+            packed.position_offset[k] = min[k];
+            packed.position_scale[k] = extent;
+            scale[k] = extent > 0.f ? 1.f / extent : 0.f;
+        }
+    }
+
+    const uint32_t in_stride = 3u + ( has_uv ? 2u : 0u ) + ( has_normal ? 3u : 0u ) + ( has_color ? 4u : 0u );
+    for ( size_t i = 0; i < num_vertices; i++, vertices += in_stride )
+    {
+        uint8_t* out = packed.data.data() + i * packed.stride;
+        const float position[3] =
+        {
+            ( vertices[0] - packed.position_offset[0] ) * scale[0],
+            ( vertices[1] - packed.position_offset[1] ) * scale[1],
+            ( vertices[2] - packed.position_offset[2] ) * scale[2]
+        };
+        detail::pack_attribute( packed.position, position, 3u, out + packed.position.offset );
+        const float* attribute = vertices + 3;
+        if ( has_uv )
+        {
+            detail::pack_attribute( packed.uv, attribute, 2u, out + packed.uv.offset );
+            attribute += 2;
+        }
+        if ( has_normal )
+        {
+            detail::pack_attribute( packed.normal, attribute, 3u, out + packed.normal.offset );
+            attribute += 3;
+        }
+        if ( has_color )
+        {
+            detail::pack_attribute( packed.color, attribute, 4u, out + packed.color.offset );
+        }
+    }
+    return packed;
+}
+}
@@ -36,25 +36,39 @@ using decimal = reactphysics3d::decimal;
 #include "containers/ring_buffer.hpp"
 #include "containers/unordered_vector.hpp"
 #include "containers/bitset.hpp"
+#include "containers/flat_map.hpp"
+#include "containers/span.hpp"
 
 #include "memory/heap_allocator.hpp"
 #include "memory/heap_indexed_pool.hpp"
 #include "memory/function_ref.hpp"
+#include "memory/inplace_function.hpp"
 #include "memory/reference_ptr.hpp"
 
 #include "core/id_manager.hpp"
+#include "core/string_id.hpp"
+#include "core/hash.hpp"
 #include "core/tween.hpp"
 #include "core/singleton.hpp"
 #include "core/async.hpp"
 #include "core/alignment.hpp"
 #include "core/byte_stream.hpp"
+#include "core/mapped_file.hpp"
+#include "core/lz4.hpp"
+#include "core/file_system.hpp"
+#include "core/cache_file.hpp"
 #include "core/serializer.hpp"
 
+#include "math/simd.hpp"
+#include "math/rng.hpp"
 #include "math/math.hpp"
 #include "math/angle.hpp"
 #include "math/matrix4x4.hpp"
 #include "math/vector4.hpp"
 #include "math/rect.hpp"
+#include "math/transform.hpp"
+#include "math/frustum.hpp"
+#include "math/quantize.hpp"
 
 #include "engine/colors.hpp"
 #include "engine/constants.hpp"
@@ -65,17 +79,28 @@ using decimal = reactphysics3d::decimal;
 #include "engine/keys.hpp"
 #include "engine/engine_events.hpp"
 #include "engine/asset.hpp"
+#include "engine/asset_loader.hpp"
+#include "engine/upload_queue.hpp"
 #include "engine/asset_manager.hpp"
 #include "engine/sound.hpp"
 #include "engine/audio_manager.hpp"
 #include "engine/display_mode.hpp"
 #include "engine/window.hpp"
 #include "engine/shader.hpp"
+#include "engine/block_compression.hpp"
 #include "engine/raw_image.hpp"
+#include "engine/image_processing.hpp"
+#include "engine/texture_cache.hpp"
 #include "engine/texture.hpp"
+#include "engine/texture_atlas.hpp"
 #include "engine/material_map.hpp"
 #include "engine/material.hpp"
+#include "engine/vertex_format.hpp"
+#include "engine/mesh_optimizer.hpp"
 #include "engine/raw_model.hpp"
+#include "engine/obj_parser.hpp"
+#include "engine/mesh_cache.hpp"
+#include "engine/material_cache.hpp"
 #include "engine/model.hpp"
 #include "engine/lights.hpp"
 #include "engine/font.hpp"
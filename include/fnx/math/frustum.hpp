@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace fnx
+{
+/// @brief The six planes that bound what a camera can see.
+/// @note Each plane is ( nx, ny, nz, d ) with a unit normal pointing inside, a point p is in front of the plane
+///     when n.p + d >= 0. A default constructed frustum contains everything.
+struct frustum
+{
+public:
+    static constexpr size_t plane_count = 6u;
+
+    frustum() = default;
+
+    /// @brief Planes of the clip space volume of clip = matrix * ( p, 1 ).
+    /// @param[in] clip : row major view projection in the convention of matrix4x4 and transform_points
+    explicit frustum( const fnx::matrix4x4& clip )
+    {
+        // Gribb and Hartmann, each plane is the last row plus or minus one of the others
+        const auto* m = clip.data();
+        for ( size_t i = 0; i < plane_count; i++ )
+        {
+            const auto* row = m + ( i / 2 ) * 4;
+            const decimal sign = i % 2 ? decimal{ -1 } : decimal{ 1 };
+            auto& plane = _planes[i];
+            plane = fnx::vector4( m[12] + sign * row[0], m[13] + sign * row[1], m[14] + sign * row[2], m[15] + sign * row[3] );
+            const auto length = std::sqrt( plane.x * plane.x + plane.y * plane.y + plane.z * plane.z );
+            if ( length > decimal{ 0 } )
+            {
+                plane = fnx::vector4( plane.x / length, plane.y / length, plane.z / length, plane.w / length );
+            }
+        }
+    }
+
+    /// @brief Planes of a camera.
+    /// @param[in] view_projection : camera::get_view_projection_matrix(), laid out in OpenGL column order like the
+    ///     other camera matrices
+    static frustum from_view_projection( const fnx::matrix4x4& view_projection )
+    {
+        return frustum( fnx::matrix_transpose( view_projection ) );
+    }
+
+    /// @brief Left, right, bottom, top, near then far.
+    const fnx::vector4& get_plane( size_t index ) const
+    {
+        return _planes[index];
+    }
+
+    /// @brief The planes as 24 contiguous values.
+    const decimal* data() const
+    {
+        return &_planes[0].x;
+    }
+
+    bool contains( const fnx::vector3& point ) const
+    {
+        for ( const auto& plane : _planes )
+        {
+            if ( plane.x * point.x + plane.y * point.y + plane.z * point.z + plane.w < decimal{ 0 } )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief True unless the box is entirely behind one of the planes.
+    /// @note Boxes near a corner of the frustum may pass while being outside, which is fine for culling.
+    bool intersects( const reactphysics3d::AABB& aabb ) const
+    {
+        uint32_t visible;
+        return fnx::simd::scalar::cull_aabbs( data(), &aabb.getMin().x, 1u, &visible ) == 1u;
+    }
+
+    /// @brief True unless the box placed with transform is entirely behind one of the planes.
+    /// @param[in] aabb : object space bounds, such as model::get_bounds()
+    /// @param[in] transform : row major object to world transform, like transform_aabbs
+    bool intersects( const reactphysics3d::AABB& aabb, const fnx::matrix4x4& transform ) const
+    {
+        reactphysics3d::AABB world_bounds;
+        fnx::transform_aabbs( transform, fnx::span<const reactphysics3d::AABB>( &aabb, 1u ),
+                              fnx::span<reactphysics3d::AABB>( &world_bounds, 1u ) );
+        return intersects( world_bounds );
+    }
+
+    /// @brief True unless the sphere is entirely behind one of the planes.
+    bool intersects( const fnx::vector3& center, decimal radius ) const
+    {
+        const decimal sphere[4] = { center.x, center.y, center.z, radius };
+        uint32_t visible;
+        return fnx::simd::scalar::cull_spheres( data(), sphere, 1u, &visible ) == 1u;
+    }
+
+private:
+    fnx::vector4 _planes[plane_count]{ { 0, 0, 0, 1 }, { 0, 0, 0, 1 }, { 0, 0, 0, 1 }, { 0, 0, 0, 1 }, { 0, 0, 0, 1 }, { 0, 0, 0, 1 } };
+};
+
+static_assert( sizeof( fnx::vector4 ) == 4 * sizeof( fnx::decimal ), "frustum planes are read as packed values" );
+
+/// @brief Indices of the boxes that may be visible, several boxes per instruction.
+/// @param[in] bounds : world space boxes
+/// @param[out] visible : must hold at least bounds.size() indices, the indices are written in increasing order
+/// @return number of indices written
+inline size_t cull_aabbs( const fnx::frustum& frustum, fnx::span<const reactphysics3d::AABB> bounds,
+                          fnx::span<uint32_t> visible )
+{
+    assert( visible.size() >= bounds.size() );
+    return fnx::simd::cull_aabbs( frustum.data(), reinterpret_cast<const fnx::decimal*>( bounds.data() ), bounds.size(),
+                                  visible.data() );
+}
+
+/// @brief Indices of the boxes that may be visible.
+/// @param[out] visible : replaced by the indices of the visible boxes, keep it between frames to reuse its memory
+inline size_t cull_aabbs( const fnx::frustum& frustum, fnx::span<const reactphysics3d::AABB> bounds,
+                          std::vector<uint32_t>& visible )
+{
+    visible.resize( bounds.size() );
+    visible.resize( cull_aabbs( frustum, bounds, fnx::span<uint32_t>( visible ) ) );
+    return visible.size();
+}
+
+/// @brief Indices of the spheres that may be visible, several spheres per instruction.
+/// @param[in] spheres : world space spheres as center xyz then radius in w
+/// @param[out] visible : must hold at least spheres.size() indices, the indices are written in increasing order
+/// @return number of indices written
+inline size_t cull_spheres( const fnx::frustum& frustum, fnx::span<const fnx::vector4> spheres,
+                            fnx::span<uint32_t> visible )
+{
+    assert( visible.size() >= spheres.size() );
+    return fnx::simd::cull_spheres( frustum.data(), reinterpret_cast<const fnx::decimal*>( spheres.data() ), spheres.size(),
+                                    visible.data() );
+}
+
+/// @brief Indices of the spheres that may be visible.
+/// @param[out] visible : replaced by the indices of the visible spheres, keep it between frames to reuse its memory
+inline size_t cull_spheres( const fnx::frustum& frustum, fnx::span<const fnx::vector4> spheres,
+                            std::vector<uint32_t>& visible )
+{
+    visible.resize( spheres.size() );
+    visible.resize( cull_spheres( frustum, spheres, fnx::span<uint32_t>( visible ) ) );
+    return visible.size();
+}
+}
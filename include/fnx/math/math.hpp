@@ -1,8 +1,6 @@
 #pragma once
 
-#include <chrono>
 #include <type_traits>
-#include <random>
 
 namespace fnx
 {
@@ -15,12 +13,11 @@ static constexpr auto EPSILON = 0.0001;
 
 template<typename T>
 /// @brief Produce a random value between an upper and lower bound.
+/// @note Uses the generator of the calling thread, see fnx::rng for seeding and bulk generation.
 inline T random( T min, T max )
 {
-    auto seed = std::chrono::system_clock::now().time_since_epoch().count();
-    std::uniform_real_distribution<double> dist( min, max );
-    std::mt19937_64 rng( seed );
-    return static_cast<T>( dist( rng ) );
+    auto& engine = fnx::rng::thread_engine();
+    return static_cast<T>( fnx::rng::uniform( engine, static_cast<double>( min ), static_cast<double>( max ) ) );
 }
 
 template<typename T, typename U = double>
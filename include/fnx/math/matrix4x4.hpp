@@ -48,8 +48,9 @@ private :
     // -------------------- Attributes -------------------- //
 
     /// Rows of the matrix;
+    /// Aligned so that each row is a single vector load for the fnx::simd kernels.
     //Quaternion mRows[4];
-    decimal mRows[4][4];
+    FNX_SIMD_ALIGN decimal mRows[4][4];
 
 public :
 
@@ -179,6 +180,18 @@ public :
 
     /// Return the string representation
     std::string to_string() const;
+
+    /// Return the 16 values in row major order
+    RP3D_FORCE_INLINE const decimal* data() const
+    {
+        return &mRows[0][0];
+    }
+
+    /// Return the 16 values in row major order
+    RP3D_FORCE_INLINE decimal* data()
+    {
+        return &mRows[0][0];
+    }
 };
 
 // Constructor of the class matrix4x4
@@ -269,10 +282,9 @@ RP3D_FORCE_INLINE matrix4x4 matrix4x4::getTranspose() const
 {
 
     // Return the transpose matrix
-    return matrix4x4( mRows[0][0], mRows[1][0], mRows[2][0], mRows[3][0],
-                      mRows[0][1], mRows[1][1], mRows[2][1], mRows[3][1],
-                      mRows[0][2], mRows[1][2], mRows[2][2], mRows[3][2],
-                      mRows[0][3], mRows[1][3], mRows[2][3], mRows[3][3] );
+    matrix4x4 ret;
+    simd::mat4_transpose( data(), ret.data() );
+    return ret;
 }
 
 // Return the determinant of the matrix
@@ -443,66 +455,18 @@ RP3D_FORCE_INLINE matrix4x4 operator/( const matrix4x4& matrix, decimal nb )
 // Overloaded operator for matrix multiplication
 RP3D_FORCE_INLINE matrix4x4 operator*( const matrix4x4& matrix1, const matrix4x4& matrix2 )
 {
-    return matrix4x4( matrix1.mRows[0][0] * matrix2.mRows[0][0] + matrix1.mRows[0][1] * matrix2.mRows[1][0] + 
-                      matrix1.mRows[0][2] * matrix2.mRows[2][0] + matrix1.mRows[0][3] * matrix2.mRows[3][0],
-
-                      matrix1.mRows[0][0] * matrix2.mRows[0][1] + matrix1.mRows[0][1] * matrix2.mRows[1][1] + 
-                      matrix1.mRows[0][2] * matrix2.mRows[2][1] + matrix1.mRows[0][3] * matrix2.mRows[3][1],
-
-                      matrix1.mRows[0][0] * matrix2.mRows[0][2] + matrix1.mRows[0][1] * matrix2.mRows[1][2] + 
-                      matrix1.mRows[0][2] * matrix2.mRows[2][2] + matrix1.mRows[0][3] * matrix2.mRows[3][2],
-
-                      matrix1.mRows[0][0] * matrix2.mRows[0][3] + matrix1.mRows[0][1] * matrix2.mRows[1][3] +
-                      matrix1.mRows[0][2] * matrix2.mRows[2][3] + matrix1.mRows[0][3] * matrix2.mRows[3][3],
-
-                      matrix1.mRows[1][0] * matrix2.mRows[0][0] + matrix1.mRows[1][1] * matrix2.mRows[1][0] +
-                      matrix1.mRows[1][2] * matrix2.mRows[2][0] + matrix1.mRows[1][3] * matrix2.mRows[3][0],
-
-                      matrix1.mRows[1][0] * matrix2.mRows[0][1] + matrix1.mRows[1][1] * matrix2.mRows[1][1] + 
-                      matrix1.mRows[1][2] * matrix2.mRows[2][1] + matrix1.mRows[1][3] * matrix2.mRows[3][1],
-
-                      matrix1.mRows[1][0] * matrix2.mRows[0][2] + matrix1.mRows[1][1] * matrix2.mRows[1][2] + 
-                      matrix1.mRows[1][2] * matrix2.mRows[2][2] + matrix1.mRows[1][3] * matrix2.mRows[3][2],
-
-                      matrix1.mRows[1][0] * matrix2.mRows[0][3] + matrix1.mRows[1][1] * matrix2.mRows[1][3] + 
-                      matrix1.mRows[1][2] * matrix2.mRows[2][3] + matrix1.mRows[1][3] * matrix2.mRows[3][3],
-
-                      matrix1.mRows[2][0] * matrix2.mRows[0][0] + matrix1.mRows[2][1] * matrix2.mRows[1][0] + 
-                      matrix1.mRows[2][2] * matrix2.mRows[2][0] + matrix1.mRows[2][3] * matrix2.mRows[3][0],
-
-                      matrix1.mRows[2][0] * matrix2.mRows[0][1] + matrix1.mRows[2][1] * matrix2.mRows[1][1] + 
-                      matrix1.mRows[2][2] * matrix2.mRows[2][1] + matrix1.mRows[2][3] * matrix2.mRows[3][1],
-
-                      matrix1.mRows[2][0] * matrix2.mRows[0][2] + matrix1.mRows[2][1] * matrix2.mRows[1][2] + 
-                      matrix1.mRows[2][2] * matrix2.mRows[2][2] + matrix1.mRows[2][3] * matrix2.mRows[3][2],
-
-                      matrix1.mRows[2][0] * matrix2.mRows[0][3] + matrix1.mRows[2][1] * matrix2.mRows[1][3] + 
-                      matrix1.mRows[2][2] * matrix2.mRows[2][3] + matrix1.mRows[2][3] * matrix2.mRows[3][3],
-
-                      matrix1.mRows[3][0] * matrix2.mRows[0][0] + matrix1.mRows[3][1] * matrix2.mRows[1][0] + 
-                      matrix1.mRows[3][2] * matrix2.mRows[2][0] + matrix1.mRows[3][3] * matrix2.mRows[3][0],
-
-                      matrix1.mRows[3][0] * matrix2.mRows[0][1] + matrix1.mRows[3][1] * matrix2.mRows[1][1] + 
-                      matrix1.mRows[3][2] * matrix2.mRows[2][1] + matrix1.mRows[3][3] * matrix2.mRows[3][1],
-
-                      matrix1.mRows[3][0] * matrix2.mRows[0][2] + matrix1.mRows[3][1] * matrix2.mRows[1][2] + 
-                      matrix1.mRows[3][2] * matrix2.mRows[2][2] + matrix1.mRows[3][3] * matrix2.mRows[3][2],
-
-                      matrix1.mRows[3][0] * matrix2.mRows[0][3] + matrix1.mRows[3][1] * matrix2.mRows[1][3] + 
-                      matrix1.mRows[3][2] * matrix2.mRows[2][3] + matrix1.mRows[3][3] * matrix2.mRows[3][3] );
+    matrix4x4 ret;
+    simd::mat4_multiply( matrix1.data(), matrix2.data(), ret.data() );
+    return ret;
 }
 
 // Overloaded operator for multiplication with a vector
 RP3D_FORCE_INLINE Quaternion operator*( const matrix4x4& matrix, const Quaternion& vector )
 {
-    return Quaternion( matrix.mRows[0][0] * vector.x + matrix.mRows[0][1] * vector.y + matrix.mRows[0][2] * vector.z +
-                       matrix.mRows[0][3] * vector.w,
-                       matrix.mRows[1][0] * vector.x + matrix.mRows[1][1] * vector.y + matrix.mRows[1][2] * vector.z + matrix.mRows[1][3] *
-                       vector.w,
-                       matrix.mRows[2][0] * vector.x + matrix.mRows[2][1] * vector.y + matrix.mRows[2][2] * vector.z + matrix.mRows[2][3] *
-                       vector.w,
-                       matrix.mRows[3][0] * vector.x + matrix.mRows[3][1] * vector.y + matrix.mRows[3][2] * vector.z + matrix.mRows[3][3] *
-                       vector.w );
+    const decimal v[4] = { vector.x, vector.y, vector.z, vector.w };
+    decimal r[4];
+    simd::mat4_transform( matrix.data(), v, r );
+    return Quaternion( r[0], r[1], r[2], r[3] );
 }
 
 // Overloaded operator for equality condition
@@ -688,10 +652,12 @@ RP3D_FORCE_INLINE fnx::matrix4x4 matrix_translate( const fnx::vector3& position
     return ret;
 }
 
+/// @brief Equivalent to input * matrix_translate( position ) without building the translation matrix.
 RP3D_FORCE_INLINE fnx::matrix4x4 matrix_translate( const fnx::matrix4x4& input, const fnx::vector3& position )
 {
-    auto scale = matrix_translate(position);
-    return input * scale;
+    matrix4x4 ret;
+    simd::mat4_translate( input.data(), position.x, position.y, position.z, ret.data() );
+    return ret;
 }
 
 RP3D_FORCE_INLINE fnx::matrix4x4 matrix_translate( const fnx::matrix4x4& input, reactphysics3d::decimal x,
@@ -745,19 +711,8 @@ RP3D_FORCE_INLINE fnx::matrix4x4 matrix_scale( const fnx::matrix4x4& input,
         reactphysics3d::decimal sy,
         reactphysics3d::decimal sz )
 {
-    auto ret = input;
-    ret[0][0] *= sx;
-    ret[0][1] *= sx;
-    ret[0][2] *= sx;
-    ret[0][3] *= sx;
-    ret[1][0] *= sy;
-    ret[1][1] *= sy;
-    ret[1][2] *= sy;
-    ret[1][3] *= sy;
-    ret[2][0] *= sz;
-    ret[2][1] *= sz;
-    ret[2][2] *= sz;
-    ret[2][3] *= sz;
+    matrix4x4 ret;
+    simd::mat4_scale_rows( input.data(), sx, sy, sz, ret.data() );
     return ret;
 }
 
@@ -768,40 +723,17 @@ RP3D_FORCE_INLINE fnx::matrix4x4 matrix_scale( const fnx::matrix4x4& input, cons
 
 RP3D_FORCE_INLINE fnx::matrix4x4 matrix_inverse( const fnx::matrix4x4& input )
 {
-    auto a00 = input[0][0], a01 = input[0][1], a02 = input[0][2], a03 = input[0][3],
-         a10 = input[1][0], a11 = input[1][1], a12 = input[1][2], a13 = input[1][3],
-         a20 = input[2][0], a21 = input[2][1], a22 = input[2][2], a23 = input[2][3],
-         a30 = input[3][0], a31 = input[3][1], a32 = input[3][2], a33 = input[3][3],
-         b00 = a00 * a11 - a01 * a10,
-         b01 = a00 * a12 - a02 * a10,
-         b02 = a00 * a13 - a03 * a10,
-         b03 = a01 * a12 - a02 * a11,
-         b04 = a01 * a13 - a03 * a11,
-         b05 = a02 * a13 - a03 * a12,
-         b06 = a20 * a31 - a21 * a30,
-         b07 = a20 * a32 - a22 * a30,
-         b08 = a20 * a33 - a23 * a30,
-         b09 = a21 * a32 - a22 * a31,
-         b10 = a21 * a33 - a23 * a31,
-         b11 = a22 * a33 - a23 * a32,
-         det = b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06;
-    return fnx::matrix4x4(
-               a11 * b11 - a12 * b10 + a13 * b09,
-               a02 * b10 - a01 * b11 - a03 * b09,
-               a31 * b05 - a32 * b04 + a33 * b03,
-               a22 * b04 - a21 * b05 - a23 * b03,
-               a12 * b08 - a10 * b11 - a13 * b07,
-               a00 * b11 - a02 * b08 + a03 * b07,
-               a32 * b02 - a30 * b05 - a33 * b01,
-               a20 * b05 - a22 * b02 + a23 * b01,
-               a10 * b10 - a11 * b08 + a13 * b06,
-               a01 * b08 - a00 * b10 - a03 * b06,
-               a30 * b04 - a31 * b02 + a33 * b00,
-               a21 * b02 - a20 * b04 - a23 * b00,
-               a11 * b07 - a10 * b09 - a12 * b06,
-               a00 * b09 - a01 * b07 + a02 * b06,
-               a31 * b01 - a30 * b03 - a32 * b00,
-               a20 * b03 - a21 * b01 + a22 * b00 ) / det;
+    matrix4x4 ret;
+    simd::mat4_inverse( input.data(), ret.data() );
+    return ret;
+}
+
+/// @brief Multiply two affine transforms, cheaper than operator* when the last row of both is ( 0, 0, 0, 1 ).
+RP3D_FORCE_INLINE fnx::matrix4x4 matrix_affine_multiply( const fnx::matrix4x4& lhs, const fnx::matrix4x4& rhs )
+{
+    matrix4x4 ret;
+    simd::mat4_affine_multiply( lhs.data(), rhs.data(), ret.data() );
+    return ret;
 }
 
 /// @brief Equivalent to gluLookAt()
@@ -845,6 +777,7 @@ RP3D_FORCE_INLINE fnx::matrix4x4 matrix_look_at( const fnx::vector3& eye,
     matrix[3][0] = -left_x * eye_x - left_y * eye_y - left_z * eye_z;
     matrix[3][1] = -up_x * eye_x - up_y * eye_y - up_z * eye_z;
     matrix[3][2] = -forward_x * eye_x - forward_y * eye_y - forward_z * eye_z;
+    matrix[3][3] = 1;
     return matrix;
 }
 
@@ -863,12 +796,7 @@ RP3D_FORCE_INLINE auto matrix_to_vector(const matrix<Type, rows, 1>& input)
 /// Calculate the transposed matrix.
 RP3D_FORCE_INLINE auto matrix_transpose( const matrix4x4& mat )
 {
-    // TODO
-    auto m = mat.getAll();
-    return matrix4x4( m[0][0], m[0][1], m[0][2], m[0][3],
-                      m[1][0], m[1][1], m[1][2], m[1][3],
-                      m[2][0], m[2][1], m[2][2], m[2][3],
-                      m[3][0], m[3][1], m[3][2], m[3][3] );
+    return mat.getTranspose();
 }
 
 /// Create a matrix with the given transformation parameters.
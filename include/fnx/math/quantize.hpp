@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace fnx
+{
+/// @brief Conversions between floats and the compact types used for vertex attributes.
+/// @note The normalized conversions follow the OpenGL rules, so the GPU decodes them without shader changes.
+namespace quantize
+{
+/// @brief Nearest 16 bit float, rounding ties to even, out of range values become infinity.
+inline uint16_t to_half( float value )
+{
+    uint32_t f;
+    std::memcpy( &f, &value, sizeof( f ) );
+    const uint32_t sign = f & 0x80000000u;
+    f ^= sign;
+    uint32_t h;
+    if ( f >= 0x47800000u )
+    {
+        // infinity and nan keep every exponent bit, nan stays quiet
+        h = f > 0x7f800000u ? 0x7e00u : 0x7c00u;
+    }
+    else if ( f < 0x38800000u )
+    {
+        // subnormal or zero, adding a magic number lets the fpu do the rounding
+        const uint32_t magic_bits = 0x3f000000u;
+        float magic;
+        std::memcpy( &magic, &magic_bits, sizeof( magic ) );
+        float shifted;
+        std::memcpy( &shifted, &f, sizeof( shifted ) );
+        shifted += magic;
+        std::memcpy( &h, &shifted, sizeof( h ) );
+        h -= magic_bits;
+    }
+    else
+    {
+        // rebias the exponent and round the 13 dropped mantissa bits to even
+        const uint32_t odd = ( f >> 13u ) & 1u;
+        f += 0xc8000fffu + odd;
+        h = f >> 13u;
+    }
+    return static_cast<uint16_t>( h | ( sign >> 16u ) );
+}
+
+/// @brief Exact float of a 16 bit float.
+inline float from_half( uint16_t value )
+{
+    const uint32_t shifted_exponent = 0x7c00u << 13u;
+    uint32_t f = ( value & 0x7fffu ) << 13u;
+    const uint32_t exponent = f & shifted_exponent;
+    f += ( 127u - 15u ) << 23u;
+    if ( exponent == shifted_exponent )
+    {
+        f += ( 128u - 16u ) << 23u;
+    }
+    else if ( exponent == 0u )
+    {
+        // subnormal, renormalize with a float subtraction
+        f += 1u << 23u;
+        float result;
+        std::memcpy( &result, &f, sizeof( result ) );
+        result -= 6.103515625e-05f;
+        std::memcpy( &f, &result, sizeof( f ) );
+    }
+    f |= static_cast<uint32_t>( value & 0x8000u ) << 16u;
+    float result;
+    std::memcpy( &result, &f, sizeof( result ) );
+    return result;
+}
+
+/// @brief value in [0, 1] to 16 bits.
+inline uint16_t to_unorm16( float value )
+{
+    value = value < 0.f ? 0.f : ( value > 1.f ? 1.f : value );
+    return static_cast<uint16_t>( value * 65535.f + .5f );
+}
+
+inline float from_unorm16( uint16_t value )
+{
+    return static_cast<float>( value ) * ( 1.f / 65535.f );
+}
+
+/// @brief value in [-1, 1] to 16 bits.
+inline int16_t to_snorm16( float value )
+{
+    value = value < -1.f ? -1.f : ( value > 1.f ? 1.f : value );
+    return static_cast<int16_t>( std::lround( value * 32767.f ) );
+}
+
+/// @brief Both -32768 and -32767 are -1.
+inline float from_snorm16( int16_t value )
+{
+    const float result = static_cast<float>( value ) * ( 1.f / 32767.f );
+    return result < -1.f ? -1.f : result;
+}
+
+/// @brief value in [0, 1] to 8 bits.
+inline uint8_t to_unorm8( float value )
+{
+    value = value < 0.f ? 0.f : ( value > 1.f ? 1.f : value );
+    return static_cast<uint8_t>( value * 255.f + .5f );
+}
+
+inline float from_unorm8( uint8_t value )
+{
+    return static_cast<float>( value ) * ( 1.f / 255.f );
+}
+
+/// @brief Map a unit vector onto the two components of an octahedron unfolded into a square.
+/// @param[out] out : two values in [-1, 1], store them as snorm16 for less than 0.05 degrees of error
+inline void to_octahedral( float x, float y, float z, float* out )
+{
+    const float length = std::abs( x ) + std::abs( y ) + std::abs( z );
+    const float inv = length > 0.f ? 1.f / length : 0.f;
+    float u = x * inv;
+    float v = y * inv;
+    if ( z < 0.f )
+    {
+        // fold the lower half over the diagonals
+        const float folded_u = ( 1.f - std::abs( v ) ) * ( u >= 0.f ? 1.f : -1.f );
+        const float folded_v = ( 1.f - std::abs( u ) ) * ( v >= 0.f ? 1.f : -1.f );
+        u = folded_u;
+        v = folded_v;
+    }
+    out[0] = u;
+    out[1] = v;
+}
+
+/// @brief Unit vector of the octahedral components u and v.
+inline void from_octahedral( float u, float v, float* out )
+{
+    float z = 1.f - std::abs( u ) - std::abs( v );
+    if ( z < 0.f )
+    {
+        const float unfolded_u = ( 1.f - std::abs( v ) ) * ( u >= 0.f ? 1.f : -1.f );
+        const float unfolded_v = ( 1.f - std::abs( u ) ) * ( v >= 0.f ? 1.f : -1.f );
+        u = unfolded_u;
+        v = unfolded_v;
+    }
+    const float inv = 1.f / std::sqrt( u * u + v * v + z * z );
+    out[0] = u * inv;
+    out[1] = v * inv;
+    out[2] = z * inv;
+}
+
+/// @brief Pack values in [-1, 1] as 10 bits each for x, y and z and 2 bits for w, x in the low bits.
+/// @note Matches GL_INT_2_10_10_10_REV with normalization.
+inline uint32_t to_snorm_10_10_10_2( float x, float y, float z, float w )
+{
+    auto pack = []( float value, float scale, uint32_t mask )
+    {
+        value = value < -1.f ? -1.f : ( value > 1.f ? 1.f : value );
+        return static_cast<uint32_t>( static_cast<int32_t>( std::lround( value * scale ) ) ) & mask;
+    };
+    return pack( x, 511.f, 0x3ffu ) | ( pack( y, 511.f, 0x3ffu ) << 10u ) | ( pack( z, 511.f, 0x3ffu ) << 20u ) |
+           ( pack( w, 1.f, 0x3u ) << 30u );
+}
+
+/// @param[out] out : x, y, z and w
+inline void from_snorm_10_10_10_2( uint32_t value, float* out )
+{
+    auto unpack = []( uint32_t bits, uint32_t width )
+    {
+        // shift the field to the top to sign extend it
+        const int32_t signed_value = static_cast<int32_t>( bits << ( 32u - width ) ) >> ( 32u - width );
+        const float result = static_cast<float>( signed_value ) / static_cast<float>( ( 1 << ( width - 1u ) ) - 1 );
+        return result < -1.f ? -1.f : result;
+    };
+    out[0] = unpack( value & 0x3ffu, 10u );
+    out[1] = unpack( ( value >> 10u ) & 0x3ffu, 10u );
+    out[2] = unpack( ( value >> 20u ) & 0x3ffu, 10u );
+    out[3] = unpack( value >> 30u, 2u );
+}
+}
+}
@@ -0,0 +1,321 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <type_traits>
+
+namespace fnx
+{
+/// @brief Small and fast random number generators.
+/// @note Engines are plain values, seed or copy one to replay a sequence. The functions without an engine
+///     use generators owned by the calling thread so they never lock.
+namespace rng
+{
+/// @brief Expands a 64 bit seed into the state of the other engines.
+struct splitmix64
+{
+    using result_type = uint64_t;
+
+    explicit splitmix64( uint64_t seed = 0u )
+        : _state( seed )
+    {
+    }
+
+    static constexpr result_type min()
+    {
+        return 0u;
+    }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()()
+    {
+        uint64_t z = ( _state += 0x9e3779b97f4a7c15ull );
+        z = ( z ^ ( z >> 30u ) ) * 0xbf58476d1ce4e5b9ull;
+        z = ( z ^ ( z >> 27u ) ) * 0x94d049bb133111ebull;
+        return z ^ ( z >> 31u );
+    }
+
+private:
+    uint64_t _state;
+};
+
+/// @brief PCG32 (XSH RR), 16 bytes of state and 2^63 independent streams.
+struct pcg32
+{
+    using result_type = uint32_t;
+
+    explicit pcg32( uint64_t seed = 0x853c49e6748fea9bull, uint64_t stream = 0xda3e39cb94b95bdbull )
+    {
+        this->seed( seed, stream );
+    }
+
+    void seed( uint64_t seed, uint64_t stream = 0xda3e39cb94b95bdbull )
+    {
+        _state = 0u;
+        _inc = ( stream << 1u ) | 1u;
+        ( *this )();
+        _state += seed;
+        ( *this )();
+    }
+
+    static constexpr result_type min()
+    {
+        return 0u;
+    }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()()
+    {
+        const uint64_t old = _state;
+        _state = old * 6364136223846793005ull + _inc;
+        const uint32_t xorshifted = static_cast<uint32_t>( ( ( old >> 18u ) ^ old ) >> 27u );
+        const uint32_t rot = static_cast<uint32_t>( old >> 59u );
+        return ( xorshifted >> rot ) | ( xorshifted << ( ( 0u - rot ) & 31u ) );
+    }
+
+private:
+    uint64_t _state;
+    uint64_t _inc;
+};
+
+/// @brief xoshiro256**, the general purpose engine with 32 bytes of state.
+struct xoshiro256ss
+{
+    using result_type = uint64_t;
+
+    explicit xoshiro256ss( uint64_t seed = 0u )
+    {
+        this->seed( seed );
+    }
+
+    /// @brief Start from an exact state, which must not be all zero.
+    xoshiro256ss( uint64_t s0, uint64_t s1, uint64_t s2, uint64_t s3 )
+        : _s{ s0, s1, s2, s3 }
+    {
+    }
+
+    void seed( uint64_t seed )
+    {
+        splitmix64 expand( seed );
+        for ( auto& s : _s )
+        {
+            s = expand();
+        }
+    }
+
+    static constexpr result_type min()
+    {
+        return 0u;
+    }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()()
+    {
+        const uint64_t result = rotl( _s[1] * 5u, 7 ) * 9u;
+        const uint64_t t = _s[1] << 17u;
+        _s[2] ^= _s[0];
+        _s[3] ^= _s[1];
+        _s[1] ^= _s[2];
+        _s[0] ^= _s[3];
+        _s[2] ^= t;
+        _s[3] = rotl( _s[3], 45 );
+        return result;
+    }
+
+    /// @brief Advance by 2^128 calls, used to split one seed into sequences that never overlap.
+    void jump()
+    {
+        static constexpr uint64_t polynomial[] =
+        {
+            0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull
+        };
+        uint64_t s[4] = { 0u, 0u, 0u, 0u };
+        for ( auto word : polynomial )
+        {
+            for ( uint32_t bit = 0u; bit < 64u; bit++ )
+            {
+                if ( word & ( uint64_t{ 1u } << bit ) )
+                {
+                    for ( size_t i = 0; i < 4; i++ )
+                    {
+                        s[i] ^= _s[i];
+                    }
+                }
+                ( *this )();
+            }
+        }
+        for ( size_t i = 0; i < 4; i++ )
+        {
+            _s[i] = s[i];
+        }
+    }
+
+private:
+    uint64_t _s[4];
+
+    static uint64_t rotl( uint64_t x, int k )
+    {
+        return ( x << k ) | ( x >> ( 64 - k ) );
+    }
+};
+
+/// @brief Eight interleaved xoshiro128+ generators that fill arrays of floats several values per instruction.
+/// @note Only the upper 24 bits of each output are used, the lower bits of xoshiro128+ are weak.
+struct batch_engine
+{
+    static constexpr size_t lanes = 8u;
+
+    explicit batch_engine( uint64_t seed = 0u )
+    {
+        this->seed( seed );
+    }
+
+    void seed( uint64_t seed )
+    {
+        splitmix64 expand( seed );
+        for ( size_t i = 0; i < 4u * lanes; i += 2 )
+        {
+            const uint64_t bits = expand();
+            _state[i] = static_cast<uint32_t>( bits );
+            _state[i + 1] = static_cast<uint32_t>( bits >> 32u );
+        }
+    }
+
+    /// @brief State words of every generator, four rows of one word per lane.
+    uint32_t* data()
+    {
+        return _state;
+    }
+
+private:
+    FNX_SIMD_ALIGN uint32_t _state[4u * lanes];
+};
+
+using default_engine = xoshiro256ss;
+
+/// @brief Generator owned by the calling thread.
+/// @note Seeded from the clock and thread id, call seed() for a repeatable sequence.
+inline default_engine& thread_engine()
+{
+    thread_local default_engine engine( static_cast<uint64_t>(
+                                            std::chrono::high_resolution_clock::now().time_since_epoch().count() ) ^
+                                        ( std::hash<std::thread::id> {}( std::this_thread::get_id() ) * 0x9e3779b97f4a7c15ull ) );
+    return engine;
+}
+
+/// @brief Batch generator owned by the calling thread, used by fill_uniform and fill_normal.
+inline batch_engine& thread_batch_engine()
+{
+    thread_local batch_engine engine( thread_engine()() );
+    return engine;
+}
+
+/// @brief Seed the generators of the calling thread to replay a sequence.
+inline void seed( uint64_t value )
+{
+    thread_batch_engine().seed( ~value );
+    thread_engine().seed( value );
+}
+
+template<typename Engine>
+/// @brief Uniform double in [0, 1) with 53 random bits.
+inline double canonical( Engine& engine )
+{
+    uint64_t bits = engine();
+    if ( sizeof( typename Engine::result_type ) < sizeof( uint64_t ) )
+    {
+        bits = ( bits << 32u ) | static_cast<uint32_t>( engine() );
+    }
+    return static_cast<double>( bits >> 11u ) * 0x1.0p-53;
+}
+
+template<typename T, typename Engine>
+/// @brief Uniform value in [min, max).
+inline T uniform( Engine& engine, T min, T max )
+{
+    static_assert( std::is_floating_point<T>::value, "use uniform_index for integers" );
+    return min + static_cast<T>( canonical( engine ) * static_cast<double>( max - min ) );
+}
+
+template<typename Engine>
+/// @brief Unbiased integer in [0, count), count must not be 0.
+inline uint32_t uniform_index( Engine& engine, uint32_t count )
+{
+    // multiply and keep the high bits, rejecting the few low values that would bias the result
+    uint64_t product = uint64_t{ static_cast<uint32_t>( engine() ) } * count;
+    if ( static_cast<uint32_t>( product ) < count )
+    {
+        const uint32_t threshold = ( 0u - count ) % count;
+        while ( static_cast<uint32_t>( product ) < threshold )
+        {
+            product = uint64_t{ static_cast<uint32_t>( engine() ) } * count;
+        }
+    }
+    return static_cast<uint32_t>( product >> 32u );
+}
+
+template<typename T, typename Engine>
+/// @brief Normally distributed value.
+inline T normal( Engine& engine, T mean, T stddev )
+{
+    const double radius = std::sqrt( -2.0 * std::log( 1.0 - canonical( engine ) ) );
+    return mean + stddev * static_cast<T>( radius * std::cos( 2.0 * 3.14159265358979323846 * canonical( engine ) ) );
+}
+
+/// @brief Fill values with uniform floats in [min, max).
+inline void fill_uniform( batch_engine& engine, fnx::span<float> values, float min = 0.f, float max = 1.f )
+{
+    fnx::simd::fill_uniform( engine.data(), values.data(), values.size(), min, max );
+}
+
+/// @brief Fill values with normally distributed floats.
+inline void fill_normal( batch_engine& engine, fnx::span<float> values, float mean = 0.f, float stddev = 1.f )
+{
+    // Box-Muller on pairs of uniform values, the last pair may be generated for a single value
+    const size_t pairs = values.size() / 2u;
+    fill_uniform( engine, values.subspan( 0u, pairs * 2u ) );
+    for ( size_t i = 0; i < pairs * 2u; i += 2 )
+    {
+        const float radius = stddev * std::sqrt( -2.f * std::log( 1.f - values[i] ) );
+        const float angle = 2.f * 3.14159265f * values[i + 1];
+        values[i] = mean + radius * std::cos( angle );
+        values[i + 1] = mean + radius * std::sin( angle );
+    }
+    if ( values.size() % 2u )
+    {
+        float last[2];
+        fill_uniform( engine, last );
+        values[values.size() - 1] = mean + stddev * std::sqrt( -2.f * std::log( 1.f - last[0] ) ) *
+                                    std::cos( 2.f * 3.14159265f * last[1] );
+    }
+}
+
+/// @brief Fill values with uniform floats in [min, max) from the generators of the calling thread.
+inline void fill_uniform( fnx::span<float> values, float min = 0.f, float max = 1.f )
+{
+    fill_uniform( thread_batch_engine(), values, min, max );
+}
+
+/// @brief Fill values with normally distributed floats from the generators of the calling thread.
+inline void fill_normal( fnx::span<float> values, float mean = 0.f, float stddev = 1.f )
+{
+    fill_normal( thread_batch_engine(), values, mean, stddev );
+}
+}
+}
@@ -0,0 +1,1563 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Select the vector instruction set at compile time. Define FNX_NO_SIMD to force the scalar kernels.
+#if !defined(FNX_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#define FNX_SIMD_SSE 1
+#include <emmintrin.h>
+#if defined(__AVX__)
+#define FNX_SIMD_AVX 1
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define FNX_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
+
+/// @brief Alignment of 4 component vectors and 4x4 matrices so that a row is a single aligned vector load.
+#define FNX_SIMD_ALIGN alignas( 16 )
+
+namespace fnx
+{
+/// @brief Kernels for 4x4 matrices, vectors, batches of points and boxes, frustum culling, random numbers and image
+///     filtering.
+/// @note Matrices are 16 contiguous row major values. The float overloads use SSE, AVX or NEON when available,
+///     every other type and the FNX_NO_SIMD build use the scalar kernels. Pointers do not need to be aligned
+///     and the output may alias an input.
+namespace simd
+{
+/// @brief Reference implementations, also used to verify the vector kernels.
+namespace scalar
+{
+template<typename T>
+/// @brief out = a * b
+inline void mat4_multiply( const T* a, const T* b, T* out )
+{
+    T r[16];
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        const T* row = a + i * 4;
+        for ( size_t j = 0; j < 4; j++ )
+        {
+            r[i * 4 + j] = row[0] * b[j] + row[1] * b[4 + j] + row[2] * b[8 + j] + row[3] * b[12 + j];
+        }
+    }
+    for ( size_t i = 0; i < 16; i++ )
+    {
+        out[i] = r[i];
+    }
+}
+
+template<typename T>
+/// @brief out = a * b for affine matrices, the last row of both must be ( 0, 0, 0, 1 ).
+inline void mat4_affine_multiply( const T* a, const T* b, T* out )
+{
+    T r[12];
+    for ( size_t i = 0; i < 3; i++ )
+    {
+        const T* row = a + i * 4;
+        for ( size_t j = 0; j < 4; j++ )
+        {
+            r[i * 4 + j] = row[0] * b[j] + row[1] * b[4 + j] + row[2] * b[8 + j] + row[3] * b[12 + j];
+        }
+    }
+    for ( size_t i = 0; i < 12; i++ )
+    {
+        out[i] = r[i];
+    }
+    out[12] = T{ 0 };
+    out[13] = T{ 0 };
+    out[14] = T{ 0 };
+    out[15] = T{ 1 };
+}
+
+template<typename T>
+/// @brief out = m * v where v is a column vector.
+inline void mat4_transform( const T* m, const T* v, T* out )
+{
+    T r[4];
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        r[i] = m[i * 4] * v[0] + m[i * 4 + 1] * v[1] + m[i * 4 + 2] * v[2] + m[i * 4 + 3] * v[3];
+    }
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        out[i] = r[i];
+    }
+}
+
+template<typename T>
+inline void mat4_transpose( const T* m, T* out )
+{
+    T r[16];
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        for ( size_t j = 0; j < 4; j++ )
+        {
+            r[j * 4 + i] = m[i * 4 + j];
+        }
+    }
+    for ( size_t i = 0; i < 16; i++ )
+    {
+        out[i] = r[i];
+    }
+}
+
+template<typename T>
+/// @brief Multiply the first three rows by sx, sy and sz.
+inline void mat4_scale_rows( const T* m, T sx, T sy, T sz, T* out )
+{
+    const T s[3] = { sx, sy, sz };
+    for ( size_t i = 0; i < 12; i++ )
+    {
+        out[i] = m[i] * s[i / 4];
+    }
+    for ( size_t i = 12; i < 16; i++ )
+    {
+        out[i] = m[i];
+    }
+}
+
+template<typename T>
+/// @brief out = m * translation( x, y, z ), only the last column changes.
+inline void mat4_translate( const T* m, T x, T y, T z, T* out )
+{
+    T r[4];
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        r[i] = m[i * 4] * x + m[i * 4 + 1] * y + m[i * 4 + 2] * z + m[i * 4 + 3];
+    }
+    for ( size_t i = 0; i < 16; i++ )
+    {
+        out[i] = m[i];
+    }
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        out[i * 4 + 3] = r[i];
+    }
+}
+
+template<typename T>
+/// @brief Inverse from the 2x2 sub determinants of the first and last two rows.
+/// @note A singular matrix produces infinities or NaN.
+inline void mat4_inverse( const T* m, T* out )
+{
+    auto a00 = m[0], a01 = m[1], a02 = m[2], a03 = m[3],
+         a10 = m[4], a11 = m[5], a12 = m[6], a13 = m[7],
+         a20 = m[8], a21 = m[9], a22 = m[10], a23 = m[11],
+         a30 = m[12], a31 = m[13], a32 = m[14], a33 = m[15],
+         b00 = a00 * a11 - a01 * a10,
+         b01 = a00 * a12 - a02 * a10,
+         b02 = a00 * a13 - a03 * a10,
+         b03 = a01 * a12 - a02 * a11,
+         b04 = a01 * a13 - a03 * a11,
+         b05 = a02 * a13 - a03 * a12,
+         b06 = a20 * a31 - a21 * a30,
+         b07 = a20 * a32 - a22 * a30,
+         b08 = a20 * a33 - a23 * a30,
+         b09 = a21 * a32 - a22 * a31,
+         b10 = a21 * a33 - a23 * a31,
+         b11 = a22 * a33 - a23 * a32,
+         det = b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06;
+    out[0] = ( a11 * b11 - a12 * b10 + a13 * b09 ) / det;
+    out[1] = ( a02 * b10 - a01 * b11 - a03 * b09 ) / det;
+    out[2] = ( a31 * b05 - a32 * b04 + a33 * b03 ) / det;
+    out[3] = ( a22 * b04 - a21 * b05 - a23 * b03 ) / det;
+    out[4] = ( a12 * b08 - a10 * b11 - a13 * b07 ) / det;
+    out[5] = ( a00 * b11 - a02 * b08 + a03 * b07 ) / det;
+    out[6] = ( a32 * b02 - a30 * b05 - a33 * b01 ) / det;
+    out[7] = ( a20 * b05 - a22 * b02 + a23 * b01 ) / det;
+    out[8] = ( a10 * b10 - a11 * b08 + a13 * b06 ) / det;
+    out[9] = ( a01 * b08 - a00 * b10 - a03 * b06 ) / det;
+    out[10] = ( a30 * b04 - a31 * b02 + a33 * b00 ) / det;
+    out[11] = ( a21 * b02 - a20 * b04 - a23 * b00 ) / det;
+    out[12] = ( a11 * b07 - a10 * b09 - a12 * b06 ) / det;
+    out[13] = ( a00 * b09 - a01 * b07 + a02 * b06 ) / det;
+    out[14] = ( a31 * b01 - a30 * b03 - a32 * b00 ) / det;
+    out[15] = ( a20 * b03 - a21 * b01 + a22 * b00 ) / det;
+}
+
+template<typename T>
+/// @brief out[i] = m * ( in[i], 1 ) for count packed xyz points, the last row of m is ignored.
+inline void transform_points( const T* m, const T* in, T* out, size_t count )
+{
+    for ( size_t i = 0; i < count * 3; i += 3 )
+    {
+        const T x = in[i];
+        const T y = in[i + 1];
+        const T z = in[i + 2];
+        out[i] = m[0] * x + m[1] * y + m[2] * z + m[3];
+        out[i + 1] = m[4] * x + m[5] * y + m[6] * z + m[7];
+        out[i + 2] = m[8] * x + m[9] * y + m[10] * z + m[11];
+    }
+}
+
+template<typename T>
+/// @brief Bounds of count boxes after the affine transform m, each box is packed as min xyz then max xyz.
+/// @note The center is transformed and the half extents are projected onto the absolute axes of m.
+inline void transform_aabbs( const T* m, const T* in, T* out, size_t count )
+{
+    for ( size_t i = 0; i < count * 6; i += 6 )
+    {
+        T center[3];
+        T extent[3];
+        for ( size_t k = 0; k < 3; k++ )
+        {
+            center[k] = ( in[i + k] + in[i + 3 + k] ) * T( 0.5 );
+            extent[k] = ( in[i + 3 + k] - in[i + k] ) * T( 0.5 );
+        }
+        for ( size_t k = 0; k < 3; k++ )
+        {
+            const T* row = m + k * 4;
+            const T c = row[0] * center[0] + row[1] * center[1] + row[2] * center[2] + row[3];
+            const T e = std::abs( row[0] ) * extent[0] + std::abs( row[1] ) * extent[1] + std::abs( row[2] ) * extent[2];
+            out[i + k] = c - e;
+            out[i + 3 + k] = c + e;
+        }
+    }
+}
+
+template<typename T>
+/// @brief Fill out with uniform values in [min, max) from eight interleaved xoshiro128+ generators.
+/// @param[in,out] state : 32 words, four rows of one word per generator
+inline void fill_uniform( uint32_t* state, T* out, size_t count, T min, T max )
+{
+    uint32_t* s0 = state;
+    uint32_t* s1 = state + 8;
+    uint32_t* s2 = state + 16;
+    uint32_t* s3 = state + 24;
+    const T scale = ( max - min ) / T( 16777216 );
+    for ( size_t i = 0; i < count; i += 8 )
+    {
+        for ( size_t l = 0; l < 8; l++ )
+        {
+            const uint32_t r = s0[l] + s3[l];
+            const uint32_t t = s1[l] << 9u;
+            s2[l] ^= s0[l];
+            s3[l] ^= s1[l];
+            s1[l] ^= s2[l];
+            s0[l] ^= s3[l];
+            s2[l] ^= t;
+            s3[l] = ( s3[l] << 11u ) | ( s3[l] >> 21u );
+            if ( i + l < count )
+            {
+                // the upper 24 bits, the lower bits of xoshiro128+ are weak
+                out[i + l] = min + static_cast<T>( static_cast<int32_t>( r >> 8u ) ) * scale;
+            }
+        }
+    }
+}
+
+/// @brief Write first + lane for every lane set in mask, without branching on the mask.
+/// @note Every lane is stored and only the set lanes advance the output, out must have room for all the lanes.
+/// @return number of indices kept
+inline size_t append_indices( uint32_t* out, uint32_t first, uint32_t mask, size_t lanes )
+{
+    size_t n = 0;
+    for ( size_t l = 0; l < lanes; l++ )
+    {
+        out[n] = first + static_cast<uint32_t>( l );
+        n += ( mask >> l ) & 1u;
+    }
+    return n;
+}
+
+template<typename T>
+/// @brief Indices of the boxes that are not entirely behind one of the six planes.
+/// @param[in] planes : 24 values, six planes as ( nx, ny, nz, d ) with unit normals pointing inside
+/// @param[in] boxes : count boxes packed as min xyz then max xyz
+/// @param[out] visible : indices of the boxes that may be visible, must hold count indices
+/// @param[in] first : index of the first box
+/// @return number of indices written
+inline size_t cull_aabbs( const T* planes, const T* boxes, size_t count, uint32_t* visible, uint32_t first = 0u )
+{
+    size_t n = 0;
+    for ( size_t i = 0; i < count; i++, boxes += 6 )
+    {
+        T center[3];
+        T extent[3];
+        for ( size_t k = 0; k < 3; k++ )
+        {
+            center[k] = ( boxes[k] + boxes[3 + k] ) * T( 0.5 );
+            extent[k] = ( boxes[3 + k] - boxes[k] ) * T( 0.5 );
+        }
+        uint32_t inside = 1u;
+        for ( const T* plane = planes; plane != planes + 24; plane += 4 )
+        {
+            // distance of the center and the extent projected onto the normal
+            const T d = plane[0] * center[0] + plane[1] * center[1] + plane[2] * center[2] + plane[3];
+            const T r = std::abs( plane[0] ) * extent[0] + std::abs( plane[1] ) * extent[1] + std::abs( plane[2] ) * extent[2];
+            inside &= !( d + r < T( 0 ) );
+        }
+        n += append_indices( visible + n, first + static_cast<uint32_t>( i ), inside, 1u );
+    }
+    return n;
+}
+
+template<typename T>
+/// @brief Indices of the spheres that are not entirely behind one of the six planes.
+/// @param[in] spheres : count spheres packed as center xyz then radius
+/// @see cull_aabbs
+inline size_t cull_spheres( const T* planes, const T* spheres, size_t count, uint32_t* visible, uint32_t first = 0u )
+{
+    size_t n = 0;
+    for ( size_t i = 0; i < count; i++, spheres += 4 )
+    {
+        uint32_t inside = 1u;
+        for ( const T* plane = planes; plane != planes + 24; plane += 4 )
+        {
+            const T d = plane[0] * spheres[0] + plane[1] * spheres[1] + plane[2] * spheres[2] + plane[3];
+            inside &= !( d + spheres[3] < T( 0 ) );
+        }
+        n += append_indices( visible + n, first + static_cast<uint32_t>( i ), inside, 1u );
+    }
+    return n;
+}
+
+template<typename T>
+/// @brief out[i] += in[i] * weight
+inline void multiply_add( const T* in, T weight, T* out, size_t count )
+{
+    for ( size_t i = 0; i < count; i++ )
+    {
+        out[i] += in[i] * weight;
+    }
+}
+
+template<typename T>
+/// @brief out = sum of weights[k] * pixel k, for count pixels of four components.
+inline void weighted_sum4( const T* pixels, const T* weights, size_t count, T* out )
+{
+    T r[4] = { T( 0 ), T( 0 ), T( 0 ), T( 0 ) };
+    for ( size_t k = 0; k < count; k++, pixels += 4 )
+    {
+        for ( size_t c = 0; c < 4; c++ )
+        {
+            r[c] += pixels[c] * weights[k];
+        }
+    }
+    for ( size_t c = 0; c < 4; c++ )
+    {
+        out[c] = r[c];
+    }
+}
+}
+
+/// @brief Name of the instruction set used by the float kernels.
+inline const char* backend()
+{
+#if defined(FNX_SIMD_AVX) && defined(__FMA__)
+    return "avx+fma";
+#elif defined(FNX_SIMD_AVX)
+    return "avx";
+#elif defined(FNX_SIMD_SSE)
+    return "sse";
+#elif defined(FNX_SIMD_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+template<typename T>
+inline void mat4_multiply( const T* a, const T* b, T* out )
+{
+    scalar::mat4_multiply( a, b, out );
+}
+
+template<typename T>
+inline void mat4_affine_multiply( const T* a, const T* b, T* out )
+{
+    scalar::mat4_affine_multiply( a, b, out );
+}
+
+template<typename T>
+inline void mat4_transform( const T* m, const T* v, T* out )
+{
+    scalar::mat4_transform( m, v, out );
+}
+
+template<typename T>
+inline void mat4_transpose( const T* m, T* out )
+{
+    scalar::mat4_transpose( m, out );
+}
+
+template<typename T>
+inline void mat4_scale_rows( const T* m, T sx, T sy, T sz, T* out )
+{
+    scalar::mat4_scale_rows( m, sx, sy, sz, out );
+}
+
+template<typename T>
+inline void mat4_translate( const T* m, T x, T y, T z, T* out )
+{
+    scalar::mat4_translate( m, x, y, z, out );
+}
+
+template<typename T>
+inline void mat4_inverse( const T* m, T* out )
+{
+    scalar::mat4_inverse( m, out );
+}
+
+template<typename T>
+inline void transform_points( const T* m, const T* in, T* out, size_t count )
+{
+    scalar::transform_points( m, in, out, count );
+}
+
+template<typename T>
+inline void transform_aabbs( const T* m, const T* in, T* out, size_t count )
+{
+    scalar::transform_aabbs( m, in, out, count );
+}
+
+template<typename T>
+inline void fill_uniform( uint32_t* state, T* out, size_t count, T min, T max )
+{
+    scalar::fill_uniform( state, out, count, min, max );
+}
+
+template<typename T>
+inline size_t cull_aabbs( const T* planes, const T* boxes, size_t count, uint32_t* visible )
+{
+    return scalar::cull_aabbs( planes, boxes, count, visible );
+}
+
+template<typename T>
+inline size_t cull_spheres( const T* planes, const T* spheres, size_t count, uint32_t* visible )
+{
+    return scalar::cull_spheres( planes, spheres, count, visible );
+}
+
+template<typename T>
+inline void multiply_add( const T* in, T weight, T* out, size_t count )
+{
+    scalar::multiply_add( in, weight, out, count );
+}
+
+template<typename T>
+inline void weighted_sum4( const T* pixels, const T* weights, size_t count, T* out )
+{
+    scalar::weighted_sum4( pixels, weights, count, out );
+}
+
+#if defined(FNX_SIMD_SSE)
+namespace detail
+{
+/// @brief Select lanes x, y from a and z, w from b.
+#define FNX_SSE_SHUFFLE( a, b, x, y, z, w ) _mm_shuffle_ps( a, b, _MM_SHUFFLE( w, z, y, x ) )
+#define FNX_SSE_SWIZZLE( v, x, y, z, w ) FNX_SSE_SHUFFLE( v, v, x, y, z, w )
+
+/// @brief a * b + c, fused when the target has fma like the scalar kernels contracted by the compiler.
+inline __m128 madd( __m128 a, __m128 b, __m128 c )
+{
+#if defined(__FMA__)
+    return _mm_fmadd_ps( a, b, c );
+#else
+    return _mm_add_ps( _mm_mul_ps( a, b ), c );
+#endif
+}
+
+/// @brief Row of a * b, a linear combination of the rows of b.
+inline __m128 multiply_row( __m128 a, __m128 b0, __m128 b1, __m128 b2, __m128 b3 )
+{
+    __m128 r = _mm_mul_ps( FNX_SSE_SWIZZLE( a, 0, 0, 0, 0 ), b0 );
+    r = madd( FNX_SSE_SWIZZLE( a, 1, 1, 1, 1 ), b1, r );
+    r = madd( FNX_SSE_SWIZZLE( a, 2, 2, 2, 2 ), b2, r );
+    return madd( FNX_SSE_SWIZZLE( a, 3, 3, 3, 3 ), b3, r );
+}
+
+#if defined(FNX_SIMD_AVX)
+inline __m256 madd( __m256 a, __m256 b, __m256 c )
+{
+#if defined(__FMA__)
+    return _mm256_fmadd_ps( a, b, c );
+#else
+    return _mm256_add_ps( _mm256_mul_ps( a, b ), c );
+#endif
+}
+
+/// @brief Load a row into both halves of a 256 bit register.
+inline __m256 broadcast_row( const float* row )
+{
+    const __m128 r = _mm_loadu_ps( row );
+    return _mm256_insertf128_ps( _mm256_castps128_ps256( r ), r, 1 );
+}
+
+/// @brief Two output rows at a time, each one a linear combination of the rows of b.
+inline __m256 multiply_rows( __m256 a, __m256 b0, __m256 b1, __m256 b2, __m256 b3 )
+{
+    __m256 r = _mm256_mul_ps( _mm256_shuffle_ps( a, a, 0x00 ), b0 );
+    r = madd( _mm256_shuffle_ps( a, a, 0x55 ), b1, r );
+    r = madd( _mm256_shuffle_ps( a, a, 0xaa ), b2, r );
+    return madd( _mm256_shuffle_ps( a, a, 0xff ), b3, r );
+}
+
+/// @brief Store two pairs of rows.
+inline void store_rows( float* out, __m256 r01, __m256 r23 )
+{
+#if defined(__AVX512F__)
+    // matrices are copied with a single 64 byte move on these targets, which only forwards from a single store
+    const __m512d lo = _mm512_castpd256_pd512( _mm256_castps_pd( r01 ) );
+    _mm512_storeu_ps( out, _mm512_castpd_ps( _mm512_insertf64x4( lo, _mm256_castps_pd( r23 ), 1 ) ) );
+#else
+    _mm256_storeu_ps( out, r01 );
+    _mm256_storeu_ps( out + 8, r23 );
+#endif
+}
+#endif
+
+/// @brief Store the four rows of a matrix.
+/// @note Wider targets merge the rows so that copying the result does not stall on store forwarding.
+inline void store_rows( float* out, __m128 r0, __m128 r1, __m128 r2, __m128 r3 )
+{
+#if defined(FNX_SIMD_AVX)
+    store_rows( out, _mm256_insertf128_ps( _mm256_castps128_ps256( r0 ), r1, 1 ),
+                _mm256_insertf128_ps( _mm256_castps128_ps256( r2 ), r3, 1 ) );
+#else
+    _mm_storeu_ps( out, r0 );
+    _mm_storeu_ps( out + 4, r1 );
+    _mm_storeu_ps( out + 8, r2 );
+    _mm_storeu_ps( out + 12, r3 );
+#endif
+}
+
+/// @brief 2x2 row major a * b
+inline __m128 mat2_multiply( __m128 a, __m128 b )
+{
+    return _mm_add_ps( _mm_mul_ps( a, FNX_SSE_SWIZZLE( b, 0, 3, 0, 3 ) ),
+                       _mm_mul_ps( FNX_SSE_SWIZZLE( a, 1, 0, 3, 2 ), FNX_SSE_SWIZZLE( b, 2, 1, 2, 1 ) ) );
+}
+
+/// @brief 2x2 row major adjugate( a ) * b
+inline __m128 mat2_adjugate_multiply( __m128 a, __m128 b )
+{
+    return _mm_sub_ps( _mm_mul_ps( FNX_SSE_SWIZZLE( a, 3, 3, 0, 0 ), b ),
+                       _mm_mul_ps( FNX_SSE_SWIZZLE( a, 1, 1, 2, 2 ), FNX_SSE_SWIZZLE( b, 2, 3, 0, 1 ) ) );
+}
+
+/// @brief 2x2 row major a * adjugate( b )
+inline __m128 mat2_multiply_adjugate( __m128 a, __m128 b )
+{
+    return _mm_sub_ps( _mm_mul_ps( a, FNX_SSE_SWIZZLE( b, 3, 0, 3, 0 ) ),
+                       _mm_mul_ps( FNX_SSE_SWIZZLE( a, 1, 0, 3, 2 ), FNX_SSE_SWIZZLE( b, 2, 1, 2, 1 ) ) );
+}
+
+/// @brief Lane wise operations shared by the 128 and 256 bit batch kernels, 256 bit shuffles stay within each half.
+template<int x, int y, int z, int w>
+inline __m128 shuffle( __m128 a, __m128 b )
+{
+    return _mm_shuffle_ps( a, b, _MM_SHUFFLE( w, z, y, x ) );
+}
+
+inline __m128 add( __m128 a, __m128 b )
+{
+    return _mm_add_ps( a, b );
+}
+
+inline __m128 sub( __m128 a, __m128 b )
+{
+    return _mm_sub_ps( a, b );
+}
+
+inline __m128 mul( __m128 a, __m128 b )
+{
+    return _mm_mul_ps( a, b );
+}
+
+inline __m128 unpack_lo( __m128 a, __m128 b )
+{
+    return _mm_unpacklo_ps( a, b );
+}
+
+inline __m128 unpack_hi( __m128 a, __m128 b )
+{
+    return _mm_unpackhi_ps( a, b );
+}
+
+inline void splat( float value, __m128& out )
+{
+    out = _mm_set1_ps( value );
+}
+
+/// @brief Load 12 floats as three vectors.
+inline void load_lanes( const float* in, __m128& a, __m128& b, __m128& c )
+{
+    a = _mm_loadu_ps( in );
+    b = _mm_loadu_ps( in + 4 );
+    c = _mm_loadu_ps( in + 8 );
+}
+
+inline void store_lanes( float* out, __m128 a, __m128 b, __m128 c )
+{
+    _mm_storeu_ps( out, a );
+    _mm_storeu_ps( out + 4, b );
+    _mm_storeu_ps( out + 8, c );
+}
+
+inline __m128 minimum( __m128 a, __m128 b )
+{
+    return _mm_min_ps( a, b );
+}
+
+/// @brief Bit mask of the lanes below zero.
+inline uint32_t negative_lanes( __m128 a )
+{
+    return static_cast<uint32_t>( _mm_movemask_ps( _mm_cmplt_ps( a, _mm_setzero_ps() ) ) );
+}
+
+/// @brief Load 16 floats as four vectors.
+inline void load_quads( const float* in, __m128& a, __m128& b, __m128& c, __m128& d )
+{
+    a = _mm_loadu_ps( in );
+    b = _mm_loadu_ps( in + 4 );
+    c = _mm_loadu_ps( in + 8 );
+    d = _mm_loadu_ps( in + 12 );
+}
+
+/// @brief Reorder the mask of a batch of boxes so that bit i is box i.
+inline uint32_t box_lanes( uint32_t mask, __m128 )
+{
+    return mask;
+}
+
+#if defined(FNX_SIMD_AVX)
+template<int x, int y, int z, int w>
+inline __m256 shuffle( __m256 a, __m256 b )
+{
+    return _mm256_shuffle_ps( a, b, _MM_SHUFFLE( w, z, y, x ) );
+}
+
+inline __m256 add( __m256 a, __m256 b )
+{
+    return _mm256_add_ps( a, b );
+}
+
+inline __m256 sub( __m256 a, __m256 b )
+{
+    return _mm256_sub_ps( a, b );
+}
+
+inline __m256 mul( __m256 a, __m256 b )
+{
+    return _mm256_mul_ps( a, b );
+}
+
+inline __m256 unpack_lo( __m256 a, __m256 b )
+{
+    return _mm256_unpacklo_ps( a, b );
+}
+
+inline __m256 unpack_hi( __m256 a, __m256 b )
+{
+    return _mm256_unpackhi_ps( a, b );
+}
+
+inline void splat( float value, __m256& out )
+{
+    out = _mm256_set1_ps( value );
+}
+
+inline __m256 minimum( __m256 a, __m256 b )
+{
+    return _mm256_min_ps( a, b );
+}
+
+inline uint32_t negative_lanes( __m256 a )
+{
+    return static_cast<uint32_t>( _mm256_movemask_ps( _mm256_cmp_ps( a, _mm256_setzero_ps(), _CMP_LT_OQ ) ) );
+}
+
+/// @brief Load 32 floats as four vectors, the first 16 in the low halves and the next 16 in the high halves.
+inline void load_quads( const float* in, __m256& a, __m256& b, __m256& c, __m256& d )
+{
+    a = _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( in ) ), _mm_loadu_ps( in + 16 ), 1 );
+    b = _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( in + 4 ) ), _mm_loadu_ps( in + 20 ), 1 );
+    c = _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( in + 8 ) ), _mm_loadu_ps( in + 24 ), 1 );
+    d = _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( in + 12 ) ), _mm_loadu_ps( in + 28 ), 1 );
+}
+
+inline uint32_t box_lanes( uint32_t mask, __m256 )
+{
+    // splitting min from max within each half leaves boxes 0 1 4 5 in the low half and 2 3 6 7 in the high half
+    return ( mask & 0xc3u ) | ( ( mask & 0x0cu ) << 2u ) | ( ( mask & 0x30u ) >> 2u );
+}
+
+#if defined(__AVX2__)
+/// @brief Load eight packed xyz points as structure of arrays.
+/// @note Each output gathers its values from the three loads with two blends and a single cross lane permute.
+inline void load_xyz( const float* in, __m256& x, __m256& y, __m256& z )
+{
+    const __m256 a = _mm256_loadu_ps( in );
+    const __m256 b = _mm256_loadu_ps( in + 8 );
+    const __m256 c = _mm256_loadu_ps( in + 16 );
+    x = _mm256_blend_ps( _mm256_blend_ps( a, b, 0x92 ), c, 0x24 );
+    y = _mm256_blend_ps( _mm256_blend_ps( a, b, 0x24 ), c, 0x49 );
+    z = _mm256_blend_ps( _mm256_blend_ps( a, b, 0x49 ), c, 0x92 );
+    x = _mm256_permutevar8x32_ps( x, _mm256_setr_epi32( 0, 3, 6, 1, 4, 7, 2, 5 ) );
+    y = _mm256_permutevar8x32_ps( y, _mm256_setr_epi32( 1, 4, 7, 2, 5, 0, 3, 6 ) );
+    z = _mm256_permutevar8x32_ps( z, _mm256_setr_epi32( 2, 5, 0, 3, 6, 1, 4, 7 ) );
+}
+
+/// @brief Store eight points from structure of arrays as packed xyz.
+inline void store_xyz( float* out, __m256 x, __m256 y, __m256 z )
+{
+    x = _mm256_permutevar8x32_ps( x, _mm256_setr_epi32( 0, 3, 6, 1, 4, 7, 2, 5 ) );
+    y = _mm256_permutevar8x32_ps( y, _mm256_setr_epi32( 5, 0, 3, 6, 1, 4, 7, 2 ) );
+    z = _mm256_permutevar8x32_ps( z, _mm256_setr_epi32( 2, 5, 0, 3, 6, 1, 4, 7 ) );
+    _mm256_storeu_ps( out, _mm256_blend_ps( _mm256_blend_ps( x, y, 0x92 ), z, 0x24 ) );
+    _mm256_storeu_ps( out + 8, _mm256_blend_ps( _mm256_blend_ps( x, y, 0x24 ), z, 0x49 ) );
+    _mm256_storeu_ps( out + 16, _mm256_blend_ps( _mm256_blend_ps( x, y, 0x49 ), z, 0x92 ) );
+}
+#else
+inline __m256 load_halves( const float* lo, const float* hi )
+{
+    return _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( lo ) ), _mm_loadu_ps( hi ), 1 );
+}
+
+/// @brief Load 24 floats as three vectors, the first 12 in the low halves and the next 12 in the high halves.
+inline void load_lanes( const float* in, __m256& a, __m256& b, __m256& c )
+{
+    a = load_halves( in, in + 12 );
+    b = load_halves( in + 4, in + 16 );
+    c = load_halves( in + 8, in + 20 );
+}
+
+inline void store_halves( float* lo, float* hi, __m256 v )
+{
+    _mm_storeu_ps( lo, _mm256_castps256_ps128( v ) );
+    _mm_storeu_ps( hi, _mm256_extractf128_ps( v, 1 ) );
+}
+
+inline void store_lanes( float* out, __m256 a, __m256 b, __m256 c )
+{
+    store_halves( out, out + 12, a );
+    store_halves( out + 4, out + 16, b );
+    store_halves( out + 8, out + 20, c );
+}
+#endif
+#endif
+
+/// @brief One step of four xoshiro128+ generators, returns the output of each.
+inline __m128i xoshiro128p( __m128i& s0, __m128i& s1, __m128i& s2, __m128i& s3 )
+{
+    const __m128i result = _mm_add_epi32( s0, s3 );
+    const __m128i t = _mm_slli_epi32( s1, 9 );
+    s2 = _mm_xor_si128( s2, s0 );
+    s3 = _mm_xor_si128( s3, s1 );
+    s1 = _mm_xor_si128( s1, s2 );
+    s0 = _mm_xor_si128( s0, s3 );
+    s2 = _mm_xor_si128( s2, t );
+    s3 = _mm_or_si128( _mm_slli_epi32( s3, 11 ), _mm_srli_epi32( s3, 21 ) );
+    return result;
+}
+
+/// @brief min + ( bits >> 8 ) * scale
+inline __m128 to_uniform( __m128i bits, __m128 scale, __m128 min )
+{
+    return madd( _mm_cvtepi32_ps( _mm_srli_epi32( bits, 8 ) ), scale, min );
+}
+
+template<typename V>
+/// @brief Load packed xyz points as structure of arrays, four points per 128 bits.
+inline void load_xyz( const float* in, V& x, V& y, V& z )
+{
+    V a, b, c;
+    load_lanes( in, a, b, c );                      // x0 y0 z0 x1, y1 z1 x2 y2, z2 x3 y3 z3
+    const V t0 = shuffle<2, 3, 0, 1>( b, c );     // x2 y2 z2 x3
+    const V t1 = shuffle<1, 2, 0, 1>( a, b );     // y0 z0 y1 z1
+    const V t2 = shuffle<1, 2, 2, 3>( t0, c );    // y2 z2 y3 z3
+    x = shuffle<0, 3, 0, 3>( a, t0 );
+    y = shuffle<0, 2, 0, 2>( t1, t2 );
+    z = shuffle<1, 3, 1, 3>( t1, t2 );
+}
+
+template<typename V>
+/// @brief Store structure of arrays as packed xyz points.
+inline void store_xyz( float* out, V x, V y, V z )
+{
+    const V lo = unpack_lo( x, y );               // x0 y0 x1 y1
+    const V hi = unpack_hi( x, y );               // x2 y2 x3 y3
+    const V z0x1 = shuffle<0, 0, 2, 2>( z, lo );
+    const V y1z1 = shuffle<3, 3, 1, 1>( lo, z );
+    const V z2x3 = shuffle<2, 2, 2, 2>( z, hi );
+    const V y3z3 = shuffle<3, 3, 3, 3>( hi, z );
+    store_lanes( out, shuffle<0, 1, 0, 2>( lo, z0x1 ), shuffle<0, 2, 0, 1>( y1z1, hi ),
+                 shuffle<0, 2, 0, 2>( z2x3, y3z3 ) );
+}
+
+template<typename V>
+/// @brief The first three rows of a matrix, each element broadcast to every lane.
+struct affine_rows
+{
+    V m[12];
+
+    affine_rows( const float* matrix, bool absolute = false )
+    {
+        for ( size_t i = 0; i < 12; i++ )
+        {
+            splat( absolute ? std::abs( matrix[i] ) : matrix[i], m[i] );
+        }
+    }
+
+    /// @brief Row r times ( x, y, z, 0 ).
+    V dot3( size_t r, V x, V y, V z ) const
+    {
+        return madd( m[r * 4 + 2], z, madd( m[r * 4 + 1], y, mul( m[r * 4], x ) ) );
+    }
+
+    /// @brief Row r times ( x, y, z, 1 ).
+    V dot3_translate( size_t r, V x, V y, V z ) const
+    {
+        return madd( m[r * 4 + 2], z, madd( m[r * 4 + 1], y, madd( m[r * 4], x, m[r * 4 + 3] ) ) );
+    }
+};
+
+template<typename V>
+/// @brief Transform whole batches of points.
+/// @return number of points transformed, the rest are left to the caller
+inline size_t batch_transform_points( const float* m, const float* in, float* out, size_t count )
+{
+    constexpr size_t width = sizeof( V ) / sizeof( float );
+    const affine_rows<V> mat( m );
+    size_t i = 0;
+    for ( ; i + width <= count; i += width, in += width * 3, out += width * 3 )
+    {
+        V x, y, z;
+        load_xyz( in, x, y, z );
+        const V ox = mat.dot3_translate( 0, x, y, z );
+        const V oy = mat.dot3_translate( 1, x, y, z );
+        const V oz = mat.dot3_translate( 2, x, y, z );
+        store_xyz( out, ox, oy, oz );
+    }
+    return i;
+}
+
+template<typename V>
+/// @brief Transform whole batches of boxes, each box is loaded as two points, min then max.
+/// @return number of boxes transformed, the rest are left to the caller
+inline size_t batch_transform_aabbs( const float* m, const float* in, float* out, size_t count )
+{
+    constexpr size_t width = sizeof( V ) / sizeof( float );
+    const affine_rows<V> mat( m );
+    const affine_rows<V> abs_mat( m, true );
+    V half;
+    splat( .5f, half );
+    size_t i = 0;
+    for ( ; i + width <= count; i += width, in += width * 6, out += width * 6 )
+    {
+        V x0, y0, z0, x1, y1, z1;
+        load_xyz( in, x0, y0, z0 );
+        load_xyz( in + width * 3, x1, y1, z1 );
+        const V min_x = shuffle<0, 2, 0, 2>( x0, x1 );
+        const V max_x = shuffle<1, 3, 1, 3>( x0, x1 );
+        const V min_y = shuffle<0, 2, 0, 2>( y0, y1 );
+        const V max_y = shuffle<1, 3, 1, 3>( y0, y1 );
+        const V min_z = shuffle<0, 2, 0, 2>( z0, z1 );
+        const V max_z = shuffle<1, 3, 1, 3>( z0, z1 );
+        const V cx = mul( add( min_x, max_x ), half );
+        const V cy = mul( add( min_y, max_y ), half );
+        const V cz = mul( add( min_z, max_z ), half );
+        const V ex = mul( sub( max_x, min_x ), half );
+        const V ey = mul( sub( max_y, min_y ), half );
+        const V ez = mul( sub( max_z, min_z ), half );
+        V lo[3];
+        V hi[3];
+        for ( size_t r = 0; r < 3; r++ )
+        {
+            const V c = mat.dot3_translate( r, cx, cy, cz );
+            const V e = abs_mat.dot3( r, ex, ey, ez );
+            lo[r] = sub( c, e );
+            hi[r] = add( c, e );
+        }
+        // back to min then max per box
+        store_xyz( out, unpack_lo( lo[0], hi[0] ), unpack_lo( lo[1], hi[1] ), unpack_lo( lo[2], hi[2] ) );
+        store_xyz( out + width * 3, unpack_hi( lo[0], hi[0] ), unpack_hi( lo[1], hi[1] ), unpack_hi( lo[2], hi[2] ) );
+    }
+    return i;
+}
+
+template<typename V>
+/// @brief Six planes with each element broadcast to every lane.
+struct frustum_planes
+{
+    V n[24];
+    V abs_n[24];
+
+    explicit frustum_planes( const float* planes )
+    {
+        for ( size_t i = 0; i < 24; i++ )
+        {
+            splat( planes[i], n[i] );
+            splat( std::abs( planes[i] ), abs_n[i] );
+        }
+    }
+
+    /// @brief Signed distance of ( x, y, z ) to plane p.
+    V distance( size_t p, V x, V y, V z ) const
+    {
+        return madd( n[p * 4 + 2], z, madd( n[p * 4 + 1], y, madd( n[p * 4], x, n[p * 4 + 3] ) ) );
+    }
+
+    /// @brief Half extents ( x, y, z ) projected onto the normal of plane p.
+    V radius( size_t p, V x, V y, V z ) const
+    {
+        return madd( abs_n[p * 4 + 2], z, madd( abs_n[p * 4 + 1], y, mul( abs_n[p * 4], x ) ) );
+    }
+};
+
+template<typename V>
+/// @brief Cull whole batches of boxes from box i on, each box is loaded as two points, min then max.
+/// @param[in,out] written : number of indices in visible
+/// @return index of the first box left to the caller
+inline size_t batch_cull_aabbs( const float* planes, const float* boxes, size_t i, size_t count, uint32_t* visible,
+                                size_t& written )
+{
+    constexpr size_t width = sizeof( V ) / sizeof( float );
+    constexpr uint32_t all_lanes = ( 1u << width ) - 1u;
+    const frustum_planes<V> frustum( planes );
+    V half;
+    splat( .5f, half );
+    for ( ; i + width <= count; i += width )
+    {
+        const float* in = boxes + i * 6;
+        V x0, y0, z0, x1, y1, z1;
+        load_xyz( in, x0, y0, z0 );
+        load_xyz( in + width * 3, x1, y1, z1 );
+        const V min_x = shuffle<0, 2, 0, 2>( x0, x1 );
+        const V max_x = shuffle<1, 3, 1, 3>( x0, x1 );
+        const V min_y = shuffle<0, 2, 0, 2>( y0, y1 );
+        const V max_y = shuffle<1, 3, 1, 3>( y0, y1 );
+        const V min_z = shuffle<0, 2, 0, 2>( z0, z1 );
+        const V max_z = shuffle<1, 3, 1, 3>( z0, z1 );
+        const V cx = mul( add( min_x, max_x ), half );
+        const V cy = mul( add( min_y, max_y ), half );
+        const V cz = mul( add( min_z, max_z ), half );
+        const V ex = mul( sub( max_x, min_x ), half );
+        const V ey = mul( sub( max_y, min_y ), half );
+        const V ez = mul( sub( max_z, min_z ), half );
+        // a box is culled when it is entirely behind any plane
+        V nearest = add( frustum.distance( 0, cx, cy, cz ), frustum.radius( 0, ex, ey, ez ) );
+        for ( size_t p = 1; p < 6; p++ )
+        {
+            nearest = minimum( nearest, add( frustum.distance( p, cx, cy, cz ), frustum.radius( p, ex, ey, ez ) ) );
+        }
+        const uint32_t mask = box_lanes( ~negative_lanes( nearest ) & all_lanes, V{} );
+        written += scalar::append_indices( visible + written, static_cast<uint32_t>( i ), mask, width );
+    }
+    return i;
+}
+
+template<typename V>
+/// @brief Cull whole batches of spheres from sphere i on.
+/// @see batch_cull_aabbs
+inline size_t batch_cull_spheres( const float* planes, const float* spheres, size_t i, size_t count,
+                                  uint32_t* visible, size_t& written )
+{
+    constexpr size_t width = sizeof( V ) / sizeof( float );
+    constexpr uint32_t all_lanes = ( 1u << width ) - 1u;
+    const frustum_planes<V> frustum( planes );
+    for ( ; i + width <= count; i += width )
+    {
+        V a, b, c, d;
+        load_quads( spheres + i * 4, a, b, c, d );
+        const V t0 = unpack_lo( a, b );                // x0 x1 y0 y1
+        const V t1 = unpack_lo( c, d );                // x2 x3 y2 y3
+        const V t2 = unpack_hi( a, b );                // z0 z1 r0 r1
+        const V t3 = unpack_hi( c, d );                // z2 z3 r2 r3
+        const V x = shuffle<0, 1, 0, 1>( t0, t1 );
+        const V y = shuffle<2, 3, 2, 3>( t0, t1 );
+        const V z = shuffle<0, 1, 0, 1>( t2, t3 );
+        const V radius = shuffle<2, 3, 2, 3>( t2, t3 );
+        // the radius is the same for every plane, so only the nearest plane needs it
+        V nearest = frustum.distance( 0, x, y, z );
+        for ( size_t p = 1; p < 6; p++ )
+        {
+            nearest = minimum( nearest, frustum.distance( p, x, y, z ) );
+        }
+        const uint32_t mask = ~negative_lanes( add( nearest, radius ) ) & all_lanes;
+        written += scalar::append_indices( visible + written, static_cast<uint32_t>( i ), mask, width );
+    }
+    return i;
+}
+}
+
+inline void mat4_multiply( const float* a, const float* b, float* out )
+{
+#if defined(FNX_SIMD_AVX)
+    const __m256 b0 = detail::broadcast_row( b );
+    const __m256 b1 = detail::broadcast_row( b + 4 );
+    const __m256 b2 = detail::broadcast_row( b + 8 );
+    const __m256 b3 = detail::broadcast_row( b + 12 );
+    const __m256 r01 = detail::multiply_rows( _mm256_loadu_ps( a ), b0, b1, b2, b3 );
+    const __m256 r23 = detail::multiply_rows( _mm256_loadu_ps( a + 8 ), b0, b1, b2, b3 );
+    detail::store_rows( out, r01, r23 );
+#else
+    const __m128 b0 = _mm_loadu_ps( b );
+    const __m128 b1 = _mm_loadu_ps( b + 4 );
+    const __m128 b2 = _mm_loadu_ps( b + 8 );
+    const __m128 b3 = _mm_loadu_ps( b + 12 );
+    __m128 r[4];
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        // each output row is a linear combination of the rows of b
+        r[i] = detail::multiply_row( _mm_loadu_ps( a + i * 4 ), b0, b1, b2, b3 );
+    }
+    detail::store_rows( out, r[0], r[1], r[2], r[3] );
+#endif
+}
+
+inline void mat4_affine_multiply( const float* a, const float* b, float* out )
+{
+    const __m128 b0 = _mm_loadu_ps( b );
+    const __m128 b1 = _mm_loadu_ps( b + 4 );
+    const __m128 b2 = _mm_loadu_ps( b + 8 );
+    const __m128 b3 = _mm_loadu_ps( b + 12 );
+    __m128 r[3];
+    for ( size_t i = 0; i < 3; i++ )
+    {
+        r[i] = detail::multiply_row( _mm_loadu_ps( a + i * 4 ), b0, b1, b2, b3 );
+    }
+    detail::store_rows( out, r[0], r[1], r[2], _mm_setr_ps( 0.f, 0.f, 0.f, 1.f ) );
+}
+
+inline void mat4_transform( const float* m, const float* v, float* out )
+{
+    __m128 c0 = _mm_loadu_ps( m );
+    __m128 c1 = _mm_loadu_ps( m + 4 );
+    __m128 c2 = _mm_loadu_ps( m + 8 );
+    __m128 c3 = _mm_loadu_ps( m + 12 );
+    _MM_TRANSPOSE4_PS( c0, c1, c2, c3 );
+    __m128 r = _mm_mul_ps( c0, _mm_set1_ps( v[0] ) );
+    r = detail::madd( c1, _mm_set1_ps( v[1] ), r );
+    r = detail::madd( c2, _mm_set1_ps( v[2] ), r );
+    r = detail::madd( c3, _mm_set1_ps( v[3] ), r );
+    _mm_storeu_ps( out, r );
+}
+
+inline void mat4_transpose( const float* m, float* out )
+{
+    const __m128 r0 = _mm_loadu_ps( m );
+    const __m128 r1 = _mm_loadu_ps( m + 4 );
+    const __m128 r2 = _mm_loadu_ps( m + 8 );
+    const __m128 r3 = _mm_loadu_ps( m + 12 );
+    // split into even and odd columns, then merge each pair of rows
+    const __m128 even01 = FNX_SSE_SHUFFLE( r0, r1, 0, 2, 0, 2 );
+    const __m128 odd01 = FNX_SSE_SHUFFLE( r0, r1, 1, 3, 1, 3 );
+    const __m128 even23 = FNX_SSE_SHUFFLE( r2, r3, 0, 2, 0, 2 );
+    const __m128 odd23 = FNX_SSE_SHUFFLE( r2, r3, 1, 3, 1, 3 );
+    detail::store_rows( out, FNX_SSE_SHUFFLE( even01, even23, 0, 2, 0, 2 ), FNX_SSE_SHUFFLE( odd01, odd23, 0, 2, 0, 2 ),
+                        FNX_SSE_SHUFFLE( even01, even23, 1, 3, 1, 3 ), FNX_SSE_SHUFFLE( odd01, odd23, 1, 3, 1, 3 ) );
+}
+
+inline void mat4_scale_rows( const float* m, float sx, float sy, float sz, float* out )
+{
+    detail::store_rows( out, _mm_mul_ps( _mm_loadu_ps( m ), _mm_set1_ps( sx ) ),
+                        _mm_mul_ps( _mm_loadu_ps( m + 4 ), _mm_set1_ps( sy ) ),
+                        _mm_mul_ps( _mm_loadu_ps( m + 8 ), _mm_set1_ps( sz ) ), _mm_loadu_ps( m + 12 ) );
+}
+
+inline void mat4_translate( const float* m, float x, float y, float z, float* out )
+{
+    // multiply by the translation matrix built in registers, keeping the result in vector registers avoids
+    // store forwarding stalls when it feeds the next kernel
+    const __m128 t0 = _mm_setr_ps( 1.f, 0.f, 0.f, x );
+    const __m128 t1 = _mm_setr_ps( 0.f, 1.f, 0.f, y );
+    const __m128 t2 = _mm_setr_ps( 0.f, 0.f, 1.f, z );
+    const __m128 t3 = _mm_setr_ps( 0.f, 0.f, 0.f, 1.f );
+    __m128 r[4];
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        r[i] = detail::multiply_row( _mm_loadu_ps( m + i * 4 ), t0, t1, t2, t3 );
+    }
+    detail::store_rows( out, r[0], r[1], r[2], r[3] );
+}
+
+/// @brief Inverse by 2x2 blocks, M = | A B | with |M| = |A||D| + |B||C| - tr( adj( A ) B adj( D ) C )
+///                                   | C D |
+inline void mat4_inverse( const float* m, float* out )
+{
+    const __m128 r0 = _mm_loadu_ps( m );
+    const __m128 r1 = _mm_loadu_ps( m + 4 );
+    const __m128 r2 = _mm_loadu_ps( m + 8 );
+    const __m128 r3 = _mm_loadu_ps( m + 12 );
+
+    // 2x2 sub matrices
+    const __m128 a = _mm_movelh_ps( r0, r1 );
+    const __m128 b = _mm_movehl_ps( r1, r0 );
+    const __m128 c = _mm_movelh_ps( r2, r3 );
+    const __m128 d = _mm_movehl_ps( r3, r2 );
+
+    // ( |A|, |B|, |C|, |D| )
+    const __m128 det_sub = _mm_sub_ps(
+                               _mm_mul_ps( FNX_SSE_SHUFFLE( r0, r2, 0, 2, 0, 2 ), FNX_SSE_SHUFFLE( r1, r3, 1, 3, 1, 3 ) ),
+                               _mm_mul_ps( FNX_SSE_SHUFFLE( r0, r2, 1, 3, 1, 3 ), FNX_SSE_SHUFFLE( r1, r3, 0, 2, 0, 2 ) ) );
+    const __m128 det_a = FNX_SSE_SWIZZLE( det_sub, 0, 0, 0, 0 );
+    const __m128 det_b = FNX_SSE_SWIZZLE( det_sub, 1, 1, 1, 1 );
+    const __m128 det_c = FNX_SSE_SWIZZLE( det_sub, 2, 2, 2, 2 );
+    const __m128 det_d = FNX_SSE_SWIZZLE( det_sub, 3, 3, 3, 3 );
+
+    const __m128 d_c = detail::mat2_adjugate_multiply( d, c );
+    const __m128 a_b = detail::mat2_adjugate_multiply( a, b );
+
+    // adjugates of the blocks of the inverse
+    __m128 x = _mm_sub_ps( _mm_mul_ps( det_d, a ), detail::mat2_multiply( b, d_c ) );
+    __m128 w = _mm_sub_ps( _mm_mul_ps( det_a, d ), detail::mat2_multiply( c, a_b ) );
+    __m128 y = _mm_sub_ps( _mm_mul_ps( det_b, c ), detail::mat2_multiply_adjugate( d, a_b ) );
+    __m128 z = _mm_sub_ps( _mm_mul_ps( det_c, b ), detail::mat2_multiply_adjugate( a, d_c ) );
+
+    __m128 tr = _mm_mul_ps( a_b, FNX_SSE_SWIZZLE( d_c, 0, 2, 1, 3 ) );
+    tr = _mm_add_ps( tr, FNX_SSE_SWIZZLE( tr, 1, 0, 3, 2 ) );
+    tr = _mm_add_ps( tr, FNX_SSE_SWIZZLE( tr, 2, 3, 0, 1 ) );
+    const __m128 det = _mm_sub_ps( _mm_add_ps( _mm_mul_ps( det_a, det_d ), _mm_mul_ps( det_b, det_c ) ), tr );
+
+    const __m128 rcp_det = _mm_div_ps( _mm_setr_ps( 1.f, -1.f, -1.f, 1.f ), det );
+    x = _mm_mul_ps( x, rcp_det );
+    y = _mm_mul_ps( y, rcp_det );
+    z = _mm_mul_ps( z, rcp_det );
+    w = _mm_mul_ps( w, rcp_det );
+
+    // the final shuffle applies the adjugate and puts the blocks back into rows
+    detail::store_rows( out, FNX_SSE_SHUFFLE( x, y, 3, 1, 3, 1 ), FNX_SSE_SHUFFLE( x, y, 2, 0, 2, 0 ),
+                        FNX_SSE_SHUFFLE( z, w, 3, 1, 3, 1 ), FNX_SSE_SHUFFLE( z, w, 2, 0, 2, 0 ) );
+}
+
+inline void transform_points( const float* m, const float* in, float* out, size_t count )
+{
+    // batches of points in structure of arrays form, eight at a time with avx then four at a time
+    size_t done = 0;
+#if defined(FNX_SIMD_AVX)
+    done += detail::batch_transform_points<__m256>( m, in, out, count );
+#endif
+    done += detail::batch_transform_points<__m128>( m, in + done * 3, out + done * 3, count - done );
+    scalar::transform_points( m, in + done * 3, out + done * 3, count - done );
+}
+
+inline void transform_aabbs( const float* m, const float* in, float* out, size_t count )
+{
+    size_t done = 0;
+#if defined(FNX_SIMD_AVX)
+    done += detail::batch_transform_aabbs<__m256>( m, in, out, count );
+#endif
+    done += detail::batch_transform_aabbs<__m128>( m, in + done * 6, out + done * 6, count - done );
+    scalar::transform_aabbs( m, in + done * 6, out + done * 6, count - done );
+}
+
+inline void fill_uniform( uint32_t* state, float* out, size_t count, float min, float max )
+{
+    // generators 0-3 and 4-7 are stepped independently to hide the latency of each step
+    __m128i a[4];
+    __m128i b[4];
+    for ( size_t k = 0; k < 4; k++ )
+    {
+        a[k] = _mm_loadu_si128( reinterpret_cast<const __m128i*>( state + k * 8 ) );
+        b[k] = _mm_loadu_si128( reinterpret_cast<const __m128i*>( state + k * 8 + 4 ) );
+    }
+    const __m128 scale = _mm_set1_ps( ( max - min ) / 16777216.f );
+    const __m128 offset = _mm_set1_ps( min );
+    size_t i = 0;
+    for ( ; i + 8 <= count; i += 8 )
+    {
+        const __m128i ra = detail::xoshiro128p( a[0], a[1], a[2], a[3] );
+        const __m128i rb = detail::xoshiro128p( b[0], b[1], b[2], b[3] );
+        _mm_storeu_ps( out + i, detail::to_uniform( ra, scale, offset ) );
+        _mm_storeu_ps( out + i + 4, detail::to_uniform( rb, scale, offset ) );
+    }
+    if ( i < count )
+    {
+        float last[8];
+        _mm_storeu_ps( last, detail::to_uniform( detail::xoshiro128p( a[0], a[1], a[2], a[3] ), scale, offset ) );
+        _mm_storeu_ps( last + 4, detail::to_uniform( detail::xoshiro128p( b[0], b[1], b[2], b[3] ), scale, offset ) );
+        for ( size_t l = 0; i + l < count; l++ )
+        {
+            out[i + l] = last[l];
+        }
+    }
+    for ( size_t k = 0; k < 4; k++ )
+    {
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( state + k * 8 ), a[k] );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( state + k * 8 + 4 ), b[k] );
+    }
+}
+
+inline size_t cull_aabbs( const float* planes, const float* boxes, size_t count, uint32_t* visible )
+{
+    size_t i = 0;
+    size_t n = 0;
+#if defined(FNX_SIMD_AVX)
+    i = detail::batch_cull_aabbs<__m256>( planes, boxes, i, count, visible, n );
+#endif
+    i = detail::batch_cull_aabbs<__m128>( planes, boxes, i, count, visible, n );
+    return n + scalar::cull_aabbs( planes, boxes + i * 6, count - i, visible + n, static_cast<uint32_t>( i ) );
+}
+
+inline size_t cull_spheres( const float* planes, const float* spheres, size_t count, uint32_t* visible )
+{
+    size_t i = 0;
+    size_t n = 0;
+#if defined(FNX_SIMD_AVX)
+    i = detail::batch_cull_spheres<__m256>( planes, spheres, i, count, visible, n );
+#endif
+    i = detail::batch_cull_spheres<__m128>( planes, spheres, i, count, visible, n );
+    return n + scalar::cull_spheres( planes, spheres + i * 4, count - i, visible + n, static_cast<uint32_t>( i ) );
+}
+
+inline void multiply_add( const float* in, float weight, float* out, size_t count )
+{
+    size_t i = 0;
+#if defined(FNX_SIMD_AVX)
+    const __m256 w8 = _mm256_set1_ps( weight );
+    for ( ; i + 8 <= count; i += 8 )
+    {
+        _mm256_storeu_ps( out + i, detail::madd( _mm256_loadu_ps( in + i ), w8, _mm256_loadu_ps( out + i ) ) );
+    }
+#endif
+    const __m128 w = _mm_set1_ps( weight );
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        _mm_storeu_ps( out + i, detail::madd( _mm_loadu_ps( in + i ), w, _mm_loadu_ps( out + i ) ) );
+    }
+    scalar::multiply_add( in + i, weight, out + i, count - i );
+}
+
+inline void weighted_sum4( const float* pixels, const float* weights, size_t count, float* out )
+{
+    // a pixel is a whole register, two accumulators hide the latency of the multiply adds
+    __m128 r0 = _mm_setzero_ps();
+    __m128 r1 = _mm_setzero_ps();
+    size_t k = 0;
+    for ( ; k + 2 <= count; k += 2 )
+    {
+        r0 = detail::madd( _mm_loadu_ps( pixels + k * 4 ), _mm_set1_ps( weights[k] ), r0 );
+        r1 = detail::madd( _mm_loadu_ps( pixels + k * 4 + 4 ), _mm_set1_ps( weights[k + 1] ), r1 );
+    }
+    if ( k < count )
+    {
+        r0 = detail::madd( _mm_loadu_ps( pixels + k * 4 ), _mm_set1_ps( weights[k] ), r0 );
+    }
+    _mm_storeu_ps( out, _mm_add_ps( r0, r1 ) );
+}
+
+#undef FNX_SSE_SWIZZLE
+#undef FNX_SSE_SHUFFLE
+
+#elif defined(FNX_SIMD_NEON)
+
+inline void mat4_multiply( const float* a, const float* b, float* out )
+{
+    const float32x4_t b0 = vld1q_f32( b );
+    const float32x4_t b1 = vld1q_f32( b + 4 );
+    const float32x4_t b2 = vld1q_f32( b + 8 );
+    const float32x4_t b3 = vld1q_f32( b + 12 );
+    float32x4_t r[4];
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        // each output row is a linear combination of the rows of b, vmla is not fused
+        const float* row = a + i * 4;
+        r[i] = vmulq_n_f32( b0, row[0] );
+        r[i] = vmlaq_n_f32( r[i], b1, row[1] );
+        r[i] = vmlaq_n_f32( r[i], b2, row[2] );
+        r[i] = vmlaq_n_f32( r[i], b3, row[3] );
+    }
+    vst1q_f32( out, r[0] );
+    vst1q_f32( out + 4, r[1] );
+    vst1q_f32( out + 8, r[2] );
+    vst1q_f32( out + 12, r[3] );
+}
+
+inline void mat4_affine_multiply( const float* a, const float* b, float* out )
+{
+    const float32x4_t b0 = vld1q_f32( b );
+    const float32x4_t b1 = vld1q_f32( b + 4 );
+    const float32x4_t b2 = vld1q_f32( b + 8 );
+    const float32x4_t b3 = vld1q_f32( b + 12 );
+    float32x4_t r[3];
+    for ( size_t i = 0; i < 3; i++ )
+    {
+        const float* row = a + i * 4;
+        r[i] = vmulq_n_f32( b0, row[0] );
+        r[i] = vmlaq_n_f32( r[i], b1, row[1] );
+        r[i] = vmlaq_n_f32( r[i], b2, row[2] );
+        r[i] = vmlaq_n_f32( r[i], b3, row[3] );
+    }
+    const float last[4] = { 0.f, 0.f, 0.f, 1.f };
+    vst1q_f32( out, r[0] );
+    vst1q_f32( out + 4, r[1] );
+    vst1q_f32( out + 8, r[2] );
+    vst1q_f32( out + 12, vld1q_f32( last ) );
+}
+
+inline void mat4_transform( const float* m, const float* v, float* out )
+{
+    // vld4 de-interleaves the rows into columns
+    const float32x4x4_t c = vld4q_f32( m );
+    float32x4_t r = vmulq_n_f32( c.val[0], v[0] );
+    r = vmlaq_n_f32( r, c.val[1], v[1] );
+    r = vmlaq_n_f32( r, c.val[2], v[2] );
+    r = vmlaq_n_f32( r, c.val[3], v[3] );
+    vst1q_f32( out, r );
+}
+
+inline void mat4_transpose( const float* m, float* out )
+{
+    const float32x4x4_t c = vld4q_f32( m );
+    vst1q_f32( out, c.val[0] );
+    vst1q_f32( out + 4, c.val[1] );
+    vst1q_f32( out + 8, c.val[2] );
+    vst1q_f32( out + 12, c.val[3] );
+}
+
+inline void mat4_scale_rows( const float* m, float sx, float sy, float sz, float* out )
+{
+    const float32x4_t r3 = vld1q_f32( m + 12 );
+    vst1q_f32( out, vmulq_n_f32( vld1q_f32( m ), sx ) );
+    vst1q_f32( out + 4, vmulq_n_f32( vld1q_f32( m + 4 ), sy ) );
+    vst1q_f32( out + 8, vmulq_n_f32( vld1q_f32( m + 8 ), sz ) );
+    vst1q_f32( out + 12, r3 );
+}
+
+inline void mat4_translate( const float* m, float x, float y, float z, float* out )
+{
+    const float identity[16] = { 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f };
+    const float32x4_t t0 = vsetq_lane_f32( x, vld1q_f32( identity ), 3 );
+    const float32x4_t t1 = vsetq_lane_f32( y, vld1q_f32( identity + 4 ), 3 );
+    const float32x4_t t2 = vsetq_lane_f32( z, vld1q_f32( identity + 8 ), 3 );
+    const float32x4_t t3 = vld1q_f32( identity + 12 );
+    float32x4_t r[4];
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        const float* row = m + i * 4;
+        r[i] = vmulq_n_f32( t0, row[0] );
+        r[i] = vmlaq_n_f32( r[i], t1, row[1] );
+        r[i] = vmlaq_n_f32( r[i], t2, row[2] );
+        r[i] = vmlaq_n_f32( r[i], t3, row[3] );
+    }
+    vst1q_f32( out, r[0] );
+    vst1q_f32( out + 4, r[1] );
+    vst1q_f32( out + 8, r[2] );
+    vst1q_f32( out + 12, r[3] );
+}
+
+inline void transform_points( const float* m, const float* in, float* out, size_t count )
+{
+    // vld3 and vst3 convert four packed points to and from structure of arrays
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4, in += 12, out += 12 )
+    {
+        const float32x4x3_t p = vld3q_f32( in );
+        float32x4x3_t r;
+        for ( size_t k = 0; k < 3; k++ )
+        {
+            const float* row = m + k * 4;
+            r.val[k] = vmlaq_n_f32( vdupq_n_f32( row[3] ), p.val[0], row[0] );
+            r.val[k] = vmlaq_n_f32( r.val[k], p.val[1], row[1] );
+            r.val[k] = vmlaq_n_f32( r.val[k], p.val[2], row[2] );
+        }
+        vst3q_f32( out, r );
+    }
+    scalar::transform_points( m, in, out, count - i );
+}
+
+inline void transform_aabbs( const float* m, const float* in, float* out, size_t count )
+{
+    // four boxes per iteration, each box is loaded as two points, min then max
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4, in += 24, out += 24 )
+    {
+        const float32x4x3_t p0 = vld3q_f32( in );
+        const float32x4x3_t p1 = vld3q_f32( in + 12 );
+        float32x4_t center[3];
+        float32x4_t extent[3];
+        for ( size_t k = 0; k < 3; k++ )
+        {
+            const float32x4x2_t min_max = vuzpq_f32( p0.val[k], p1.val[k] );
+            center[k] = vmulq_n_f32( vaddq_f32( min_max.val[0], min_max.val[1] ), .5f );
+            extent[k] = vmulq_n_f32( vsubq_f32( min_max.val[1], min_max.val[0] ), .5f );
+        }
+        float32x4x3_t r0;
+        float32x4x3_t r1;
+        for ( size_t k = 0; k < 3; k++ )
+        {
+            const float* row = m + k * 4;
+            float32x4_t c = vmlaq_n_f32( vdupq_n_f32( row[3] ), center[0], row[0] );
+            c = vmlaq_n_f32( c, center[1], row[1] );
+            c = vmlaq_n_f32( c, center[2], row[2] );
+            float32x4_t e = vmulq_n_f32( extent[0], std::abs( row[0] ) );
+            e = vmlaq_n_f32( e, extent[1], std::abs( row[1] ) );
+            e = vmlaq_n_f32( e, extent[2], std::abs( row[2] ) );
+            const float32x4x2_t min_max = vzipq_f32( vsubq_f32( c, e ), vaddq_f32( c, e ) );
+            r0.val[k] = min_max.val[0];
+            r1.val[k] = min_max.val[1];
+        }
+        vst3q_f32( out, r0 );
+        vst3q_f32( out + 12, r1 );
+    }
+    scalar::transform_aabbs( m, in, out, count - i );
+}
+
+inline void fill_uniform( uint32_t* state, float* out, size_t count, float min, float max )
+{
+    uint32x4_t a[4];
+    uint32x4_t b[4];
+    for ( size_t k = 0; k < 4; k++ )
+    {
+        a[k] = vld1q_u32( state + k * 8 );
+        b[k] = vld1q_u32( state + k * 8 + 4 );
+    }
+    const float scale = ( max - min ) / 16777216.f;
+    const float32x4_t offset = vdupq_n_f32( min );
+    auto step = []( uint32x4_t* s )
+    {
+        const uint32x4_t result = vaddq_u32( s[0], s[3] );
+        const uint32x4_t t = vshlq_n_u32( s[1], 9 );
+        s[2] = veorq_u32( s[2], s[0] );
+        s[3] = veorq_u32( s[3], s[1] );
+        s[1] = veorq_u32( s[1], s[2] );
+        s[0] = veorq_u32( s[0], s[3] );
+        s[2] = veorq_u32( s[2], t );
+        s[3] = vorrq_u32( vshlq_n_u32( s[3], 11 ), vshrq_n_u32( s[3], 21 ) );
+        return result;
+    };
+    auto to_uniform = [&]( uint32x4_t bits )
+    {
+        return vmlaq_n_f32( offset, vcvtq_f32_u32( vshrq_n_u32( bits, 8 ) ), scale );
+    };
+    size_t i = 0;
+    for ( ; i + 8 <= count; i += 8 )
+    {
+        vst1q_f32( out + i, to_uniform( step( a ) ) );
+        vst1q_f32( out + i + 4, to_uniform( step( b ) ) );
+    }
+    if ( i < count )
+    {
+        float last[8];
+        vst1q_f32( last, to_uniform( step( a ) ) );
+        vst1q_f32( last + 4, to_uniform( step( b ) ) );
+        for ( size_t l = 0; i + l < count; l++ )
+        {
+            out[i + l] = last[l];
+        }
+    }
+    for ( size_t k = 0; k < 4; k++ )
+    {
+        vst1q_u32( state + k * 8, a[k] );
+        vst1q_u32( state + k * 8 + 4, b[k] );
+    }
+}
+
+namespace detail
+{
+/// @brief Bit mask of the lanes that are not below zero.
+inline uint32_t non_negative_lanes( float32x4_t a )
+{
+    const uint32x4_t below = vcltq_f32( a, vdupq_n_f32( 0.f ) );
+    return ~( ( vgetq_lane_u32( below, 0 ) & 1u ) | ( vgetq_lane_u32( below, 1 ) & 2u ) |
+              ( vgetq_lane_u32( below, 2 ) & 4u ) | ( vgetq_lane_u32( below, 3 ) & 8u ) ) & 0xfu;
+}
+
+/// @brief Signed distance of ( x, y, z ) to a plane.
+inline float32x4_t plane_distance( const float* plane, float32x4_t x, float32x4_t y, float32x4_t z )
+{
+    float32x4_t d = vmlaq_n_f32( vdupq_n_f32( plane[3] ), x, plane[0] );
+    d = vmlaq_n_f32( d, y, plane[1] );
+    return vmlaq_n_f32( d, z, plane[2] );
+}
+}
+
+inline size_t cull_aabbs( const float* planes, const float* boxes, size_t count, uint32_t* visible )
+{
+    size_t i = 0;
+    size_t n = 0;
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        const float32x4x3_t p0 = vld3q_f32( boxes + i * 6 );
+        const float32x4x3_t p1 = vld3q_f32( boxes + i * 6 + 12 );
+        float32x4_t center[3];
+        float32x4_t extent[3];
+        for ( size_t k = 0; k < 3; k++ )
+        {
+            const float32x4x2_t min_max = vuzpq_f32( p0.val[k], p1.val[k] );
+            center[k] = vmulq_n_f32( vaddq_f32( min_max.val[0], min_max.val[1] ), .5f );
+            extent[k] = vmulq_n_f32( vsubq_f32( min_max.val[1], min_max.val[0] ), .5f );
+        }
+        float32x4_t nearest = vdupq_n_f32( 0.f );
+        for ( size_t p = 0; p < 6; p++ )
+        {
+            const float* plane = planes + p * 4;
+            float32x4_t r = vmulq_n_f32( extent[0], std::abs( plane[0] ) );
+            r = vmlaq_n_f32( r, extent[1], std::abs( plane[1] ) );
+            r = vmlaq_n_f32( r, extent[2], std::abs( plane[2] ) );
+            const float32x4_t d = vaddq_f32( detail::plane_distance( plane, center[0], center[1], center[2] ), r );
+            nearest = p == 0 ? d : vminq_f32( nearest, d );
+        }
+        n += scalar::append_indices( visible + n, static_cast<uint32_t>( i ), detail::non_negative_lanes( nearest ), 4u );
+    }
+    return n + scalar::cull_aabbs( planes, boxes + i * 6, count - i, visible + n, static_cast<uint32_t>( i ) );
+}
+
+inline size_t cull_spheres( const float* planes, const float* spheres, size_t count, uint32_t* visible )
+{
+    // vld4 de-interleaves four spheres into x, y, z and radius
+    size_t i = 0;
+    size_t n = 0;
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        const float32x4x4_t s = vld4q_f32( spheres + i * 4 );
+        float32x4_t nearest = detail::plane_distance( planes, s.val[0], s.val[1], s.val[2] );
+        for ( size_t p = 1; p < 6; p++ )
+        {
+            nearest = vminq_f32( nearest, detail::plane_distance( planes + p * 4, s.val[0], s.val[1], s.val[2] ) );
+        }
+        n += scalar::append_indices( visible + n, static_cast<uint32_t>( i ),
+                                     detail::non_negative_lanes( vaddq_f32( nearest, s.val[3] ) ), 4u );
+    }
+    return n + scalar::cull_spheres( planes, spheres + i * 4, count - i, visible + n, static_cast<uint32_t>( i ) );
+}
+
+inline void multiply_add( const float* in, float weight, float* out, size_t count )
+{
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        vst1q_f32( out + i, vmlaq_n_f32( vld1q_f32( out + i ), vld1q_f32( in + i ), weight ) );
+    }
+    scalar::multiply_add( in + i, weight, out + i, count - i );
+}
+
+inline void weighted_sum4( const float* pixels, const float* weights, size_t count, float* out )
+{
+    float32x4_t r0 = vdupq_n_f32( 0.f );
+    float32x4_t r1 = vdupq_n_f32( 0.f );
+    size_t k = 0;
+    for ( ; k + 2 <= count; k += 2 )
+    {
+        r0 = vmlaq_n_f32( r0, vld1q_f32( pixels + k * 4 ), weights[k] );
+        r1 = vmlaq_n_f32( r1, vld1q_f32( pixels + k * 4 + 4 ), weights[k + 1] );
+    }
+    if ( k < count )
+    {
+        r0 = vmlaq_n_f32( r0, vld1q_f32( pixels + k * 4 ), weights[k] );
+    }
+    vst1q_f32( out, vaddq_f32( r0, r1 ) );
+}
+
+#endif
+
+template<typename T>
+/// @brief out[i] = a[i] * b[i] for count matrices.
+inline void mat4_multiply_array( const T* a, const T* b, T* out, size_t count )
+{
+    for ( size_t i = 0; i < count * 16; i += 16 )
+    {
+        mat4_multiply( a + i, b + i, out + i );
+    }
+}
+}
+}
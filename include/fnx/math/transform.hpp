@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cassert>
+
+namespace fnx
+{
+static_assert( sizeof( fnx::vector3 ) == 3 * sizeof( fnx::decimal ), "batched transforms expect packed vector3" );
+static_assert( sizeof( fnx::matrix4x4 ) == 16 * sizeof( fnx::decimal ), "batched transforms expect packed matrices" );
+static_assert( sizeof( reactphysics3d::AABB ) == 6 * sizeof( fnx::decimal ), "batched transforms expect aabb as min then max" );
+
+/// @brief Transform points by an affine matrix, out[i] = matrix * ( in[i], 1 ).
+/// @param[in] matrix : affine transform, the last row is ignored
+/// @param[in] in : points to transform
+/// @param[out] out : transformed points, must hold at least in.size() points and may be the same array as in
+/// @note Processes several points per instruction, prefer this to transforming one point at a time.
+inline void transform_points( const fnx::matrix4x4& matrix, fnx::span<const fnx::vector3> in,
+                              fnx::span<fnx::vector3> out )
+{
+    assert( out.size() >= in.size() );
+    fnx::simd::transform_points( matrix.data(), reinterpret_cast<const fnx::decimal*>( in.data() ),
+                                 reinterpret_cast<fnx::decimal*>( out.data() ), in.size() );
+}
+
+/// @brief Compose transforms, out[i] = parents[i] * locals[i].
+/// @param[out] out : must hold at least parents.size() matrices and may be the same array as either input
+inline void transform_matrices( fnx::span<const fnx::matrix4x4> parents, fnx::span<const fnx::matrix4x4> locals,
+                                fnx::span<fnx::matrix4x4> out )
+{
+    assert( locals.size() >= parents.size() && out.size() >= parents.size() );
+    fnx::simd::mat4_multiply_array( reinterpret_cast<const fnx::decimal*>( parents.data() ),
+                                    reinterpret_cast<const fnx::decimal*>( locals.data() ),
+                                    reinterpret_cast<fnx::decimal*>( out.data() ), parents.size() );
+}
+
+/// @brief Axis aligned bounds of boxes after an affine transform.
+/// @param[in] matrix : affine transform, the last row is ignored
+/// @param[in] in : boxes to transform
+/// @param[out] out : bounds of the transformed boxes, must hold at least in.size() boxes and may be the same array as in
+/// @note The result encloses the rotated box, it is not the tightest bound of the original geometry.
+inline void transform_aabbs( const fnx::matrix4x4& matrix, fnx::span<const reactphysics3d::AABB> in,
+                             fnx::span<reactphysics3d::AABB> out )
+{
+    assert( out.size() >= in.size() );
+    fnx::simd::transform_aabbs( matrix.data(), reinterpret_cast<const fnx::decimal*>( in.data() ),
+                                reinterpret_cast<fnx::decimal*>( out.data() ), in.size() );
+}
+}
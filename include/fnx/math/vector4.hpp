@@ -40,8 +40,9 @@ namespace fnx
 // Struct vector4
 /**
  * This class represents a 4D vector.
+ * Aligned so that it is a single vector load for the fnx::simd kernels.
  */
-struct vector4
+struct FNX_SIMD_ALIGN vector4
 {
 
 public:
@@ -417,6 +418,14 @@ RP3D_FORCE_INLINE vector4 operator*( const vector4& vector1, const vector4& vect
     return vector4( vector1.x * vector2.x, vector1.y * vector2.y, vector1.z * vector2.z, vector1.w * vector2.w );
 }
 
+// Overloaded operator for multiplication with a matrix
+RP3D_FORCE_INLINE vector4 operator*( const matrix4x4& matrix, const vector4& vector )
+{
+    vector4 ret;
+    simd::mat4_transform( matrix.data(), &vector.x, &ret.x );
+    return ret;
+}
+
 // Overloaded less than operator for ordering to be used inside std::set for instance
 RP3D_FORCE_INLINE bool vector4::operator<( const vector4& vector ) const
 {
@@ -68,6 +68,8 @@ public:
         };
     }
 
+    /// @warning Only the address of the callable is stored, binding a temporary will dangle.
+    ///     Use fnx::inplace_function when the callable must be owned.
     template < typename Func, std::enable_if_t < std::is_class_v<std::decay_t<Func>>&&
                !std::is_same_v<function_ref, std::decay_t<Func> >>* = nullptr >
     function_ref( Func && f ) : _obj{ nullptr }, _func{ std::addressof( f ) }
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace fnx
+{
+/// @brief Default number of bytes an inplace_function can store without allocating.
+/// @note Large enough to hold a function_ref or a lambda capturing a handful of pointers.
+constexpr size_t inplace_function_capacity = 8 * sizeof( void* );
+
+template < typename F, size_t capacity = inplace_function_capacity, size_t alignment = alignof( std::max_align_t ),
+           bool copyable = true >
+class inplace_function;
+
+template <typename F, size_t capacity = inplace_function_capacity, size_t alignment = alignof( std::max_align_t )>
+/// @brief inplace_function that can hold move only callables and cannot be copied.
+using unique_inplace_function = inplace_function<F, capacity, alignment, false>;
+
+template <typename rtype, typename... args, size_t capacity, size_t alignment, bool copyable>
+/// @brief Owning callable with fixed inline storage. Think std::function without the heap.
+/// @note Callables larger than the capacity are rejected at compile time.
+/// @note Move only callables are rejected at compile time, use unique_inplace_function to hold them.
+class inplace_function<rtype( args... ), capacity, alignment, copyable>
+{
+    enum class operation
+    {
+        copy,
+        move,
+        destroy
+    };
+
+    using invoke_fn = rtype( * )( void*, args... );
+    using manage_fn = void( * )( operation, void*, void* );
+
+    template <typename F>
+    using is_inplace_function = std::is_same<inplace_function, std::decay_t<F>>;
+
+    /// @brief Stands in for the copied type when copies are disabled, the implicit copy is deleted by the move.
+    struct not_copyable
+    {
+    };
+    using copy_source = std::conditional_t<copyable, inplace_function, not_copyable>;
+
+public:
+    using MyType = inplace_function<rtype( args... ), capacity, alignment, copyable>;
+
+    inplace_function() noexcept = default;
+
+    inplace_function( std::nullptr_t ) noexcept {}
+
+    template < typename Func, typename C = std::decay_t<Func>,
+               std::enable_if_t < !is_inplace_function<Func>::value &&
+                                  std::is_invocable_r_v<rtype, C&, args...> > * = nullptr >
+    inplace_function( Func && f )
+    {
+        emplace<C>( std::forward<Func>( f ) );
+    }
+
+    template < typename C, typename Func,
+               std::enable_if_t < std::is_class<C>::value&&
+                                  std::is_member_function_pointer<Func>::value > * = nullptr >
+    inplace_function( C& o, Func f )
+    {
+        auto obj = std::addressof( o );
+        auto fn = [obj, f]( args... xs ) -> rtype
+        {
+            return ( obj->*f )( std::forward<args>( xs )... );
+        };
+        emplace<decltype( fn )>( std::move( fn ) );
+    }
+
+    inplace_function( const copy_source& other )
+        : _invoke{ other._invoke }
+        , _manage{ other._manage }
+    {
+        if ( _manage )
+        {
+            _manage( operation::copy, _storage, const_cast<unsigned char*>( other._storage ) );
+        }
+    }
+
+    inplace_function( inplace_function&& other ) noexcept
+        : _invoke{ other._invoke }
+        , _manage{ other._manage }
+    {
+        if ( _manage )
+        {
+            _manage( operation::move, _storage, other._storage );
+            other.reset();
+        }
+    }
+
+    ~inplace_function()
+    {
+        reset();
+    }
+
+    inplace_function& operator=( const copy_source& other )
+    {
+        if ( this != &other )
+        {
+            reset();
+            if ( other._manage )
+            {
+                other._manage( operation::copy, _storage, const_cast<unsigned char*>( other._storage ) );
+                _invoke = other._invoke;
+                _manage = other._manage;
+            }
+        }
+        return *this;
+    }
+
+    inplace_function& operator=( inplace_function&& other ) noexcept
+    {
+        if ( this != &other )
+        {
+            reset();
+            if ( other._manage )
+            {
+                other._manage( operation::move, _storage, other._storage );
+                _invoke = other._invoke;
+                _manage = other._manage;
+                other.reset();
+            }
+        }
+        return *this;
+    }
+
+    inplace_function& operator=( std::nullptr_t ) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    template < typename Func, typename C = std::decay_t<Func>,
+               std::enable_if_t < !is_inplace_function<Func>::value &&
+                                  std::is_invocable_r_v<rtype, C&, args...> > * = nullptr >
+    inplace_function & operator=( Func && f )
+    {
+        reset();
+        emplace<C>( std::forward<Func>( f ) );
+        return *this;
+    }
+
+    /// @brief Destroy the stored callable leaving this object empty.
+    void reset() noexcept
+    {
+        if ( _manage )
+        {
+            _manage( operation::destroy, _storage, nullptr );
+        }
+        _invoke = nullptr;
+        _manage = nullptr;
+    }
+
+    rtype operator()( args... xs ) const
+    {
+        assert( _invoke );
+        return _invoke( const_cast<unsigned char*>( _storage ), std::forward<args>( xs )... );
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return _invoke != nullptr;
+    }
+
+    auto operator==( std::nullptr_t ) const noexcept
+    {
+        return _invoke == nullptr;
+    }
+
+    auto operator!=( std::nullptr_t ) const noexcept
+    {
+        return _invoke != nullptr;
+    }
+
+private:
+    alignas( alignment ) unsigned char _storage[capacity] {};
+    invoke_fn _invoke = nullptr;
+    manage_fn _manage = nullptr;
+
+    template <typename C, typename Func>
+    void emplace( Func&& f )
+    {
+        static_assert( sizeof( C ) <= capacity, "callable does not fit within the inplace_function capacity" );
+        static_assert( alignment % alignof( C ) == 0, "callable alignment is not supported by the inplace_function" );
+        static_assert( std::is_nothrow_move_constructible<C>::value, "callable must be nothrow move constructible" );
+        static_assert( !copyable || std::is_copy_constructible<C>::value,
+                       "move only callables must be held by a unique_inplace_function" );
+
+        ::new ( static_cast<void*>( _storage ) ) C( std::forward<Func>( f ) );
+        _invoke = []( void* obj, args... xs ) -> rtype
+        {
+            return ( *static_cast<C*>( obj ) )( std::forward<args>( xs )... );
+        };
+        _manage = []( operation op, void* dst, void* src )
+        {
+            switch ( op )
+            {
+                case operation::copy:
+                    if constexpr( copyable )
+                    {
+                        ::new ( dst ) C( *static_cast<const C*>( src ) );
+                    }
+                    break;
+                case operation::move:
+                    ::new ( dst ) C( std::move( *static_cast<C*>( src ) ) );
+                    break;
+                case operation::destroy:
+                default:
+                    static_cast<C*>( dst )->~C();
+                    break;
+            }
+        };
+    }
+};
+}
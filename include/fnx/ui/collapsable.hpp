@@ -14,7 +14,7 @@ public:
         , _collapsed( collapsed )
     {
         auto [events, _] = singleton<event_manager>::acquire();
-        events.subscribe<widget_release_evt>( fnx::bind( *this, &collapsable::on_widget_release ) );
+        _release_token = events.subscribe<widget_release_evt>( fnx::bind( *this, &collapsable::on_widget_release ) );
         if ( collapsed && _content )
         {
             _content->set_visibility( false );
@@ -36,7 +36,7 @@ public:
     virtual ~collapsable()
     {
         auto [events, _] = singleton<event_manager>::acquire();
-        events.unsubscribe<widget_release_evt>( fnx::bind( *this, &collapsable::on_widget_release ) );
+        events.unsubscribe<widget_release_evt>( _release_token );
     }
 
     /// @brief Expands the widget.
@@ -65,6 +65,7 @@ protected:
     fnx::widget_handle _icon{ nullptr };
     fnx::widget_handle _content{ nullptr };
     bool _collapsed{ false };
+    fnx::subscription_token _release_token{ fnx::invalid_subscription };
 
     bool on_widget_release( const widget_release_evt& evt )
     {
@@ -64,12 +64,21 @@ public:
         _manual_atlas_index = 0;
     }
 
+    /// @brief Draw the image from a page of the texture_atlas when it fits there, which is the default.
+    void set_use_atlas( bool use_atlas )
+    {
+        _use_atlas = use_atlas;
+        _region = use_atlas ? _region : nullptr;
+    }
+
 protected:
     std::string _resource;
+    std::shared_ptr<fnx::atlas_region> _region;	/// part of an atlas page that holds the image
     fnx::texture::config _resource_config{};
     int _atlas_index[static_cast<int>( state::max )] { -1 };
     int _manual_atlas_index{ 0 };
     bool _auto_pick_atlas_index{ true };
     bool _overlay{ true };
+    bool _use_atlas{ true };	/// false once the atlas could not pack the image
 };
 }
\ No newline at end of file
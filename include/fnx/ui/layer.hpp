@@ -116,6 +116,8 @@ protected:
 
     /// TODO this may need to create widget ids that are only ever increasing
     unsigned int _active_widget{ 0xffffffff };
+    subscription_token _active_token{ invalid_subscription };
+    subscription_token _inactive_token{ invalid_subscription };
 };
 
 using layer_handle = fnx::reference_ptr<fnx::layer>;
@@ -22,15 +22,15 @@ public:
         , _drag_btn{drag_button}
     {
         auto [events, _] = singleton<event_manager>::acquire();
-        events.subscribe<widget_release_evt>( fnx::bind( *this, &panel::on_widget_release ) );
-        events.subscribe<widget_press_evt>( fnx::bind( *this, &panel::on_widget_press ) );
+        _panel_release_token = events.subscribe<widget_release_evt>( fnx::bind( *this, &panel::on_widget_release ) );
+        _press_token = events.subscribe<widget_press_evt>( fnx::bind( *this, &panel::on_widget_press ) );
     };
 
     virtual ~panel()
     {
         auto [events, _] = singleton<event_manager>::acquire();
-        events.unsubscribe<widget_release_evt>( fnx::bind( *this, &panel::on_widget_release ) );
-        events.unsubscribe<widget_press_evt>( fnx::bind( *this, &panel::on_widget_press ) );
+        events.unsubscribe<widget_release_evt>( _panel_release_token );
+        events.unsubscribe<widget_press_evt>( _press_token );
     };
 
     virtual void render( camera_handle camera, matrix4x4 parent_matrix ) override
@@ -73,5 +73,7 @@ protected:
     widget_handle _drag_btn;
     fnx::vector2 _current_cursor_position;
     fnx::vector2 _prev_cursor_position;
+    fnx::subscription_token _panel_release_token{ fnx::invalid_subscription };
+    fnx::subscription_token _press_token{ fnx::invalid_subscription };
 };
 }
\ No newline at end of file
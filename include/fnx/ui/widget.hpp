@@ -562,7 +562,7 @@ protected:
 
 // TODO: These functions may need to be turned into a factory if they get more complex
 
-extern std::unordered_map<widget_id, widget_handle>& get_widget_map();
+extern fnx::flat_map<widget_id, widget_handle>& get_widget_map();
 
 template<typename T, typename... Args, typename = typename std::enable_if<std::is_base_of<fnx::widget, T>::value>::type>
 fnx::widget_handle_t<T> create_widget( Args... args )
@@ -0,0 +1,99 @@
+/*
+ * Packs asset files into an archive that the engine mounts with
+ * fnx::file_system::mount, so that a game starts without opening
+ * every asset file on its own.
+ *
+ * usage: fnx-pack <archive> <file or directory>...
+ *
+ * Files are named by their path as given, so pack from the directory
+ * the game runs from: fnx-pack assets.fnxpak res shaders
+ */
+
+#include "fnx/fnx.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+
+namespace
+{
+/// @brief Files that are compressed already and would only be slower to read once compressed again.
+bool is_compressed_format(const std::filesystem::path& path)
+{
+    auto extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".ogg" ||
+           extension == ".mp3" || extension == ".zip";
+}
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "usage: " << argv[0] << " <archive> <file or directory>..." << std::endl;
+        return 1;
+    }
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::filesystem::path> paths;
+    for (int i = 2; i < argc; ++i)
+    {
+        const std::filesystem::path path(argv[i]);
+        if (std::filesystem::is_directory(path))
+        {
+            for (const auto& item : std::filesystem::recursive_directory_iterator(path))
+            {
+                if (item.is_regular_file())
+                {
+                    paths.push_back(item.path());
+                }
+            }
+        }
+        else if (std::filesystem::is_regular_file(path))
+        {
+            paths.push_back(path);
+        }
+        else
+        {
+            std::cerr << "unable to find " << path.string() << std::endl;
+            return 1;
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+
+    // the files stay mapped until the archive is written
+    std::vector<fnx::mapped_file> files;
+    std::vector<fnx::archive_input> inputs;
+    files.reserve(paths.size());
+    size_t total_size = 0;
+    for (const auto& path : paths)
+    {
+        files.emplace_back(path.string());
+        if (!files.back().is_open())
+        {
+            std::cerr << "unable to read " << path.string() << std::endl;
+            return 1;
+        }
+        inputs.push_back({fnx::normalize_path(path.generic_string()), files.back().data(), files.back().size(),
+                          !is_compressed_format(path)});
+        total_size += files.back().size();
+    }
+
+    const auto bytes = fnx::archive::serialize(inputs);
+    const std::string archive_path(argv[1]);
+    if (!fnx::write_file_replacing(archive_path, bytes.data(), bytes.size()))
+    {
+        std::cerr << "unable to write " << archive_path << std::endl;
+        return 1;
+    }
+
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "packed " << inputs.size() << " files, " << total_size / 1024 << " KB into " << archive_path << ", "
+              << bytes.size() / 1024 << " KB in " << seconds << " s" << std::endl;
+    return 0;
+}
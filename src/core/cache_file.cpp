@@ -0,0 +1,31 @@
+#include <string>
+#include <vector>
+
+namespace fnx
+{
+void cache_file::open( const std::string& file_path, uint64_t content_hash )
+{
+    _file = fnx::read_file( file_path );
+    _open = _file.is_open() && read( _file.data(), _file.size(), content_hash );
+    if ( !_open )
+    {
+        _file.close();
+    }
+}
+
+void cache_file::open( std::vector<char>&& bytes, uint64_t content_hash )
+{
+    _bytes = std::move( bytes );
+    _open = read( _bytes.data(), _bytes.size(), content_hash );
+}
+
+bool write_cache_file( const std::string& cache_path, const std::vector<char>& bytes )
+{
+    if ( !fnx::write_file_replacing( cache_path, bytes.data(), bytes.size() ) )
+    {
+        FNX_WARN( fnx::format_string( "unable to write cache %s", cache_path.c_str() ) );
+        return false;
+    }
+    return true;
+}
+}
@@ -0,0 +1,366 @@
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <thread>
+
+namespace fnx
+{
+namespace
+{
+constexpr uint32_t archive_magic = 0x4b504e46u;	/// "FNPK" when read on a little endian machine
+constexpr size_t min_mapped_size = 256u * 1024u;	/// smaller files on disk are read rather than mapped
+
+struct archive_header
+{
+    uint32_t magic;
+    uint32_t format_version;
+    uint32_t num_entries;
+    uint32_t names_size;
+    uint64_t file_size;
+    uint64_t reserved;
+};
+
+// the directory follows the header and both are read in place from the mapping
+static_assert( sizeof( archive_header ) == 32u, "archive header is padded" );
+static_assert( sizeof( archive::entry ) == 40u, "archive entry is padded" );
+
+bool entry_less( const archive::entry& record, uint64_t hash )
+{
+    return record.hash < hash;
+}
+}
+
+file_data::file_data( fnx::mapped_file&& file )
+    : _file( std::move( file ) )
+{
+    _data = _file.data();
+    _size = _file.size();
+    _open = _file.is_open();
+}
+
+file_data::file_data( std::vector<char>&& buffer )
+    : _buffer( std::move( buffer ) )
+{
+    _data = _buffer.data();
+    _size = _buffer.size();
+    _open = true;
+}
+
+file_data::file_data( const char* data, size_t size, std::shared_ptr<const void> owner )
+    : _owner( std::move( owner ) )
+    , _data( data )
+    , _size( size )
+    , _open( true )
+{
+}
+
+file_data::file_data( file_data&& other ) noexcept
+    : _file( std::move( other._file ) )
+    , _buffer( std::move( other._buffer ) )
+    , _owner( std::move( other._owner ) )
+    , _data( other._data )
+    , _size( other._size )
+    , _open( other._open )
+{
+    other._data = nullptr;
+    other._size = 0u;
+    other._open = false;
+}
+
+file_data& file_data::operator=( file_data&& other ) noexcept
+{
+    if ( this != &other )
+    {
+        close();
+        _file = std::move( other._file );
+        _buffer = std::move( other._buffer );
+        _owner = std::move( other._owner );
+        std::swap( _data, other._data );
+        std::swap( _size, other._size );
+        std::swap( _open, other._open );
+    }
+    return *this;
+}
+
+void file_data::close()
+{
+    _file.close();
+    _buffer = std::vector<char>();
+    _owner.reset();
+    _data = nullptr;
+    _size = 0u;
+    _open = false;
+}
+
+archive::archive( const std::string& file_path )
+    : _file( file_path )
+{
+    archive_header header;
+    if ( !_file.is_open() || _file.size() < sizeof( header ) )
+    {
+        _file.close();
+        return;
+    }
+    std::memcpy( &header, _file.data(), sizeof( header ) );
+    const size_t tables_size = sizeof( header ) + static_cast<size_t>( header.num_entries ) * sizeof( entry ) +
+                               header.names_size;
+    if ( header.magic != archive_magic || header.format_version != format_version ||
+            header.file_size != _file.size() || tables_size > _file.size() )
+    {
+        FNX_WARN( fnx::format_string( "archive %s is out of date or damaged", file_path.c_str() ) );
+        _file.close();
+        return;
+    }
+    // the mapping is page aligned so the records that follow the header are aligned too
+    _entries = reinterpret_cast<const entry*>( _file.data() + sizeof( header ) );
+    _names = _file.data() + sizeof( header ) + header.num_entries * sizeof( entry );
+    _num_entries = header.num_entries;
+    for ( size_t i = 0u; i < _num_entries; i++ )
+    {
+        const auto& record = _entries[i];
+        if ( record.name_offset + static_cast<size_t>( record.name_length ) > header.names_size ||
+                record.offset > _file.size() || record.stored_size > _file.size() - record.offset ||
+                ( record.compression == archive_compression::none && record.stored_size != record.size ) ||
+                ( i > 0u && record.hash < _entries[i - 1u].hash ) )
+        {
+            FNX_WARN( fnx::format_string( "archive %s is damaged", file_path.c_str() ) );
+            _file.close();
+            _entries = nullptr;
+            _names = nullptr;
+            _num_entries = 0u;
+            return;
+        }
+    }
+    _open = true;
+}
+
+const archive::entry* archive::find( std::string_view name ) const
+{
+    const auto hash = fnx::hash_bytes( name.data(), name.size() );
+    const auto* end = _entries + _num_entries;
+    for ( const auto* it = std::lower_bound( _entries, end, hash, entry_less ); it != end && it->hash == hash; ++it )
+    {
+        if ( get_name( *it ) == name )
+        {
+            return it;
+        }
+    }
+    return nullptr;
+}
+
+std::string_view archive::get_name( const entry& record ) const
+{
+    return std::string_view( _names + record.name_offset, record.name_length );
+}
+
+fnx::file_data archive::read( const entry& record ) const
+{
+    const char* stored = _file.data() + record.offset;
+    if ( record.compression == archive_compression::none )
+    {
+        // the archive stays mapped while the view is held, if it is owned by a file_system
+        return fnx::file_data( stored, record.size, weak_from_this().lock() );
+    }
+    std::vector<char> buffer( record.size );
+    if ( record.compression != archive_compression::lz4 ||
+            !fnx::lz4_decompress( stored, record.stored_size, buffer.data(), buffer.size() ) )
+    {
+        FNX_ERROR( fnx::format_string( "unable to decompress %s", std::string( get_name( record ) ).c_str() ) );
+        return fnx::file_data();
+    }
+    return fnx::file_data( std::move( buffer ) );
+}
+
+std::vector<char> archive::serialize( const std::vector<fnx::archive_input>& inputs )
+{
+    std::vector<entry> entries( inputs.size() );
+    std::vector<std::vector<char>> compressed( inputs.size() );
+    for ( size_t i = 0u; i < inputs.size(); i++ )
+    {
+        const auto& input = inputs[i];
+        auto& record = entries[i];
+        record = entry{};
+        record.hash = fnx::hash_bytes( input.name.data(), input.name.size() );
+        record.size = input.size;
+        record.stored_size = input.size;
+        record.compression = archive_compression::none;
+        if ( input.compress && input.size > 0u )
+        {
+            // only kept when it saves at least an eighth, reading in place beats decompressing a few bytes less
+            auto blocks = fnx::lz4_compress( input.data, input.size );
+            if ( blocks.size() < input.size - input.size / 8u )
+            {
+                record.stored_size = blocks.size();
+                record.compression = archive_compression::lz4;
+                compressed[i] = std::move( blocks );
+            }
+        }
+    }
+
+    std::vector<size_t> order( inputs.size() );
+    std::iota( order.begin(), order.end(), size_t{ 0 } );
+    std::sort( order.begin(), order.end(), [&]( size_t a, size_t b )
+    {
+        return entries[a].hash != entries[b].hash ? entries[a].hash < entries[b].hash : inputs[a].name < inputs[b].name;
+    } );
+
+    archive_header header{};
+    header.magic = archive_magic;
+    header.format_version = format_version;
+    header.num_entries = static_cast<uint32_t>( inputs.size() );
+    std::string names;
+    for ( auto i : order )
+    {
+        entries[i].name_offset = static_cast<uint32_t>( names.size() );
+        entries[i].name_length = static_cast<uint16_t>( inputs[i].name.size() );
+        names += inputs[i].name;
+    }
+    header.names_size = static_cast<uint32_t>( names.size() );
+
+    // content in the order of the inputs, files given together are read together
+    size_t offset = sizeof( header ) + inputs.size() * sizeof( entry ) + names.size();
+    for ( auto& record : entries )
+    {
+        offset = fnx::align_offset( offset, record.compression == archive_compression::none ? page_alignment :
+                                    fnx::file_blob_alignment );
+        record.offset = offset;
+        offset += record.stored_size;
+    }
+    header.file_size = offset;
+
+    std::vector<char> bytes( offset, 0 );
+    std::memcpy( bytes.data(), &header, sizeof( header ) );
+    auto* directory = bytes.data() + sizeof( header );
+    for ( size_t i = 0u; i < order.size(); i++ )
+    {
+        std::memcpy( directory + i * sizeof( entry ), &entries[order[i]], sizeof( entry ) );
+    }
+    std::memcpy( directory + order.size() * sizeof( entry ), names.data(), names.size() );
+    for ( size_t i = 0u; i < inputs.size(); i++ )
+    {
+        const auto& record = entries[i];
+        const char* content = record.compression == archive_compression::none ? inputs[i].data : compressed[i].data();
+        if ( record.stored_size > 0u )
+        {
+            std::memcpy( bytes.data() + record.offset, content, record.stored_size );
+        }
+    }
+    return bytes;
+}
+
+bool file_system::mount( const std::string& archive_path )
+{
+    auto mounted = std::make_shared<fnx::archive>( archive_path );
+    if ( !mounted->is_open() )
+    {
+        FNX_ERROR( fnx::format_string( "unable to mount archive %s", archive_path.c_str() ) );
+        return false;
+    }
+    FNX_INFO( fnx::format_string( "mounted archive %s, %zu files", archive_path.c_str(),
+                                  mounted->get_num_entries() ) );
+    _archives.emplace_back( std::move( mounted ) );
+    return true;
+}
+
+void file_system::unmount_all()
+{
+    // files read from the archives keep them mapped until they are released
+    _archives.clear();
+}
+
+std::shared_ptr<const fnx::archive> file_system::find( std::string_view name ) const
+{
+    for ( auto it = _archives.rbegin(); it != _archives.rend(); ++it )
+    {
+        if ( nullptr != ( *it )->find( name ) )
+        {
+            return *it;
+        }
+    }
+    return nullptr;
+}
+
+std::string normalize_path( std::string_view file_path )
+{
+    std::string path( file_path );
+    std::replace( path.begin(), path.end(), '\\', '/' );
+    while ( path.compare( 0u, 2u, "./" ) == 0 )
+    {
+        path.erase( 0u, 2u );
+    }
+    return path;
+}
+
+fnx::file_data read_file( const std::string& file_path )
+{
+    const auto name = normalize_path( file_path );
+    std::shared_ptr<const fnx::archive> source;
+    {
+        // the lookup is locked, not the read, loader threads decompress side by side
+        auto [files, _] = singleton<file_system>::acquire();
+        if ( files.get_num_archives() > 0u )
+        {
+            source = files.find( name );
+        }
+    }
+    if ( nullptr != source )
+    {
+        return source->read( *source->find( name ) );
+    }
+
+    // small files are copied, mapping them costs more than the copy
+    std::ifstream in( file_path, std::ios::binary | std::ios::ate );
+    if ( !in )
+    {
+        return fnx::file_data();
+    }
+    const auto size = static_cast<size_t>( in.tellg() );
+    if ( size >= min_mapped_size )
+    {
+        in.close();
+        return fnx::file_data( fnx::mapped_file( file_path ) );
+    }
+    std::vector<char> buffer( size );
+    in.seekg( 0 );
+    in.read( buffer.data(), static_cast<std::streamsize>( size ) );
+    return in ? fnx::file_data( std::move( buffer ) ) : fnx::file_data();
+}
+
+bool write_file_replacing( const std::string& file_path, const char* data, size_t size )
+{
+    // the process and thread ids keep concurrent writers of the same file out of each other's temporary file
+#if defined(_WIN32)
+    const auto process_id = static_cast<unsigned long>( GetCurrentProcessId() );
+#else
+    const auto process_id = static_cast<unsigned long>( getpid() );
+#endif
+    const auto thread_id = std::hash<std::thread::id> {}( std::this_thread::get_id() );
+    const auto temp_path = file_path + "." + std::to_string( process_id ) + "." + std::to_string( thread_id ) + ".tmp";
+    std::ofstream out( temp_path, std::ios::binary | std::ios::trunc );
+    out.write( data, static_cast<std::streamsize>( size ) );
+    out.close();
+    if ( !out )
+    {
+        std::remove( temp_path.c_str() );
+        return false;
+    }
+    // rename replaces the file in one step on POSIX, elsewhere the old file has to go first
+    if ( std::rename( temp_path.c_str(), file_path.c_str() ) != 0 )
+    {
+        std::remove( file_path.c_str() );
+        if ( std::rename( temp_path.c_str(), file_path.c_str() ) != 0 )
+        {
+            std::remove( temp_path.c_str() );
+            return false;
+        }
+    }
+    return true;
+}
+}
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <cstring>
+
+namespace fnx
+{
+namespace
+{
+constexpr size_t min_match = 4u;
+constexpr size_t last_literals = 5u;	/// the block ends with at least this many literals
+constexpr size_t match_limit = 12u;	/// no match starts in the last bytes of the block
+constexpr size_t max_offset = 65535u;
+constexpr uint32_t hash_bits = 14u;
+
+uint32_t read_u32( const char* data )
+{
+    uint32_t value;
+    std::memcpy( &value, data, sizeof( value ) );
+    return value;
+}
+
+uint32_t hash_sequence( uint32_t sequence )
+{
+    return ( sequence * 2654435761u ) >> ( 32u - hash_bits );
+}
+
+void write_length( std::vector<char>& out, size_t length )
+{
+    // lengths from 15 continue in bytes of 255 until a smaller one
+    for ( ; length >= 255u; length -= 255u )
+    {
+        out.push_back( static_cast<char>( 255 ) );
+    }
+    out.push_back( static_cast<char>( length ) );
+}
+
+void write_sequence( std::vector<char>& out, const char* literals, size_t num_literals, size_t offset,
+                     size_t match_length )
+{
+    const size_t match_code = match_length - min_match;
+    out.push_back( static_cast<char>( ( std::min<size_t>( num_literals, 15u ) << 4u ) |
+                                      std::min<size_t>( match_code, 15u ) ) );
+    if ( num_literals >= 15u )
+    {
+        write_length( out, num_literals - 15u );
+    }
+    out.insert( out.end(), literals, literals + num_literals );
+    out.push_back( static_cast<char>( offset & 0xffu ) );
+    out.push_back( static_cast<char>( offset >> 8u ) );
+    if ( match_code >= 15u )
+    {
+        write_length( out, match_code - 15u );
+    }
+}
+
+bool read_length( const unsigned char*& in, const unsigned char* end, size_t& length )
+{
+    unsigned char byte = 255u;
+    while ( byte == 255u )
+    {
+        if ( in >= end )
+        {
+            return false;
+        }
+        byte = *in++;
+        length += byte;
+    }
+    return true;
+}
+}
+
+std::vector<char> lz4_compress( const char* data, size_t size )
+{
+    std::vector<char> out;
+    out.reserve( size + size / 255u + 16u );
+    std::vector<uint32_t> table( size_t{ 1 } << hash_bits, 0u );
+    size_t anchor = 0u;
+    size_t pos = 1u;
+    while ( size >= match_limit && pos + match_limit <= size )
+    {
+        const auto sequence = read_u32( data + pos );
+        auto& slot = table[hash_sequence( sequence )];
+        size_t candidate = slot;
+        slot = static_cast<uint32_t>( pos );
+        if ( pos - candidate > max_offset || read_u32( data + candidate ) != sequence )
+        {
+            // data that does not compress is skipped faster and faster
+            pos += 1u + ( ( pos - anchor ) >> 6u );
+            continue;
+        }
+        size_t length = min_match;
+        const size_t end = size - last_literals;
+        while ( pos + length < end && data[candidate + length] == data[pos + length] )
+        {
+            length++;
+        }
+        while ( pos > anchor && candidate > 0u && data[pos - 1u] == data[candidate - 1u] )
+        {
+            pos--;
+            candidate--;
+            length++;
+        }
+        write_sequence( out, data + anchor, pos - anchor, pos - candidate, length );
+        pos += length;
+        anchor = pos;
+    }
+
+    const size_t num_literals = size - anchor;
+    out.push_back( static_cast<char>( std::min<size_t>( num_literals, 15u ) << 4u ) );
+    if ( num_literals >= 15u )
+    {
+        write_length( out, num_literals - 15u );
+    }
+    out.insert( out.end(), data + anchor, data + size );
+    return out;
+}
+
+bool lz4_decompress( const char* src, size_t src_size, char* dst, size_t dst_size )
+{
+    const auto* in = reinterpret_cast<const unsigned char*>( src );
+    const auto* end = in + src_size;
+    size_t out = 0u;
+    while ( in < end )
+    {
+        const auto token = *in++;
+        size_t num_literals = token >> 4u;
+        if ( ( num_literals == 15u && !read_length( in, end, num_literals ) ) ||
+                num_literals > static_cast<size_t>( end - in ) || num_literals > dst_size - out )
+        {
+            return false;
+        }
+        if ( num_literals > 0u )
+        {
+            std::memcpy( dst + out, in, num_literals );
+        }
+        in += num_literals;
+        out += num_literals;
+        if ( in == end )
+        {
+            // the last sequence only has literals
+            break;
+        }
+
+        if ( end - in < 2 )
+        {
+            return false;
+        }
+        const size_t offset = in[0] | ( static_cast<size_t>( in[1] ) << 8u );
+        in += 2;
+        size_t length = token & 0xfu;
+        if ( offset == 0u || offset > out || ( length == 15u && !read_length( in, end, length ) ) )
+        {
+            return false;
+        }
+        length += min_match;
+        if ( length > dst_size - out )
+        {
+            return false;
+        }
+        const char* match = dst + out - offset;
+        if ( offset >= length )
+        {
+            std::memcpy( dst + out, match, length );
+        }
+        else
+        {
+            // the match overlaps what it writes, repeating the last offset bytes
+            for ( size_t i = 0u; i < length; i++ )
+            {
+                dst[out + i] = match[i];
+            }
+        }
+        out += length;
+    }
+    return out == dst_size;
+}
+}
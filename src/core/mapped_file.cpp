@@ -0,0 +1,130 @@
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace fnx
+{
+#if defined(_WIN32)
+mapped_file::mapped_file( const std::string& file_path )
+{
+    auto file = CreateFileA( file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+    if ( file == INVALID_HANDLE_VALUE )
+    {
+        return;
+    }
+    LARGE_INTEGER size;
+    if ( GetFileSizeEx( file, &size ) )
+    {
+        _open = true;
+        _size = static_cast<size_t>( size.QuadPart );
+        // empty files cannot be mapped, they are open with no content
+        auto mapping = _size > 0u ? CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr ) : nullptr;
+        if ( mapping )
+        {
+            _data = static_cast<const char*>( MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) );
+            _mapping = mapping;
+        }
+        if ( _size > 0u && !_data )
+        {
+            close();
+        }
+    }
+    CloseHandle( file );
+}
+
+void mapped_file::close()
+{
+    if ( _data )
+    {
+        UnmapViewOfFile( _data );
+    }
+    if ( _mapping )
+    {
+        CloseHandle( static_cast<HANDLE>( _mapping ) );
+    }
+    _data = nullptr;
+    _mapping = nullptr;
+    _size = 0u;
+    _open = false;
+}
+#else
+mapped_file::mapped_file( const std::string& file_path )
+{
+    auto file = ::open( file_path.c_str(), O_RDONLY );
+    if ( file < 0 )
+    {
+        return;
+    }
+    struct stat info;
+    if ( ::fstat( file, &info ) == 0 && S_ISREG( info.st_mode ) )
+    {
+        _open = true;
+        _size = static_cast<size_t>( info.st_size );
+        // empty files cannot be mapped, they are open with no content
+        if ( _size > 0u )
+        {
+            auto* data = ::mmap( nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0 );
+            if ( data != MAP_FAILED )
+            {
+                ::madvise( data, _size, MADV_SEQUENTIAL );
+                _data = static_cast<const char*>( data );
+                _mapping = data;
+            }
+            else
+            {
+                close();
+            }
+        }
+    }
+    ::close( file );
+}
+
+void mapped_file::close()
+{
+    if ( _mapping )
+    {
+        ::munmap( _mapping, _size );
+    }
+    _data = nullptr;
+    _mapping = nullptr;
+    _size = 0u;
+    _open = false;
+}
+#endif
+
+mapped_file::~mapped_file()
+{
+    close();
+}
+
+mapped_file::mapped_file( mapped_file&& other ) noexcept
+    : _data( other._data )
+    , _size( other._size )
+    , _mapping( other._mapping )
+    , _open( other._open )
+{
+    other._data = nullptr;
+    other._mapping = nullptr;
+    other._size = 0u;
+    other._open = false;
+}
+
+mapped_file& mapped_file::operator=( mapped_file&& other ) noexcept
+{
+    if ( this != &other )
+    {
+        close();
+        std::swap( _data, other._data );
+        std::swap( _size, other._size );
+        std::swap( _mapping, other._mapping );
+        std::swap( _open, other._open );
+    }
+    return *this;
+}
+}
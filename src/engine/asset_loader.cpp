@@ -0,0 +1,109 @@
+#include <algorithm>
+
+namespace fnx
+{
+asset_loader::~asset_loader()
+{
+    {
+        std::lock_guard<std::mutex> guard( _lock );
+        _stopping = true;
+    }
+    _wake.notify_all();
+    for ( auto& worker : _workers )
+    {
+        worker.join();
+    }
+}
+
+void asset_loader::submit( std::shared_ptr<fnx::load_job> job )
+{
+    {
+        std::lock_guard<std::mutex> guard( _lock );
+        if ( _workers.empty() )
+        {
+            // one core is left to the main thread
+            const auto num_workers = std::max( std::thread::hardware_concurrency(), 2u ) - 1u;
+            for ( unsigned int i = 0u; i < num_workers; i++ )
+            {
+                _workers.emplace_back( [this]()
+                {
+                    work();
+                } );
+            }
+        }
+        _reads.emplace_back( std::move( job ) );
+        ++_num_pending;
+    }
+    _wake.notify_one();
+}
+
+size_t asset_loader::update( std::chrono::microseconds budget )
+{
+    const auto start = std::chrono::steady_clock::now();
+    size_t created = 0u;
+    while ( true )
+    {
+        std::shared_ptr<fnx::load_job> job;
+        {
+            std::lock_guard<std::mutex> guard( _lock );
+            if ( _creates.empty() )
+            {
+                break;
+            }
+            job = std::move( _creates.front() );
+            _creates.pop_front();
+        }
+        job->create();
+        --_num_pending;
+        created++;
+        if ( std::chrono::steady_clock::now() - start >= budget )
+        {
+            break;
+        }
+    }
+    return created;
+}
+
+void asset_loader::finish()
+{
+    while ( _num_pending > 0u )
+    {
+        {
+            std::unique_lock<std::mutex> lock( _lock );
+            _read.wait( lock, [this]()
+            {
+                return !_creates.empty();
+            } );
+        }
+        update( std::chrono::hours( 1 ) );
+    }
+}
+
+void asset_loader::work()
+{
+    while ( true )
+    {
+        std::shared_ptr<fnx::load_job> job;
+        {
+            std::unique_lock<std::mutex> lock( _lock );
+            _wake.wait( lock, [this]()
+            {
+                return _stopping || !_reads.empty();
+            } );
+            if ( _stopping )
+            {
+                return;
+            }
+            job = std::move( _reads.front() );
+            _reads.pop_front();
+        }
+        job->read();
+        {
+            // the main thread holds the last reference from now on, assets are never released by a worker
+            std::lock_guard<std::mutex> guard( _lock );
+            _creates.emplace_back( std::move( job ) );
+        }
+        _read.notify_all();
+    }
+}
+}
@@ -61,17 +61,17 @@ audio_manager::audio_manager()
 {
     auto [emitter, _] = fnx::singleton<fnx::event_manager>::acquire();
     _event_queue.reserve( max_events );
-    emitter.subscribe<sound_evt>( fnx::bind( *this, &audio_manager::on_event ) );
-    emitter.subscribe<window_init_evt>( fnx::bind( *this, &audio_manager::on_window_init ) );
-    emitter.subscribe<window_close_evt>( fnx::bind( *this, &audio_manager::on_window_close ) );
+    _sound_token = emitter.subscribe<sound_evt>( fnx::bind( *this, &audio_manager::on_event ) );
+    _window_init_token = emitter.subscribe<window_init_evt>( fnx::bind( *this, &audio_manager::on_window_init ) );
+    _window_close_token = emitter.subscribe<window_close_evt>( fnx::bind( *this, &audio_manager::on_window_close ) );
 }
 
 audio_manager::~audio_manager()
 {
     auto [emitter, _] = fnx::singleton<fnx::event_manager>::acquire();
-    emitter.unsubscribe<sound_evt>( fnx::bind( *this, &audio_manager::on_event ) );
-    emitter.unsubscribe<window_init_evt>( fnx::bind( *this, &audio_manager::on_window_init ) );
-    emitter.unsubscribe<window_close_evt>( fnx::bind( *this, &audio_manager::on_window_close ) );
+    emitter.unsubscribe<sound_evt>( _sound_token );
+    emitter.unsubscribe<window_init_evt>( _window_init_token );
+    emitter.unsubscribe<window_close_evt>( _window_close_token );
 }
 
 bool audio_manager::on_event( const sound_evt& event )
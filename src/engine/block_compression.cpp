@@ -0,0 +1,838 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace fnx
+{
+namespace
+{
+constexpr uint32_t block_size = 4u;
+constexpr uint32_t block_texels = block_size * block_size;
+
+using texel_block = float[block_texels][4];
+
+/// @brief Load the texels of the block at bx, by, the edge texels are repeated over the edges of the image.
+void load_block( const unsigned char* pixels, uint32_t width, uint32_t height, uint32_t bx, uint32_t by,
+                 texel_block& texels )
+{
+    for ( uint32_t y = 0u; y < block_size; y++ )
+    {
+        const auto row = std::min( by * block_size + y, height - 1u );
+        for ( uint32_t x = 0u; x < block_size; x++ )
+        {
+            const auto col = std::min( bx * block_size + x, width - 1u );
+            const auto* pixel = pixels + ( static_cast<size_t>( row ) * width + col ) * 4u;
+            for ( uint32_t c = 0u; c < 4u; c++ )
+            {
+                texels[y * block_size + x][c] = pixel[c];
+            }
+        }
+    }
+}
+
+/// @brief Store the texels of a decoded block that are inside the image.
+void store_block( const unsigned char ( &texels )[block_texels][4], uint32_t width, uint32_t height, uint32_t bx,
+                  uint32_t by, unsigned char* pixels )
+{
+    for ( uint32_t y = 0u; y < block_size && by * block_size + y < height; y++ )
+    {
+        for ( uint32_t x = 0u; x < block_size && bx * block_size + x < width; x++ )
+        {
+            auto* pixel = pixels + ( static_cast<size_t>( by * block_size + y ) * width + bx * block_size + x ) * 4u;
+            std::memcpy( pixel, texels[y * block_size + x], 4u );
+        }
+    }
+}
+
+/// @brief Fit the line through the first N channels of the active texels along their principal axis.
+/// @param[out] lo, hi : ends of the line where the texels project, within 0 to 255
+template<uint32_t N>
+void fit_principal_axis( const texel_block& texels, const bool* active, float ( &lo )[4], float ( &hi )[4] )
+{
+    float mean[N] = {};
+    float count = 0.f;
+    for ( uint32_t i = 0u; i < block_texels; i++ )
+    {
+        if ( active[i] )
+        {
+            for ( uint32_t c = 0u; c < N; c++ )
+            {
+                mean[c] += texels[i][c];
+            }
+            count += 1.f;
+        }
+    }
+    for ( uint32_t c = 0u; c < N; c++ )
+    {
+        mean[c] /= std::max( count, 1.f );
+    }
+
+    float covariance[N][N] = {};
+    for ( uint32_t i = 0u; i < block_texels; i++ )
+    {
+        if ( active[i] )
+        {
+            for ( uint32_t a = 0u; a < N; a++ )
+            {
+                for ( uint32_t b = 0u; b < N; b++ )
+                {
+                    covariance[a][b] += ( texels[i][a] - mean[a] ) * ( texels[i][b] - mean[b] );
+                }
+            }
+        }
+    }
+
+    // power iteration from the diagonal converges to the axis of largest variance
+    float axis[N];
+    for ( uint32_t c = 0u; c < N; c++ )
+    {
+        axis[c] = covariance[c][c];
+    }
+    for ( int iteration = 0; iteration < 8; iteration++ )
+    {
+        float next[N] = {};
+        float length = 0.f;
+        for ( uint32_t a = 0u; a < N; a++ )
+        {
+            for ( uint32_t b = 0u; b < N; b++ )
+            {
+                next[a] += covariance[a][b] * axis[b];
+            }
+            length = std::max( length, std::abs( next[a] ) );
+        }
+        if ( length <= 0.f )
+        {
+            break;
+        }
+        for ( uint32_t c = 0u; c < N; c++ )
+        {
+            axis[c] = next[c] / length;
+        }
+    }
+    float length = 0.f;
+    for ( uint32_t c = 0u; c < N; c++ )
+    {
+        length += axis[c] * axis[c];
+    }
+    length = std::sqrt( length );
+    for ( uint32_t c = 0u; c < N; c++ )
+    {
+        axis[c] = length > 0.f ? axis[c] / length : 0.f;
+    }
+
+    float min_t = 0.f;
+    float max_t = 0.f;
+    for ( uint32_t i = 0u; i < block_texels; i++ )
+    {
+        if ( active[i] )
+        {
+            float t = 0.f;
+            for ( uint32_t c = 0u; c < N; c++ )
+            {
+                t += ( texels[i][c] - mean[c] ) * axis[c];
+            }
+            min_t = std::min( min_t, t );
+            max_t = std::max( max_t, t );
+        }
+    }
+    for ( uint32_t c = 0u; c < N; c++ )
+    {
+        lo[c] = std::clamp( mean[c] + min_t * axis[c], 0.f, 255.f );
+        hi[c] = std::clamp( mean[c] + max_t * axis[c], 0.f, 255.f );
+    }
+}
+
+/// @brief Least squares endpoints of the active texels for the weight of the second endpoint in each texel.
+/// @return false when every texel has the same weight, the endpoints are then left as they are
+template<uint32_t N>
+bool refine_endpoints( const texel_block& texels, const bool* active, const float* weights, float ( &lo )[4],
+                       float ( &hi )[4] )
+{
+    float aa = 0.f;
+    float ab = 0.f;
+    float bb = 0.f;
+    float ra[N] = {};
+    float rb[N] = {};
+    for ( uint32_t i = 0u; i < block_texels; i++ )
+    {
+        if ( active[i] )
+        {
+            const auto w = weights[i];
+            aa += ( 1.f - w ) * ( 1.f - w );
+            ab += ( 1.f - w ) * w;
+            bb += w * w;
+            for ( uint32_t c = 0u; c < N; c++ )
+            {
+                ra[c] += ( 1.f - w ) * texels[i][c];
+                rb[c] += w * texels[i][c];
+            }
+        }
+    }
+    const auto determinant = aa * bb - ab * ab;
+    if ( std::abs( determinant ) < 1e-6f )
+    {
+        return false;
+    }
+    for ( uint32_t c = 0u; c < N; c++ )
+    {
+        lo[c] = std::clamp( ( bb * ra[c] - ab * rb[c] ) / determinant, 0.f, 255.f );
+        hi[c] = std::clamp( ( aa * rb[c] - ab * ra[c] ) / determinant, 0.f, 255.f );
+    }
+    return true;
+}
+
+void write_u16( unsigned char* out, uint32_t value )
+{
+    out[0] = static_cast<unsigned char>( value & 0xffu );
+    out[1] = static_cast<unsigned char>( value >> 8u );
+}
+
+uint32_t read_u16( const unsigned char* in )
+{
+    return in[0] | ( static_cast<uint32_t>( in[1] ) << 8u );
+}
+
+// -- BC1 colors --
+
+uint32_t pack_565( const float* color )
+{
+    const auto r = static_cast<uint32_t>( std::lround( color[0] * 31.f / 255.f ) );
+    const auto g = static_cast<uint32_t>( std::lround( color[1] * 63.f / 255.f ) );
+    const auto b = static_cast<uint32_t>( std::lround( color[2] * 31.f / 255.f ) );
+    return ( r << 11u ) | ( g << 5u ) | b;
+}
+
+void unpack_565( uint32_t packed, int* color )
+{
+    const auto r = ( packed >> 11u ) & 31u;
+    const auto g = ( packed >> 5u ) & 63u;
+    const auto b = packed & 31u;
+    color[0] = static_cast<int>( ( r << 3u ) | ( r >> 2u ) );
+    color[1] = static_cast<int>( ( g << 2u ) | ( g >> 4u ) );
+    color[2] = static_cast<int>( ( b << 3u ) | ( b >> 2u ) );
+}
+
+/// @brief Return the 4 colors of a BC1 block, the last one is transparent black in the 3 color mode.
+void color_palette( uint32_t c0, uint32_t c1, bool four_colors, int ( &palette )[4][4] )
+{
+    unpack_565( c0, palette[0] );
+    unpack_565( c1, palette[1] );
+    palette[0][3] = 255;
+    palette[1][3] = 255;
+    for ( uint32_t c = 0u; c < 3u; c++ )
+    {
+        if ( four_colors )
+        {
+            palette[2][c] = ( 2 * palette[0][c] + palette[1][c] ) / 3;
+            palette[3][c] = ( palette[0][c] + 2 * palette[1][c] ) / 3;
+        }
+        else
+        {
+            palette[2][c] = ( palette[0][c] + palette[1][c] ) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    palette[2][3] = 255;
+    palette[3][3] = four_colors ? 255 : 0;
+}
+
+/// @brief Encode the colors of a block between two endpoints.
+/// @param[in] transparent : texels written as transparent, which selects the 3 color mode when there are any
+/// @return squared error of the active texels
+float encode_colors( const texel_block& texels, const bool* transparent, bool three_colors, const float* lo,
+                     const float* hi, unsigned char* out, float* weights )
+{
+    auto c0 = pack_565( lo );
+    auto c1 = pack_565( hi );
+    // the order of the endpoints selects the mode, c0 > c1 has 4 colors
+    if ( three_colors ? c0 > c1 : c0 < c1 )
+    {
+        std::swap( c0, c1 );
+    }
+    const bool four_colors = c0 > c1;
+    int palette[4][4];
+    color_palette( c0, c1, four_colors || !three_colors, palette );
+    const int num_colors = four_colors || !three_colors ? 4 : 3;
+    // weight of c1 in each color, to refine the endpoints
+    const float palette_weights[2][4] = { { 0.f, 1.f, 1.f / 3.f, 2.f / 3.f }, { 0.f, 1.f, .5f, 0.f } };
+
+    float error = 0.f;
+    uint32_t indices = 0u;
+    for ( uint32_t i = 0u; i < block_texels; i++ )
+    {
+        uint32_t best = 3u;
+        if ( !transparent[i] )
+        {
+            float best_error = std::numeric_limits<float>::max();
+            for ( int p = 0; p < num_colors; p++ )
+            {
+                float texel_error = 0.f;
+                for ( uint32_t c = 0u; c < 3u; c++ )
+                {
+                    const auto d = texels[i][c] - static_cast<float>( palette[p][c] );
+                    texel_error += d * d;
+                }
+                if ( texel_error < best_error )
+                {
+                    best_error = texel_error;
+                    best = static_cast<uint32_t>( p );
+                }
+            }
+            error += best_error;
+            weights[i] = palette_weights[num_colors == 4 ? 0 : 1][best];
+        }
+        indices |= best << ( i * 2u );
+    }
+    write_u16( out, c0 );
+    write_u16( out + 2, c1 );
+    write_u16( out + 4, indices & 0xffffu );
+    write_u16( out + 6, indices >> 16u );
+    return error;
+}
+
+/// @brief Encode a BC1 block, or the color half of a BC3 block which always has 4 colors.
+void encode_bc1( const texel_block& texels, bool four_colors, unsigned char* out )
+{
+    bool transparent[block_texels];
+    bool active[block_texels];
+    bool any_transparent = false;
+    bool any_active = false;
+    for ( uint32_t i = 0u; i < block_texels; i++ )
+    {
+        transparent[i] = !four_colors && texels[i][3] < 128.f;
+        active[i] = !transparent[i];
+        any_transparent = any_transparent || transparent[i];
+        any_active = any_active || active[i];
+    }
+    if ( !any_active )
+    {
+        // equal endpoints select the 3 color mode, every index is transparent
+        std::memset( out, 0, 4u );
+        std::memset( out + 4, 0xff, 4u );
+        return;
+    }
+
+    float lo[4];
+    float hi[4];
+    float weights[block_texels] = {};
+    fit_principal_axis<3u>( texels, active, lo, hi );
+    auto best_error = encode_colors( texels, transparent, any_transparent, lo, hi, out, weights );
+    for ( int iteration = 0; iteration < 2 && best_error > 0.f; iteration++ )
+    {
+        // the weights are relative to c0 and c1 as written, which become lo and hi
+        float c0[4];
+        float c1[4];
+        if ( !refine_endpoints<3u>( texels, active, weights, c0, c1 ) )
+        {
+            break;
+        }
+        unsigned char candidate[8];
+        float candidate_weights[block_texels] = {};
+        const auto error = encode_colors( texels, transparent, any_transparent, c0, c1, candidate, candidate_weights );
+        if ( error >= best_error )
+        {
+            break;
+        }
+        best_error = error;
+        std::memcpy( out, candidate, sizeof( candidate ) );
+        std::memcpy( weights, candidate_weights, sizeof( weights ) );
+    }
+}
+
+void decode_bc1( const unsigned char* in, bool four_colors, unsigned char ( &texels )[block_texels][4] )
+{
+    const auto c0 = read_u16( in );
+    const auto c1 = read_u16( in + 2 );
+    const auto indices = read_u16( in + 4 ) | ( read_u16( in + 6 ) << 16u );
+    int palette[4][4];
+    color_palette( c0, c1, four_colors || c0 > c1, palette );
+    for ( uint32_t i = 0u; i < block_texels; i++ )
+    {
+        const auto& color = palette[( indices >> ( i * 2u ) ) & 3u];
+        for ( uint32_t c = 0u; c < 4u; c++ )
+        {
+            texels[i][c] = static_cast<unsigned char>( color[c] );
+        }
+    }
+}
+
+// -- BC4 single channel --
+
+/// @brief Return the 8 values of a BC4 block, r0 > r1 has 8 interpolated values, otherwise 6 and 0 and 255.
+void value_palette( int r0, int r1, int ( &palette )[8] )
+{
+    palette[0] = r0;
+    palette[1] = r1;
+    if ( r0 > r1 )
+    {
+        for ( int i = 1; i < 7; i++ )
+        {
+            palette[i + 1] = ( ( 7 - i ) * r0 + i * r1 + 3 ) / 7;
+        }
+    }
+    else
+    {
+        for ( int i = 1; i < 5; i++ )
+        {
+            palette[i + 1] = ( ( 5 - i ) * r0 + i * r1 + 2 ) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+/// @return squared error of the values
+float encode_values( const float* values, int r0, int r1, unsigned char* out )
+{
+    int palette[8];
+    value_palette( r0, r1, palette );
+    float error = 0.f;
+    uint64_t indices = 0u;
+    for ( uint32_t i = 0u; i < block_texels; i++ )
+    {
+        uint64_t best = 0u;
+        float best_error = std::numeric_limits<float>::max();
+        for ( uint32_t p = 0u; p < 8u; p++ )
+        {
+            const auto d = values[i] - static_cast<float>( palette[p] );
+            if ( d * d < best_error )
+            {
+                best_error = d * d;
+                best = p;
+            }
+        }
+        error += best_error;
+        indices |= best << ( i * 3u );
+    }
+    out[0] = static_cast<unsigned char>( r0 );
+    out[1] = static_cast<unsigned char>( r1 );
+    for ( uint32_t b = 0u; b < 6u; b++ )
+    {
+        out[2u + b] = static_cast<unsigned char>( ( indices >> ( b * 8u ) ) & 0xffu );
+    }
+    return error;
+}
+
+void encode_bc4( const texel_block& texels, uint32_t channel, unsigned char* out )
+{
+    float values[block_texels];
+    float min = 255.f;
+    float max = 0.f;
+    // bounds of the values that the 6 value mode does not get exactly from its 0 and 255
+    float inner_min = 255.f;
+    float inner_max = 0.f;
+    for ( uint32_t i = 0u; i < block_texels; i++ )
+    {
+        values[i] = texels[i][channel];
+        min = std::min( min, values[i] );
+        max = std::max( max, values[i] );
+        if ( values[i] > 0.f && values[i] < 255.f )
+        {
+            inner_min = std::min( inner_min, values[i] );
+            inner_max = std::max( inner_max, values[i] );
+        }
+    }
+    auto best_error = encode_values( values, static_cast<int>( max ), static_cast<int>( min ), out );
+    if ( best_error > 0.f && ( min == 0.f || max == 255.f ) )
+    {
+        unsigned char candidate[8];
+        const auto error = encode_values( values, static_cast<int>( std::min( inner_min, inner_max ) ),
+                                          static_cast<int>( inner_max ), candidate );
+        if ( error < best_error )
+        {
+            std::memcpy( out, candidate, sizeof( candidate ) );
+        }
+    }
+}
+
+void decode_bc4( const unsigned char* in, uint32_t channel, unsigned char ( &texels )[block_texels][4] )
+{
+    int palette[8];
+    value_palette( in[0], in[1], palette );
+    uint64_t indices = 0u;
+    for ( uint32_t b = 0u; b < 6u; b++ )
+    {
+        indices |= static_cast<uint64_t>( in[2u + b] ) << ( b * 8u );
+    }
+    for ( uint32_t i = 0u; i < block_texels; i++ )
+    {
+        texels[i][channel] = static_cast<unsigned char>( palette[( indices >> ( i * 3u ) ) & 7u] );
+    }
+}
+
+// -- BC7 mode 6 --
+
+constexpr int bc7_weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+/// @brief Writes the fields of a block from its lowest bit.
+struct bit_writer
+{
+    unsigned char* _out;
+    uint32_t _bit{ 0u };
+
+    void write( uint32_t value, uint32_t bits )
+    {
+        for ( uint32_t b = 0u; b < bits; b++, _bit++ )
+        {
+            _out[_bit / 8u] |= static_cast<unsigned char>( ( ( value >> b ) & 1u ) << ( _bit % 8u ) );
+        }
+    }
+};
+
+struct bit_reader
+{
+    const unsigned char* _in;
+    uint32_t _bit{ 0u };
+
+    uint32_t read( uint32_t bits )
+    {
+        uint32_t value = 0u;
+        for ( uint32_t b = 0u; b < bits; b++, _bit++ )
+        {
+            value |= ( ( _in[_bit / 8u] >> ( _bit % 8u ) ) & 1u ) << b;
+        }
+        return value;
+    }
+};
+
+/// @brief Quantize an endpoint to 7 bits per channel and the shared lowest bit that fits it best.
+void quantize_endpoint( const float* endpoint, uint32_t ( &quantized )[4], uint32_t& p_bit )
+{
+    float best_error = std::numeric_limits<float>::max();
+    // opaque endpoints keep an alpha of exactly 255, which only the odd values reach
+    for ( uint32_t p = endpoint[3] >= 255.f ? 1u : 0u; p < 2u; p++ )
+    {
+        uint32_t candidate[4];
+        float error = 0.f;
+        for ( uint32_t c = 0u; c < 4u; c++ )
+        {
+            const auto q = std::clamp( std::lround( ( endpoint[c] - static_cast<float>( p ) ) / 2.f ), 0l, 127l );
+            candidate[c] = static_cast<uint32_t>( q );
+            const auto d = endpoint[c] - static_cast<float>( ( q << 1 ) | p );
+            error += d * d;
+        }
+        if ( error < best_error )
+        {
+            best_error = error;
+            std::memcpy( quantized, candidate, sizeof( candidate ) );
+            p_bit = p;
+        }
+    }
+}
+
+/// @return squared error of the block
+float encode_mode6( const texel_block& texels, const float* lo, const float* hi, unsigned char* out, float* weights )
+{
+    uint32_t endpoints[2][4];
+    uint32_t p_bits[2];
+    quantize_endpoint( lo, endpoints[0], p_bits[0] );
+    quantize_endpoint( hi, endpoints[1], p_bits[1] );
+    int ends[2][4];
+    for ( uint32_t e = 0u; e < 2u; e++ )
+    {
+        for ( uint32_t c = 0u; c < 4u; c++ )
+        {
+            ends[e][c] = static_cast<int>( ( endpoints[e][c] << 1u ) | p_bits[e] );
+        }
+    }
+    int palette[16][4];
+    for ( uint32_t p = 0u; p < 16u; p++ )
+    {
+        for ( uint32_t c = 0u; c < 4u; c++ )
+        {
+            palette[p][c] = ( ( 64 - bc7_weights[p] ) * ends[0][c] + bc7_weights[p] * ends[1][c] + 32 ) >> 6;
+        }
+    }
+
+    // the palette lies along the line between the endpoints, so only the entries around the projection are tried
+    float direction[4];
+    float length = 0.f;
+    for ( uint32_t c = 0u; c < 4u; c++ )
+    {
+        direction[c] = static_cast<float>( ends[1][c] - ends[0][c] );
+        length += direction[c] * direction[c];
+    }
+    const auto scale = length > 0.f ? 15.f / length : 0.f;
+
+    float error = 0.f;
+    uint32_t indices[block_texels];
+    for ( uint32_t i = 0u; i < block_texels; i++ )
+    {
+        float t = 0.f;
+        for ( uint32_t c = 0u; c < 4u; c++ )
+        {
+            t += ( texels[i][c] - static_cast<float>( ends[0][c] ) ) * direction[c];
+        }
+        const auto nearest = static_cast<uint32_t>( std::clamp( std::lround( t * scale ), 0l, 15l ) );
+        float best_error = std::numeric_limits<float>::max();
+        for ( uint32_t p = nearest > 0u ? nearest - 1u : 0u; p <= std::min( nearest + 1u, 15u ); p++ )
+        {
+            float texel_error = 0.f;
+            for ( uint32_t c = 0u; c < 4u; c++ )
+            {
+                const auto d = texels[i][c] - static_cast<float>( palette[p][c] );
+                texel_error += d * d;
+            }
+            if ( texel_error < best_error )
+            {
+                best_error = texel_error;
+                indices[i] = p;
+            }
+        }
+        error += best_error;
+    }
+
+    // the highest bit of the first index is implicitly 0, the endpoints are swapped to clear it
+    const bool swap = indices[0] >= 8u;
+    for ( uint32_t i = 0u; i < block_texels; i++ )
+    {
+        if ( swap )
+        {
+            indices[i] = 15u - indices[i];
+        }
+        weights[i] = static_cast<float>( bc7_weights[indices[i]] ) / 64.f;
+    }
+    if ( swap )
+    {
+        std::swap( endpoints[0], endpoints[1] );
+        std::swap( p_bits[0], p_bits[1] );
+    }
+
+    std::memset( out, 0, 16u );
+    bit_writer writer{ out };
+    writer.write( 1u << 6u, 7u );
+    for ( uint32_t c = 0u; c < 4u; c++ )
+    {
+        writer.write( endpoints[0][c], 7u );
+        writer.write( endpoints[1][c], 7u );
+    }
+    writer.write( p_bits[0], 1u );
+    writer.write( p_bits[1], 1u );
+    for ( uint32_t i = 0u; i < block_texels; i++ )
+    {
+        writer.write( indices[i], i == 0u ? 3u : 4u );
+    }
+    return error;
+}
+
+void encode_bc7( const texel_block& texels, unsigned char* out )
+{
+    bool active[block_texels];
+    std::fill( std::begin( active ), std::end( active ), true );
+    float lo[4];
+    float hi[4];
+    float weights[block_texels];
+    fit_principal_axis<4u>( texels, active, lo, hi );
+    auto best_error = encode_mode6( texels, lo, hi, out, weights );
+    for ( int iteration = 0; iteration < 2 && best_error > 0.f; iteration++ )
+    {
+        if ( !refine_endpoints<4u>( texels, active, weights, lo, hi ) )
+        {
+            break;
+        }
+        unsigned char candidate[16];
+        float candidate_weights[block_texels];
+        const auto error = encode_mode6( texels, lo, hi, candidate, candidate_weights );
+        if ( error >= best_error )
+        {
+            break;
+        }
+        best_error = error;
+        std::memcpy( out, candidate, sizeof( candidate ) );
+        std::memcpy( weights, candidate_weights, sizeof( weights ) );
+    }
+}
+
+void decode_bc7( const unsigned char* in, unsigned char ( &texels )[block_texels][4] )
+{
+    if ( ( in[0] & 0x7fu ) != 0x40u )
+    {
+        std::memset( texels, 0, sizeof( texels ) );
+        return;
+    }
+    bit_reader reader{ in, 7u };
+    int ends[2][4];
+    for ( uint32_t c = 0u; c < 4u; c++ )
+    {
+        ends[0][c] = static_cast<int>( reader.read( 7u ) << 1u );
+        ends[1][c] = static_cast<int>( reader.read( 7u ) << 1u );
+    }
+    const auto p0 = static_cast<int>( reader.read( 1u ) );
+    const auto p1 = static_cast<int>( reader.read( 1u ) );
+    for ( uint32_t c = 0u; c < 4u; c++ )
+    {
+        ends[0][c] |= p0;
+        ends[1][c] |= p1;
+    }
+    for ( uint32_t i = 0u; i < block_texels; i++ )
+    {
+        const auto w = bc7_weights[reader.read( i == 0u ? 3u : 4u )];
+        for ( uint32_t c = 0u; c < 4u; c++ )
+        {
+            texels[i][c] = static_cast<unsigned char>( ( ( 64 - w ) * ends[0][c] + w * ends[1][c] + 32 ) >> 6 );
+        }
+    }
+}
+}
+
+size_t get_block_bytes( fnx::block_format format )
+{
+    switch ( format )
+    {
+        case fnx::block_format::bc1:
+        case fnx::block_format::bc4:
+            return 8u;
+        case fnx::block_format::bc3:
+        case fnx::block_format::bc5:
+        case fnx::block_format::bc7:
+            return 16u;
+        default:
+            return 0u;
+    }
+}
+
+size_t get_compressed_size( fnx::block_format format, uint32_t width, uint32_t height )
+{
+    if ( format == fnx::block_format::none )
+    {
+        return static_cast<size_t>( width ) * height * 4u;
+    }
+    const size_t blocks_x = ( width + block_size - 1u ) / block_size;
+    const size_t blocks_y = ( height + block_size - 1u ) / block_size;
+    return blocks_x * blocks_y * get_block_bytes( format );
+}
+
+const char* get_block_format_name( fnx::block_format format )
+{
+    switch ( format )
+    {
+        case fnx::block_format::bc1:
+            return "bc1";
+        case fnx::block_format::bc3:
+            return "bc3";
+        case fnx::block_format::bc4:
+            return "bc4";
+        case fnx::block_format::bc5:
+            return "bc5";
+        case fnx::block_format::bc7:
+            return "bc7";
+        default:
+            return "rgba8";
+    }
+}
+
+std::vector<unsigned char> compress_blocks( const unsigned char* pixels, uint32_t width, uint32_t height,
+        fnx::block_format format )
+{
+    if ( format == fnx::block_format::none )
+    {
+        return std::vector<unsigned char>( pixels, pixels + get_compressed_size( format, width, height ) );
+    }
+    std::vector<unsigned char> blocks( get_compressed_size( format, width, height ), 0u );
+    const auto block_bytes = get_block_bytes( format );
+    const uint32_t blocks_x = ( width + block_size - 1u ) / block_size;
+    const uint32_t blocks_y = ( height + block_size - 1u ) / block_size;
+    auto* out = blocks.data();
+    texel_block texels;
+    for ( uint32_t by = 0u; by < blocks_y; by++ )
+    {
+        for ( uint32_t bx = 0u; bx < blocks_x; bx++, out += block_bytes )
+        {
+            load_block( pixels, width, height, bx, by, texels );
+            switch ( format )
+            {
+                case fnx::block_format::bc1:
+                    encode_bc1( texels, false, out );
+                    break;
+                case fnx::block_format::bc3:
+                    encode_bc4( texels, 3u, out );
+                    encode_bc1( texels, true, out + 8 );
+                    break;
+                case fnx::block_format::bc4:
+                    encode_bc4( texels, 0u, out );
+                    break;
+                case fnx::block_format::bc5:
+                    encode_bc4( texels, 0u, out );
+                    encode_bc4( texels, 1u, out + 8 );
+                    break;
+                case fnx::block_format::bc7:
+                    encode_bc7( texels, out );
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+    return blocks;
+}
+
+std::vector<unsigned char> decompress_blocks( const unsigned char* blocks, uint32_t width, uint32_t height,
+        fnx::block_format format )
+{
+    if ( format == fnx::block_format::none )
+    {
+        return std::vector<unsigned char>( blocks, blocks + get_compressed_size( format, width, height ) );
+    }
+    std::vector<unsigned char> pixels( static_cast<size_t>( width ) * height * 4u, 0u );
+    const auto block_bytes = get_block_bytes( format );
+    const uint32_t blocks_x = ( width + block_size - 1u ) / block_size;
+    const uint32_t blocks_y = ( height + block_size - 1u ) / block_size;
+    const auto* in = blocks;
+    for ( uint32_t by = 0u; by < blocks_y; by++ )
+    {
+        for ( uint32_t bx = 0u; bx < blocks_x; bx++, in += block_bytes )
+        {
+            unsigned char texels[block_texels][4];
+            for ( auto& texel : texels )
+            {
+                texel[0] = texel[1] = texel[2] = 0u;
+                texel[3] = 255u;
+            }
+            switch ( format )
+            {
+                case fnx::block_format::bc1:
+                    decode_bc1( in, false, texels );
+                    break;
+                case fnx::block_format::bc3:
+                    decode_bc1( in + 8, true, texels );
+                    decode_bc4( in, 3u, texels );
+                    break;
+                case fnx::block_format::bc4:
+                    decode_bc4( in, 0u, texels );
+                    break;
+                case fnx::block_format::bc5:
+                    decode_bc4( in, 0u, texels );
+                    decode_bc4( in + 8, 1u, texels );
+                    break;
+                case fnx::block_format::bc7:
+                    decode_bc7( in, texels );
+                    break;
+                default:
+                    break;
+            }
+            store_block( texels, width, height, bx, by, pixels.data() );
+        }
+    }
+    return pixels;
+}
+
+float compute_psnr( const unsigned char* pixels, const unsigned char* other, size_t num_pixels, uint32_t channels )
+{
+    double squared_error = 0.0;
+    for ( size_t i = 0u; i < num_pixels; i++ )
+    {
+        for ( uint32_t c = 0u; c < channels; c++ )
+        {
+            const double d = static_cast<double>( pixels[i * 4u + c] ) - other[i * 4u + c];
+            squared_error += d * d;
+        }
+    }
+    if ( squared_error <= 0.0 || num_pixels == 0u )
+    {
+        return 100.f;
+    }
+    const auto mean_error = squared_error / ( static_cast<double>( num_pixels ) * channels );
+    return static_cast<float>( 10.0 * std::log10( 255.0 * 255.0 / mean_error ) );
+}
+}
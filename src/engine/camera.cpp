@@ -1,6 +1,16 @@
 namespace fnx
 {
+namespace
+{
+uint64_t next_camera_version()
+{
+    static std::atomic<uint64_t> version{ 0u };
+    return ++version;
+}
+}
+
 camera::camera()
+    : _version( next_camera_version() )
 {
 }
 
@@ -8,7 +18,44 @@ camera::~camera()
 {
 }
 
-void camera::update_view_matrix()
+void camera::invalidate_view()
+{
+    _view_dirty = true;
+    _version = next_camera_version();
+}
+
+void camera::invalidate_projection()
+{
+    _projection_dirty = true;
+    _version = next_camera_version();
+}
+
+void camera::update_view_matrix() const
+{
+    _view_matrix = fnx::matrix4x4::identity();
+}
+
+void camera::update_projection_matrix() const
+{
+    _projection_matrix = fnx::matrix4x4::identity();
+}
+
+void camera::recalculate() const
 {
+    if ( _view_dirty )
+    {
+        update_view_matrix();
+        _inverse_view_matrix = fnx::matrix_inverse( _view_matrix );
+    }
+    if ( _projection_dirty )
+    {
+        update_projection_matrix();
+        _inverse_projection_matrix = fnx::matrix_inverse( _projection_matrix );
+    }
+    // the camera matrices are stored in OpenGL column order, so projection * view is multiplied the other way around
+    _view_projection_matrix = _view_matrix * _projection_matrix;
+    _inverse_view_projection_matrix = _inverse_projection_matrix * _inverse_view_matrix;
+    _view_dirty = false;
+    _projection_dirty = false;
 }
 }
@@ -86,7 +86,8 @@ void camera_serializer::deserialize_camera( const YAML::Node& data, fnx::ortho_c
     camera._right = data["right"].as<float>();
     camera._top = data["top"].as<float>();
     camera._bottom = data["bottom"].as<float>();
-    camera.update_view_matrix();
+    camera.invalidate_view();
+    camera.invalidate_projection();
 }
 
 void camera_serializer::deserialize_camera( const YAML::Node& data, fnx::perspective_camera& camera )
@@ -101,7 +102,8 @@ void camera_serializer::deserialize_camera( const YAML::Node& data, fnx::perspec
     camera._field_of_view = fnx::Radian( data["field_of_view"].as<float>() );
     camera._near = data["near"].as<float>();
     camera._far = data["far"].as<float>();
-    camera.update_view_matrix();
+    camera.invalidate_view();
+    camera.invalidate_projection();
 }
 
 fnx::camera_handle camera_serializer::deserialize_camera_type( const YAML::Node& data )
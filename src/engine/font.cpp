@@ -20,10 +20,11 @@ void font::init( fnx::asset_manager<fnx::texture>& textures, const std::string&
                              cfg ); //, 4, Format::RGBA, Format::RGBA, Filter::Linear, Attachment::None, true )
     _line_height = { 0 };
     _base = { 0 };
-    ifstream in( char_map_file_path );
+    const auto file = fnx::read_file( char_map_file_path );
 
-    if ( in.good() )
+    if ( file.is_open() )
     {
+        istringstream in( string( file.view() ) );
         string line;
 
         while ( getline( in, line ) )
@@ -66,7 +67,7 @@ font::~font()
 
 float font::calculate_line_height( float font_size_in_pixels, float window_height )
 {
-    auto& a_char = _character_info[0x41];   // A
+    auto a_char = _character_info[0x41];   // A
 
     // font height in pixels divided by texture height in pixels gives half scale opengl height
     // equivalent to the number of times the texture height needs scaled to be the correct height in pixels
@@ -78,8 +79,8 @@ fnx::vector2 font::calculate_string_size( const fnx::vector2& size_limits, const
         float font_height_in_pixels,
         float window_width, float window_height, std::vector<std::pair<float, std::string>>& lines )
 {
-    auto& a_char = _character_info[0x41];   // A
-    auto& dot_char = _character_info[0x2E];   // .
+    auto a_char = _character_info[0x41];   // A
+    auto dot_char = _character_info[0x2E];   // .
     float font_scale = font_height_in_pixels / static_cast<float>( a_char.height );
     auto line_height_in_opengl = calculate_line_height( font_height_in_pixels, window_height );
     float width_to_opengl = 2.f / window_width;		/// conversion factor for width
@@ -227,8 +228,8 @@ fnx::vector2 font::calculate_texture_model_info( fnx::alignment align, const fnx
     model_coords.reserve( text.size() * 6 * 3 );
     text_coords.reserve( text.size() * 6 * 2 );
     // find the ratio to the font size to be used for the raw model info
-    auto& a_char = _character_info[0x41];   // A
-    auto& dot_char = _character_info[0x2E];   // .
+    auto a_char = _character_info[0x41];   // A
+    auto dot_char = _character_info[0x2E];   // .
     float font_scale = font_height_in_pixels / static_cast<float>( a_char.height );
     fnx::vector2 texture_dim( static_cast<float>( _texture->width() ), static_cast<float>( _texture->height() ) );
 
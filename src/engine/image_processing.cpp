@@ -0,0 +1,416 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace
+{
+/// @brief Linear value of each sRGB byte.
+const std::array<float, 256>& get_srgb_to_linear()
+{
+    static const auto table = []()
+    {
+        std::array<float, 256> values{};
+        for ( size_t i = 0; i < values.size(); i++ )
+        {
+            const auto c = static_cast<float>( i ) / 255.f;
+            values[i] = c <= 0.04045f ? c / 12.92f : std::pow( ( c + 0.055f ) / 1.055f, 2.4f );
+        }
+        return values;
+    }();
+    return table;
+}
+
+/// @brief Value of each byte of a channel that is not sRGB encoded.
+const std::array<float, 256>& get_unorm_to_float()
+{
+    static const auto table = []()
+    {
+        std::array<float, 256> values{};
+        for ( size_t i = 0; i < values.size(); i++ )
+        {
+            values[i] = static_cast<float>( i ) / 255.f;
+        }
+        return values;
+    }();
+    return table;
+}
+
+/// @brief sRGB byte of linear values in steps of 1 / ( size - 1 ), fine enough to round dark values right.
+constexpr size_t linear_to_srgb_size = 16384u;
+
+const std::array<unsigned char, linear_to_srgb_size>& get_linear_to_srgb()
+{
+    static const auto table = []()
+    {
+        std::array<unsigned char, linear_to_srgb_size> values{};
+        for ( size_t i = 0; i < values.size(); i++ )
+        {
+            const auto c = static_cast<float>( i ) / static_cast<float>( linear_to_srgb_size - 1u );
+            const auto s = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow( c, 1.f / 2.4f ) - 0.055f;
+            values[i] = static_cast<unsigned char>( s * 255.f + 0.5f );
+        }
+        return values;
+    }();
+    return table;
+}
+
+float saturate( float value )
+{
+    return std::min( std::max( value, 0.f ), 1.f );
+}
+
+unsigned char to_byte( float value )
+{
+    return static_cast<unsigned char>( saturate( value ) * 255.f + 0.5f );
+}
+
+unsigned char to_srgb_byte( float value )
+{
+    return get_linear_to_srgb()[static_cast<size_t>( saturate( value ) * static_cast<float>( linear_to_srgb_size - 1u ) +
+                                0.5f )];
+}
+
+/// @brief Number of channels holding colors, the last channel of two and four channel images is alpha.
+uint32_t get_color_channels( uint32_t channels )
+{
+    return channels == 2u || channels == 4u ? channels - 1u : channels;
+}
+
+/// @brief Zero order modified Bessel function of the first kind, by its power series.
+float bessel_i0( float x )
+{
+    float sum = 1.f;
+    float term = 1.f;
+    const float half_square = x * x * 0.25f;
+    for ( int k = 1; k < 32 && term > sum * 1e-7f; k++ )
+    {
+        term *= half_square / static_cast<float>( k * k );
+        sum += term;
+    }
+    return sum;
+}
+
+/// @brief Half width of the filters in texels of the smaller level.
+constexpr float box_radius = 0.5f;
+constexpr float kaiser_radius = 3.f;
+constexpr float kaiser_alpha = 4.f;
+
+float kaiser( float t )
+{
+    const float x = t / kaiser_radius;
+    if ( std::abs( x ) >= 1.f )
+    {
+        return 0.f;
+    }
+    const float pi_t = 3.14159265358979f * t;
+    const float sinc = std::abs( t ) < 1e-5f ? 1.f : std::sin( pi_t ) / pi_t;
+    return sinc * bessel_i0( kaiser_alpha * std::sqrt( 1.f - x * x ) ) / bessel_i0( kaiser_alpha );
+}
+
+/// @brief Weights of the texels of a row or column of a level that make each texel of the level below.
+struct filter_taps
+{
+    std::vector<uint32_t> first;	/// first texel read by each texel
+    std::vector<uint32_t> offsets;	/// start of the weights of each texel, followed by the end of the last
+    std::vector<float> weights;
+
+    size_t get_count( size_t i ) const
+    {
+        return offsets[i + 1u] - offsets[i];
+    }
+};
+
+filter_taps get_taps( uint32_t size, uint32_t out_size, fnx::mip_filter filter )
+{
+    filter_taps taps;
+    const float scale = static_cast<float>( size ) / static_cast<float>( out_size );
+    const float radius = ( filter == fnx::mip_filter::box ? box_radius : kaiser_radius ) * scale;
+    std::vector<float> weights;
+    for ( uint32_t x = 0u; x < out_size; x++ )
+    {
+        const float center = ( static_cast<float>( x ) + 0.5f ) * scale;
+        const auto lo = static_cast<int64_t>( std::floor( center - radius ) );
+        const auto hi = static_cast<int64_t>( std::ceil( center + radius ) );
+        const auto first = static_cast<uint32_t>( std::max<int64_t>( lo, 0 ) );
+        const auto last = static_cast<uint32_t>( std::min<int64_t>( hi, size ) - 1 );
+
+        // texels past the edges repeat the edge texel, their weight goes to it
+        weights.assign( last - first + 1u, 0.f );
+        float sum = 0.f;
+        for ( auto i = lo; i < hi; i++ )
+        {
+            float weight;
+            if ( filter == fnx::mip_filter::box )
+            {
+                weight = std::max( 0.f, std::min( static_cast<float>( i + 1 ), center + radius ) -
+                                   std::max( static_cast<float>( i ), center - radius ) );
+            }
+            else
+            {
+                weight = kaiser( ( static_cast<float>( i ) + 0.5f - center ) / scale );
+            }
+            weights[std::min( std::max<int64_t>( i, first ), static_cast<int64_t>( last ) ) - first] += weight;
+            sum += weight;
+        }
+
+        taps.first.emplace_back( first );
+        taps.offsets.emplace_back( static_cast<uint32_t>( taps.weights.size() ) );
+        for ( auto weight : weights )
+        {
+            taps.weights.emplace_back( weight / sum );
+        }
+    }
+    taps.offsets.emplace_back( static_cast<uint32_t>( taps.weights.size() ) );
+    return taps;
+}
+
+/// @brief Filter a level of four floats per texel into the level below, rows first then columns.
+/// @param[in] get_row : row y of the level
+void downsample( fnx::function_ref<const float*( size_t )> get_row, uint32_t width, uint32_t height,
+                 uint32_t out_width, uint32_t out_height, fnx::mip_filter filter, std::vector<float>& rows,
+                 std::vector<float>& out )
+{
+    const auto horizontal = get_taps( width, out_width, filter );
+    const auto vertical = get_taps( height, out_height, filter );
+    const size_t out_row = static_cast<size_t>( out_width ) * 4u;
+
+    rows.resize( out_row * height );
+    for ( size_t y = 0u; y < height; y++ )
+    {
+        const float* row = get_row( y );
+        float* dst = rows.data() + y * out_row;
+        for ( size_t x = 0u; x < out_width; x++ )
+        {
+            fnx::simd::weighted_sum4( row + horizontal.first[x] * 4u, horizontal.weights.data() + horizontal.offsets[x],
+                                      horizontal.get_count( x ), dst + x * 4u );
+        }
+    }
+
+    out.assign( out_row * out_height, 0.f );
+    for ( size_t y = 0u; y < out_height; y++ )
+    {
+        for ( size_t k = 0u; k < vertical.get_count( y ); k++ )
+        {
+            fnx::simd::multiply_add( rows.data() + ( vertical.first[y] + k ) * out_row,
+                                     vertical.weights[vertical.offsets[y] + k], out.data() + y * out_row, out_row );
+        }
+    }
+}
+
+float get_coverage( const std::vector<float>& texels, float cutoff, float scale )
+{
+    const size_t num_texels = texels.size() / 4u;
+    size_t covered = 0u;
+    for ( size_t i = 0u; i < num_texels; i++ )
+    {
+        covered += texels[i * 4u + 3u] * scale > cutoff ? 1u : 0u;
+    }
+    return num_texels > 0u ? static_cast<float>( covered ) / static_cast<float>( num_texels ) : 0.f;
+}
+
+/// @brief Return the scale of alpha that keeps the coverage of a level closest to target.
+float get_coverage_scale( const std::vector<float>& texels, float cutoff, float target )
+{
+    float lo = 0.f;
+    float hi = 1.f;
+    while ( get_coverage( texels, cutoff, hi ) < target && hi < 256.f )
+    {
+        lo = hi;
+        hi *= 2.f;
+    }
+    for ( int i = 0; i < 16; i++ )
+    {
+        const float mid = ( lo + hi ) * 0.5f;
+        if ( get_coverage( texels, cutoff, mid ) < target )
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return hi;
+}
+}
+
+namespace fnx
+{
+void swizzle_channels( unsigned char* pixels, size_t num_pixels, uint32_t channels,
+                       const std::array<uint8_t, 4>& order )
+{
+    unsigned char pixel[4];
+    for ( size_t i = 0u; i < num_pixels; i++, pixels += channels )
+    {
+        for ( uint32_t c = 0u; c < channels; c++ )
+        {
+            pixel[c] = pixels[order[c] < channels ? order[c] : c];
+        }
+        std::copy( pixel, pixel + channels, pixels );
+    }
+}
+
+void premultiply_alpha( unsigned char* pixels, size_t num_pixels, bool srgb )
+{
+    const auto& to_linear = get_srgb_to_linear();
+    for ( size_t i = 0u; i < num_pixels; i++, pixels += 4u )
+    {
+        const float alpha = static_cast<float>( pixels[3] ) / 255.f;
+        for ( size_t c = 0u; c < 3u; c++ )
+        {
+            pixels[c] = srgb ? to_srgb_byte( to_linear[pixels[c]] * alpha ) :
+                        to_byte( static_cast<float>( pixels[c] ) / 255.f * alpha );
+        }
+    }
+}
+
+float alpha_coverage( const unsigned char* pixels, size_t num_pixels, float cutoff, float scale )
+{
+    size_t covered = 0u;
+    for ( size_t i = 0u; i < num_pixels; i++ )
+    {
+        covered += static_cast<float>( pixels[i * 4u + 3u] ) / 255.f * scale > cutoff ? 1u : 0u;
+    }
+    return num_pixels > 0u ? static_cast<float>( covered ) / static_cast<float>( num_pixels ) : 0.f;
+}
+
+std::vector<fnx::raw_image::mip> build_mips( const unsigned char* pixels, uint32_t width, uint32_t height,
+        uint32_t channels, const fnx::image_options& options )
+{
+    std::vector<fnx::raw_image::mip> mips;
+    if ( nullptr == pixels || channels == 0u || channels > 4u || width == 0u || height == 0u )
+    {
+        return mips;
+    }
+
+    // every level is filtered as four linear floats per texel, so that rounding does not add up down the chain
+    const uint32_t color_channels = options.srgb ? get_color_channels( channels ) : 0u;
+    const float* to_float[4];
+    for ( uint32_t c = 0u; c < 4u; c++ )
+    {
+        to_float[c] = c < color_channels ? get_srgb_to_linear().data() : get_unorm_to_float().data();
+    }
+
+    const bool keep_coverage = channels == 4u && options.alpha_cutoff > 0.f;
+    const float coverage = keep_coverage ? alpha_coverage( pixels, static_cast<size_t>( width ) * height,
+                           options.alpha_cutoff ) : 0.f;
+    std::vector<float> row( static_cast<size_t>( width ) * 4u, 0.f );
+    std::vector<float> level;
+    std::vector<float> rows;
+    std::vector<float> next;
+    auto get_row = [&]( size_t y ) -> const float*
+    {
+        if ( !mips.empty() )
+        {
+            return level.data() + y * width * 4u;
+        }
+
+        // the image is converted a row at a time as it is filtered
+        const unsigned char* pixel = pixels + y * width * channels;
+        for ( size_t x = 0u; x < width; x++, pixel += channels )
+        {
+            for ( uint32_t c = 0u; c < channels; c++ )
+            {
+                row[x * 4u + c] = to_float[c][pixel[c]];
+            }
+        }
+        return row.data();
+    };
+
+    while ( width > 1u || height > 1u )
+    {
+        const auto next_width = std::max( width / 2u, 1u );
+        const auto next_height = std::max( height / 2u, 1u );
+        downsample( get_row, width, height, next_width, next_height, options.filter, rows, next );
+        level.swap( next );
+        width = next_width;
+        height = next_height;
+
+        // the scale only applies to the stored level, the next one is filtered from the unscaled alpha, premultiplied
+        // colors are scaled along with their alpha so that they stay the same once divided by it
+        const float alpha_scale = keep_coverage ? get_coverage_scale( level, options.alpha_cutoff, coverage ) : 1.f;
+        fnx::raw_image::mip mip;
+        mip._width = width;
+        mip._height = height;
+        mip._data.resize( static_cast<size_t>( width ) * height * channels );
+        for ( size_t i = 0u; i < static_cast<size_t>( width ) * height; i++ )
+        {
+            for ( uint32_t c = 0u; c < channels; c++ )
+            {
+                const float scale = c == 3u || options.premultiply_alpha ? alpha_scale : 1.f;
+                const float value = level[i * 4u + c] * scale;
+                mip._data[i * channels + c] = c < color_channels ? to_srgb_byte( value ) : to_byte( value );
+            }
+        }
+        mips.emplace_back( std::move( mip ) );
+    }
+    return mips;
+}
+
+void prepare_image( fnx::raw_image& image, const fnx::image_options& options )
+{
+    const auto& info = image.get_info();
+    if ( !info._is_ok || nullptr == info._data || info._channels == 0u || info._channels > 4u )
+    {
+        return;
+    }
+
+    const size_t num_pixels = static_cast<size_t>( info._width ) * info._height;
+    if ( options.swizzle != std::array<uint8_t, 4> { { 0u, 1u, 2u, 3u } } )
+    {
+        swizzle_channels( image.get_pixels(), num_pixels, info._channels, options.swizzle );
+    }
+    if ( options.premultiply_alpha && info._channels == 4u )
+    {
+        premultiply_alpha( image.get_pixels(), num_pixels, options.srgb );
+    }
+    if ( options.mips )
+    {
+        image.set_mips( build_mips( image.get_pixels(), info._width, info._height, info._channels, options ) );
+    }
+}
+
+fnx::compression_report compress_image( fnx::raw_image& image, fnx::block_format format )
+{
+    fnx::compression_report report;
+    const auto info = image.get_info();
+    if ( format == fnx::block_format::none || !info._is_ok || nullptr == info._data || info._channels == 0u ||
+            info._channels > 4u )
+    {
+        return report;
+    }
+
+    auto to_rgba = [channels = info._channels]( const unsigned char* pixels, size_t num_pixels )
+    {
+        std::vector<unsigned char> rgba( num_pixels * 4u );
+        for ( size_t i = 0u; i < num_pixels; i++ )
+        {
+            for ( uint32_t c = 0u; c < 4u; c++ )
+            {
+                rgba[i * 4u + c] = c < channels ? pixels[i * channels + c] : ( c == 3u ? 255u : 0u );
+            }
+        }
+        return rgba;
+    };
+    const size_t num_pixels = static_cast<size_t>( info._width ) * info._height;
+    const auto pixels = to_rgba( image.get_pixels(), num_pixels );
+    auto blocks = compress_blocks( pixels.data(), info._width, info._height, format );
+    const auto decoded = decompress_blocks( blocks.data(), info._width, info._height, format );
+    const uint32_t format_channels = format == fnx::block_format::bc4 ? 1u : format == fnx::block_format::bc5 ? 2u : 4u;
+    report.psnr = compute_psnr( pixels.data(), decoded.data(), num_pixels, std::min( info._channels, format_channels ) );
+    report.input_bytes = num_pixels * info._channels;
+    report.output_bytes = blocks.size();
+
+    std::vector<fnx::raw_image::mip> mips;
+    mips.reserve( image.get_mips().size() );
+    for ( const auto& mip : image.get_mips() )
+    {
+        const auto level = to_rgba( mip._data.data(), static_cast<size_t>( mip._width ) * mip._height );
+        mips.push_back( { mip._width, mip._height, compress_blocks( level.data(), mip._width, mip._height, format ) } );
+        report.input_bytes += mip._data.size();
+        report.output_bytes += mips.back()._data.size();
+    }
+    image.load_blocks( info._width, info._height, info._channels, format, std::move( blocks ), std::move( mips ) );
+    return report;
+}
+}
@@ -1,95 +1,95 @@
 namespace fnx
 {
-void parse_material_file( const std::string& file_path )
+namespace
+{
+/// @brief Uniform of each texture map of mtl_material.
+constexpr const char* map_uniforms[mtl_material::map_count] =
 {
-    auto [materials, _1] = singleton<asset_manager<material>>::acquire();
-    auto [textures, _2] = singleton<asset_manager<texture>>::acquire();
+    UNIFORM_MATERIAL_MAP_KA,
+    UNIFORM_MATERIAL_MAP_KD,
+    UNIFORM_MATERIAL_MAP_KS,
+    UNIFORM_MATERIAL_MAP_KE,
+    UNIFORM_MATERIAL_MAP_NS,
+    UNIFORM_MATERIAL_MAP_D
+};
+
+fnx::vector3 to_vector3( const float ( &color )[3] )
+{
+    return fnx::vector3{ color[0], color[1], color[2] };
+}
 
-    std::ifstream in( file_path );
-    if ( in.good() )
+void set_parameters( fnx::material& mat, const fnx::mtl_material& params )
+{
+    const auto& values = params.values;
+    const auto has = [&params]( uint32_t parameter )
+    {
+        return ( params.parameters & parameter ) != 0u;
+    };
+    if ( has( mtl_material::ns ) )
+    {
+        mat.add_float( UNIFORM_MATERIAL_NS, values.ns );
+    }
+    if ( has( mtl_material::ni ) )
+    {
+        mat.add_float( UNIFORM_MATERIAL_NI, values.ni );
+    }
+    if ( has( mtl_material::d ) )
+    {
+        mat.add_float( UNIFORM_MATERIAL_D, values.d );
+    }
+    if ( has( mtl_material::illum ) )
+    {
+        mat.add_float( UNIFORM_MATERIAL_ILLUM, values.illum );
+    }
+    if ( has( mtl_material::ka ) )
+    {
+        mat.add_vector3( UNIFORM_MATERIAL_KA, to_vector3( values.ka ) );
+    }
+    if ( has( mtl_material::kd ) )
+    {
+        mat.add_vector3( UNIFORM_MATERIAL_KD, to_vector3( values.kd ) );
+    }
+    if ( has( mtl_material::ks ) )
     {
-        std::string line;
-        fnx::material_handle mat;
-        while ( getline( in, line ) )
+        mat.add_vector3( UNIFORM_MATERIAL_KS, to_vector3( values.ks ) );
+    }
+    if ( has( mtl_material::ke ) )
+    {
+        mat.add_vector3( UNIFORM_MATERIAL_KE, to_vector3( values.ke ) );
+    }
+    for ( size_t m = 0u; m < mtl_material::map_count; m++ )
+    {
+        if ( !params.maps[m].empty() )
         {
-            std::stringstream str( line );
-            std::string cmd;
-            std::string word;
-            float val, r, g, b, illum;
-            str >> cmd;
-
-            if ( "newmtl" == cmd )
-            {
-                str >> word;
-                FNX_DEBUG( fnx::format_string( "found material %s", word ) );
-                mat = materials.get( word );
-            }
-            else if ( "Ns" == cmd )
-            {
-                str >> val;
-                mat->add_float( UNIFORM_MATERIAL_NS, val );
-            }
-            else if ( "Ni" == cmd )
-            {
-                str >> val;
-                mat->add_float( UNIFORM_MATERIAL_NI, val );
-            }
-            else if ( "d" == cmd )
-            {
-                str >> val;
-                mat->add_float( UNIFORM_MATERIAL_D, val );
-            }
-            else if ( "Ka" == cmd )
-            {
-                str >> r >> g >> b;
-                mat->add_vector3( UNIFORM_MATERIAL_KA, fnx::vector3{ r, g, b } );
-            }
-            else if ( "Kd" == cmd )
-            {
-                str >> r >> g >> b;
-                mat->add_vector3( UNIFORM_MATERIAL_KD, fnx::vector3{ r, g, b } );
-            }
-            else if ( "Ks" == cmd )
-            {
-                str >> r >> g >> b;
-                mat->add_vector3( UNIFORM_MATERIAL_KS, fnx::vector3{ r, g, b } );
-            }
-            else if ( "Ke" == cmd )
-            {
-                str >> r >> g >> b;
-                mat->add_vector3( UNIFORM_MATERIAL_KE, fnx::vector3{ r, g, b } );
-            }
-            else if ( "illum" == cmd )
-            {
-                str >> illum;
-                mat->add_float( UNIFORM_MATERIAL_ILLUM, illum );
-            }
-            else if ( "map_Ka" == cmd )
-            {
-                str >> word;
-                mat->add_texture( UNIFORM_MATERIAL_MAP_KA, textures.get( word ) );
-            }
-            else if ( "map_Kd" == cmd )
-            {
-                str >> word;
-                mat->add_texture( UNIFORM_MATERIAL_MAP_KD, textures.get( word ) );
-            }
-            else if ( "map_Ks" == cmd )
-            {
-                str >> word;
-                mat->add_texture( UNIFORM_MATERIAL_MAP_KS, textures.get( word ) );
-            }
-            else if ( "map_d" == cmd )
-            {
-                str >> word;
-                mat->add_texture( UNIFORM_MATERIAL_MAP_D, textures.get( word ) );
-            }
+            mat.add_texture_file( map_uniforms[m], std::string( params.maps[m] ) );
         }
     }
-    else
+}
+}
+
+void material::load_texture_files() const
+{
+    auto [textures, _] = singleton<asset_manager<texture>>::acquire();
+    for ( const auto& [name, file_path] : _texture_files )
+    {
+        _textures[name] = textures.get( file_path );
+    }
+    _texture_files = fnx::flat_map<fnx::string_id, std::string>();
+}
+
+void parse_material_file( const std::string& file_path )
+{
+    const auto cache = fnx::load_material_cache( file_path );
+    if ( !cache.is_open() )
+    {
+        return;
+    }
+    auto [materials, _] = singleton<asset_manager<material>>::acquire();
+    for ( const auto& params : cache.get_materials() )
     {
-        in.close();
-        FNX_ERROR( fnx::format_string( "unable to load material file %s", file_path.c_str() ) );
+        FNX_DEBUG( fnx::format_string( "found material %s", std::string( params.name ) ) );
+        auto mat = materials.get( std::string( params.name ) );
+        set_parameters( *mat, params );
     }
 }
-}
\ No newline at end of file
+}
@@ -0,0 +1,163 @@
+#include <cstring>
+
+namespace fnx
+{
+namespace
+{
+constexpr uint32_t material_magic = 0x544d4e46u;	/// "FNMT" when read on a little endian machine
+
+struct material_header
+{
+    uint32_t magic;
+    uint32_t format_version;
+    uint32_t num_materials;
+    uint32_t strings_size;
+    uint64_t content_hash;
+    uint64_t file_size;
+};
+
+/// @brief Position of a name or path in the string table.
+struct material_string
+{
+    uint32_t offset;
+    uint32_t size;
+};
+
+struct material_record
+{
+    material_string name;
+    uint32_t parameters;
+    uint32_t reserved;
+    fnx::mtl_values values;
+    material_string maps[mtl_material::map_count];
+};
+
+// records are copied to and from the file as they are laid out in memory
+static_assert( sizeof( material_header ) == 32u, "material cache header is padded" );
+static_assert( sizeof( fnx::mtl_values ) == 64u, "material values are padded" );
+static_assert( sizeof( material_record ) == 128u, "material cache record is padded" );
+}
+
+material_cache::material_cache( const std::string& file_path, uint64_t content_hash )
+{
+    open( file_path, content_hash );
+}
+
+material_cache::material_cache( std::vector<char>&& bytes, uint64_t content_hash )
+{
+    open( std::move( bytes ), content_hash );
+}
+
+bool material_cache::read( const char* data, size_t size, uint64_t content_hash )
+{
+    _materials.clear();
+    material_header header;
+    if ( size < sizeof( header ) )
+    {
+        return false;
+    }
+    std::memcpy( &header, data, sizeof( header ) );
+    const size_t records_size = static_cast<size_t>( header.num_materials ) * sizeof( material_record );
+    if ( header.magic != material_magic || header.format_version != format_version ||
+            header.content_hash != content_hash || header.file_size != size ||
+            records_size > size - sizeof( header ) || header.strings_size != size - sizeof( header ) - records_size )
+    {
+        return false;
+    }
+
+    const char* strings = data + sizeof( header ) + records_size;
+    auto get_string = [&]( const material_string & string, std::string_view & out )
+    {
+        if ( string.offset > header.strings_size || string.size > header.strings_size - string.offset )
+        {
+            return false;
+        }
+        out = std::string_view( strings + string.offset, string.size );
+        return true;
+    };
+    _materials.resize( header.num_materials );
+    for ( size_t i = 0u; i < _materials.size(); i++ )
+    {
+        material_record record;
+        std::memcpy( &record, data + sizeof( header ) + i * sizeof( record ), sizeof( record ) );
+        auto& material = _materials[i];
+        material.parameters = record.parameters;
+        material.values = record.values;
+        bool ok = get_string( record.name, material.name );
+        for ( size_t m = 0u; m < mtl_material::map_count; m++ )
+        {
+            ok = ok && get_string( record.maps[m], material.maps[m] );
+        }
+        if ( !ok )
+        {
+            _materials.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<char> material_cache::serialize( uint64_t content_hash, const std::vector<fnx::mtl_material>& materials )
+{
+    std::string strings;
+    auto add_string = [&strings]( std::string_view string )
+    {
+        const material_string position{ static_cast<uint32_t>( strings.size() ), static_cast<uint32_t>( string.size() ) };
+        strings += string;
+        return position;
+    };
+    std::vector<material_record> records( materials.size() );
+    for ( size_t i = 0u; i < materials.size(); i++ )
+    {
+        const auto& material = materials[i];
+        auto& record = records[i];
+        record = material_record{};
+        record.name = add_string( material.name );
+        record.parameters = material.parameters;
+        record.values = material.values;
+        for ( size_t m = 0u; m < mtl_material::map_count; m++ )
+        {
+            record.maps[m] = add_string( material.maps[m] );
+        }
+    }
+
+    material_header header{};
+    header.magic = material_magic;
+    header.format_version = format_version;
+    header.num_materials = static_cast<uint32_t>( records.size() );
+    header.strings_size = static_cast<uint32_t>( strings.size() );
+    header.content_hash = content_hash;
+    header.file_size = sizeof( header ) + records.size() * sizeof( material_record ) + strings.size();
+
+    std::vector<char> bytes( header.file_size );
+    std::memcpy( bytes.data(), &header, sizeof( header ) );
+    if ( !records.empty() )
+    {
+        std::memcpy( bytes.data() + sizeof( header ), records.data(), records.size() * sizeof( material_record ) );
+    }
+    std::memcpy( bytes.data() + sizeof( header ) + records.size() * sizeof( material_record ), strings.data(),
+                 strings.size() );
+    return bytes;
+}
+
+std::string get_material_cache_path( const std::string& mtl_path )
+{
+    return mtl_path + ".fnxmtl";
+}
+
+fnx::material_cache load_material_cache( const std::string& mtl_path )
+{
+    const auto source = fnx::read_file( mtl_path );
+    if ( !source.is_open() )
+    {
+        FNX_ERROR( fnx::format_string( "unable to load material file %s", mtl_path.c_str() ) );
+        return fnx::material_cache();
+    }
+    const auto content_hash = fnx::hash_bytes( source.data(), source.size() );
+    return fnx::load_cache_file<fnx::material_cache>( get_material_cache_path( mtl_path ), content_hash, [&]()
+    {
+        FNX_DEBUG( fnx::format_string( "parsing material file %s", mtl_path.c_str() ) );
+        return material_cache::serialize( content_hash, fnx::parse_mtl( source.view() ) );
+    } );
+}
+}
@@ -0,0 +1,519 @@
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace fnx
+{
+namespace
+{
+constexpr uint32_t cache_magic = 0x484d4e46u;	/// "FNMH" when read on a little endian machine
+
+/// @brief Position of a name in the string table.
+struct cache_string
+{
+    uint32_t offset;
+    uint32_t size;
+};
+
+struct cache_header
+{
+    uint32_t magic;
+    uint32_t format_version;
+    uint32_t importer_version;
+    uint32_t num_meshes;
+    uint64_t content_hash;
+    uint64_t file_size;
+    uint32_t num_materials;
+    uint32_t num_libraries;
+    uint64_t strings_offset;
+    uint32_t num_lods;
+    uint32_t reserved;
+};
+
+struct cache_mesh
+{
+    cache_string name;
+    uint32_t flags;
+    uint32_t first_material;
+    uint32_t num_materials;
+    uint32_t first_lod;
+    uint32_t num_lods;
+    float min[3];
+    float max[3];
+    uint32_t index_size;	/// bytes of each index
+    uint64_t vertex_offset;
+    uint64_t num_vertices;	/// in floats
+    uint64_t index_offset;
+    uint64_t num_indices;
+};
+
+struct cache_material
+{
+    cache_string name;
+    int32_t start;
+    int32_t end;
+};
+
+struct cache_lod
+{
+    uint32_t start;
+    uint32_t end;
+    float error;
+    uint32_t first_material;	/// the materials of a level follow those of its mesh
+    uint32_t num_materials;
+};
+
+// the tables follow each other without padding
+static_assert( sizeof( cache_header ) == 56u, "cache header is padded" );
+static_assert( sizeof( cache_mesh ) == 88u, "cache mesh is padded" );
+static_assert( sizeof( cache_material ) == 16u, "cache material is padded" );
+static_assert( sizeof( cache_lod ) == 20u, "cache lod is padded" );
+
+template<typename T>
+void write_record( std::vector<char>& bytes, size_t& offset, const T& record )
+{
+    std::memcpy( bytes.data() + offset, &record, sizeof( T ) );
+    offset += sizeof( T );
+}
+
+/// @brief Reads the records of a cache, every read is bounds checked so damaged files are rejected.
+struct cache_reader
+{
+    const char* _data;
+    size_t _size;
+
+    template<typename T>
+    bool read_record( size_t offset, T& record ) const
+    {
+        if ( offset > _size || _size - offset < sizeof( T ) )
+        {
+            return false;
+        }
+        std::memcpy( &record, _data + offset, sizeof( T ) );
+        return true;
+    }
+
+    bool contains( uint64_t offset, uint64_t count, size_t element_size ) const
+    {
+        return offset <= _size && count <= ( _size - offset ) / element_size;
+    }
+
+    template<typename T>
+    bool get_blob( uint64_t offset, uint64_t count, fnx::span<const T>& blob ) const
+    {
+        if ( offset % alignof( T ) != 0u || !contains( offset, count, sizeof( T ) ) )
+        {
+            return false;
+        }
+        blob = fnx::span<const T>( reinterpret_cast<const T*>( _data + offset ), static_cast<size_t>( count ) );
+        return true;
+    }
+};
+}
+
+mesh_cache::mesh_cache( const std::string& file_path, uint64_t content_hash )
+{
+    open( file_path, content_hash );
+}
+
+mesh_cache::mesh_cache( std::vector<char>&& bytes, uint64_t content_hash )
+{
+    open( std::move( bytes ), content_hash );
+}
+
+bool mesh_cache::read( const char* data, size_t size, uint64_t content_hash )
+{
+    _meshes.clear();
+    _material_libraries.clear();
+    cache_reader reader{ data, size };
+    cache_header header;
+    if ( !reader.read_record( 0u, header ) || header.magic != cache_magic || header.format_version != format_version ||
+            header.importer_version != importer_version || header.content_hash != content_hash ||
+            header.file_size != size )
+    {
+        return false;
+    }
+
+    const size_t meshes_offset = sizeof( cache_header );
+    const size_t materials_offset = meshes_offset + header.num_meshes * sizeof( cache_mesh );
+    const size_t lods_offset = materials_offset + header.num_materials * sizeof( cache_material );
+    const size_t libraries_offset = lods_offset + header.num_lods * sizeof( cache_lod );
+    if ( !reader.contains( meshes_offset, header.num_meshes, sizeof( cache_mesh ) ) ||
+            !reader.contains( materials_offset, header.num_materials, sizeof( cache_material ) ) ||
+            !reader.contains( lods_offset, header.num_lods, sizeof( cache_lod ) ) ||
+            !reader.contains( libraries_offset, header.num_libraries, sizeof( cache_string ) ) ||
+            header.strings_offset > size )
+    {
+        return false;
+    }
+    const std::string_view strings( data + header.strings_offset, size - header.strings_offset );
+    auto get_string = [&strings]( const cache_string & str, std::string_view & value )
+    {
+        if ( str.offset > strings.size() || str.size > strings.size() - str.offset )
+        {
+            return false;
+        }
+        value = strings.substr( str.offset, str.size );
+        return true;
+    };
+
+    _material_libraries.resize( header.num_libraries );
+    for ( uint32_t i = 0u; i < header.num_libraries; i++ )
+    {
+        cache_string library;
+        if ( !reader.read_record( libraries_offset + i * sizeof( cache_string ), library ) ||
+                !get_string( library, _material_libraries[i] ) )
+        {
+            return false;
+        }
+    }
+
+    auto read_materials = [&]( uint32_t first, uint32_t count, fnx::material_map & materials )
+    {
+        for ( uint32_t m = first; m < first + count; m++ )
+        {
+            cache_material material;
+            std::string_view material_name;
+            if ( !reader.read_record( materials_offset + m * sizeof( cache_material ), material ) ||
+                    !get_string( material.name, material_name ) )
+            {
+                return false;
+            }
+            materials.add_material_range( std::string( material_name ), material.start, material.end );
+        }
+        return true;
+    };
+
+    _meshes.resize( header.num_meshes );
+    for ( uint32_t i = 0u; i < header.num_meshes; i++ )
+    {
+        cache_mesh record;
+        auto& mesh = _meshes[i];
+        if ( !reader.read_record( meshes_offset + i * sizeof( cache_mesh ), record ) ||
+                !get_string( record.name, mesh.name ) ||
+                record.first_material > header.num_materials ||
+                record.num_materials > header.num_materials - record.first_material ||
+                record.first_lod > header.num_lods || record.num_lods > header.num_lods - record.first_lod ||
+                !reader.get_blob( record.vertex_offset, record.num_vertices, mesh.vertices ) ||
+                ( record.index_size == sizeof( unsigned short ) &&
+                  !reader.get_blob( record.index_offset, record.num_indices, mesh.indices ) ) ||
+                ( record.index_size == sizeof( unsigned int ) &&
+                  !reader.get_blob( record.index_offset, record.num_indices, mesh.indices_32 ) ) ||
+                ( record.num_indices > 0u && mesh.indices.empty() && mesh.indices_32.empty() ) )
+        {
+            return false;
+        }
+        mesh.flags = static_cast<int>( record.flags );
+        mesh.aabb.setMin( fnx::vector3( record.min[0], record.min[1], record.min[2] ) );
+        mesh.aabb.setMax( fnx::vector3( record.max[0], record.max[1], record.max[2] ) );
+        if ( !read_materials( record.first_material, record.num_materials, mesh.materials ) )
+        {
+            return false;
+        }
+        const auto num_indices = mesh.indices.size() + mesh.indices_32.size();
+        mesh.lods.resize( record.num_lods );
+        for ( uint32_t l = 0u; l < record.num_lods; l++ )
+        {
+            cache_lod lod;
+            if ( !reader.read_record( lods_offset + ( record.first_lod + l ) * sizeof( cache_lod ), lod ) ||
+                    lod.start > lod.end || lod.end > num_indices ||
+                    lod.first_material > header.num_materials ||
+                    lod.num_materials > header.num_materials - lod.first_material ||
+                    !read_materials( lod.first_material, lod.num_materials, mesh.lods[l].materials ) )
+            {
+                return false;
+            }
+            mesh.lods[l].start = lod.start;
+            mesh.lods[l].end = lod.end;
+            mesh.lods[l].error = lod.error;
+        }
+    }
+    return true;
+}
+
+std::vector<char> mesh_cache::serialize( uint64_t content_hash, const std::vector<fnx::cached_mesh>& meshes,
+        const std::vector<std::string>& material_libraries )
+{
+    // size every section first so the content is written with a single allocation
+    cache_header header{};
+    header.magic = cache_magic;
+    header.format_version = format_version;
+    header.importer_version = importer_version;
+    header.content_hash = content_hash;
+    header.num_meshes = static_cast<uint32_t>( meshes.size() );
+    header.num_libraries = static_cast<uint32_t>( material_libraries.size() );
+    size_t strings_size = 0u;
+    for ( const auto& mesh : meshes )
+    {
+        header.num_materials += static_cast<uint32_t>( mesh.materials.size() );
+        header.num_lods += static_cast<uint32_t>( mesh.lods.size() );
+        strings_size += mesh.name.size();
+        for ( const auto& material : mesh.materials.get_all() )
+        {
+            strings_size += material._material_name.size();
+        }
+        for ( const auto& lod : mesh.lods )
+        {
+            header.num_materials += static_cast<uint32_t>( lod.materials.size() );
+            for ( const auto& material : lod.materials.get_all() )
+            {
+                strings_size += material._material_name.size();
+            }
+        }
+    }
+    for ( const auto& library : material_libraries )
+    {
+        strings_size += library.size();
+    }
+    header.strings_offset = sizeof( cache_header ) + header.num_meshes * sizeof( cache_mesh ) +
+                            header.num_materials * sizeof( cache_material ) + header.num_lods * sizeof( cache_lod ) +
+                            header.num_libraries * sizeof( cache_string );
+    header.file_size = fnx::align_offset( header.strings_offset + strings_size );
+    for ( const auto& mesh : meshes )
+    {
+        header.file_size = fnx::align_offset( header.file_size + mesh.vertices.size() * sizeof( float ) );
+        header.file_size = fnx::align_offset( header.file_size + mesh.indices.size() * sizeof( unsigned short ) +
+                                              mesh.indices_32.size() * sizeof( unsigned int ) );
+    }
+
+    std::vector<char> bytes( static_cast<size_t>( header.file_size ), 0 );
+    size_t offset = 0u;
+    size_t string_offset = 0u;
+    size_t blob_offset = fnx::align_offset( header.strings_offset + strings_size );
+    auto add_string = [&]( std::string_view str )
+    {
+        std::memcpy( bytes.data() + header.strings_offset + string_offset, str.data(), str.size() );
+        cache_string record{ static_cast<uint32_t>( string_offset ), static_cast<uint32_t>( str.size() ) };
+        string_offset += str.size();
+        return record;
+    };
+    auto add_blob = [&]( const void* data, size_t size )
+    {
+        const auto start = blob_offset;
+        if ( size > 0u )
+        {
+            std::memcpy( bytes.data() + start, data, size );
+        }
+        blob_offset = fnx::align_offset( blob_offset + size );
+        return static_cast<uint64_t>( start );
+    };
+
+    write_record( bytes, offset, header );
+    uint32_t first_material = 0u;
+    uint32_t first_lod = 0u;
+    for ( const auto& mesh : meshes )
+    {
+        cache_mesh record{};
+        record.name = add_string( mesh.name );
+        record.flags = static_cast<uint32_t>( mesh.flags );
+        record.first_material = first_material;
+        record.num_materials = static_cast<uint32_t>( mesh.materials.size() );
+        record.first_lod = first_lod;
+        record.num_lods = static_cast<uint32_t>( mesh.lods.size() );
+        const auto& min = mesh.aabb.getMin();
+        const auto& max = mesh.aabb.getMax();
+        record.min[0] = static_cast<float>( min.x );
+        record.min[1] = static_cast<float>( min.y );
+        record.min[2] = static_cast<float>( min.z );
+        record.max[0] = static_cast<float>( max.x );
+        record.max[1] = static_cast<float>( max.y );
+        record.max[2] = static_cast<float>( max.z );
+        record.vertex_offset = add_blob( mesh.vertices.data(), mesh.vertices.size() * sizeof( float ) );
+        record.num_vertices = mesh.vertices.size();
+        if ( mesh.indices_32.empty() )
+        {
+            record.index_size = sizeof( unsigned short );
+            record.index_offset = add_blob( mesh.indices.data(), mesh.indices.size() * sizeof( unsigned short ) );
+            record.num_indices = mesh.indices.size();
+        }
+        else
+        {
+            record.index_size = sizeof( unsigned int );
+            record.index_offset = add_blob( mesh.indices_32.data(), mesh.indices_32.size() * sizeof( unsigned int ) );
+            record.num_indices = mesh.indices_32.size();
+        }
+        write_record( bytes, offset, record );
+        first_material += record.num_materials;
+        for ( const auto& lod : mesh.lods )
+        {
+            first_material += static_cast<uint32_t>( lod.materials.size() );
+        }
+        first_lod += record.num_lods;
+    }
+    auto add_materials = [&]( const fnx::material_map & materials )
+    {
+        for ( const auto& material : materials.get_all() )
+        {
+            write_record( bytes, offset, cache_material{ add_string( material._material_name ), material._start, material._end } );
+        }
+    };
+    for ( const auto& mesh : meshes )
+    {
+        add_materials( mesh.materials );
+        for ( const auto& lod : mesh.lods )
+        {
+            add_materials( lod.materials );
+        }
+    }
+    first_material = 0u;
+    for ( const auto& mesh : meshes )
+    {
+        first_material += static_cast<uint32_t>( mesh.materials.size() );
+        for ( const auto& lod : mesh.lods )
+        {
+            const auto num_materials = static_cast<uint32_t>( lod.materials.size() );
+            write_record( bytes, offset, cache_lod{ static_cast<uint32_t>( lod.start ), static_cast<uint32_t>( lod.end ),
+                                                    lod.error, first_material, num_materials } );
+            first_material += num_materials;
+        }
+    }
+    for ( const auto& library : material_libraries )
+    {
+        write_record( bytes, offset, add_string( library ) );
+    }
+    return bytes;
+}
+
+namespace
+{
+/// @brief Import a model file and return the content of its cache.
+std::vector<char> import_model( const std::string& model_path, uint64_t content_hash )
+{
+    FNX_DEBUG( fnx::format_string( "importing model %s", model_path.c_str() ) );
+    auto data = load_obj( model_path );
+
+    // objects of the same name are drawn as one model, their material ranges follow the vertices they are moved to
+    std::vector<fnx::obj_object*> objects;
+    std::unordered_map<std::string_view, fnx::obj_object*> objects_by_name;
+    for ( auto& object : data.objects )
+    {
+        // faces before the first named object are not kept
+        if ( object.name.empty() )
+        {
+            continue;
+        }
+        auto [it, inserted] = objects_by_name.emplace( object.name, &object );
+        auto& first = *it->second;
+        if ( inserted )
+        {
+            objects.emplace_back( &object );
+        }
+        else if ( first.has_texture == object.has_texture && first.has_normal == object.has_normal )
+        {
+            const auto stride = 3 + ( object.has_texture ? 2 : 0 ) + ( object.has_normal ? 3 : 0 );
+            const auto start = static_cast<int>( first.vertices.size() / stride );
+            for ( const auto& material : object.materials.get_all() )
+            {
+                first.materials.add_material_range( material._material_name, start + material._start, start + material._end );
+            }
+            if ( first.vertices.empty() )
+            {
+                first.aabb = object.aabb;
+            }
+            else if ( !object.vertices.empty() )
+            {
+                first.aabb.mergeWithAABB( object.aabb );
+            }
+            first.vertices.insert( first.vertices.end(), object.vertices.begin(), object.vertices.end() );
+        }
+        else
+        {
+            FNX_WARN( fnx::format_string( "object %s of %s is skipped, it has other vertex data than the first one",
+                                          object.name.c_str(), model_path.c_str() ) );
+        }
+    }
+
+    std::vector<fnx::indexed_vertices> indexed( objects.size() );
+    std::vector<fnx::cached_mesh> meshes( objects.size() );
+    for ( size_t i = 0u; i < objects.size(); i++ )
+    {
+        const auto& object = *objects[i];
+        const size_t stride = 3u + ( object.has_texture ? 2u : 0u ) + ( object.has_normal ? 3u : 0u );
+        indexed[i] = fnx::index_vertices( object.vertices.data(), object.vertices.size() / stride, stride );
+        const auto report = fnx::optimize_mesh( indexed[i], stride, object.materials );
+        FNX_INFO( fnx::format_string( "mesh %s: ACMR %.3f, %.3f after vertex cache, %.3f after overdraw, "
+                                      "ATVR %.3f, %.3f, %.3f, overfetch %.3f, %.3f after vertex fetch",
+                                      object.name.c_str(), report.input.acmr, report.vertex_cache.acmr, report.overdraw.acmr,
+                                      report.input.atvr, report.vertex_cache.atvr, report.overdraw.atvr,
+                                      report.input_overfetch, report.overfetch ) );
+        const auto num_triangles = indexed[i].get_num_indices() / 3u;
+        auto& mesh = meshes[i];
+        mesh.lods = fnx::build_lods( indexed[i], stride, object.materials );
+        for ( size_t l = 0u; l < mesh.lods.size(); l++ )
+        {
+            const auto& lod = mesh.lods[l];
+            FNX_INFO( fnx::format_string( "mesh %s: LOD %d has %d of %d triangles, error %.5f", object.name.c_str(),
+                                          static_cast<int>( l + 1u ), static_cast<int>( ( lod.end - lod.start ) / 3u ),
+                                          static_cast<int>( num_triangles ), lod.error ) );
+        }
+        mesh.name = object.name;
+        mesh.flags = ( object.has_texture ? raw_model::data_bit::texture : 0 ) |
+                     ( object.has_normal ? raw_model::data_bit::normal : 0 );
+        mesh.vertices = indexed[i].vertices;
+        mesh.indices = indexed[i].indices;
+        mesh.indices_32 = indexed[i].indices_32;
+        mesh.materials = object.materials;
+        mesh.aabb = object.aabb;
+    }
+    return mesh_cache::serialize( content_hash, meshes, data.material_libraries );
+}
+}
+
+std::string get_mesh_cache_path( const std::string& model_path )
+{
+    return model_path + ".fnxmesh";
+}
+
+mesh_cache load_mesh_cache( const std::string& model_path )
+{
+    uint64_t content_hash = 0u;
+    {
+        const auto source = fnx::read_file( model_path );
+        if ( !source.is_open() )
+        {
+            FNX_ERROR( fnx::format_string( "unable to load model %s", model_path.c_str() ) );
+            throw std::runtime_error( "model file missing" );
+        }
+        content_hash = fnx::hash_bytes( source.data(), source.size() );
+    }
+
+    return fnx::load_cache_file<mesh_cache>( get_mesh_cache_path( model_path ), content_hash, [&]()
+    {
+        return import_model( model_path, content_hash );
+    } );
+}
+
+fnx::staged_mesh read_mesh( const std::string& model_path, const std::string& mesh_name )
+{
+    fnx::staged_mesh staged;
+    staged.cache = std::make_shared<const fnx::mesh_cache>( load_mesh_cache( model_path ) );
+    const auto& meshes = staged.cache->get_meshes();
+    for ( ; staged.index < meshes.size(); staged.index++ )
+    {
+        if ( meshes[staged.index].name == mesh_name )
+        {
+            return staged;
+        }
+    }
+    throw std::runtime_error( fnx::format_string( "%s has no mesh %s", model_path.c_str(), mesh_name.c_str() ) );
+}
+
+void copy_mesh( const fnx::cached_mesh& mesh, fnx::raw_model& raw )
+{
+    raw.get_mutable_vertices().assign( mesh.vertices.begin(), mesh.vertices.end() );
+    raw.get_mutable_indices().assign( mesh.indices.begin(), mesh.indices.end() );
+    raw.get_mutable_indices_32().assign( mesh.indices_32.begin(), mesh.indices_32.end() );
+    raw.get_mutable_material_map() = mesh.materials;
+    raw.get_mutable_aabb() = mesh.aabb;
+    raw.get_mutable_lods() = mesh.lods;
+    if ( mesh.flags & raw_model::data_bit::texture )
+    {
+        raw.set_texture_data_true();
+    }
+    if ( mesh.flags & raw_model::data_bit::normal )
+    {
+        raw.set_normal_data_true();
+    }
+}
+}
@@ -0,0 +1,901 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+namespace fnx
+{
+namespace
+{
+constexpr uint32_t empty_slot = UINT32_MAX;
+constexpr int forsyth_cache_size = 32;	/// cache modelled by the scores, larger than the hardware one on purpose
+constexpr size_t fetch_line_bytes = 64u;
+constexpr uint32_t fetch_cache_lines = 64u;
+
+/// @brief Score of a vertex from its position in the modelled LRU cache and its number of triangles left to draw.
+float get_vertex_score( int cache_position, uint32_t remaining )
+{
+    if ( remaining == 0u )
+    {
+        return -1.f;
+    }
+    float score = 0.f;
+    if ( cache_position >= 0 )
+    {
+        // the last triangle's vertices score a bit lower so that strips do not turn back on themselves
+        score = cache_position < 3 ? 0.75f :
+                std::pow( 1.f - static_cast<float>( cache_position - 3 ) / ( forsyth_cache_size - 3 ), 1.5f );
+    }
+    // favour vertices with few triangles left so that they leave the cache finished
+    return score + 2.f / std::sqrt( static_cast<float>( remaining ) );
+}
+
+/// @brief FIFO vertex cache, a vertex is in the cache while fewer than cache_size vertices were loaded after it.
+class fifo_cache
+{
+public:
+    fifo_cache( size_t num_vertices, size_t cache_size )
+        : _loaded( num_vertices, 0u )
+        , _cache_size( static_cast<uint32_t>( cache_size ) )
+        , _time( static_cast<uint32_t>( cache_size ) + 1u )
+    {
+    }
+
+    /// @return true if the vertex had to be loaded
+    bool load( unsigned int vertex )
+    {
+        if ( _time - _loaded[vertex] > _cache_size )
+        {
+            _loaded[vertex] = _time++;
+            return true;
+        }
+        return false;
+    }
+
+    /// @brief Forget every vertex.
+    void flush()
+    {
+        _time += _cache_size + 1u;
+    }
+
+private:
+    std::vector<uint32_t> _loaded;	/// time at which each vertex was last loaded
+    uint32_t _cache_size;
+    uint32_t _time;
+};
+
+/// @brief Number of vertices of the three corners of a triangle that miss the cache.
+uint32_t load_triangle( fifo_cache& cache, const unsigned int* corners )
+{
+    return static_cast<uint32_t>( cache.load( corners[0] ) ) + cache.load( corners[1] ) + cache.load( corners[2] );
+}
+
+struct triangle_cluster
+{
+    size_t _start;
+    size_t _end;	/// in triangles
+    float _sort_key;
+};
+
+/// @brief Sum of the squared distances to planes weighted by the area of their triangles.
+struct quadric
+{
+    double _a[6];	/// symmetric matrix of the squared terms, xx yy zz xy xz yz
+    double _b[3];
+    double _c;
+    double _weight;
+};
+
+void add_plane( quadric& q, const double* normal, double distance, double weight )
+{
+    q._a[0] += weight * normal[0] * normal[0];
+    q._a[1] += weight * normal[1] * normal[1];
+    q._a[2] += weight * normal[2] * normal[2];
+    q._a[3] += weight * normal[0] * normal[1];
+    q._a[4] += weight * normal[0] * normal[2];
+    q._a[5] += weight * normal[1] * normal[2];
+    for ( size_t k = 0u; k < 3u; k++ )
+    {
+        q._b[k] += weight * normal[k] * distance;
+    }
+    q._c += weight * distance * distance;
+    q._weight += weight;
+}
+
+void add_quadric( quadric& q, const quadric& other )
+{
+    for ( size_t k = 0u; k < 6u; k++ )
+    {
+        q._a[k] += other._a[k];
+    }
+    for ( size_t k = 0u; k < 3u; k++ )
+    {
+        q._b[k] += other._b[k];
+    }
+    q._c += other._c;
+    q._weight += other._weight;
+}
+
+/// @brief Mean squared distance of a point to the planes of the sum of two quadrics.
+float get_collapse_error( const quadric& q, const quadric& other, const float* point )
+{
+    const double weight = q._weight + other._weight;
+    if ( weight <= 0.0 )
+    {
+        return 0.f;
+    }
+    double a[6];
+    for ( size_t k = 0u; k < 6u; k++ )
+    {
+        a[k] = q._a[k] + other._a[k];
+    }
+    const double x = point[0];
+    const double y = point[1];
+    const double z = point[2];
+    const double error = a[0] * x * x + a[1] * y * y + a[2] * z * z +
+                         2.0 * ( a[3] * x * y + a[4] * x * z + a[5] * y * z ) +
+                         2.0 * ( ( q._b[0] + other._b[0] ) * x + ( q._b[1] + other._b[1] ) * y + ( q._b[2] + other._b[2] ) * z ) +
+                         q._c + other._c;
+    return static_cast<float>( std::max( error, 0.0 ) / weight );
+}
+
+void get_triangle_normal( const float* a, const float* b, const float* c, double* normal )
+{
+    const double ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+    const double ac[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+    normal[0] = ab[1] * ac[2] - ab[2] * ac[1];
+    normal[1] = ab[2] * ac[0] - ab[0] * ac[2];
+    normal[2] = ab[0] * ac[1] - ab[1] * ac[0];
+}
+
+struct edge_collapse
+{
+    unsigned int _from;
+    unsigned int _to;
+    float _error;
+};
+
+/// @brief Number the vertices of a range of indices from 0 in the order they are first used.
+/// @param[in,out] local_index : empty_slot for every vertex, before and after the call
+void gather_range( const unsigned int* indices, size_t num_indices, std::vector<uint32_t>& local_index,
+                   std::vector<unsigned int>& local_vertices, std::vector<unsigned int>& local_indices )
+{
+    local_vertices.clear();
+    local_indices.clear();
+    for ( size_t i = 0u; i < num_indices; i++ )
+    {
+        auto& local = local_index[indices[i]];
+        if ( local == empty_slot )
+        {
+            local = static_cast<uint32_t>( local_vertices.size() );
+            local_vertices.emplace_back( indices[i] );
+        }
+        local_indices.emplace_back( local );
+    }
+    for ( auto vertex : local_vertices )
+    {
+        local_index[vertex] = empty_slot;
+    }
+}
+
+void gather_positions( const std::vector<float>& vertices, size_t stride, const std::vector<unsigned int>& local_vertices,
+                       std::vector<float>& positions )
+{
+    positions.clear();
+    for ( auto vertex : local_vertices )
+    {
+        const auto* position = vertices.data() + vertex * stride;
+        positions.insert( positions.end(), position, position + 3 );
+    }
+}
+
+/// @brief Sorted starts and ends of the material ranges, whole triangles within the indices.
+std::vector<size_t> get_range_boundaries( const fnx::material_map& materials, size_t num_indices )
+{
+    std::vector<size_t> boundaries{ 0u, num_indices };
+    for ( const auto& material : materials.get_all() )
+    {
+        for ( auto boundary : { material._start, material._end } )
+        {
+            boundaries.emplace_back( std::min( static_cast<size_t>( std::max( boundary, 0 ) ) / 3u * 3u, num_indices ) );
+        }
+    }
+    std::sort( boundaries.begin(), boundaries.end() );
+    boundaries.erase( std::unique( boundaries.begin(), boundaries.end() ), boundaries.end() );
+    return boundaries;
+}
+
+std::vector<unsigned int> get_indices_32( indexed_vertices& mesh )
+{
+    return mesh.indices.empty() ? std::move( mesh.indices_32 ) :
+           std::vector<unsigned int>( mesh.indices.begin(), mesh.indices.end() );
+}
+
+void set_indices_32( indexed_vertices& mesh, std::vector<unsigned int>&& indices )
+{
+    if ( mesh.indices.empty() )
+    {
+        mesh.indices_32 = std::move( indices );
+    }
+    else
+    {
+        mesh.indices.assign( indices.begin(), indices.end() );
+    }
+}
+}
+
+indexed_vertices index_vertices( const float* vertices, size_t num_vertices, size_t stride )
+{
+    indexed_vertices result;
+    const auto vertex_bytes = stride * sizeof( float );
+
+    // open addressing table of the indices of the unique vertices, at most half full
+    size_t capacity = 16u;
+    while ( capacity < num_vertices * 2u )
+    {
+        capacity *= 2u;
+    }
+    const auto mask = capacity - 1u;
+    std::vector<uint32_t> table( capacity, empty_slot );
+    std::vector<uint32_t> remap( num_vertices );
+    std::vector<float> key( stride );
+    uint32_t num_unique = 0u;
+    for ( size_t i = 0u; i < num_vertices; i++ )
+    {
+        // -0 and 0 draw the same, computed normals often differ only by the sign of a zero
+        for ( size_t k = 0u; k < stride; k++ )
+        {
+            const auto value = vertices[i * stride + k];
+            key[k] = value == 0.f ? 0.f : value;
+        }
+        auto slot = static_cast<size_t>( fnx::hash_bytes( key.data(), vertex_bytes ) ) & mask;
+        while ( table[slot] != empty_slot &&
+                std::memcmp( result.vertices.data() + table[slot] * stride, key.data(), vertex_bytes ) != 0 )
+        {
+            slot = ( slot + 1u ) & mask;
+        }
+        if ( table[slot] == empty_slot )
+        {
+            table[slot] = num_unique++;
+            result.vertices.insert( result.vertices.end(), key.begin(), key.end() );
+        }
+        remap[i] = table[slot];
+    }
+
+    if ( num_unique <= max_vertices_16 )
+    {
+        result.indices.assign( remap.begin(), remap.end() );
+    }
+    else
+    {
+        result.indices_32 = std::move( remap );
+    }
+    return result;
+}
+
+vertex_cache_statistics analyze_vertex_cache( const unsigned int* indices, size_t num_indices, size_t num_vertices,
+        size_t cache_size )
+{
+    vertex_cache_statistics statistics;
+    fifo_cache cache( num_vertices, cache_size );
+    std::vector<bool> used( num_vertices, false );
+    size_t misses = 0u;
+    size_t num_used = 0u;
+    for ( size_t i = 0u; i < num_indices; i++ )
+    {
+        misses += cache.load( indices[i] );
+        num_used += used[indices[i]] ? 0u : 1u;
+        used[indices[i]] = true;
+    }
+    if ( num_indices >= 3u )
+    {
+        statistics.acmr = static_cast<float>( misses ) / static_cast<float>( num_indices / 3u );
+        statistics.atvr = static_cast<float>( misses ) / static_cast<float>( num_used );
+    }
+    return statistics;
+}
+
+float analyze_vertex_fetch( const unsigned int* indices, size_t num_indices, size_t num_vertices, size_t vertex_bytes )
+{
+    if ( num_vertices == 0u )
+    {
+        return 0.f;
+    }
+    fifo_cache cache( num_vertices, vertex_cache_size );
+    fifo_cache lines( ( num_vertices * vertex_bytes + fetch_line_bytes - 1u ) / fetch_line_bytes, fetch_cache_lines );
+    size_t loaded_lines = 0u;
+    for ( size_t i = 0u; i < num_indices; i++ )
+    {
+        if ( cache.load( indices[i] ) )
+        {
+            const auto first = indices[i] * vertex_bytes / fetch_line_bytes;
+            const auto last = ( ( indices[i] + 1u ) * vertex_bytes - 1u ) / fetch_line_bytes;
+            for ( auto line = first; line <= last; line++ )
+            {
+                loaded_lines += lines.load( static_cast<unsigned int>( line ) );
+            }
+        }
+    }
+    return static_cast<float>( loaded_lines * fetch_line_bytes ) / static_cast<float>( num_vertices * vertex_bytes );
+}
+
+void optimize_vertex_cache( unsigned int* indices, size_t num_indices, size_t num_vertices )
+{
+    const auto num_triangles = num_indices / 3u;
+    if ( num_triangles == 0u )
+    {
+        return;
+    }
+
+    // triangles of each vertex, those already drawn are moved past the remaining ones
+    std::vector<uint32_t> remaining( num_vertices, 0u );
+    for ( size_t i = 0u; i < num_triangles * 3u; i++ )
+    {
+        remaining[indices[i]]++;
+    }
+    std::vector<uint32_t> offsets( num_vertices + 1u, 0u );
+    std::partial_sum( remaining.begin(), remaining.end(), offsets.begin() + 1 );
+    std::vector<uint32_t> triangles( num_triangles * 3u );
+    {
+        auto cursor = offsets;
+        for ( size_t i = 0u; i < num_triangles * 3u; i++ )
+        {
+            triangles[cursor[indices[i]]++] = static_cast<uint32_t>( i / 3u );
+        }
+    }
+
+    std::vector<int> cache_position( num_vertices, -1 );
+    std::vector<float> vertex_score( num_vertices );
+    for ( size_t v = 0u; v < num_vertices; v++ )
+    {
+        vertex_score[v] = get_vertex_score( -1, remaining[v] );
+    }
+    std::vector<float> triangle_score( num_triangles );
+    for ( size_t t = 0u; t < num_triangles; t++ )
+    {
+        triangle_score[t] = vertex_score[indices[t * 3u]] + vertex_score[indices[t * 3u + 1u]] +
+                            vertex_score[indices[t * 3u + 2u]];
+    }
+
+    std::vector<bool> drawn( num_triangles, false );
+    std::vector<unsigned int> output;
+    output.reserve( num_triangles * 3u );
+    unsigned int cache[forsyth_cache_size + 3];
+    size_t cache_count = 0u;
+    size_t next_input = 0u;
+    size_t best = num_triangles;
+    while ( output.size() < num_triangles * 3u )
+    {
+        if ( best == num_triangles )
+        {
+            // dead end, nothing in the cache has triangles left, continue with the input order
+            while ( drawn[next_input] )
+            {
+                next_input++;
+            }
+            best = next_input;
+        }
+        drawn[best] = true;
+        const auto* corners = indices + best * 3u;
+        output.insert( output.end(), corners, corners + 3 );
+
+        for ( size_t k = 0u; k < 3u; k++ )
+        {
+            const auto v = corners[k];
+            auto* begin = triangles.data() + offsets[v];
+            auto* end = begin + remaining[v];
+            std::iter_swap( std::find( begin, end, static_cast<uint32_t>( best ) ), end - 1 );
+            remaining[v]--;
+        }
+
+        // the drawn corners move to the front of the cache, vertices pushed past its end leave it
+        unsigned int new_cache[forsyth_cache_size + 3];
+        size_t new_count = 0u;
+        for ( size_t k = 0u; k < 3u; k++ )
+        {
+            new_cache[new_count++] = corners[k];
+        }
+        for ( size_t i = 0u; i < cache_count; i++ )
+        {
+            if ( cache[i] != corners[0] && cache[i] != corners[1] && cache[i] != corners[2] )
+            {
+                new_cache[new_count++] = cache[i];
+            }
+        }
+
+        // rescore the vertices that moved and pick the best triangle of those still in the cache
+        best = num_triangles;
+        float best_score = -1.f;
+        for ( size_t i = 0u; i < new_count; i++ )
+        {
+            const auto v = new_cache[i];
+            cache_position[v] = i < forsyth_cache_size ? static_cast<int>( i ) : -1;
+            const auto score = get_vertex_score( cache_position[v], remaining[v] );
+            const auto delta = score - vertex_score[v];
+            vertex_score[v] = score;
+            for ( auto t = offsets[v]; t < offsets[v] + remaining[v]; t++ )
+            {
+                triangle_score[triangles[t]] += delta;
+            }
+        }
+        cache_count = std::min<size_t>( new_count, forsyth_cache_size );
+        std::copy( new_cache, new_cache + cache_count, cache );
+        for ( size_t i = 0u; i < cache_count; i++ )
+        {
+            const auto v = cache[i];
+            for ( auto t = offsets[v]; t < offsets[v] + remaining[v]; t++ )
+            {
+                if ( triangle_score[triangles[t]] > best_score )
+                {
+                    best_score = triangle_score[triangles[t]];
+                    best = triangles[t];
+                }
+            }
+        }
+    }
+    std::copy( output.begin(), output.end(), indices );
+}
+
+void optimize_overdraw( unsigned int* indices, size_t num_indices, const float* positions, size_t num_vertices,
+                        size_t stride, float threshold )
+{
+    const auto num_triangles = num_indices / 3u;
+    if ( num_triangles < 2u )
+    {
+        return;
+    }
+
+    // hard boundaries where every corner misses the cache, reordering there costs nothing
+    std::vector<size_t> boundaries;
+    fifo_cache cache( num_vertices, vertex_cache_size );
+    for ( size_t t = 0u; t < num_triangles; t++ )
+    {
+        if ( load_triangle( cache, indices + t * 3u ) == 3u )
+        {
+            boundaries.emplace_back( t );
+        }
+    }
+    boundaries.emplace_back( num_triangles );
+
+    // soft boundaries inside them, wherever the cluster so far is within the threshold of the whole
+    std::vector<triangle_cluster> clusters;
+    for ( size_t b = 0u; b + 1u < boundaries.size(); b++ )
+    {
+        const auto start = boundaries[b];
+        const auto end = boundaries[b + 1u];
+        cache.flush();
+        size_t misses = 0u;
+        for ( auto t = start; t < end; t++ )
+        {
+            misses += load_triangle( cache, indices + t * 3u );
+        }
+        const auto limit = threshold * static_cast<float>( misses ) / static_cast<float>( end - start );
+
+        cache.flush();
+        misses = 0u;
+        auto cluster_start = start;
+        for ( auto t = start; t < end; t++ )
+        {
+            misses += load_triangle( cache, indices + t * 3u );
+            if ( t + 1u == end || static_cast<float>( misses ) / static_cast<float>( t + 1u - cluster_start ) <= limit )
+            {
+                clusters.push_back( { cluster_start, t + 1u, 0.f } );
+                cluster_start = t + 1u;
+                misses = 0u;
+                cache.flush();
+            }
+        }
+    }
+
+    // clusters whose area faces away from the center of the mesh are drawn first
+    auto get_position = [&]( unsigned int vertex )
+    {
+        const auto* p = positions + vertex * stride;
+        return fnx::vector3( p[0], p[1], p[2] );
+    };
+    std::vector<fnx::vector3> centers( clusters.size() );
+    std::vector<fnx::vector3> normals( clusters.size() );
+    fnx::vector3 mesh_center( 0.f, 0.f, 0.f );
+    fnx::decimal mesh_area = 0.f;
+    for ( size_t c = 0u; c < clusters.size(); c++ )
+    {
+        fnx::vector3 center( 0.f, 0.f, 0.f );
+        fnx::vector3 normal( 0.f, 0.f, 0.f );
+        fnx::decimal area = 0.f;
+        for ( auto t = clusters[c]._start; t < clusters[c]._end; t++ )
+        {
+            const auto a = get_position( indices[t * 3u] );
+            const auto b = get_position( indices[t * 3u + 1u] );
+            const auto d = get_position( indices[t * 3u + 2u] );
+            const auto cross = ( b - a ).cross( d - a );
+            const auto triangle_area = cross.length();
+            center += ( a + b + d ) * ( triangle_area / 3.f );
+            normal += cross;
+            area += triangle_area;
+        }
+        mesh_center += center;
+        mesh_area += area;
+        centers[c] = area > 0.f ? center / area : center;
+        const auto length = normal.length();
+        normals[c] = length > 0.f ? normal / length : normal;
+    }
+    mesh_center = mesh_area > 0.f ? mesh_center / mesh_area : mesh_center;
+    for ( size_t c = 0u; c < clusters.size(); c++ )
+    {
+        clusters[c]._sort_key = static_cast<float>( ( centers[c] - mesh_center ).dot( normals[c] ) );
+    }
+    std::stable_sort( clusters.begin(), clusters.end(), []( const triangle_cluster & a, const triangle_cluster & b )
+    {
+        return a._sort_key > b._sort_key;
+    } );
+
+    std::vector<unsigned int> output;
+    output.reserve( num_triangles * 3u );
+    for ( const auto& cluster : clusters )
+    {
+        output.insert( output.end(), indices + cluster._start * 3u, indices + cluster._end * 3u );
+    }
+    std::copy( output.begin(), output.end(), indices );
+}
+
+size_t optimize_vertex_fetch( unsigned int* indices, size_t num_indices, std::vector<float>& vertices, size_t stride )
+{
+    const auto num_vertices = vertices.size() / stride;
+    std::vector<uint32_t> remap( num_vertices, empty_slot );
+    std::vector<float> output;
+    output.reserve( vertices.size() );
+    uint32_t count = 0u;
+    for ( size_t i = 0u; i < num_indices; i++ )
+    {
+        auto& vertex = remap[indices[i]];
+        if ( vertex == empty_slot )
+        {
+            vertex = count++;
+            const auto* source = vertices.data() + indices[i] * stride;
+            output.insert( output.end(), source, source + stride );
+        }
+        indices[i] = vertex;
+    }
+    vertices = std::move( output );
+    return count;
+}
+
+mesh_optimization_report optimize_mesh( indexed_vertices& mesh, size_t stride, const fnx::material_map& materials,
+                                        bool overdraw )
+{
+    mesh_optimization_report report;
+    auto indices = get_indices_32( mesh );
+    const auto num_indices = indices.size() - indices.size() % 3u;
+    const auto num_vertices = mesh.vertices.size() / stride;
+    report.input = analyze_vertex_cache( indices.data(), num_indices, num_vertices );
+    report.input_overfetch = analyze_vertex_fetch( indices.data(), num_indices, num_vertices, stride * sizeof( float ) );
+
+    // triangles are only reordered between the starts and ends of material ranges
+    const auto boundaries = get_range_boundaries( materials, num_indices );
+
+    // each range is optimised with its own vertex numbering so the work does not grow with the whole mesh
+    std::vector<uint32_t> local_index( num_vertices, empty_slot );
+    std::vector<unsigned int> local_vertices;
+    std::vector<unsigned int> local_indices;
+    std::vector<float> local_positions;
+    std::vector<unsigned int> cache_order( indices.begin(), indices.end() );
+    for ( size_t b = 0u; b + 1u < boundaries.size(); b++ )
+    {
+        const auto start = boundaries[b];
+        gather_range( indices.data() + start, boundaries[b + 1u] - start, local_index, local_vertices, local_indices );
+
+        optimize_vertex_cache( local_indices.data(), local_indices.size(), local_vertices.size() );
+        for ( size_t i = 0u; i < local_indices.size(); i++ )
+        {
+            cache_order[start + i] = local_vertices[local_indices[i]];
+        }
+        if ( overdraw )
+        {
+            gather_positions( mesh.vertices, stride, local_vertices, local_positions );
+            optimize_overdraw( local_indices.data(), local_indices.size(), local_positions.data(),
+                               local_vertices.size(), 3u );
+        }
+        for ( size_t i = 0u; i < local_indices.size(); i++ )
+        {
+            indices[start + i] = local_vertices[local_indices[i]];
+        }
+    }
+    report.vertex_cache = analyze_vertex_cache( cache_order.data(), num_indices, num_vertices );
+    report.overdraw = analyze_vertex_cache( indices.data(), num_indices, num_vertices );
+
+    // the vertices are only renumbered when fewer bytes are fetched, unused vertices shrink the buffer but not the
+    // fetches so the overfetch ratios are compared over the size of each buffer
+    const auto vertex_bytes = stride * sizeof( float );
+    report.overfetch = analyze_vertex_fetch( indices.data(), num_indices, num_vertices, vertex_bytes );
+    auto fetch_indices = indices;
+    auto fetch_vertices = mesh.vertices;
+    const auto num_fetch_vertices = optimize_vertex_fetch( fetch_indices.data(), fetch_indices.size(), fetch_vertices,
+                                    stride );
+    const auto fetch_overfetch = analyze_vertex_fetch( fetch_indices.data(), num_indices, num_fetch_vertices,
+                                 vertex_bytes );
+    if ( fetch_overfetch * static_cast<float>( num_fetch_vertices ) <
+            report.overfetch * static_cast<float>( num_vertices ) )
+    {
+        report.overfetch = fetch_overfetch;
+        indices = std::move( fetch_indices );
+        mesh.vertices = std::move( fetch_vertices );
+    }
+
+    set_indices_32( mesh, std::move( indices ) );
+    return report;
+}
+
+std::vector<unsigned int> simplify( const unsigned int* indices, size_t num_indices, const float* positions,
+                                    size_t num_vertices, size_t stride, size_t target_indices, float max_error, float* result_error )
+{
+    std::vector<unsigned int> result( indices, indices + num_indices - num_indices % 3u );
+    auto get_position = [&]( unsigned int vertex )
+    {
+        return positions + vertex * stride;
+    };
+
+    // planes of the triangles around each vertex
+    std::vector<quadric> quadrics( num_vertices, quadric{} );
+    for ( size_t t = 0u; t < result.size(); t += 3u )
+    {
+        const auto* a = get_position( result[t] );
+        double normal[3];
+        get_triangle_normal( a, get_position( result[t + 1u] ), get_position( result[t + 2u] ), normal );
+        const auto length = std::sqrt( normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2] );
+        if ( length > 0.0 )
+        {
+            for ( auto& n : normal )
+            {
+                n /= length;
+            }
+            const auto distance = -( normal[0] * a[0] + normal[1] * a[1] + normal[2] * a[2] );
+            for ( size_t k = 0u; k < 3u; k++ )
+            {
+                add_plane( quadrics[result[t + k]], normal, distance, length * 0.5 );
+            }
+        }
+    }
+
+    // an edge without its reverse is a border or a seam, one used twice in the same direction is not manifold
+    std::vector<uint64_t> edges;
+    edges.reserve( result.size() );
+    for ( size_t t = 0u; t < result.size(); t += 3u )
+    {
+        for ( size_t k = 0u; k < 3u; k++ )
+        {
+            edges.emplace_back( static_cast<uint64_t>( result[t + k] ) << 32u | result[t + ( k + 1u ) % 3u] );
+        }
+    }
+    std::sort( edges.begin(), edges.end() );
+    std::vector<bool> locked( num_vertices, false );
+    for ( size_t i = 0u; i < edges.size(); i++ )
+    {
+        const auto from = static_cast<unsigned int>( edges[i] >> 32u );
+        const auto to = static_cast<unsigned int>( edges[i] & UINT32_MAX );
+        const auto reverse = static_cast<uint64_t>( to ) << 32u | from;
+        if ( ( i + 1u < edges.size() && edges[i + 1u] == edges[i] ) ||
+                !std::binary_search( edges.begin(), edges.end(), reverse ) )
+        {
+            locked[from] = true;
+            locked[to] = true;
+        }
+    }
+
+    // each pass collapses the cheapest edges whose vertices no other collapse of the pass touched
+    const auto max_squared_error = max_error * max_error;
+    float error = 0.f;
+    std::vector<unsigned int> remap( num_vertices );
+    std::vector<uint32_t> offsets( num_vertices + 1u );
+    std::vector<uint32_t> triangles;
+    std::vector<edge_collapse> collapses;
+    std::vector<bool> touched( num_vertices );
+    while ( result.size() > target_indices )
+    {
+        std::iota( remap.begin(), remap.end(), 0u );
+        std::fill( offsets.begin(), offsets.end(), 0u );
+        for ( auto index : result )
+        {
+            offsets[index + 1u]++;
+        }
+        std::partial_sum( offsets.begin(), offsets.end(), offsets.begin() );
+        triangles.resize( result.size() );
+        {
+            auto cursor = offsets;
+            for ( size_t i = 0u; i < result.size(); i++ )
+            {
+                triangles[cursor[result[i]]++] = static_cast<uint32_t>( i / 3u );
+            }
+        }
+
+        // an edge that can collapse has two triangles, it is taken from the one going up in the vertex numbers
+        collapses.clear();
+        for ( size_t t = 0u; t < result.size(); t += 3u )
+        {
+            for ( size_t k = 0u; k < 3u; k++ )
+            {
+                const auto a = result[t + k];
+                const auto b = result[t + ( k + 1u ) % 3u];
+                if ( a > b )
+                {
+                    continue;
+                }
+                if ( !locked[a] )
+                {
+                    collapses.push_back( { a, b, get_collapse_error( quadrics[a], quadrics[b], get_position( b ) ) } );
+                }
+                if ( !locked[b] )
+                {
+                    collapses.push_back( { b, a, get_collapse_error( quadrics[b], quadrics[a], get_position( a ) ) } );
+                }
+            }
+        }
+        std::sort( collapses.begin(), collapses.end(), []( const edge_collapse & a, const edge_collapse & b )
+        {
+            return a._error < b._error;
+        } );
+
+        std::fill( touched.begin(), touched.end(), false );
+        auto remaining = result.size();
+        bool collapsed = false;
+        for ( const auto& collapse : collapses )
+        {
+            if ( remaining <= target_indices || collapse._error > max_squared_error )
+            {
+                break;
+            }
+            if ( touched[collapse._from] || touched[collapse._to] )
+            {
+                continue;
+            }
+
+            // triangles sharing the edge disappear, the others must not flip over
+            size_t removed = 0u;
+            bool flips = false;
+            for ( auto i = offsets[collapse._from]; i < offsets[collapse._from + 1u] && !flips; i++ )
+            {
+                const auto* corners = result.data() + triangles[i] * 3u;
+                unsigned int current[3];
+                unsigned int moved[3];
+                for ( size_t k = 0u; k < 3u; k++ )
+                {
+                    current[k] = remap[corners[k]];
+                    moved[k] = current[k] == collapse._from ? collapse._to : current[k];
+                }
+                if ( moved[0] == moved[1] || moved[1] == moved[2] || moved[0] == moved[2] )
+                {
+                    removed += current[0] != current[1] && current[1] != current[2] && current[0] != current[2] ? 3u : 0u;
+                    continue;
+                }
+                double before[3];
+                double after[3];
+                get_triangle_normal( get_position( current[0] ), get_position( current[1] ), get_position( current[2] ), before );
+                get_triangle_normal( get_position( moved[0] ), get_position( moved[1] ), get_position( moved[2] ), after );
+                flips = before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0;
+            }
+            if ( flips )
+            {
+                continue;
+            }
+
+            remap[collapse._from] = collapse._to;
+            add_quadric( quadrics[collapse._to], quadrics[collapse._from] );
+            touched[collapse._from] = true;
+            touched[collapse._to] = true;
+            remaining -= removed;
+            error = std::max( error, collapse._error );
+            collapsed = true;
+        }
+        if ( !collapsed )
+        {
+            break;
+        }
+
+        size_t count = 0u;
+        for ( size_t t = 0u; t < result.size(); t += 3u )
+        {
+            const auto a = remap[result[t]];
+            const auto b = remap[result[t + 1u]];
+            const auto c = remap[result[t + 2u]];
+            if ( a != b && b != c && a != c )
+            {
+                result[count++] = a;
+                result[count++] = b;
+                result[count++] = c;
+            }
+        }
+        result.resize( count );
+    }
+
+    if ( result_error )
+    {
+        *result_error = std::sqrt( error );
+    }
+    return result;
+}
+
+std::vector<mesh_lod> build_lods( indexed_vertices& mesh, size_t stride, const fnx::material_map& materials,
+                                  size_t max_lods, float ratio, float max_error )
+{
+    std::vector<mesh_lod> lods;
+    auto indices = get_indices_32( mesh );
+    const auto num_indices = indices.size() - indices.size() % 3u;
+    indices.resize( num_indices );
+    const auto num_vertices = mesh.vertices.size() / stride;
+
+    float bounds_min[3] = { 0.f, 0.f, 0.f };
+    float bounds_max[3] = { 0.f, 0.f, 0.f };
+    for ( size_t v = 0u; v < num_vertices; v++ )
+    {
+        for ( size_t k = 0u; k < 3u; k++ )
+        {
+            const auto value = mesh.vertices[v * stride + k];
+            bounds_min[k] = v == 0u || value < bounds_min[k] ? value : bounds_min[k];
+            bounds_max[k] = v == 0u || value > bounds_max[k] ? value : bounds_max[k];
+        }
+    }
+    const auto extent = std::max( { bounds_max[0] - bounds_min[0], bounds_max[1] - bounds_min[1],
+                                    bounds_max[2] - bounds_min[2] } );
+
+    // the boundaries of a level are where those of the full mesh moved to
+    const auto boundaries = get_range_boundaries( materials, num_indices );
+    auto previous = boundaries;
+    float previous_error = 0.f;
+    std::vector<uint32_t> local_index( num_vertices, empty_slot );
+    std::vector<unsigned int> local_vertices;
+    std::vector<unsigned int> local_indices;
+    std::vector<float> local_positions;
+    while ( lods.size() < max_lods && num_indices > 0u )
+    {
+        mesh_lod lod;
+        lod.start = indices.size();
+        std::vector<size_t> next;
+        float level_error = 0.f;
+        for ( size_t b = 0u; b + 1u < previous.size(); b++ )
+        {
+            next.emplace_back( indices.size() );
+            gather_range( indices.data() + previous[b], previous[b + 1u] - previous[b], local_index, local_vertices,
+                          local_indices );
+            gather_positions( mesh.vertices, stride, local_vertices, local_positions );
+            const auto target = static_cast<size_t>( static_cast<float>( local_indices.size() ) * ratio ) / 3u * 3u;
+            float range_error = 0.f;
+            auto simplified = simplify( local_indices.data(), local_indices.size(), local_positions.data(),
+                                        local_vertices.size(), 3u, target, max_error * extent, &range_error );
+            optimize_vertex_cache( simplified.data(), simplified.size(), local_vertices.size() );
+            for ( auto index : simplified )
+            {
+                indices.emplace_back( local_vertices[index] );
+            }
+            level_error = std::max( level_error, range_error );
+        }
+        next.emplace_back( indices.size() );
+        lod.end = indices.size();
+
+        // a level that barely shrank costs memory without saving any work
+        const auto previous_size = previous.back() - previous.front();
+        if ( lod.end - lod.start == 0u || static_cast<float>( lod.end - lod.start ) > 0.9f * previous_size )
+        {
+            indices.resize( lod.start );
+            break;
+        }
+        // errors add up along the chain, each level is measured against the one it was built from
+        lod.error = previous_error + level_error;
+        for ( const auto& material : materials.get_all() )
+        {
+            auto get_boundary = [&]( int position )
+            {
+                const auto full = std::min( static_cast<size_t>( std::max( position, 0 ) ) / 3u * 3u, num_indices );
+                return static_cast<int>( next[std::lower_bound( boundaries.begin(), boundaries.end(), full ) -
+                                                   boundaries.begin()] );
+            };
+            lod.materials.add_material_range( material._material_name, get_boundary( material._start ),
+                                              get_boundary( material._end ) );
+        }
+        previous_error = lod.error;
+        previous = std::move( next );
+        lods.emplace_back( std::move( lod ) );
+    }
+
+    set_indices_32( mesh, std::move( indices ) );
+    return lods;
+}
+}
@@ -6,6 +6,39 @@ using namespace fnx;
 
 #define BUFFER_OFFSET(i) ((char *)NULL + (i))
 
+namespace
+{
+/// @brief OpenGL type of a vertex format.
+GLenum get_gl_type( fnx::vertex_format format )
+{
+    switch ( format )
+    {
+        case fnx::vertex_format::half:
+            return GL_HALF_FLOAT;
+        case fnx::vertex_format::unorm16:
+            return GL_UNSIGNED_SHORT;
+        case fnx::vertex_format::unorm8:
+            return GL_UNSIGNED_BYTE;
+        case fnx::vertex_format::snorm16_octahedral:
+            return GL_SHORT;
+        case fnx::vertex_format::snorm_10_10_10_2:
+            return GL_INT_2_10_10_10_REV;
+        default:
+            return GL_FLOAT;
+    }
+}
+
+void enable_packed_attribute( Attribute_Index attr_idx, const fnx::vertex_attribute& attribute, uint32_t stride )
+{
+    if ( attribute.is_enabled() )
+    {
+        glEnableVertexAttribArray( attr_idx );
+        glVertexAttribPointer( attr_idx, attribute.components, get_gl_type( attribute.format ),
+                               attribute.is_normalized() ? GL_TRUE : GL_FALSE, stride, BUFFER_OFFSET( attribute.offset ) );
+    }
+}
+}
+
 namespace fnx
 {
 class model_impl
@@ -17,6 +50,10 @@ public:
     unsigned int _vbo_num_components[VBO_Index::VBO_Max_Assigned] { 0u };
     GLuint _ibo;
     unsigned int _num_indices{ 0u };
+    GLenum _index_type{ GL_UNSIGNED_SHORT };	/// type of the indices of the last index buffer upload
+    size_t _index_size{ sizeof( GLushort ) };
+    size_t _vbo_bytes{ 0u };	/// size of the last vertex buffer upload
+    size_t _ibo_bytes{ 0u };	/// size of the last index buffer upload
 };
 
 void model::init()
@@ -35,91 +72,247 @@ model::model( const std::string& name, bool has_texture, bool has_normals, bool
 {
     init();
     bind_to_vao();
-    auto stride = static_cast<int>( sizeof( float ) ) * 3;	// takes care of the vertex xyz data
-    auto offset = 0;
     glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[VBO_Data] );
+    _impl->_vbo_num_elements[VBO_Data] = 0;
+    _impl->_vbo_num_components[VBO_Data] = setup_float_attributes( has_texture, has_normals, has_colors );
+    unbind_vao();
+}
 
-    // enable the attributes
-    glEnableVertexAttribArray( Attribute_Index_Position );
-    if ( has_texture )
+model::model( const std::string& name, fnx::raw_model& raw )
+    : fnx::asset( name )
+{
+    load_raw_model( raw, false );
+}
+
+model::model( const std::string& name, fnx::raw_model_handle raw )
+    : fnx::asset( name )
+    , _raw_model( raw )
+{
+    load_raw_model( *raw, true );
+}
+
+void model::load_raw_model( const fnx::raw_model& raw, bool deferred )
+{
+    init();
+    bind_to_vao();
+    const auto& verts = raw.get_vertices();
+    glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[VBO_Data] );
+    if ( !deferred )
     {
-        glEnableVertexAttribArray( Attribute_Index_Texture );
-        stride += sizeof( float ) * 2;	// takes care of the texure uv data
+        glBufferData( GL_ARRAY_BUFFER, verts.size() * sizeof( float ), verts.data(), GL_STATIC_DRAW );
+        _impl->_vbo_bytes = verts.size() * sizeof( float );
     }
-    if ( has_normals )
+    _bounds = raw.measure_aabb();
+    _has_bounds = !verts.empty();
+    _lods = raw.get_lods();
+
+    //FNX_DEBUG("raw model %s has %d vertices", raw.get_name(), raw.get_num_vertices());
+
+    if ( raw.is_line() )
     {
-        glEnableVertexAttribArray( Attribute_Index_Normal );
-        stride += sizeof( float ) * 3;	// takes care of the normal xyz direction data
+        render_as_lines();
     }
-    if ( has_colors )
+
+    const auto components = setup_float_attributes( raw.has_texture_data(), raw.has_normal_data(), raw.has_color_data() );
+    _impl->_vbo_num_elements[VBO_Data] = static_cast<unsigned int>( verts.size() ) / components;
+    _impl->_vbo_num_components[VBO_Data] = components;
+
+    if ( deferred )
     {
-        glEnableVertexAttribArray( Attribute_Index_Color );
-        stride += sizeof( float ) * 4;	// takes care of the normal xyz direction data
+        // the raw model keeps the vertices and indices until the upload queue sends them
+        const auto bytes = verts.size() * sizeof( float ) + raw.get_indices_32().size() * sizeof( unsigned int ) +
+                           raw.get_indices().size() * sizeof( unsigned short );
+        auto [uploads, _] = singleton<upload_queue>::acquire();
+        _upload = uploads.push( bytes, [this]()
+        {
+            upload_raw_model();
+        } );
+    }
+    else if ( !raw.get_indices_32().empty() )
+    {
+        FNX_DEBUG( fnx::format_string( "raw model %s has 32 bit index data (%d)", raw.get_name(), raw.get_indices_32().size() ) );
+        load_to_ibo( raw.get_indices_32() );
+    }
+    else if ( !raw.get_indices().empty() )
+    {
+        FNX_DEBUG( fnx::format_string( "raw model %s has index data (%d)", raw.get_name(), raw.get_indices().size() ) );
+        load_to_ibo( raw.get_indices() );
     }
 
-    // tell opengl how to format the vbo array
-    glVertexAttribPointer( Attribute_Index_Position, 3, GL_FLOAT, GL_FALSE, stride,
-                           BUFFER_OFFSET( static_cast<int>( sizeof( float ) )* offset ) );
-    offset += 3;
-    if ( has_texture )
+    unbind_vao();
+}
+
+void model::complete_upload()
+{
+    if ( !is_resident() )
     {
-        glVertexAttribPointer( Attribute_Index_Texture, 2, GL_FLOAT, GL_FALSE, stride,
-                               BUFFER_OFFSET( static_cast<int>( sizeof( float ) )* offset ) );
-        offset += 2;
+        // the content is replaced, so the queued data goes first to keep the index buffer
+        _upload->run();
     }
-    if ( has_normals )
+}
+
+void model::upload_raw_model()
+{
+    const auto& verts = _raw_model->get_vertices();
+    glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[VBO_Data] );
+    glBufferData( GL_ARRAY_BUFFER, verts.size() * sizeof( float ), verts.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = verts.size() * sizeof( float );
+
+    if ( !_raw_model->get_indices_32().empty() )
     {
-        glVertexAttribPointer( Attribute_Index_Normal, 3, GL_FLOAT, GL_FALSE, stride,
-                               BUFFER_OFFSET( static_cast<int>( sizeof( float ) )* offset ) );
-        offset += 3;
+        load_to_ibo( _raw_model->get_indices_32() );
     }
-    if ( has_colors )
+    else if ( !_raw_model->get_indices().empty() )
     {
-        glVertexAttribPointer( Attribute_Index_Color, 4, GL_FLOAT, GL_FALSE, stride,
-                               BUFFER_OFFSET( static_cast<int>( sizeof( float ) )* offset ) );
-        offset += 4;
+        load_to_ibo( _raw_model->get_indices() );
+    }
+}
+
+model::model( const std::string& name, const fnx::raw_model& raw, const fnx::vertex_layout& layout )
+    : fnx::asset( name )
+{
+    init();
+    bind_to_vao();
+    const auto packed = raw.pack( layout );
+    glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[VBO_Data] );
+    glBufferData( GL_ARRAY_BUFFER, packed.data.size(), packed.data.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = packed.data.size();
+    _bounds = raw.measure_aabb();
+    _has_bounds = !raw.get_vertices().empty();
+    _lods = raw.get_lods();
+
+    if ( raw.is_line() )
+    {
+        render_as_lines();
+    }
+
+    enable_packed_attribute( Attribute_Index_Position, packed.position, packed.stride );
+    enable_packed_attribute( Attribute_Index_Texture, packed.uv, packed.stride );
+    enable_packed_attribute( Attribute_Index_Normal, packed.normal, packed.stride );
+    enable_packed_attribute( Attribute_Index_Color, packed.color, packed.stride );
+
+    if ( layout.position == fnx::vertex_format::unorm16 )
+    {
+        // object space = offset + scale * stored, with the translation in the last column like matrix_translate
+        _position_decode = fnx::matrix_scale( fnx::vector3( packed.position_scale[0], packed.position_scale[1],
+                                              packed.position_scale[2] ) );
+        _position_decode[0][3] = packed.position_offset[0];
+        _position_decode[1][3] = packed.position_offset[1];
+        _position_decode[2][3] = packed.position_offset[2];
+        _has_position_decode = true;
+    }
+
+    _impl->_vbo_num_elements[VBO_Data] = packed.num_vertices;
+    _impl->_vbo_num_components[VBO_Data] = raw.get_stride();
+
+    if ( !raw.get_indices_32().empty() )
+    {
+        load_to_ibo( raw.get_indices_32() );
+    }
+    else if ( !raw.get_indices().empty() )
+    {
+        load_to_ibo( raw.get_indices() );
     }
 
-    _impl->_vbo_num_elements[VBO_Data] = 0;
-    _impl->_vbo_num_components[VBO_Data] = offset;
     unbind_vao();
 }
 
-model::model( const std::string& name, fnx::raw_model& raw )
+model::model( const std::string& name, fnx::raw_model_handle raw, const fnx::vertex_layout& layout )
+    : model( name, *raw, layout )
+{
+    _raw_model = raw;
+}
+
+model::model( const std::string& name, std::shared_ptr<const fnx::mesh_cache> cache, size_t mesh_index )
     : fnx::asset( name )
+    , _mesh_cache( std::move( cache ) )
+    , _mesh_index( mesh_index )
 {
+    const auto& mesh = _mesh_cache->get_meshes()[mesh_index];
     init();
     bind_to_vao();
-    const auto& verts = raw.get_vertices();
-    auto stride = static_cast<int>( sizeof( float ) ) * 3;	// takes care of the vertex xyz data
-    auto offset = 0;
     glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[VBO_Data] );
-    glBufferData( GL_ARRAY_BUFFER, verts.size() * sizeof( float ), verts.data(), GL_STATIC_DRAW );
-
-    //FNX_DEBUG("raw model %s has %d vertices", raw.get_name(), raw.get_num_vertices());
+    _bounds = mesh.aabb;
+    _has_bounds = !mesh.vertices.empty();
+    _lods = mesh.lods;
 
-    if ( raw.is_line() )
+    if ( mesh.flags & raw_model::data_bit::line )
     {
         render_as_lines();
     }
 
+    const auto components = setup_float_attributes( mesh.flags & raw_model::data_bit::texture,
+                            mesh.flags & raw_model::data_bit::normal, mesh.flags & raw_model::data_bit::color );
+    _impl->_vbo_num_elements[VBO_Data] = static_cast<unsigned int>( mesh.vertices.size() ) / components;
+    _impl->_vbo_num_components[VBO_Data] = components;
+    unbind_vao();
+
+    const auto bytes = mesh.vertices.size() * sizeof( float ) + mesh.indices_32.size() * sizeof( unsigned int ) +
+                       mesh.indices.size() * sizeof( unsigned short );
+    auto [uploads, _] = singleton<upload_queue>::acquire();
+    _upload = uploads.push( bytes, [this]()
+    {
+        upload_cached_mesh();
+    } );
+}
+
+void model::upload_cached_mesh()
+{
+    const auto& mesh = _mesh_cache->get_meshes()[_mesh_index];
+    glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[VBO_Data] );
+    glBufferData( GL_ARRAY_BUFFER, mesh.vertices.size() * sizeof( float ), mesh.vertices.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = mesh.vertices.size() * sizeof( float );
+
+    if ( !mesh.indices_32.empty() )
+    {
+        load_to_ibo( mesh.indices_32 );
+    }
+    else if ( !mesh.indices.empty() )
+    {
+        load_to_ibo( mesh.indices );
+    }
+
+    // the views are on the GPU now, the last model to upload unmaps the cache
+    _mesh_cache.reset();
+}
+
+void load_model_file( const std::string& file_path )
+{
+    auto cache = std::make_shared<const fnx::mesh_cache>( load_mesh_cache( file_path ) );
+    for ( const auto& library : cache->get_material_libraries() )
+    {
+        // materials will need to be parsed on their own
+        parse_material_file( std::string( library ) );
+    }
+
+    auto [models, _] = singleton<asset_manager<model>>::acquire();
+    const auto& meshes = cache->get_meshes();
+    for ( size_t i = 0u; i < meshes.size(); i++ )
+    {
+        FNX_DEBUG( fnx::format_string( "found model %s", std::string( meshes[i].name ) ) );
+        models.get( std::string( meshes[i].name ), cache, i );
+    }
+}
+
+int model::setup_float_attributes( bool has_texture, bool has_normals, bool has_colors )
+{
+    auto stride = static_cast<int>( sizeof( float ) ) * 3;	// takes care of the vertex xyz data
+    auto offset = 0;
+
     // enable the attributes
     glEnableVertexAttribArray( Attribute_Index_Position );
-    if ( raw.has_texture_data() )
+    if ( has_texture )
     {
-        //FNX_DEBUG("raw model %s has texture data", raw.get_name());
         glEnableVertexAttribArray( Attribute_Index_Texture );
         stride += sizeof( float ) * 2;	// takes care of the texure uv data
     }
-    if ( raw.has_normal_data() )
+    if ( has_normals )
     {
-        //FNX_DEBUG("raw model %s has normal data", raw.get_name());
         glEnableVertexAttribArray( Attribute_Index_Normal );
         stride += sizeof( float ) * 3;	// takes care of the normal xyz direction data
     }
-    if ( raw.has_color_data() )
+    if ( has_colors )
     {
-        //FNX_DEBUG("raw model %s has color data", raw.get_name());
         glEnableVertexAttribArray( Attribute_Index_Color );
         stride += sizeof( float ) * 4;	// takes care of the color rgba data
     }
@@ -128,41 +321,25 @@ model::model( const std::string& name, fnx::raw_model& raw )
     glVertexAttribPointer( Attribute_Index_Position, 3, GL_FLOAT, GL_FALSE, stride,
                            BUFFER_OFFSET( static_cast<int>( sizeof( float ) ) * offset ) );
     offset += 3;
-    if ( raw.has_texture_data() )
+    if ( has_texture )
     {
         glVertexAttribPointer( Attribute_Index_Texture, 2, GL_FLOAT, GL_FALSE, stride,
                                BUFFER_OFFSET( static_cast<int>( sizeof( float ) )* offset ) );
         offset += 2;
     }
-    if ( raw.has_normal_data() )
+    if ( has_normals )
     {
         glVertexAttribPointer( Attribute_Index_Normal, 3, GL_FLOAT, GL_FALSE, stride,
                                BUFFER_OFFSET( static_cast<int>( sizeof( float ) )* offset ) );
         offset += 3;
     }
-    if ( raw.has_color_data() )
+    if ( has_colors )
     {
         glVertexAttribPointer( Attribute_Index_Color, 4, GL_FLOAT, GL_FALSE, stride,
                                BUFFER_OFFSET( static_cast<int>( sizeof( float ) )* offset ) );
         offset += 4;
     }
-
-    _impl->_vbo_num_elements[VBO_Data] = static_cast<unsigned int>( verts.size() * sizeof( float ) ) / stride;
-    _impl->_vbo_num_components[VBO_Data] = offset;
-
-    if ( !raw.get_indices().empty() )
-    {
-        FNX_DEBUG( fnx::format_string( "raw model %s has index data (%d)", raw.get_name(), raw.get_indices().size() ) );
-        load_to_ibo( raw.get_indices() );
-    }
-
-    unbind_vao();
-}
-
-model::model( const std::string& name, fnx::raw_model_handle raw )
-    : model( name, *raw )
-{
-    _raw_model = raw;
+    return offset;
 }
 
 void model::bind_to_vao()
@@ -187,7 +364,9 @@ void model::bind_to_vbo( VBO_Index vbo_idx )
 
 void model::set_vbo_data( const std::vector<float>& elements )
 {
+    complete_upload();
     glBufferData( GL_ARRAY_BUFFER, elements.size() * sizeof( float ), elements.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = elements.size() * sizeof( float );
 }
 
 void model::enable_attrib( Attribute_Index attr_idx )
@@ -228,8 +407,18 @@ model::~model()
     _impl = nullptr;
 }
 
+size_t model::get_memory_usage() const
+{
+    return nullptr != _impl ? _impl->_vbo_bytes + _impl->_ibo_bytes : 0u;
+}
+
 void model::bind() const
 {
+    if ( !is_resident() )
+    {
+        // bound for drawing, so it is on screen
+        _upload->set_priority( fnx::upload_priority::visible );
+    }
     glBindVertexArray( _impl->_vao );
 
     if ( _impl->_num_indices > 0 )
@@ -244,6 +433,11 @@ void model::bind() const
 
 void model::render() const
 {
+    if ( !is_resident() )
+    {
+        return;
+    }
+
     // no default map, trust that the shader will take care of it
     if ( _render_as_lines )
     {
@@ -251,7 +445,9 @@ void model::render() const
     }
     else if ( _impl->_num_indices > 0 )
     {
-        glDrawElements( GL_TRIANGLES, _impl->_num_indices, GL_UNSIGNED_SHORT, 0 );
+        // the levels of detail follow the full model in the index buffer
+        const auto count = _lods.empty() ? _impl->_num_indices : static_cast<unsigned int>( _lods.front().start );
+        glDrawElements( GL_TRIANGLES, count, _impl->_index_type, 0 );
     }
     else
     {
@@ -259,11 +455,42 @@ void model::render() const
     }
 }
 
+void model::render_lod( size_t lod ) const
+{
+    if ( lod == 0u || lod > _lods.size() || _render_as_lines || _impl->_num_indices == 0 )
+    {
+        render();
+    }
+    else
+    {
+        const auto& level = _lods[lod - 1u];
+        render_partial( static_cast<int>( level.start ), static_cast<int>( level.end ) );
+    }
+}
+
+size_t model::select_lod( fnx::decimal error_scale, fnx::decimal threshold ) const
+{
+    // errors grow along the chain, the first level from the end that fits is the cheapest one
+    for ( auto lod = _lods.size(); lod > 0u; lod-- )
+    {
+        if ( _lods[lod - 1u].error * error_scale <= threshold )
+        {
+            return lod;
+        }
+    }
+    return 0u;
+}
+
 void model::render_partial( int start, int end ) const
 {
+    if ( !is_resident() )
+    {
+        return;
+    }
+
     if ( _impl->_num_indices > 0 )
     {
-        glDrawElements( GL_TRIANGLES, end - start, GL_UNSIGNED_SHORT, BUFFER_OFFSET( start * sizeof( GLushort ) ) );
+        glDrawElements( GL_TRIANGLES, end - start, _impl->_index_type, BUFFER_OFFSET( start * _impl->_index_size ) );
     }
     else if ( end - start > 0 )
     {
@@ -292,8 +519,15 @@ void model::unbind() const
 
 void model::load_to_vbo( VBO_Index vbo_idx, unsigned int num_components, const std::vector<float>& elements )
 {
+    load_to_vbo( vbo_idx, num_components, fnx::span<const float>( elements ) );
+}
+
+void model::load_to_vbo( VBO_Index vbo_idx, unsigned int num_components, fnx::span<const float> elements )
+{
+    complete_upload();
     glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[vbo_idx] );
     glBufferData( GL_ARRAY_BUFFER, elements.size() * sizeof( float ), elements.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = elements.size() * sizeof( float );
     glVertexAttribPointer( vbo_idx, num_components, GL_FLOAT, GL_FALSE, 0, NULL ); // 0 stride indicates tight packing
     glEnableVertexAttribArray( vbo_idx );
     _impl->_vbo_num_elements[vbo_idx] = static_cast<unsigned int>( elements.size() ) / num_components;
@@ -302,8 +536,10 @@ void model::load_to_vbo( VBO_Index vbo_idx, unsigned int num_components, const s
 
 void model::load_to_vbo( VBO_Index vbo_idx, unsigned int num_components, const std::vector<int>& elements )
 {
+    complete_upload();
     glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[vbo_idx] );
     glBufferData( GL_ARRAY_BUFFER, elements.size() * sizeof( int ), elements.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = elements.size() * sizeof( int );
     glVertexAttribPointer( vbo_idx, num_components, GL_INT, GL_FALSE, 0, NULL ); // 0 stride indicates tight packing
     glEnableVertexAttribArray( vbo_idx );
     _impl->_vbo_num_elements[vbo_idx] = static_cast<unsigned int>( elements.size() ) / num_components;
@@ -312,8 +548,10 @@ void model::load_to_vbo( VBO_Index vbo_idx, unsigned int num_components, const s
 
 void model::load_to_vbo( VBO_Index vbo_idx, unsigned int num_components, const std::vector<unsigned int>& elements )
 {
+    complete_upload();
     glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[vbo_idx] );
     glBufferData( GL_ARRAY_BUFFER, elements.size() * sizeof( unsigned int ), elements.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = elements.size() * sizeof( unsigned int );
     glVertexAttribPointer( vbo_idx, num_components, GL_UNSIGNED_INT, GL_FALSE, 0,
                            NULL ); // 0 stride indicates tight packing
     glEnableVertexAttribArray( vbo_idx );
@@ -323,8 +561,10 @@ void model::load_to_vbo( VBO_Index vbo_idx, unsigned int num_components, const s
 
 void model::load_to_vbo( VBO_Index vbo_idx, unsigned int num_components, const std::vector<short>& elements )
 {
+    complete_upload();
     glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[vbo_idx] );
     glBufferData( GL_ARRAY_BUFFER, elements.size() * sizeof( short ), elements.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = elements.size() * sizeof( short );
     glVertexAttribPointer( vbo_idx, num_components, GL_SHORT, GL_FALSE, 0, NULL ); // 0 stride indicates tight packing
     glEnableVertexAttribArray( vbo_idx );
     _impl->_vbo_num_elements[vbo_idx] = static_cast<unsigned int>( elements.size() ) / num_components;
@@ -333,8 +573,10 @@ void model::load_to_vbo( VBO_Index vbo_idx, unsigned int num_components, const s
 
 void model::load_to_vbo( VBO_Index vbo_idx, unsigned int num_components, const std::vector<unsigned short>& elements )
 {
+    complete_upload();
     glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[vbo_idx] );
     glBufferData( GL_ARRAY_BUFFER, elements.size() * sizeof( unsigned short ), elements.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = elements.size() * sizeof( unsigned short );
     glVertexAttribPointer( vbo_idx, num_components, GL_UNSIGNED_SHORT, GL_FALSE, 0,
                            NULL ); // 0 stride indicates tight packing
     glEnableVertexAttribArray( vbo_idx );
@@ -344,8 +586,10 @@ void model::load_to_vbo( VBO_Index vbo_idx, unsigned int num_components, const s
 
 void model::load_to_vbo( VBO_Index vbo_idx, unsigned int num_components, const std::vector<char>& elements )
 {
+    complete_upload();
     glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[vbo_idx] );
     glBufferData( GL_ARRAY_BUFFER, elements.size() * sizeof( char ), elements.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = elements.size() * sizeof( char );
     glVertexAttribPointer( vbo_idx, num_components, GL_BYTE, GL_FALSE, 0, NULL ); // 0 stride indicates tight packing
     glEnableVertexAttribArray( vbo_idx );
     _impl->_vbo_num_elements[vbo_idx] = static_cast<unsigned int>( elements.size() ) / num_components;
@@ -354,8 +598,10 @@ void model::load_to_vbo( VBO_Index vbo_idx, unsigned int num_components, const s
 
 void model::load_to_vbo( VBO_Index vbo_idx, unsigned int num_components, const std::vector<unsigned char>& elements )
 {
+    complete_upload();
     glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[vbo_idx] );
     glBufferData( GL_ARRAY_BUFFER, elements.size() * sizeof( unsigned char ), elements.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = elements.size() * sizeof( unsigned char );
     glVertexAttribPointer( vbo_idx, num_components, GL_UNSIGNED_BYTE, GL_FALSE, 0,
                            NULL ); // 0 stride indicates tight packing
     glEnableVertexAttribArray( vbo_idx );
@@ -368,6 +614,7 @@ void model::load_to_attribute( VBO_Index vbo_idx, Attribute_Index attr_idx, unsi
 {
     glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[vbo_idx] );
     glBufferData( GL_ARRAY_BUFFER, elements.size() * sizeof( float ), elements.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = elements.size() * sizeof( float );
     glVertexAttribPointer( attr_idx, num_components, GL_FLOAT, GL_FALSE, stride_in_num_components * sizeof( float ),
                            ( void* )( offset_in_num_components * sizeof( float ) ) );
     glEnableVertexAttribArray( vbo_idx );
@@ -384,77 +631,110 @@ void model::load_to_attribute( Attribute_Index attr_idx, unsigned int num_compon
 
 void model::update_vbo( VBO_Index vbo_idx, const std::vector<float>& elements )
 {
+    complete_upload();
     glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[vbo_idx] );
     glBufferData( GL_ARRAY_BUFFER, elements.size() * sizeof( float ), elements.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = elements.size() * sizeof( float );
     _impl->_vbo_num_elements[vbo_idx] = static_cast<unsigned int>( elements.size() ) / _impl->_vbo_num_components[vbo_idx];
 }
 
 void model::update_vbo( VBO_Index vbo_idx, const std::vector<int>& elements )
 {
+    complete_upload();
     glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[vbo_idx] );
     glBufferData( GL_ARRAY_BUFFER, elements.size() * sizeof( int ), elements.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = elements.size() * sizeof( int );
     _impl->_vbo_num_elements[vbo_idx] = static_cast<unsigned int>( elements.size() ) / _impl->_vbo_num_components[vbo_idx];
 }
 
 void model::update_vbo( VBO_Index vbo_idx, const std::vector<unsigned int>& elements )
 {
+    complete_upload();
     glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[vbo_idx] );
     glBufferData( GL_ARRAY_BUFFER, elements.size() * sizeof( unsigned int ), elements.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = elements.size() * sizeof( unsigned int );
     _impl->_vbo_num_elements[vbo_idx] = static_cast<unsigned int>( elements.size() ) / _impl->_vbo_num_components[vbo_idx];
 }
 
 void model::update_vbo( VBO_Index vbo_idx, const std::vector<short>& elements )
 {
+    complete_upload();
     glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[vbo_idx] );
     glBufferData( GL_ARRAY_BUFFER, elements.size() * sizeof( short ), elements.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = elements.size() * sizeof( short );
     _impl->_vbo_num_elements[vbo_idx] = static_cast<unsigned int>( elements.size() ) / _impl->_vbo_num_components[vbo_idx];
 }
 
 void model::update_vbo( VBO_Index vbo_idx, const std::vector<unsigned short>& elements )
 {
+    complete_upload();
     glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[vbo_idx] );
     glBufferData( GL_ARRAY_BUFFER, elements.size() * sizeof( unsigned short ), elements.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = elements.size() * sizeof( unsigned short );
     _impl->_vbo_num_elements[vbo_idx] = static_cast<unsigned int>( elements.size() ) / _impl->_vbo_num_components[vbo_idx];
 }
 
 void model::update_vbo( VBO_Index vbo_idx, const std::vector<char>& elements )
 {
+    complete_upload();
     glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[vbo_idx] );
     glBufferData( GL_ARRAY_BUFFER, elements.size() * sizeof( char ), elements.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = elements.size() * sizeof( char );
     _impl->_vbo_num_elements[vbo_idx] = static_cast<unsigned int>( elements.size() ) / _impl->_vbo_num_components[vbo_idx];
 }
 
 void model::update_vbo( VBO_Index vbo_idx, const std::vector<unsigned char>& elements )
 {
+    complete_upload();
     glBindBuffer( GL_ARRAY_BUFFER, _impl->_vbos[vbo_idx] );
     glBufferData( GL_ARRAY_BUFFER, elements.size() * sizeof( unsigned char ), elements.data(), GL_STATIC_DRAW );
+    _impl->_vbo_bytes = elements.size() * sizeof( unsigned char );
     _impl->_vbo_num_elements[vbo_idx] = static_cast<unsigned int>( elements.size() ) / _impl->_vbo_num_components[vbo_idx];
 }
 
 void model::load_to_ibo( const std::vector<unsigned char>& indices )
 {
     _impl->_num_indices = static_cast<unsigned int>( indices.size() );
+    _impl->_index_type = GL_UNSIGNED_BYTE;
+    _impl->_index_size = sizeof( unsigned char );
     glGenBuffers( 1, &_impl->_ibo );
     glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, _impl->_ibo );
     glBufferData( GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof( unsigned char ), indices.data(), GL_STATIC_DRAW );
+    _impl->_ibo_bytes = indices.size() * sizeof( unsigned char );
     glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
 }
 
 void model::load_to_ibo( const std::vector<unsigned short>& indices )
+{
+    load_to_ibo( fnx::span<const unsigned short>( indices ) );
+}
+
+void model::load_to_ibo( fnx::span<const unsigned short> indices )
 {
     _impl->_num_indices = static_cast<unsigned int>( indices.size() );
+    _impl->_index_type = GL_UNSIGNED_SHORT;
+    _impl->_index_size = sizeof( unsigned short );
     glGenBuffers( 1, &_impl->_ibo );
     glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, _impl->_ibo );
     glBufferData( GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof( unsigned short ), indices.data(), GL_STATIC_DRAW );
+    _impl->_ibo_bytes = indices.size() * sizeof( unsigned short );
     glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
 }
 
 void model::load_to_ibo( const std::vector<unsigned int>& indices )
+{
+    load_to_ibo( fnx::span<const unsigned int>( indices ) );
+}
+
+void model::load_to_ibo( fnx::span<const unsigned int> indices )
 {
     _impl->_num_indices = static_cast<unsigned int>( indices.size() );
+    _impl->_index_type = GL_UNSIGNED_INT;
+    _impl->_index_size = sizeof( unsigned int );
     glGenBuffers( 1, &_impl->_ibo );
     glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, _impl->_ibo );
     glBufferData( GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof( unsigned int ), indices.data(), GL_STATIC_DRAW );
+    _impl->_ibo_bytes = indices.size() * sizeof( unsigned int );
     glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
 }
-}
\ No newline at end of file
+}
@@ -0,0 +1,671 @@
+#include <charconv>
+#include <cstring>
+#include <thread>
+
+namespace fnx
+{
+namespace
+{
+constexpr uint32_t invalid_index = UINT32_MAX;
+constexpr size_t min_chunk_bytes = 1024u * 1024u;	/// smaller files are not worth a thread
+
+/// @brief Records that hold coordinates, in the order of the fields of a face corner.
+enum coordinate_type : size_t
+{
+    position = 0u,
+    uv,
+    normal,
+    coordinate_type_count
+};
+
+constexpr size_t coordinate_sizes[coordinate_type_count] = { 3u, 2u, 3u };
+
+bool is_blank( char c )
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/// @brief Reads the tokens of one line in place.
+struct line_cursor
+{
+    const char* _it;
+    const char* _end;
+
+    void skip_blanks()
+    {
+        while ( _it != _end && is_blank( *_it ) )
+        {
+            ++_it;
+        }
+    }
+
+    /// @return an empty view at the end of the line
+    std::string_view next_token()
+    {
+        skip_blanks();
+        auto start = _it;
+        while ( _it != _end && !is_blank( *_it ) )
+        {
+            ++_it;
+        }
+        return std::string_view( start, static_cast<size_t>( _it - start ) );
+    }
+
+    bool next_float( float& value )
+    {
+        skip_blanks();
+        if ( _it != _end && *_it == '+' )
+        {
+            ++_it;	// from_chars does not accept a leading plus sign
+        }
+        auto [ptr, error] = std::from_chars( _it, _end, value );
+        _it = ptr;
+        return error == std::errc();
+    }
+};
+
+/// @brief Call func with a cursor over each line of text.
+template<typename TFunc>
+void for_each_line( std::string_view text, TFunc&& func )
+{
+    const char* it = text.data();
+    const char* end = it + text.size();
+    while ( it != end )
+    {
+        auto eol = static_cast<const char*>( std::memchr( it, '\n', static_cast<size_t>( end - it ) ) );
+        auto line_end = eol ? eol : end;
+        func( line_cursor{ it, line_end } );
+        it = eol ? eol + 1 : end;
+    }
+}
+
+/// @return the coordinate record named by type, coordinate_type_count for any other record
+size_t get_coordinate_type( std::string_view type )
+{
+    if ( type == "v" )
+    {
+        return position;
+    }
+    if ( type == "vt" )
+    {
+        return uv;
+    }
+    if ( type == "vn" )
+    {
+        return normal;
+    }
+    return coordinate_type_count;
+}
+
+/// @brief Indices of one face corner, invalid_index when the field is empty.
+struct obj_corner
+{
+    uint32_t _indices[coordinate_type_count]{ invalid_index, invalid_index, invalid_index };
+};
+
+/// @brief Faces of one object within a chunk, chunks are merged by appending their segments in order.
+struct obj_segment
+{
+    std::string _name;
+    bool _starts_object{ false };	/// false for the faces that continue the object of the previous chunk
+    size_t _triangles{ 0u };		/// counted by the first pass to reserve the vertices
+    bool _guess_texture{ false };
+    std::vector<float> _vertices;
+    bool _has_texture{ false };
+    bool _has_normal{ false };
+    int _leading_vertices{ 0 };		/// vertices of the faces before the first usemtl of the segment
+    std::vector<material_info> _materials;	/// usemtl records, _end counts the vertices of the faces that follow
+    float _min[3]{ 0.f, 0.f, 0.f };
+    float _max[3]{ 0.f, 0.f, 0.f };
+    bool _has_bounds{ false };
+};
+
+/// @brief Lines of the file parsed by one thread.
+/// @note The first pass reads the coordinates and sizes the faces, the second pass builds the faces once the
+///     coordinates of all chunks are known.
+struct obj_chunk
+{
+    std::string_view _text;
+    std::vector<float> _coordinates[coordinate_type_count];
+    std::vector<const char*> _skipped;	/// coordinate lines that failed to parse, they do not count as records
+    size_t _first_record[coordinate_type_count]{ 0u, 0u, 0u };	/// records of the previous chunks
+    std::vector<obj_segment> _segments{ 1u };
+    std::vector<std::string> _material_libraries;
+};
+
+void read_coordinates( obj_chunk& chunk )
+{
+    for_each_line( chunk._text, [&chunk]( line_cursor line )
+    {
+        auto start = line._it;
+        auto type_name = line.next_token();
+        auto type = get_coordinate_type( type_name );
+        if ( type != coordinate_type_count )
+        {
+            float values[3];
+            for ( size_t i = 0u; i < coordinate_sizes[type]; i++ )
+            {
+                if ( !line.next_float( values[i] ) )
+                {
+                    chunk._skipped.push_back( start );
+                    return;
+                }
+            }
+            chunk._coordinates[type].insert( chunk._coordinates[type].end(), values, values + coordinate_sizes[type] );
+        }
+        else if ( type_name == "f" )
+        {
+            auto& segment = chunk._segments.back();
+            size_t corners = 0u;
+            for ( auto token = line.next_token(); !token.empty(); token = line.next_token() )
+            {
+                if ( segment._triangles == 0u && corners == 0u )
+                {
+                    // v/vt or v/vt/vn, not v//vn
+                    auto slash = token.find( '/' );
+                    segment._guess_texture = slash != std::string_view::npos && slash + 1u < token.size() &&
+                                             token[slash + 1u] != '/';
+                }
+                corners++;
+            }
+            segment._triangles += corners > 2u ? corners - 2u : 0u;
+        }
+        else if ( type_name == "o" )
+        {
+            auto name = line.next_token();
+            if ( !name.empty() )
+            {
+                auto& segment = chunk._segments.emplace_back();
+                segment._name = std::string( name );
+                segment._starts_object = true;
+            }
+        }
+        else if ( type_name == "mtllib" )
+        {
+            for ( auto name = line.next_token(); !name.empty(); name = line.next_token() )
+            {
+                chunk._material_libraries.emplace_back( name );
+            }
+        }
+    } );
+}
+
+/// @brief Builds the faces of a chunk from the coordinates of the whole file.
+class face_reader
+{
+public:
+    face_reader( obj_chunk& chunk, const std::vector<float>* coordinates )
+        : _chunk( chunk )
+        , _coordinates( coordinates )
+    {
+        for ( size_t type = 0u; type < coordinate_type_count; type++ )
+        {
+            _counts[type] = chunk._first_record[type];
+        }
+    }
+
+    void read()
+    {
+        _segment = &_chunk._segments[0];
+        reserve();
+        auto skipped = _chunk._skipped.begin();
+        for_each_line( _chunk._text, [this, &skipped]( line_cursor line )
+        {
+            auto start = line._it;
+            auto type_name = line.next_token();
+            auto type = get_coordinate_type( type_name );
+            if ( type != coordinate_type_count )
+            {
+                // faces may only use the records above them
+                if ( skipped != _chunk._skipped.end() && *skipped == start )
+                {
+                    ++skipped;
+                }
+                else
+                {
+                    _counts[type]++;
+                }
+            }
+            else if ( type_name == "f" )
+            {
+                read_face( line );
+            }
+            else if ( type_name == "o" )
+            {
+                if ( !line.next_token().empty() )
+                {
+                    _segment++;
+                    reserve();
+                }
+            }
+            else if ( type_name == "usemtl" )
+            {
+                auto name = line.next_token();
+                if ( !name.empty() )
+                {
+                    _segment->_materials.emplace_back( std::string( name ), 0, 0 );
+                }
+            }
+        } );
+    }
+
+private:
+    obj_chunk& _chunk;
+    const std::vector<float>* _coordinates;
+    size_t _counts[coordinate_type_count];	/// records above the current line
+    obj_segment* _segment{ nullptr };
+    std::vector<obj_corner> _corners;	/// corners of the current face, kept to reuse its memory
+
+    void reserve()
+    {
+        _segment->_vertices.reserve( _segment->_triangles * 3u * ( _segment->_guess_texture ? 8u : 6u ) );
+    }
+
+    /// @brief Read v, v/vt, v//vn or v/vt/vn, indices are 1 based or negative from the last record.
+    bool read_corner( std::string_view token, obj_corner& corner ) const
+    {
+        const char* it = token.data();
+        const char* end = it + token.size();
+        for ( size_t field = 0u; field < coordinate_type_count && it != end; field++ )
+        {
+            if ( *it != '/' )
+            {
+                int32_t index = 0;
+                auto [ptr, error] = std::from_chars( it, end, index );
+                if ( error != std::errc() || index == 0 )
+                {
+                    return false;
+                }
+                const auto count = static_cast<int64_t>( _counts[field] );
+                auto resolved = index > 0 ? static_cast<int64_t>( index ) - 1 : count + index;
+                if ( resolved < 0 || resolved >= count )
+                {
+                    return false;
+                }
+                corner._indices[field] = static_cast<uint32_t>( resolved );
+                it = ptr;
+            }
+            if ( it != end )
+            {
+                if ( *it != '/' )
+                {
+                    return false;
+                }
+                ++it;
+            }
+        }
+        return corner._indices[position] != invalid_index;
+    }
+
+    void read_face( line_cursor& line )
+    {
+        _corners.clear();
+        bool has_texture = true;
+        bool has_normal = true;
+        for ( auto token = line.next_token(); !token.empty(); token = line.next_token() )
+        {
+            obj_corner corner;
+            if ( !read_corner( token, corner ) )
+            {
+                return;
+            }
+            has_texture &= corner._indices[uv] != invalid_index;
+            has_normal &= corner._indices[normal] != invalid_index;
+            _corners.push_back( corner );
+        }
+        if ( _corners.size() < 3u )
+        {
+            return;
+        }
+
+        // split into a fan around the first corner, a quad abcd becomes abc and acd
+        for ( size_t i = 1u; i + 1u < _corners.size(); i++ )
+        {
+            const obj_corner* triangle[3] = { &_corners[0], &_corners[i], &_corners[i + 1u] };
+            float face_normal[3];
+            if ( !has_normal )
+            {
+                auto computed = get_normal( get_position( *triangle[0] ), get_position( *triangle[1] ),
+                                            get_position( *triangle[2] ) );
+                face_normal[0] = static_cast<float>( computed.x );
+                face_normal[1] = static_cast<float>( computed.y );
+                face_normal[2] = static_cast<float>( computed.z );
+            }
+            for ( auto* corner : triangle )
+            {
+                add_vertex( *corner, has_texture,
+                            has_normal ? &_coordinates[normal][corner->_indices[normal] * 3u] : face_normal );
+            }
+        }
+        _segment->_has_texture |= has_texture;
+        _segment->_has_normal = true;
+        const auto vertices = static_cast<int>( ( _corners.size() - 2u ) * 3u );
+        if ( _segment->_materials.empty() )
+        {
+            _segment->_leading_vertices += vertices;
+        }
+        else
+        {
+            _segment->_materials.back()._end += vertices;
+        }
+    }
+
+    fnx::vector3 get_position( const obj_corner& corner ) const
+    {
+        const float* values = &_coordinates[position][corner._indices[position] * 3u];
+        return fnx::vector3( values[0], values[1], values[2] );
+    }
+
+    void add_vertex( const obj_corner& corner, bool has_texture, const float* normal_values )
+    {
+        auto& out = _segment->_vertices;
+        const float* values = &_coordinates[position][corner._indices[position] * 3u];
+        out.insert( out.end(), values, values + 3 );
+        if ( has_texture )
+        {
+            const float* uv_values = &_coordinates[uv][corner._indices[uv] * 2u];
+            out.insert( out.end(), uv_values, uv_values + 2 );
+        }
+        out.insert( out.end(), normal_values, normal_values + 3 );
+
+        for ( size_t k = 0u; k < 3u; k++ )
+        {
+            _segment->_min[k] = _segment->_has_bounds && _segment->_min[k] < values[k] ? _segment->_min[k] : values[k];
+            _segment->_max[k] = _segment->_has_bounds && _segment->_max[k] > values[k] ? _segment->_max[k] : values[k];
+        }
+        _segment->_has_bounds = true;
+    }
+};
+
+/// @brief Run func on every chunk, one thread per chunk.
+template<typename TFunc>
+void for_each_chunk( std::vector<obj_chunk>& chunks, TFunc&& func )
+{
+    std::vector<std::thread> workers;
+    workers.reserve( chunks.size() - 1u );
+    for ( size_t i = 1u; i < chunks.size(); i++ )
+    {
+        workers.emplace_back( [&func, &chunks, i]()
+        {
+            func( chunks[i] );
+        } );
+    }
+    func( chunks[0] );
+    for ( auto& worker : workers )
+    {
+        worker.join();
+    }
+}
+
+/// @brief Split text into count pieces that end at line breaks.
+std::vector<obj_chunk> split_chunks( std::string_view text, size_t count )
+{
+    std::vector<obj_chunk> chunks( count );
+    size_t start = 0u;
+    for ( size_t i = 0u; i < count; i++ )
+    {
+        size_t end = text.size();
+        if ( i + 1u < count )
+        {
+            auto line_end = text.find( '\n', std::max( start, text.size() * ( i + 1u ) / count ) );
+            end = line_end == std::string_view::npos ? text.size() : line_end + 1u;
+        }
+        chunks[i]._text = text.substr( start, end - start );
+        start = end;
+    }
+    return chunks;
+}
+
+/// @brief Coordinates of all chunks in file order.
+void merge_coordinates( std::vector<obj_chunk>& chunks, std::vector<float>* coordinates )
+{
+    for ( size_t type = 0u; type < coordinate_type_count; type++ )
+    {
+        if ( chunks.size() == 1u )
+        {
+            coordinates[type] = std::move( chunks[0]._coordinates[type] );
+            continue;
+        }
+        size_t total = 0u;
+        for ( auto& chunk : chunks )
+        {
+            chunk._first_record[type] = total / coordinate_sizes[type];
+            total += chunk._coordinates[type].size();
+        }
+        coordinates[type].reserve( total );
+        for ( auto& chunk : chunks )
+        {
+            coordinates[type].insert( coordinates[type].end(), chunk._coordinates[type].begin(),
+                                      chunk._coordinates[type].end() );
+            chunk._coordinates[type] = std::vector<float>();
+        }
+    }
+}
+
+/// @brief Append the segments of all chunks to their objects, replaying the usemtl ranges as a single pass would.
+obj_data merge_segments( std::vector<obj_chunk>& chunks )
+{
+    obj_data data;
+    size_t num_objects = 1u;
+    for ( const auto& chunk : chunks )
+    {
+        for ( const auto& segment : chunk._segments )
+        {
+            num_objects += segment._starts_object ? 1u : 0u;
+        }
+    }
+    data.objects.resize( 1u );
+    data.objects.reserve( num_objects );
+
+    // size each object before appending so that its vertices are allocated once
+    std::vector<size_t> sizes( num_objects, 0u );
+    size_t object_index = 0u;
+    for ( const auto& chunk : chunks )
+    {
+        for ( const auto& segment : chunk._segments )
+        {
+            object_index += segment._starts_object ? 1u : 0u;
+            sizes[object_index] += segment._vertices.size();
+        }
+    }
+
+    std::vector<bool> has_bounds( num_objects, false );
+    std::vector<std::array<float, 6>> bounds( num_objects );
+    material_info* material{ nullptr };
+    for ( auto& chunk : chunks )
+    {
+        for ( auto& library : chunk._material_libraries )
+        {
+            data.material_libraries.emplace_back( std::move( library ) );
+        }
+        for ( auto& segment : chunk._segments )
+        {
+            if ( segment._starts_object )
+            {
+                data.objects.emplace_back().name = std::move( segment._name );
+                material = nullptr;
+            }
+            auto index = data.objects.size() - 1u;
+            auto& object = data.objects.back();
+            if ( object.vertices.empty() && segment._vertices.size() == sizes[index] )
+            {
+                object.vertices = std::move( segment._vertices );
+            }
+            else
+            {
+                object.vertices.reserve( sizes[index] );
+                object.vertices.insert( object.vertices.end(), segment._vertices.begin(), segment._vertices.end() );
+                segment._vertices = std::vector<float>();
+            }
+            object.has_texture |= segment._has_texture;
+            object.has_normal |= segment._has_normal;
+
+            if ( material )
+            {
+                material->_end += segment._leading_vertices;
+            }
+            for ( const auto& range : segment._materials )
+            {
+                int start = material ? material->_end : 0;
+                material = &object.materials.add_material_range( range._material_name, start, start + range._end );
+            }
+
+            if ( segment._has_bounds )
+            {
+                auto& box = bounds[index];
+                for ( size_t k = 0u; k < 3u; k++ )
+                {
+                    box[k] = has_bounds[index] && box[k] < segment._min[k] ? box[k] : segment._min[k];
+                    box[k + 3u] = has_bounds[index] && box[k + 3u] > segment._max[k] ? box[k + 3u] : segment._max[k];
+                }
+                has_bounds[index] = true;
+            }
+        }
+    }
+
+    for ( size_t i = 0u; i < num_objects; i++ )
+    {
+        if ( has_bounds[i] )
+        {
+            const auto& box = bounds[i];
+            data.objects[i].aabb = reactphysics3d::AABB( fnx::vector3( box[0], box[1], box[2] ),
+                                   fnx::vector3( box[3], box[4], box[5] ) );
+        }
+    }
+    return data;
+}
+}
+
+obj_data parse_obj( std::string_view text, size_t num_threads )
+{
+    auto chunks = split_chunks( text, std::max<size_t>( num_threads, 1u ) );
+    for_each_chunk( chunks, read_coordinates );
+
+    std::vector<float> coordinates[coordinate_type_count];
+    merge_coordinates( chunks, coordinates );
+    for_each_chunk( chunks, [&coordinates]( obj_chunk & chunk )
+    {
+        face_reader( chunk, coordinates ).read();
+    } );
+    return merge_segments( chunks );
+}
+
+obj_data load_obj( const std::string& file_path, size_t num_threads )
+{
+    const auto file = fnx::read_file( file_path );
+    if ( !file.is_open() )
+    {
+        FNX_ERROR( fnx::format_string( "unable to load model %s", file_path.c_str() ) );
+        throw std::runtime_error( "model file missing" );
+    }
+    if ( num_threads == 0u )
+    {
+        num_threads = std::max<size_t>( std::thread::hardware_concurrency(), 1u );
+    }
+    num_threads = std::min( num_threads, file.size() / min_chunk_bytes + 1u );
+    return parse_obj( file.view(), num_threads );
+}
+
+namespace
+{
+/// @brief Read the r g b of a color, g and b are r when they are left out.
+bool read_color( line_cursor& line, float ( &color )[3] )
+{
+    if ( !line.next_float( color[0] ) )
+    {
+        return false;
+    }
+    color[1] = color[2] = color[0];
+    if ( line.next_float( color[1] ) )
+    {
+        line.next_float( color[2] );
+    }
+    return true;
+}
+
+/// @return the last word of the line
+std::string_view read_path( line_cursor& line )
+{
+    std::string_view path;
+    for ( auto token = line.next_token(); !token.empty(); token = line.next_token() )
+    {
+        path = token;
+    }
+    return path;
+}
+}
+
+std::vector<fnx::mtl_material> parse_mtl( std::string_view text )
+{
+    std::vector<fnx::mtl_material> materials;
+    for_each_line( text, [&materials]( line_cursor line )
+    {
+        const auto command = line.next_token();
+        if ( command == "newmtl" )
+        {
+            materials.emplace_back();
+            materials.back().name = line.next_token();
+            return;
+        }
+        if ( materials.empty() || command.empty() )
+        {
+            return;
+        }
+
+        auto& material = materials.back();
+        auto& values = material.values;
+        auto read = [&material]( bool ok, uint32_t parameter )
+        {
+            material.parameters |= ok ? parameter : 0u;
+        };
+        switch ( fnx::string_id( command ).value() )
+        {
+            case fnx::string_id( "Ns" ).value():
+                read( line.next_float( values.ns ), mtl_material::ns );
+                break;
+            case fnx::string_id( "Ni" ).value():
+                read( line.next_float( values.ni ), mtl_material::ni );
+                break;
+            case fnx::string_id( "d" ).value():
+                read( line.next_float( values.d ), mtl_material::d );
+                break;
+            case fnx::string_id( "illum" ).value():
+                read( line.next_float( values.illum ), mtl_material::illum );
+                break;
+            case fnx::string_id( "Ka" ).value():
+                read( read_color( line, values.ka ), mtl_material::ka );
+                break;
+            case fnx::string_id( "Kd" ).value():
+                read( read_color( line, values.kd ), mtl_material::kd );
+                break;
+            case fnx::string_id( "Ks" ).value():
+                read( read_color( line, values.ks ), mtl_material::ks );
+                break;
+            case fnx::string_id( "Ke" ).value():
+                read( read_color( line, values.ke ), mtl_material::ke );
+                break;
+            case fnx::string_id( "map_Ka" ).value():
+                material.maps[mtl_material::map_ka] = read_path( line );
+                break;
+            case fnx::string_id( "map_Kd" ).value():
+                material.maps[mtl_material::map_kd] = read_path( line );
+                break;
+            case fnx::string_id( "map_Ks" ).value():
+                material.maps[mtl_material::map_ks] = read_path( line );
+                break;
+            case fnx::string_id( "map_Ke" ).value():
+                material.maps[mtl_material::map_ke] = read_path( line );
+                break;
+            case fnx::string_id( "map_Ns" ).value():
+                material.maps[mtl_material::map_ns] = read_path( line );
+                break;
+            case fnx::string_id( "map_d" ).value():
+                material.maps[mtl_material::map_d] = read_path( line );
+                break;
+            default:
+                break;
+        }
+    } );
+    return materials;
+}
+}
@@ -11,7 +11,9 @@ raw_image::raw_image( const std::string& file_path, int32_t channels )
 bool raw_image::load_from_file( const std::string& file_path, int32_t channels )
 {
     int width, height, components;
-    _info._stb_data = stbi_load( file_path.c_str(), &width, &height, &components, channels );
+    const auto file = fnx::read_file( file_path );
+    _info._stb_data = file.is_open() ? stbi_load_from_memory( reinterpret_cast<const stbi_uc*>( file.data() ),
+                      static_cast<int>( file.size() ), &width, &height, &components, channels ) : nullptr;
 
     if ( nullptr != _info._stb_data )
     {
@@ -46,7 +48,7 @@ bool raw_image::load_from_buffer( void* data, size_t size, int32_t width, int32_
     _info._width = width;
     _info._height = height;
     _info._channels = channels;
-    _info._is_ok = _info._stb_data != nullptr && _info._size == ( _info._width * _info._height * 8 );
+    _info._is_ok = nullptr != data && _info._size == static_cast<size_t>( _info._width ) * _info._height * channels;
 
     if ( !_info._is_ok )
     {
@@ -56,6 +58,31 @@ bool raw_image::load_from_buffer( void* data, size_t size, int32_t width, int32_
     return _info._is_ok;
 }
 
+raw_image::raw_image( raw_image&& other ) noexcept
+    : _info( other._info )
+    , _mips( std::move( other._mips ) )
+    , _format( other._format )
+    , _blocks( std::move( other._blocks ) )
+{
+    other._info = info{};
+    other._format = fnx::block_format::none;
+}
+
+raw_image& raw_image::operator=( raw_image&& other ) noexcept
+{
+    if ( this != &other )
+    {
+        unload();
+        _info = other._info;
+        _mips = std::move( other._mips );
+        _format = other._format;
+        _blocks = std::move( other._blocks );
+        other._info = info{};
+        other._format = fnx::block_format::none;
+    }
+    return *this;
+}
+
 raw_image::~raw_image()
 {
     unload();
@@ -74,5 +101,23 @@ void raw_image::unload()
 
     _info._data = nullptr;
     _info._stb_data = nullptr;
+    _mips.clear();
+    _format = fnx::block_format::none;
+    _blocks.clear();
+}
+
+void raw_image::load_blocks( uint32_t width, uint32_t height, uint32_t channels, fnx::block_format format,
+                             std::vector<unsigned char>&& blocks, std::vector<fnx::raw_image::mip>&& mips )
+{
+    unload();
+    _info = info{};
+    _info._width = width;
+    _info._height = height;
+    _info._components = channels;
+    _info._channels = channels;
+    _info._is_ok = !blocks.empty();
+    _format = format;
+    _blocks = std::move( blocks );
+    _mips = std::move( mips );
 }
 }
\ No newline at end of file
@@ -59,11 +59,13 @@ void renderer::draw(camera_handle camera, const fnx::renderable& renderable, con
 
 void renderer::draw_current( const fnx::matrix4x4& transform )
 {
-    if ( _model && _shader && _camera && _material )
+    if ( _model && _shader && _camera && _material && is_visible( transform ) )
     {
-        _shader->set_uniform( UNIFORM_MODEL_VIEW_MATRIX, transform );
+        _shader->set_uniform( UNIFORM_MODEL_VIEW_MATRIX,
+                              _model->has_position_decode() ? transform * _model->get_position_decode() : transform );
         apply_material( _material );
-        _model->render();
+        _model->render_lod( _model->get_lods().empty() ? 0u :
+                            _model->select_lod( get_lod_scale( transform ), _lod_threshold ) );
     }
 }
 
@@ -75,6 +77,54 @@ void renderer::draw_current()
     }
 }
 
+bool renderer::is_visible( const fnx::matrix4x4& transform ) const
+{
+    if ( !_model || !_model->has_bounds() )
+    {
+        return true;
+    }
+    return _frustum.intersects( _model->get_bounds(), transform );
+}
+
+size_t renderer::cull( fnx::span<const AABB> world_bounds, std::vector<uint32_t>& visible ) const
+{
+    return fnx::cull_aabbs( _frustum, world_bounds, visible );
+}
+
+fnx::decimal renderer::get_lod_scale( const fnx::matrix4x4& transform ) const
+{
+    if ( !_model || !_camera || !_model->has_bounds() )
+    {
+        return std::numeric_limits<fnx::decimal>::max();
+    }
+    // the transform is row major like transform_aabbs, the camera matrices are in OpenGL column order
+    const auto& bounds = _model->get_bounds();
+    const auto center = ( bounds.getMin() + bounds.getMax() ) * decimal{ 0.5 };
+    const auto* m = transform.data();
+    fnx::decimal world[3];
+    fnx::decimal scale = 0.f;
+    for ( size_t k = 0u; k < 3u; k++ )
+    {
+        world[k] = m[k * 4u] * center.x + m[k * 4u + 1u] * center.y + m[k * 4u + 2u] * center.z + m[k * 4u + 3u];
+        scale = std::max( scale, std::sqrt( m[k] * m[k] + m[4u + k] * m[4u + k] + m[8u + k] * m[8u + k] ) );
+    }
+    const auto* view_projection = _camera->get_view_projection_matrix().data();
+    const auto* projection = _camera->get_projection_matrix().data();
+    auto depth = view_projection[3] * world[0] + view_projection[7] * world[1] + view_projection[11] * world[2] +
+                 view_projection[15];
+    if ( projection[15] == decimal{ 0 } )
+    {
+        // perspective, the closest point of the bounds is the one to keep under the threshold
+        depth -= ( bounds.getMax() - bounds.getMin() ).length() * decimal{ 0.5 } * scale;
+        if ( depth <= decimal{ 0 } )
+        {
+            return std::numeric_limits<fnx::decimal>::max();
+        }
+    }
+    // clip space spans 2 units of the screen height
+    return scale * std::abs( projection[5] ) * decimal{ 0.5 } / depth;
+}
+
 void renderer::apply_transformation( const matrix4x4& transform ) const
 {
     apply_transformation( _shader, transform );
@@ -101,11 +151,22 @@ void renderer::apply_model( model_handle model )
 void renderer::apply_camera( camera_handle camera )
 {
     _camera = camera;
+    if ( _frustum_version != _camera->get_version() )
+    {
+        _frustum = fnx::frustum::from_view_projection( _camera->get_view_projection_matrix() );
+        _frustum_version = _camera->get_version();
+    }
     apply_camera( _shader, _camera );
 }
 
 void renderer::apply_camera( shader_handle shader, camera_handle camera )
 {
+    // uniforms stay in the program, skip the upload when the shader already has this version of the camera
+    if ( shader->get_camera_version() == camera->get_version() )
+    {
+        return;
+    }
+    shader->set_camera_version( camera->get_version() );
     shader->set_uniform( UNIFORM_CAMERA_PROJECTION_MATRIX, camera->get_projection_matrix() );
     shader->set_uniform( UNIFORM_CAMERA_VIEW_MATRIX, camera->get_view_matrix() );
     shader->set_uniform( UNIFORM_CAMERA_POSITION, camera->get_position() );
@@ -139,6 +200,7 @@ void renderer::apply_lights( shader_handle shader, const Vector3& gamma, const s
 
 void renderer::apply_material( material_handle mat )
 {
+    _material = mat;
     apply_material( _shader, *mat );
 }
 
@@ -161,31 +223,31 @@ void renderer::apply_material( shader_handle shader, const fnx::material& mat )
     for ( const auto& t : mat.get_textures() )
     {
         t.second->bind( cnt );
-        shader->set_uniform( t.first.c_str(), cnt++ );
+        shader->set_uniform( t.first, cnt++ );
     }
     for ( const auto& f : mat.get_floats() )
     {
-        shader->set_uniform( f.first.c_str(), f.second );
+        shader->set_uniform( f.first, f.second );
     }
     for ( const auto& i : mat.get_ints() )
     {
-        shader->set_uniform( i.first.c_str(), i.second );
+        shader->set_uniform( i.first, i.second );
     }
     for ( const auto& m : mat.get_matrix4x4s() )
     {
-        shader->set_uniform( m.first.c_str(), m.second );
+        shader->set_uniform( m.first, m.second );
     }
     for ( const auto& v : mat.get_vector2s() )
     {
-        shader->set_uniform( v.first.c_str(), v.second );
+        shader->set_uniform( v.first, v.second );
     }
     for ( const auto& v : mat.get_vector3s() )
     {
-        shader->set_uniform( v.first.c_str(), v.second );
+        shader->set_uniform( v.first, v.second );
     }
     for ( const auto& v : mat.get_vector4s() )
     {
-        shader->set_uniform( v.first.c_str(), v.second );
+        shader->set_uniform( v.first, v.second );
     }
     for ( const auto& pair : mat.get_array_vector4s() )
     {
@@ -491,15 +553,17 @@ bool renderer::render_game_objects(const fnx::render_evt& evt)
     entities->each<fnx::transform, fnx::camera_component>([&](fnx::entity::id entity, fnx::transform& transform, fnx::camera_component& cam) {
         if (cam._camera != nullptr)
         {
+            const auto frustum = fnx::frustum::from_view_projection(cam._camera->get_view_projection_matrix());
             entities->each_with_component_subset<fnx::transform, fnx::renderable>([&](fnx::entity::id entity, fnx::transform& transform, fnx::renderable& renderable) {
-                if (renderable._shader && renderable._model)
+                // models outside the view of the camera are skipped, like draw_current(transform) does
+                if (renderable._shader && renderable._model &&
+                    (!renderable._model->has_bounds() || frustum.intersects(renderable._model->get_bounds(), transform)))
                 {
                     renderable._shader->bind();
                     ////////////////////////// Start Shadow
                     renderable._shader->set_uniform(UNIFORM_LIGHT_SPACE_MATRIX, light_space_matrix);
                     renderable._shader->set_uniform(UNIFORM_SHADOW_MAP, 0);	// @TODO this can't stay ... need to check the shader or material for this
-                    glActiveTexture(GL_TEXTURE0);
-                    glBindTexture(GL_TEXTURE_2D, _depth_map_texture);
+                    fnx::texture::bind_external(0, _depth_map_texture);
                     ////////////////////////// End Shadow
                     apply_camera(renderable._shader, cam._camera);
                     apply_transformation(renderable._shader, transform);
@@ -633,7 +697,7 @@ void renderer::init_depth_map()
     // create a texture to render the depth map to
     // @todo : use the texture helpers
     glGenTextures( 1, &_depth_map_texture );
-    glBindTexture( GL_TEXTURE_2D, _depth_map_texture );
+    fnx::texture::bind_external( 0, _depth_map_texture );
     glTexImage2D( GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL );
     glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
     glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
@@ -668,7 +732,7 @@ void renderer::init_post_processing()
     // @todo window size
     int width = 1920, height = 1080;
     glGenTextures( 1, &_post_processing_texture );
-    glBindTexture( GL_TEXTURE_2D, _post_processing_texture );
+    fnx::texture::bind_external( 0, _post_processing_texture );
     glTexImage2D( GL_TEXTURE_2D, 0, GL_RGB16F, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL );
     glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
     glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
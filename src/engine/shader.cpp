@@ -1,10 +1,11 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <algorithm>
 
 using namespace std;
 
 static const unsigned int MAX_UNIFORM_LENGTH = 32u;
-using uniform_map = std::unordered_map<std::string, GLint>;
+using uniform_map = fnx::flat_map<fnx::string_id, GLint>;
 
 namespace fnx
 {
@@ -14,19 +15,40 @@ public:
     GLuint _program;
     GLuint _shaders[shader_max];
     uniform_map _uniforms;
+    bool _linked = false;	/// every active uniform is in _uniforms, names that are missing are not in the program
 
-    inline GLint get_uniform_location( const char* name )
+    /// @brief Returns the location of a uniform, querying opengl only the first time the uniform is seen.
+    /// @note When no name is provided the name is recovered from the interned strings.
+    inline GLint get_uniform_location( fnx::string_id id, const char* name )
     {
-        auto iter = _uniforms.find( name );
+        auto iter = _uniforms.find( id );
 
         if ( iter != _uniforms.end() )
         {
             return iter->second;
         }
-        else
+
+        if ( name == nullptr )
         {
+            name = id.str().c_str();
+        }
+        if ( *name == '\0' )
+        {
+            // ids of constants are not interned, before the program is linked a later call may carry the name
+            if ( _linked )
+            {
+                _uniforms.emplace( id, -1 );
+            }
             return -1;
         }
+        auto loc = glGetUniformLocation( _program, name );
+        _uniforms.emplace( id, loc );
+        return loc;
+    }
+
+    inline GLint get_uniform_location( const char* name )
+    {
+        return get_uniform_location( fnx::string_id( name ), name );
     }
 };
 
@@ -99,9 +121,41 @@ void shader::init( const std::string& vertex_str, const std::string& fragment_st
     add_all_uniforms( vertex_str );
     FNX_DEBUG( "checking uniforms in fragment shader" );
     add_all_uniforms( fragment_str );
+    add_active_uniforms();
+    _impl->_linked = true;
     FNX_DEBUG( "finished checking uniforms" );
 }
 
+void shader::add_active_uniforms()
+{
+    // the source scan misses declarations it cannot split, e.g. indented or with a layout qualifier
+    GLint num_uniforms = 0;
+    GLint max_length = 0;
+    glGetProgramiv( _impl->_program, GL_ACTIVE_UNIFORMS, &num_uniforms );
+    glGetProgramiv( _impl->_program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length );
+    std::vector<char> buffer( static_cast<size_t>( std::max( max_length, 1 ) ) );
+    for ( GLint i = 0; i < num_uniforms; ++i )
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform( _impl->_program, static_cast<GLuint>( i ), static_cast<GLsizei>( buffer.size() ), &length,
+                            &size, &type, buffer.data() );
+        std::string name( buffer.data(), static_cast<size_t>( length ) );
+        if ( ends_with( name, "[0]" ) )
+        {
+            // arrays are reported by their first element
+            name.resize( name.size() - 3u );
+            for ( GLint element = 0; element < size; ++element )
+            {
+                const auto element_name = create_array_name( name.c_str(), static_cast<unsigned int>( element ) );
+                _impl->get_uniform_location( fnx::intern( element_name ), element_name.c_str() );
+            }
+        }
+        _impl->get_uniform_location( fnx::intern( name ), name.c_str() );
+    }
+}
+
 void shader::add_all_uniforms( const std::string& source )
 {
     // parse each line of the source file and populate the uniform data
@@ -138,7 +192,7 @@ void shader::add_all_uniforms( const std::string& source )
                     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
                     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s[%d]", array_name.c_str(), i );
                     auto loc = glGetUniformLocation( _impl->_program, buffer );
-                    _impl->_uniforms[buffer] = loc;   // set the uniform to the invalid value to protect stepping on valid data
+                    _impl->_uniforms[fnx::intern( buffer )] = loc;   // set the uniform to the invalid value to protect stepping on valid data
 
                     if ( loc != -1 )
                     {
@@ -155,7 +209,7 @@ void shader::add_all_uniforms( const std::string& source )
             {
                 // single struct uniform
                 auto loc = glGetUniformLocation( _impl->_program, name.c_str() );
-                _impl->_uniforms[name] = loc;   // set the uniform to the invalid value to protect stepping on valid data
+                _impl->_uniforms[fnx::intern( name )] = loc;   // set the uniform to the invalid value to protect stepping on valid data
 
                 if ( loc != -1 )
                 {
@@ -221,11 +275,12 @@ shader::shader( const std::string& name, const std::string& content )
 shader::shader( const std::string& path )
     : fnx::asset( path ), _impl( new shader_impl() )
 {
-    ifstream stream( path );
+    const auto file = fnx::read_file( path );
     stringstream ss[shader_max];
 
-    if ( stream.good() )
+    if ( file.is_open() )
     {
+        istringstream stream( string( file.view() ) );
         FNX_DEBUG( fnx::format_string( "loading shader from %s", path.c_str() ) );
         std::string line;
         auto idx = shader_vertex;
@@ -266,7 +321,6 @@ shader::shader( const std::string& path )
             FNX_ERROR( "fragment shader is empty" );
         }
 
-        stream.close();
         init( ss[shader_vertex].str(), ss[shader_fragment].str() );
     }
     else
@@ -623,7 +677,7 @@ void shader::apply_uniform( const char* uniform_name, const char* member_name, u
 
 void shader::set_uniform( const char* uniform_name, float val ) const
 {
-    auto loc = glGetUniformLocation( _impl->_program, uniform_name );
+    auto loc = _impl->get_uniform_location( uniform_name );
 
     if ( loc != -1 )
     {
@@ -633,7 +687,7 @@ void shader::set_uniform( const char* uniform_name, float val ) const
 
 void shader::set_uniform( const char* uniform_name, double val ) const
 {
-    auto loc = glGetUniformLocation( _impl->_program, uniform_name );
+    auto loc = _impl->get_uniform_location( uniform_name );
 
     if ( loc != -1 )
     {
@@ -643,7 +697,7 @@ void shader::set_uniform( const char* uniform_name, double val ) const
 
 void shader::set_uniform( const char* uniform_name, const fnx::vector2& val ) const
 {
-    auto loc = glGetUniformLocation( _impl->_program, uniform_name );
+    auto loc = _impl->get_uniform_location( uniform_name );
 
     if ( loc != -1 )
     {
@@ -653,7 +707,7 @@ void shader::set_uniform( const char* uniform_name, const fnx::vector2& val ) co
 
 void shader::set_uniform( const char* uniform_name, const fnx::vector3& val ) const
 {
-    auto loc = glGetUniformLocation( _impl->_program, uniform_name );
+    auto loc = _impl->get_uniform_location( uniform_name );
 
     if ( loc != -1 )
     {
@@ -663,7 +717,7 @@ void shader::set_uniform( const char* uniform_name, const fnx::vector3& val ) co
 
 void shader::set_uniform( const char* uniform_name, const fnx::vector4& val ) const
 {
-    auto loc = glGetUniformLocation( _impl->_program, uniform_name );
+    auto loc = _impl->get_uniform_location( uniform_name );
 
     if ( loc != -1 )
     {
@@ -673,7 +727,7 @@ void shader::set_uniform( const char* uniform_name, const fnx::vector4& val ) co
 
 void shader::set_uniform( const char* uniform_name, const fnx::matrix4x4& val ) const
 {
-    auto loc = glGetUniformLocation( _impl->_program, uniform_name );
+    auto loc = _impl->get_uniform_location( uniform_name );
 
     if ( loc != -1 )
     {
@@ -689,7 +743,7 @@ void shader::set_uniform( const char* uniform_name, unsigned int index, int valu
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s[%d]", uniform_name, index );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -701,7 +755,7 @@ void shader::set_uniform( const char* uniform_name, unsigned int index, float va
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s[%d]", uniform_name, index );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -713,7 +767,7 @@ void shader::set_uniform( const char* uniform_name, unsigned int index, int x, i
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s[%d]", uniform_name, index );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -725,7 +779,7 @@ void shader::set_uniform( const char* uniform_name, unsigned int index, const fn
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s[%d]", uniform_name, index );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -737,7 +791,7 @@ void shader::set_uniform( const char* uniform_name, unsigned int index, int x, i
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s[%d]", uniform_name, index );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -749,7 +803,7 @@ void shader::set_uniform( const char* uniform_name, unsigned int index, const fn
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s[%d]", uniform_name, index );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -761,7 +815,7 @@ void shader::set_uniform( const char* uniform_name, unsigned int index, int x, i
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s[%d]", uniform_name, index );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -773,7 +827,7 @@ void shader::set_uniform( const char* uniform_name, unsigned int index, const fn
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s[%d]", uniform_name, index );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -785,7 +839,7 @@ void shader::set_uniform( const char* uniform_name, const char* member, unsigned
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s[%d].%s", uniform_name, index, member );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -798,7 +852,7 @@ void shader::set_uniform( const char* uniform_name, const char* member, unsigned
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s[%d].%s", uniform_name, index, member );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -811,7 +865,7 @@ void shader::set_uniform( const char* uniform_name, const char* member, unsigned
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s[%d].%s", uniform_name, index, member );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -824,7 +878,7 @@ void shader::set_uniform( const char* uniform_name, const char* member, unsigned
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s[%d].%s", uniform_name, index, member );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -834,7 +888,7 @@ void shader::set_uniform( const char* uniform_name, const char* member, unsigned
 
 void shader::set_uniform( const char* uniform_name, unsigned int val ) const
 {
-    auto loc = glGetUniformLocation( _impl->_program, uniform_name );
+    auto loc = _impl->get_uniform_location( uniform_name );
 
     if ( loc != -1 )
     {
@@ -844,7 +898,7 @@ void shader::set_uniform( const char* uniform_name, unsigned int val ) const
 
 void shader::set_uniform( const char* uniform_name, int val ) const
 {
-    auto loc = glGetUniformLocation( _impl->_program, uniform_name );
+    auto loc = _impl->get_uniform_location( uniform_name );
 
     if ( loc != -1 )
     {
@@ -857,7 +911,7 @@ void shader::set_uniform( const char* uniform_name, const char* member, unsigned
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s[%d].%s", uniform_name, index, member );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -870,7 +924,7 @@ void shader::set_uniform( const char* uniform_name, const char* member, unsigned
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s[%d].%s", uniform_name, index, member );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -883,7 +937,7 @@ void shader::set_uniform( const char* uniform_name, const char* member, unsigned
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s[%d].%s", uniform_name, index, member );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -897,7 +951,7 @@ void shader::set_uniform( const char* uniform_name, const char* member, int valu
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s.%s", uniform_name, member );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -909,7 +963,7 @@ void shader::set_uniform( const char* uniform_name, const char* member, unsigned
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s.%s", uniform_name, member );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -921,7 +975,7 @@ void shader::set_uniform( const char* uniform_name, const char* member, int x, i
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s.%s", uniform_name, member );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -933,7 +987,7 @@ void shader::set_uniform( const char* uniform_name, const char* member, int x, i
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s.%s", uniform_name, member );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -945,7 +999,7 @@ void shader::set_uniform( const char* uniform_name, const char* member, float va
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s.%s", uniform_name, member );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -956,7 +1010,7 @@ void shader::set_uniform( const char* uniform_name, const char* member, double v
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s.%s", uniform_name, member );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -968,7 +1022,7 @@ void shader::set_uniform( const char* uniform_name, const char* member, const fn
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s.%s", uniform_name, member );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -980,7 +1034,7 @@ void shader::set_uniform( const char* uniform_name, const char* member, const fn
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s.%s", uniform_name, member );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -992,7 +1046,7 @@ void shader::set_uniform( const char* uniform_name, const char* member, const fn
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s.%s", uniform_name, member );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -1004,7 +1058,7 @@ void shader::set_uniform( const char* uniform_name, const char* member, const fn
 {
     char buffer[MAX_UNIFORM_LENGTH] = { 0 };
     snprintf( buffer, MAX_UNIFORM_LENGTH - 1, "%s.%s", uniform_name, member );
-    auto loc = glGetUniformLocation( _impl->_program, buffer );
+    auto loc = _impl->get_uniform_location( buffer );
 
     if ( loc != -1 )
     {
@@ -1016,6 +1070,92 @@ void shader::set_uniform( const char* uniform_name, const char* member, const fn
     }
 }
 
+/* setters by id, the uniform must be declared in the shader source or interned */
+
+void shader::set_uniform( fnx::string_id uniform_name, int val ) const
+{
+    auto loc = _impl->get_uniform_location( uniform_name, nullptr );
+
+    if ( loc != -1 )
+    {
+        glProgramUniform1i( _impl->_program, loc, val );
+    }
+}
+
+void shader::set_uniform( fnx::string_id uniform_name, unsigned int val ) const
+{
+    auto loc = _impl->get_uniform_location( uniform_name, nullptr );
+
+    if ( loc != -1 )
+    {
+        glProgramUniform1ui( _impl->_program, loc, val );
+    }
+}
+
+void shader::set_uniform( fnx::string_id uniform_name, float val ) const
+{
+    auto loc = _impl->get_uniform_location( uniform_name, nullptr );
+
+    if ( loc != -1 )
+    {
+        glProgramUniform1f( _impl->_program, loc, val );
+    }
+}
+
+void shader::set_uniform( fnx::string_id uniform_name, double val ) const
+{
+    auto loc = _impl->get_uniform_location( uniform_name, nullptr );
+
+    if ( loc != -1 )
+    {
+        glProgramUniform1d( _impl->_program, loc, val );
+    }
+}
+
+void shader::set_uniform( fnx::string_id uniform_name, const fnx::vector2& val ) const
+{
+    auto loc = _impl->get_uniform_location( uniform_name, nullptr );
+
+    if ( loc != -1 )
+    {
+        glProgramUniform2f( _impl->_program, loc, val.x, val.y );
+    }
+}
+
+void shader::set_uniform( fnx::string_id uniform_name, const fnx::vector3& val ) const
+{
+    auto loc = _impl->get_uniform_location( uniform_name, nullptr );
+
+    if ( loc != -1 )
+    {
+        glProgramUniform3f( _impl->_program, loc, val.x, val.y, val.z );
+    }
+}
+
+void shader::set_uniform( fnx::string_id uniform_name, const fnx::vector4& val ) const
+{
+    auto loc = _impl->get_uniform_location( uniform_name, nullptr );
+
+    if ( loc != -1 )
+    {
+        glProgramUniform4f( _impl->_program, loc, val.x, val.y, val.z, val.w );
+    }
+}
+
+void shader::set_uniform( fnx::string_id uniform_name, const fnx::matrix4x4& val ) const
+{
+    auto loc = _impl->get_uniform_location( uniform_name, nullptr );
+
+    if ( loc != -1 )
+    {
+        #if defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)   // If we are compiling for double precision
+        glProgramUniformMatrix4dv( _impl->_program, loc, 1, GL_FALSE, *val.getAll() );
+        #else                                   // If we are compiling for single precision
+        glProgramUniformMatrix4fv( _impl->_program, loc, 1, GL_FALSE, *val.getAll() );
+        #endif
+    }
+}
+
 std::string shader::create_array_name( const char* uniform_name, unsigned int index )
 {
     std::string buffer = uniform_name;
@@ -48,8 +48,13 @@ sound::sound( const std::string& file_path )
     , _impl( std::make_unique<sound_impl>() )
 {
     auto [ctx, _] = singleton<audio_context>::acquire();
-    cs_error_t error;
-    _impl->_loaded_sound = *cs_load_wav( file_path.c_str(), &error );
+    cs_error_t error = CUTE_SOUND_ERROR_FILE_NOT_FOUND;
+    const auto file = fnx::read_file( file_path );
+    auto* source = file.is_open() ? cs_read_mem_wav( file.data(), file.size(), &error ) : nullptr;
+    if ( nullptr != source )
+    {
+        _impl->_loaded_sound = *source;
+    }
     if ( error != CUTE_SOUND_ERROR_NONE )
     {
         FNX_ERROR( fnx::format_string( "failed to load %s %s", file_path, error ) );
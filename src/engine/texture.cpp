@@ -6,6 +6,80 @@ using namespace std;
 
 namespace fnx
 {
+namespace
+{
+/// @brief Return the image of a texture created synchronously, compressed images come from their cache.
+fnx::raw_image load_image( const std::string& file_path, const fnx::texture::config& config )
+{
+    if ( config._compression == fnx::block_format::none )
+    {
+        return fnx::raw_image( file_path, static_cast<int32_t>( config._channels ) );
+    }
+    auto options = config._image_options;
+    options.mips = options.mips && config._enable_mip;
+    return fnx::load_compressed_image( file_path, config._channels, options, config._compression );
+}
+
+/// @brief Textures bound to each unit, so that binding a texture again is skipped.
+/// @note texture records each of its glBindTexture, and textures it does not own are bound with
+///     texture::bind_external(), so the units stay up to date. Textures are only bound on the main thread.
+struct texture_bindings
+{
+    static constexpr GLuint max_units = 32u;
+
+    GLuint units[max_units]{};
+    GLuint active_unit{ 0u };
+    fnx::texture::bind_stats stats;
+
+    /// @brief Record a bind to the active unit done outside of bind().
+    void bound( GLuint texture )
+    {
+        units[active_unit] = texture;
+    }
+
+    /// @brief Bind a texture to a unit unless it is already bound to it.
+    void bind( GLenum target, GLuint texture, GLuint unit )
+    {
+        if ( unit < max_units && units[unit] == texture )
+        {
+            stats.skipped++;
+            return;
+        }
+        if ( active_unit != unit )
+        {
+            glActiveTexture( GL_TEXTURE0 + unit );
+            active_unit = unit;
+        }
+        glBindTexture( target, texture );
+        bound( texture );
+        stats.binds++;
+    }
+};
+
+texture_bindings& get_bindings()
+{
+    static texture_bindings bindings;
+    return bindings;
+}
+
+GLenum get_compressed_format( fnx::block_format format )
+{
+    switch ( format )
+    {
+        case fnx::block_format::bc1:
+            return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        case fnx::block_format::bc3:
+            return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case fnx::block_format::bc4:
+            return GL_COMPRESSED_RED_RGTC1;
+        case fnx::block_format::bc5:
+            return GL_COMPRESSED_RG_RGTC2;
+        default:
+            return GL_COMPRESSED_RGBA_BPTC_UNORM;
+    }
+}
+}
+
 struct texture::impl
 {
     GLuint _texture{};
@@ -41,8 +115,7 @@ texture::texture( const std::string& file_path, uint32_t target )
 }
 
 texture::texture( const std::string& file_path, const fnx::texture::config& config )
-    : texture( file_path, config._channels, config._format, config._internal_format,
-               config._filter, config._attachment, config._clamp, config._enable_mip, config._mip_bias, config._rows, config._cols )
+    : texture( file_path, load_image( file_path, config ), config )
 {
 
 }
@@ -67,6 +140,31 @@ texture::texture( const std::string& file_path, unsigned int channels,
     init();
 }
 
+texture::texture( const std::string& file_path, fnx::raw_image&& image )
+    : fnx::asset( file_path )
+    , _image( std::move( image ) )
+    , _impl{ new texture::impl( GL_TEXTURE_2D ) }
+{
+    init();
+}
+
+texture::texture( const std::string& file_path, fnx::raw_image&& image, const fnx::texture::config& config )
+    : fnx::asset( file_path )
+    , _image( std::move( image ) )
+    , _format{ config._format }
+    , _internal_format{ config._internal_format }
+    , _filter{ config._filter }
+    , _attachment{ config._attachment }
+    , _clamp{ config._clamp }
+    , _enable_mip{ config._enable_mip }
+    , _mip_bias{ config._mip_bias }
+    , _rows{ config._rows }
+    , _cols{ config._cols }
+    , _impl( new texture::impl() )
+{
+    init();
+}
+
 texture::texture( unsigned int width, unsigned int height, unsigned int channels, fnx::format format,
                   fnx::format internal_format, fnx::filter filter, fnx::attachment attachment, bool clamp, bool enable_mip_mapping,
                   float mip_bias,
@@ -130,24 +228,32 @@ void texture::init()
         glTexParameteri( _impl->_texture_target, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
         glTexParameteri( _impl->_texture_target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR );
         glTexParameterf( _impl->_texture_target, GL_TEXTURE_LOD_BIAS, _mip_bias );
-        glTexImage2D( _impl->_texture_target, 0, _internal_format, info._width, info._height, 0, _format, GL_UNSIGNED_BYTE,
-                      info._data );
 
         GLfloat max;
         glGetFloatv( GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &max );
         glTexParameterf( _impl->_texture_target, GL_TEXTURE_MAX_ANISOTROPY_EXT, clamp( 0.f, 8.0f, max ) );
-        glGenerateMipmap( _impl->_texture_target );
     }
     else
     {
         glTexParameteri( _impl->_texture_target, GL_TEXTURE_MIN_FILTER, _filter );
         glTexParameteri( _impl->_texture_target, GL_TEXTURE_MAG_FILTER, _filter );
-
-        glTexImage2D( _impl->_texture_target, 0, _internal_format, info._width, info._height, 0, _format,
-                      GL_UNSIGNED_BYTE, info._data );
     }
 
     glBindTexture( _impl->_texture_target, 0 ); // unbind
+    get_bindings().bound( 0u );
+
+    if ( _attachment == GL_NONE )
+    {
+        // plain textures wait for the upload queue, render targets need their storage right away
+        auto [uploads, _] = singleton<upload_queue>::acquire();
+        _upload = uploads.push( get_upload_bytes(), [this]()
+        {
+            upload();
+        } );
+        return;
+    }
+
+    upload();
     GLenum draw_buffer;
     bool has_depth = false;
 
@@ -156,10 +262,6 @@ void texture::init()
         draw_buffer = GL_NONE;
         has_depth = true;
     }
-    else if ( _attachment == GL_NONE )
-    {
-        return;
-    }
     else
     {
         draw_buffer = _attachment;
@@ -197,10 +299,99 @@ void texture::init()
     //TODO: initialize the texture for mip mapping
 }
 
+void texture::upload()
+{
+    const auto& info = _image.get_info();
+    glBindTexture( _impl->_texture_target, _impl->_texture );
+    if ( _image.get_format() != fnx::block_format::none )
+    {
+        // the levels were compressed on a worker thread or read from their cache, the GPU cannot build them
+        const auto format = get_compressed_format( _image.get_format() );
+        const auto& blocks = _image.get_blocks();
+        glCompressedTexImage2D( _impl->_texture_target, 0, format, info._width, info._height, 0,
+                                static_cast<GLsizei>( blocks.size() ), blocks.data() );
+        GLint level = 1;
+        for ( const auto& mip : _image.get_mips() )
+        {
+            glCompressedTexImage2D( _impl->_texture_target, level++, format, mip._width, mip._height, 0,
+                                    static_cast<GLsizei>( mip._data.size() ), mip._data.data() );
+        }
+        glTexParameteri( _impl->_texture_target, GL_TEXTURE_MAX_LEVEL, level - 1 );
+        glBindTexture( _impl->_texture_target, 0 ); // unbind
+        get_bindings().bound( 0u );
+        return;
+    }
+    glTexImage2D( _impl->_texture_target, 0, _internal_format, info._width, info._height, 0, _format, GL_UNSIGNED_BYTE,
+                  info._data );
+    if ( _enable_mip && !_image.get_mips().empty() )
+    {
+        // levels built on a worker thread, rows of small levels are not aligned to 4 bytes
+        glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+        GLint level = 1;
+        for ( const auto& mip : _image.get_mips() )
+        {
+            glTexImage2D( _impl->_texture_target, level++, _internal_format, mip._width, mip._height, 0, _format,
+                          GL_UNSIGNED_BYTE, mip._data.data() );
+        }
+        glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+    }
+    else if ( _enable_mip )
+    {
+        glGenerateMipmap( _impl->_texture_target );
+    }
+    glBindTexture( _impl->_texture_target, 0 ); // unbind
+    get_bindings().bound( 0u );
+}
+
+size_t texture::get_upload_bytes() const
+{
+    const auto& info = _image.get_info();
+    size_t bytes = static_cast<size_t>( info._width ) * info._height * info._channels;
+    if ( _image.get_format() != fnx::block_format::none )
+    {
+        bytes = _image.get_blocks().size();
+        for ( const auto& mip : _image.get_mips() )
+        {
+            bytes += mip._data.size();
+        }
+    }
+    else if ( _enable_mip && !_image.get_mips().empty() )
+    {
+        for ( const auto& mip : _image.get_mips() )
+        {
+            bytes += mip._data.size();
+        }
+    }
+    else if ( _enable_mip )
+    {
+        // the full mip chain adds a third of the base level
+        bytes += bytes / 3u;
+    }
+    return bytes;
+}
+
 texture::~texture()
 {
     if ( nullptr != _impl )
     {
+        // a texture created later may get the same name
+        for ( auto& bound : get_bindings().units )
+        {
+            bound = bound == _impl->_texture ? 0u : bound;
+        }
+        // evicted textures give their memory back to the GPU
+        if ( 0 != _impl->_render_buffer )
+        {
+            glDeleteRenderbuffers( 1, &_impl->_render_buffer );
+        }
+        if ( 0 != _impl->_frame_buffer )
+        {
+            glDeleteFramebuffers( 1, &_impl->_frame_buffer );
+        }
+        if ( 0 != _impl->_texture )
+        {
+            glDeleteTextures( 1, &_impl->_texture );
+        }
         delete _impl;
     }
 
@@ -221,6 +412,17 @@ fnx::vector2 texture::calc_atlas_offset( unsigned char index )
     return ret;
 }
 
+size_t texture::get_memory_usage() const
+{
+    const auto& info = _image.get_info();
+    size_t cpu_bytes = ( nullptr != info._data ? info._size : 0u ) + _image.get_blocks().size();
+    for ( const auto& mip : _image.get_mips() )
+    {
+        cpu_bytes += mip._data.size();
+    }
+    return get_upload_bytes() + cpu_bytes;
+}
+
 void texture::pixel( unsigned int row, unsigned int col, char& r, char& g, char& b, char& a ) const
 {
     const auto& info = _image.get_info();
@@ -241,6 +443,7 @@ void texture::set_render_target()
 {
     const auto& info = _image.get_info();
     glBindTexture( GL_TEXTURE_2D, 0 );
+    get_bindings().bound( 0u );
     glBindFramebuffer( GL_FRAMEBUFFER, _impl->_frame_buffer );
     glViewport( 0, 0, info._width, info._height );
 }
@@ -248,7 +451,53 @@ void texture::set_render_target()
 void texture::bind( unsigned int unit ) const
 {
     assert( unit >= 0 && unit < 32 );
-    glActiveTexture( GL_TEXTURE0 + unit );
+    if ( nullptr != _upload && !_upload->is_done() )
+    {
+        // bound for drawing, so it is on screen
+        _upload->set_priority( fnx::upload_priority::visible );
+    }
+    get_bindings().bind( _impl->_texture_target, _impl->_texture, unit );
+}
+
+void texture::bind_external( unsigned int unit, unsigned int texture_id )
+{
+    assert( unit < 32 );
+    get_bindings().bind( GL_TEXTURE_2D, texture_id, unit );
+}
+
+void texture::write_pixels( uint32_t x, uint32_t y, uint32_t width, uint32_t height, const unsigned char* pixels )
+{
+    const auto& info = _image.get_info();
+    auto* data = _image.get_pixels();
+    if ( nullptr == data || nullptr == pixels || x + width > info._width || y + height > info._height )
+    {
+        return;
+    }
+    const size_t row_bytes = static_cast<size_t>( width ) * info._channels;
+    for ( uint32_t row = 0u; row < height; row++ )
+    {
+        std::copy_n( pixels + row * row_bytes, row_bytes,
+                     data + ( static_cast<size_t>( y + row ) * info._width + x ) * info._channels );
+    }
+    if ( !is_resident() )
+    {
+        return;
+    }
     glBindTexture( _impl->_texture_target, _impl->_texture );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+    glTexSubImage2D( _impl->_texture_target, 0, x, y, width, height, _format, GL_UNSIGNED_BYTE, pixels );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+    glBindTexture( _impl->_texture_target, 0 ); // unbind
+    get_bindings().bound( 0u );
+}
+
+const texture::bind_stats& texture::get_bind_stats()
+{
+    return get_bindings().stats;
+}
+
+void texture::reset_bind_stats()
+{
+    get_bindings().stats = bind_stats{};
 }
 }
\ No newline at end of file
@@ -0,0 +1,364 @@
+#include <algorithm>
+#include <limits>
+
+namespace fnx
+{
+namespace
+{
+bool intersects( const fnx::packed_rect& a, const fnx::packed_rect& b )
+{
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+bool contains( const fnx::packed_rect& outer, const fnx::packed_rect& inner )
+{
+    return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.width <= outer.x + outer.width &&
+           inner.y + inner.height <= outer.y + outer.height;
+}
+}
+
+rect_packer::rect_packer( uint32_t width, uint32_t height )
+    : _width( width )
+    , _height( height )
+{
+    clear();
+}
+
+bool rect_packer::insert( uint32_t width, uint32_t height, fnx::packed_rect& rect )
+{
+    if ( width == 0u || height == 0u )
+    {
+        return false;
+    }
+    // best short side fit, ties go to the best long side fit
+    const fnx::packed_rect* best = nullptr;
+    uint32_t best_short = std::numeric_limits<uint32_t>::max();
+    uint32_t best_long = std::numeric_limits<uint32_t>::max();
+    for ( const auto& free_rect : _free )
+    {
+        if ( free_rect.width >= width && free_rect.height >= height )
+        {
+            const auto leftover_x = free_rect.width - width;
+            const auto leftover_y = free_rect.height - height;
+            const auto short_side = std::min( leftover_x, leftover_y );
+            const auto long_side = std::max( leftover_x, leftover_y );
+            if ( short_side < best_short || ( short_side == best_short && long_side < best_long ) )
+            {
+                best = &free_rect;
+                best_short = short_side;
+                best_long = long_side;
+            }
+        }
+    }
+    if ( nullptr == best )
+    {
+        return false;
+    }
+    rect = fnx::packed_rect{ best->x, best->y, width, height };
+    const auto num_free = _free.size();
+    split( rect );
+    prune( num_free );
+    _used_area += static_cast<size_t>( width ) * height;
+    return true;
+}
+
+void rect_packer::free( const fnx::packed_rect& rect )
+{
+    _used_area -= std::min( _used_area, static_cast<size_t>( rect.width ) * rect.height );
+    if ( _used_area == 0u )
+    {
+        clear();
+        return;
+    }
+    _free.emplace_back( rect );
+    merge();
+    prune();
+}
+
+void rect_packer::clear()
+{
+    _free.assign( 1u, fnx::packed_rect{ 0u, 0u, _width, _height } );
+    _used_area = 0u;
+}
+
+void rect_packer::split( const fnx::packed_rect& used )
+{
+    // every free rectangle under the used one is replaced by its parts on each side of it
+    const size_t num_free = _free.size();
+    for ( size_t i = 0u; i < num_free; i++ )
+    {
+        const auto free_rect = _free[i];
+        if ( !intersects( free_rect, used ) )
+        {
+            continue;
+        }
+        if ( used.x > free_rect.x )
+        {
+            _free.push_back( { free_rect.x, free_rect.y, used.x - free_rect.x, free_rect.height } );
+        }
+        if ( used.x + used.width < free_rect.x + free_rect.width )
+        {
+            _free.push_back( { used.x + used.width, free_rect.y, free_rect.x + free_rect.width - used.x - used.width,
+                               free_rect.height } );
+        }
+        if ( used.y > free_rect.y )
+        {
+            _free.push_back( { free_rect.x, free_rect.y, free_rect.width, used.y - free_rect.y } );
+        }
+        if ( used.y + used.height < free_rect.y + free_rect.height )
+        {
+            _free.push_back( { free_rect.x, used.y + used.height, free_rect.width,
+                               free_rect.y + free_rect.height - used.y - used.height } );
+        }
+        _free[i].width = 0u;	// removed by prune()
+    }
+}
+
+void rect_packer::merge()
+{
+    bool merged = true;
+    while ( merged )
+    {
+        merged = false;
+        for ( size_t i = 0u; i < _free.size() && !merged; i++ )
+        {
+            for ( size_t j = i + 1u; j < _free.size() && !merged; j++ )
+            {
+                auto& a = _free[i];
+                const auto& b = _free[j];
+                if ( a.x == b.x && a.width == b.width && ( a.y + a.height == b.y || b.y + b.height == a.y ) )
+                {
+                    a.y = std::min( a.y, b.y );
+                    a.height += b.height;
+                    merged = true;
+                }
+                else if ( a.y == b.y && a.height == b.height && ( a.x + a.width == b.x || b.x + b.width == a.x ) )
+                {
+                    a.x = std::min( a.x, b.x );
+                    a.width += b.width;
+                    merged = true;
+                }
+                if ( merged )
+                {
+                    _free.erase( _free.begin() + static_cast<std::ptrdiff_t>( j ) );
+                }
+            }
+        }
+    }
+}
+
+void rect_packer::prune( size_t first_new )
+{
+    // free rectangles inside another one are redundant, the ones before first_new were already pruned together
+    for ( size_t i = 0u; i < _free.size(); i++ )
+    {
+        for ( size_t j = std::max( first_new, i + 1u ); j < _free.size() && _free[i].width > 0u; j++ )
+        {
+            if ( _free[j].width == 0u )
+            {
+                continue;
+            }
+            if ( contains( _free[j], _free[i] ) )
+            {
+                _free[i].width = 0u;
+            }
+            else if ( contains( _free[i], _free[j] ) )
+            {
+                _free[j].width = 0u;
+            }
+        }
+    }
+    _free.erase( std::remove_if( _free.begin(), _free.end(), []( const fnx::packed_rect & rect )
+    {
+        return rect.width == 0u || rect.height == 0u;
+    } ), _free.end() );
+}
+
+fnx::vector2 atlas_region::calc_atlas_offset( unsigned char index, unsigned char rows, unsigned char cols ) const
+{
+    fnx::vector2 ret{ _uv_offset };
+    if ( rows > 0u && cols > 0u && index < rows * cols )
+    {
+        ret.x += _uv_scale.x * static_cast<fnx::decimal>( index % cols ) / cols;
+        ret.y += _uv_scale.y * static_cast<fnx::decimal>( index / cols ) / rows;
+    }
+    return ret;
+}
+
+std::shared_ptr<fnx::atlas_region> texture_atlas::get( const std::string& file_path )
+{
+    auto it = _regions.find( file_path );
+    if ( it != _regions.end() )
+    {
+        it->second->_last_used = ++_tick;
+        return it->second;
+    }
+    if ( _unpacked.count( file_path ) > 0u )
+    {
+        return nullptr;
+    }
+    fnx::raw_image image( file_path, 4 );
+    auto region = image.get_info()._is_ok ?
+                  add( file_path, image.get_pixels(), image.get_info()._width, image.get_info()._height ) : nullptr;
+    if ( nullptr == region )
+    {
+        // not tried again, the image keeps its own texture
+        _unpacked.emplace( file_path );
+    }
+    return region;
+}
+
+std::shared_ptr<fnx::atlas_region> texture_atlas::add( const std::string& name, const unsigned char* pixels,
+        uint32_t width, uint32_t height )
+{
+    if ( nullptr == pixels || width == 0u || height == 0u || width > _config.max_region_size ||
+            height > _config.max_region_size )
+    {
+        return nullptr;
+    }
+    auto it = _regions.find( name );
+    if ( it != _regions.end() )
+    {
+        if ( it->second.use_count() == 1 )
+        {
+            remove( *it->second );
+        }
+        else
+        {
+            // its rectangle is still drawn from, it is freed once released
+            _replaced.emplace_back( std::move( it->second ) );
+        }
+        _regions.erase( it );
+    }
+
+    const auto padding = _config.padding;
+    fnx::packed_rect rect;
+    uint32_t page_index = 0u;
+    if ( !place( width + 2u * padding, height + 2u * padding, rect, page_index ) )
+    {
+        FNX_WARN( fnx::format_string( "texture atlas is full, %s keeps its own texture", name.c_str() ) );
+        return nullptr;
+    }
+
+    // the edge pixels are repeated over the padding so that filtering at the edges only reads the image
+    std::vector<unsigned char> padded( static_cast<size_t>( rect.width ) * rect.height * 4u );
+    for ( uint32_t y = 0u; y < rect.height; y++ )
+    {
+        const auto src_y = std::min( static_cast<uint32_t>( std::max( static_cast<int64_t>( y ) - padding, int64_t{ 0 } ) ),
+                                     height - 1u );
+        for ( uint32_t x = 0u; x < rect.width; x++ )
+        {
+            const auto src_x = std::min( static_cast<uint32_t>( std::max( static_cast<int64_t>( x ) - padding,
+                                         int64_t{ 0 } ) ), width - 1u );
+            std::copy_n( pixels + ( static_cast<size_t>( src_y ) * width + src_x ) * 4u, 4u,
+                         padded.data() + ( static_cast<size_t>( y ) * rect.width + x ) * 4u );
+        }
+    }
+    auto& page = _pages[page_index];
+    page.texture->write_pixels( rect.x, rect.y, rect.width, rect.height, padded.data() );
+
+    auto region = std::make_shared<fnx::atlas_region>();
+    const auto page_size = static_cast<fnx::decimal>( _config.page_size );
+    region->_texture = page.texture;
+    region->_rect = rect;
+    region->_padding = padding;
+    region->_page = page_index;
+    region->_last_used = ++_tick;
+    region->_uv_offset = fnx::vector2( ( rect.x + padding ) / page_size, ( rect.y + padding ) / page_size );
+    region->_uv_scale = fnx::vector2( width / page_size, height / page_size );
+    _regions[name] = region;
+    return region;
+}
+
+size_t texture_atlas::evict_unused()
+{
+    size_t evicted = free_replaced();
+    for ( auto it = _regions.begin(); it != _regions.end(); )
+    {
+        if ( it->second.use_count() == 1 )
+        {
+            remove( *it->second );
+            it = _regions.erase( it );
+            evicted++;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return evicted;
+}
+
+bool texture_atlas::place( uint32_t width, uint32_t height, fnx::packed_rect& rect, uint32_t& page_index )
+{
+    auto insert = [&]()
+    {
+        for ( size_t i = 0u; i < _pages.size(); i++ )
+        {
+            if ( _pages[i].packer.insert( width, height, rect ) )
+            {
+                page_index = static_cast<uint32_t>( i );
+                return true;
+            }
+        }
+        return false;
+    };
+    if ( insert() || ( free_replaced() > 0u && insert() ) )
+    {
+        return true;
+    }
+
+    // regions not in use make room before another page is created, the least recently used first
+    std::vector<std::pair<uint64_t, std::string>> unused;
+    for ( const auto& [name, region] : _regions )
+    {
+        if ( region.use_count() == 1 )
+        {
+            unused.emplace_back( region->_last_used, name );
+        }
+    }
+    std::sort( unused.begin(), unused.end() );
+    for ( const auto& [_, name] : unused )
+    {
+        auto it = _regions.find( name );
+        remove( *it->second );
+        _regions.erase( it );
+        if ( insert() )
+        {
+            return true;
+        }
+    }
+
+    if ( _pages.size() >= _config.max_pages || width > _config.page_size || height > _config.page_size )
+    {
+        return false;
+    }
+    page new_page;
+    new_page.packer = fnx::rect_packer( _config.page_size, _config.page_size );
+    new_page.texture = fnx::make_shared_ref<fnx::texture>( _config.page_size, _config.page_size, 4u, fnx::format::RGBA,
+                       fnx::format::RGBA, fnx::filter::Linear, fnx::attachment::None, true, false, 0.f,
+                       static_cast<unsigned char>( 1 ), static_cast<unsigned char>( 1 ) );
+    _pages.emplace_back( std::move( new_page ) );
+    return insert();
+}
+
+void texture_atlas::remove( const fnx::atlas_region& region )
+{
+    _pages[region._page].packer.free( region._rect );
+}
+
+size_t texture_atlas::free_replaced()
+{
+    const auto num_replaced = _replaced.size();
+    _replaced.erase( std::remove_if( _replaced.begin(), _replaced.end(), [this]( const auto & region )
+    {
+        if ( region.use_count() > 1 )
+        {
+            return false;
+        }
+        remove( *region );
+        return true;
+    } ), _replaced.end() );
+    return num_replaced - _replaced.size();
+}
+}
@@ -0,0 +1,200 @@
+#include <cstdio>
+#include <cstring>
+
+namespace fnx
+{
+namespace
+{
+constexpr uint32_t cache_magic = 0x58544e46u;	/// "FNTX" when read on a little endian machine
+
+struct cache_header
+{
+    uint32_t magic;
+    uint32_t format_version;
+    uint32_t encoder_version;
+    uint32_t format;	/// block_format of every level
+    uint64_t key;
+    uint64_t file_size;
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;	/// channels of the image that was compressed
+    uint32_t num_levels;	/// the image then its mips
+};
+
+struct cache_level
+{
+    uint32_t width;
+    uint32_t height;
+    uint64_t offset;
+    uint64_t size;
+};
+
+// the levels follow the header, both are written as they are laid out in memory
+static_assert( sizeof( cache_header ) == 48u, "cache header is padded" );
+static_assert( sizeof( cache_level ) == 24u, "cache level is padded" );
+}
+
+uint64_t texture_cache::get_settings_key( uint32_t channels, const fnx::image_options& options,
+        fnx::block_format format )
+{
+    // the options are copied field by field, the padding of image_options is not hashed
+    unsigned char settings[16] = {};
+    std::memcpy( settings, options.swizzle.data(), 4u );
+    settings[4] = options.premultiply_alpha ? 1u : 0u;
+    settings[5] = options.srgb ? 1u : 0u;
+    settings[6] = options.mips ? 1u : 0u;
+    settings[7] = static_cast<unsigned char>( options.filter );
+    std::memcpy( settings + 8, &options.alpha_cutoff, sizeof( float ) );
+    settings[12] = static_cast<unsigned char>( channels );
+    settings[13] = static_cast<unsigned char>( format );
+    return fnx::hash_bytes( settings, sizeof( settings ) );
+}
+
+uint64_t texture_cache::get_key( const char* data, size_t size, uint32_t channels, const fnx::image_options& options,
+                                 fnx::block_format format )
+{
+    return fnx::hash_bytes( data, size, get_settings_key( channels, options, format ) );
+}
+
+std::vector<char> texture_cache::serialize( uint64_t key, const fnx::raw_image& image )
+{
+    const auto& info = image.get_info();
+    cache_header header{};
+    header.magic = cache_magic;
+    header.format_version = format_version;
+    header.encoder_version = encoder_version;
+    header.format = static_cast<uint32_t>( image.get_format() );
+    header.key = key;
+    header.width = info._width;
+    header.height = info._height;
+    header.channels = info._channels;
+    header.num_levels = static_cast<uint32_t>( 1u + image.get_mips().size() );
+
+    std::vector<cache_level> levels;
+    levels.reserve( header.num_levels );
+    size_t offset = fnx::align_offset( sizeof( cache_header ) + header.num_levels * sizeof( cache_level ) );
+    levels.push_back( { info._width, info._height, offset, image.get_blocks().size() } );
+    offset = fnx::align_offset( offset + image.get_blocks().size() );
+    for ( const auto& mip : image.get_mips() )
+    {
+        levels.push_back( { mip._width, mip._height, offset, mip._data.size() } );
+        offset = fnx::align_offset( offset + mip._data.size() );
+    }
+    header.file_size = offset;
+
+    std::vector<char> bytes( offset, 0 );
+    std::memcpy( bytes.data(), &header, sizeof( header ) );
+    std::memcpy( bytes.data() + sizeof( header ), levels.data(), levels.size() * sizeof( cache_level ) );
+    auto add_blob = [&bytes]( const cache_level & level, const std::vector<unsigned char>& blocks )
+    {
+        if ( !blocks.empty() )
+        {
+            std::memcpy( bytes.data() + level.offset, blocks.data(), blocks.size() );
+        }
+    };
+    add_blob( levels[0], image.get_blocks() );
+    for ( size_t i = 0u; i < image.get_mips().size(); i++ )
+    {
+        add_blob( levels[i + 1u], image.get_mips()[i]._data );
+    }
+    return bytes;
+}
+
+bool texture_cache::read( const char* data, size_t size, uint64_t key, fnx::raw_image& image )
+{
+    cache_header header;
+    if ( size < sizeof( cache_header ) )
+    {
+        return false;
+    }
+    std::memcpy( &header, data, sizeof( header ) );
+    const auto format = static_cast<fnx::block_format>( header.format );
+    if ( header.magic != cache_magic || header.format_version != format_version ||
+            header.encoder_version != encoder_version || header.key != key || header.file_size != size ||
+            fnx::get_block_bytes( format ) == 0u || header.num_levels == 0u ||
+            header.num_levels > ( size - sizeof( cache_header ) ) / sizeof( cache_level ) )
+    {
+        return false;
+    }
+
+    std::vector<unsigned char> blocks;
+    std::vector<fnx::raw_image::mip> mips( header.num_levels - 1u );
+    for ( uint32_t i = 0u; i < header.num_levels; i++ )
+    {
+        cache_level level;
+        std::memcpy( &level, data + sizeof( cache_header ) + i * sizeof( cache_level ), sizeof( level ) );
+        // every level must hold exactly the blocks of its size
+        if ( level.offset > size || level.size > size - level.offset ||
+                level.size != fnx::get_compressed_size( format, level.width, level.height ) ||
+                ( i == 0u && ( level.width != header.width || level.height != header.height ) ) )
+        {
+            return false;
+        }
+        const auto* begin = reinterpret_cast<const unsigned char*>( data + level.offset );
+        auto& level_blocks = i == 0u ? blocks : mips[i - 1u]._data;
+        level_blocks.assign( begin, begin + level.size );
+        if ( i > 0u )
+        {
+            mips[i - 1u]._width = level.width;
+            mips[i - 1u]._height = level.height;
+        }
+    }
+    image.load_blocks( header.width, header.height, header.channels, format, std::move( blocks ), std::move( mips ) );
+    return image.get_info()._is_ok;
+}
+
+std::string get_texture_cache_path( const std::string& image_path, uint32_t channels, const fnx::image_options& options,
+                                    fnx::block_format format )
+{
+    // each set of options gets its own file, so loading the image with other options keeps this cache
+    char settings[9];
+    std::snprintf( settings, sizeof( settings ), "%08x",
+                   static_cast<uint32_t>( texture_cache::get_settings_key( channels, options, format ) ) );
+    return image_path + "." + fnx::get_block_format_name( format ) + "." + settings + ".fnxtex";
+}
+
+fnx::raw_image load_compressed_image( const std::string& image_path, uint32_t channels,
+                                      const fnx::image_options& options, fnx::block_format format )
+{
+    uint64_t key = 0u;
+    {
+        const auto source = fnx::read_file( image_path );
+        if ( !source.is_open() )
+        {
+            FNX_ERROR( fnx::format_string( "unable to load image %s", image_path.c_str() ) );
+            return fnx::raw_image();
+        }
+        key = texture_cache::get_key( source.data(), source.size(), channels, options, format );
+    }
+
+    const auto cache_path = get_texture_cache_path( image_path, channels, options, format );
+    fnx::raw_image image;
+    {
+        const auto cache = fnx::read_file( cache_path );
+        if ( cache.is_open() && texture_cache::read( cache.data(), cache.size(), key, image ) )
+        {
+            return image;
+        }
+    }
+
+    FNX_DEBUG( fnx::format_string( "compressing image %s to %s", image_path.c_str(),
+                                   fnx::get_block_format_name( format ) ) );
+    if ( !image.load_from_file( image_path, static_cast<int32_t>( channels ) ) )
+    {
+        return image;
+    }
+    fnx::prepare_image( image, options );
+    const auto report = fnx::compress_image( image, format );
+    FNX_INFO( fnx::format_string( "texture %s: %s, %.2f MB to %.2f MB, PSNR %.2f dB", image_path.c_str(),
+                                  fnx::get_block_format_name( format ), report.input_bytes / ( 1024.0 * 1024.0 ),
+                                  report.output_bytes / ( 1024.0 * 1024.0 ), report.psnr ) );
+    const auto bytes = texture_cache::serialize( key, image );
+
+    if ( !fnx::write_file_replacing( cache_path, bytes.data(), bytes.size() ) )
+    {
+        // the image directory may be read only, the texture is still compressed in memory
+        FNX_WARN( fnx::format_string( "unable to write texture cache %s", cache_path.c_str() ) );
+    }
+    return image;
+}
+}
@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <limits>
+
+namespace fnx
+{
+std::shared_ptr<fnx::gpu_upload> upload_queue::push( size_t bytes, fnx::gpu_upload::upload_func&& func,
+        fnx::upload_priority priority )
+{
+    auto upload = std::make_shared<fnx::gpu_upload>( bytes, std::move( func ), priority );
+    _uploads.emplace_back( upload );
+    return upload;
+}
+
+const fnx::upload_stats& upload_queue::update( size_t byte_budget, std::chrono::microseconds time_budget )
+{
+    const auto start = std::chrono::steady_clock::now();
+    _stats = {};
+
+    // drop the uploads of released assets, then move the visible ones ahead keeping the order of submission
+    _uploads.erase( std::remove_if( _uploads.begin(), _uploads.end(), []( const auto & upload )
+    {
+        const auto locked = upload.lock();
+        return nullptr == locked || locked->is_done();
+    } ), _uploads.end() );
+    std::stable_partition( _uploads.begin(), _uploads.end(), []( const auto & upload )
+    {
+        return upload.lock()->get_priority() == fnx::upload_priority::visible;
+    } );
+
+    while ( !_uploads.empty() )
+    {
+        auto upload = _uploads.front().lock();
+        if ( nullptr == upload )
+        {
+            // released by an earlier upload of this update
+            _uploads.pop_front();
+            continue;
+        }
+        if ( _stats.uploads > 0u && ( _stats.bytes + upload->get_bytes() > byte_budget ||
+                                      std::chrono::steady_clock::now() - start >= time_budget ) )
+        {
+            break;
+        }
+        _uploads.pop_front();
+        upload->run();
+        _stats.uploads++;
+        _stats.bytes += upload->get_bytes();
+    }
+
+    _stats.stall = std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - start );
+    _total_stall += _stats.stall;
+    for ( const auto& upload : _uploads )
+    {
+        if ( const auto locked = upload.lock() )
+        {
+            _stats.depth++;
+            _stats.queued_bytes += locked->get_bytes();
+        }
+    }
+    return _stats;
+}
+
+const fnx::upload_stats& upload_queue::flush()
+{
+    return update( std::numeric_limits<size_t>::max(), std::chrono::hours( 1 ) );
+}
+}
@@ -13,6 +13,7 @@ namespace world
 namespace detail
 {
 std::atomic<bool> _engine_running{true};
+subscription_token _window_close_token{ invalid_subscription };
 }
 
 void init()
@@ -33,7 +34,7 @@ void create_window( const char* window_title, fnx::display_mode& display )
 {
     {
         auto [events, _] = singleton<event_manager>::acquire();
-        events.subscribe<fnx::window_close_evt>( fnx::bind( &fnx::world::stop ) );
+        detail::_window_close_token = events.subscribe<fnx::window_close_evt>( fnx::bind( &fnx::world::stop ) );
     }
     {
         singleton<audio_manager>::acquire();
@@ -137,6 +138,11 @@ void run()
                 FNX_EMIT_NOW( fnx::update_evt{fnx::update_evt::action_t::start, delta} );
                 FNX_EMIT_NOW( fnx::update_evt{fnx::update_evt::action_t::end} );
             }
+            {
+                // create the assets read in the background, then send the queued uploads within the budgets of a frame
+                singleton<asset_loader>::acquire().data.update();
+                singleton<upload_queue>::acquire().data.update();
+            }
             if ( cycle_accumulator >= fps )
             {
                 num_samples++;
@@ -200,7 +206,7 @@ bool stop( const window_close_evt& )
 {
     detail::_engine_running = false;
     auto [events, _] = singleton<event_manager>::acquire();
-    events.unsubscribe<fnx::window_close_evt>( fnx::bind( &fnx::world::stop ) );
+    events.unsubscribe<fnx::window_close_evt>( detail::_window_close_token );
     return false;
 }
 
@@ -227,15 +233,13 @@ void save_display_configuration( const std::string& file_path, fnx::display_mode
 fnx::display_mode load_display_configuration( const std::string& file_path )
 {
     fnx::display_mode mode;
-    ifstream in( file_path );
-    if ( !in.good() )
+    const auto file = fnx::read_file( file_path );
+    if ( !file.is_open() )
     {
         FNX_ERROR( fnx::format_string( "Unable to load display configuration file %s", file_path ) );
         return mode;
     }
-    ostringstream sout;
-    copy( istreambuf_iterator<char>( in ), istreambuf_iterator<char>(), ostreambuf_iterator<char>( sout ) );
-    serializer<display_mode>::from_yaml( sout.str(), mode );
+    serializer<display_mode>::from_yaml( string( file.view() ), mode );
     return mode;
 }
 }
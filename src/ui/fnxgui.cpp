@@ -3,6 +3,7 @@ namespace fnx
 namespace
 {
 fnx::label_handle fps_label_widget = nullptr;
+fnx::subscription_token debug_ui_token = fnx::invalid_subscription;
 bool update_debug_ui( const render_evt& msg )
 {
     if ( fps_label_widget )
@@ -45,7 +46,7 @@ void enable_debug_ui_output()
             str << "\nFPS (max): " << 0;
             fps_label_widget->set_text( str.str() );
             auto [events, _] = singleton<event_manager>::acquire();
-            events.subscribe<fnx::render_evt>( fnx::bind( &update_debug_ui ) );
+            debug_ui_token = events.subscribe<fnx::render_evt>( fnx::bind( &update_debug_ui ) );
         }
     }
 }
@@ -54,7 +55,8 @@ void disable_debug_ui_output()
 {
     auto [events, _] = singleton<event_manager>::acquire();
     auto [stack, _1] = singleton<layer_stack>::acquire();
-    events.unsubscribe<fnx::render_evt>( fnx::bind( &update_debug_ui ) );
+    events.unsubscribe<fnx::render_evt>( debug_ui_token );
+    debug_ui_token = fnx::invalid_subscription;
     // find the layer we added and remove it
     stack.remove_layer( "debug_layer" );
 }
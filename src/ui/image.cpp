@@ -293,6 +293,19 @@ void image::render( camera_handle camera, matrix4x4 parent_matrix )
         auto [manager, _2] = singleton<asset_manager<material>>::acquire();
         _material = manager.get( "ui_block.material" );
     }
+    if ( _use_atlas && nullptr == _region && _resource_config._attachment == fnx::attachment::None &&
+            _resource_config._format == fnx::format::RGBA && _resource_config._compression == fnx::block_format::none )
+    {
+        // small images share the pages of the atlas, the image keeps its own texture when it is not packed
+        auto [atlas, _2] = singleton<texture_atlas>::acquire();
+        _region = atlas.get( _resource );
+        _use_atlas = nullptr != _region;
+    }
+    if ( nullptr != _region )
+    {
+        _texture = _region->get_texture();
+    }
+    else
     {
         auto [manager, _2] = singleton<asset_manager<texture>>::acquire();
         _texture = manager.get( _resource, _resource_config );
@@ -361,8 +374,6 @@ void image::render( camera_handle camera, matrix4x4 parent_matrix )
                       static_cast<int>( _gradients[static_cast<size_t>( state )].get_values().size() ) );
     material.add_int( UNIFORM_GRADIENT_DIRECTION, static_cast<int>( _gradient_directions[static_cast<size_t>( state )] ) );
 
-    material.add_vector2( UNIFORM_TEXTURE_ATLAS_MAP, fnx::vector2( _texture->atlas_num_cols(),
-                          _texture->atlas_num_rows() ) );
     int idx = _atlas_index[static_cast<int>( get_state() )];
     if ( is_checked() )
     {
@@ -372,11 +383,25 @@ void image::render( camera_handle camera, matrix4x4 parent_matrix )
     {
         idx = _manual_atlas_index;
     }
-    auto atlas_coord = _texture->calc_atlas_offset( idx );
-    // convert the pixel coordinate to uv coordinate
-    atlas_coord.x = ( atlas_coord.x / _texture->width() );
-    atlas_coord.y = ( atlas_coord.y / _texture->height() );
-    material.add_vector2( UNIFORM_TEXTURE_ATLAS_OFFSET, atlas_coord );
+    if ( nullptr != _region )
+    {
+        // the tiles of the image are a part of the page
+        const auto& uv_scale = _region->get_uv_scale();
+        material.add_vector2( UNIFORM_TEXTURE_ATLAS_MAP, fnx::vector2( _resource_config._cols / uv_scale.x,
+                              _resource_config._rows / uv_scale.y ) );
+        material.add_vector2( UNIFORM_TEXTURE_ATLAS_OFFSET, _region->calc_atlas_offset( static_cast<unsigned char>( idx ),
+                              _resource_config._rows, _resource_config._cols ) );
+    }
+    else
+    {
+        material.add_vector2( UNIFORM_TEXTURE_ATLAS_MAP, fnx::vector2( _texture->atlas_num_cols(),
+                              _texture->atlas_num_rows() ) );
+        auto atlas_coord = _texture->calc_atlas_offset( idx );
+        // convert the pixel coordinate to uv coordinate
+        atlas_coord.x = ( atlas_coord.x / _texture->width() );
+        atlas_coord.y = ( atlas_coord.y / _texture->height() );
+        material.add_vector2( UNIFORM_TEXTURE_ATLAS_OFFSET, atlas_coord );
+    }
 
     auto gradient = _gradients[static_cast<size_t>( state )].get_values();
     std::for_each( std::begin( gradient ), std::end( gradient ), [this]( fnx::vector4 & v )
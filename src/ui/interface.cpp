@@ -18,15 +18,13 @@ bool init()
 void parse_yaml_file( const std::string& file_path )
 {
     auto [stack, _] = singleton<layer_stack>::acquire();
-    ifstream in( file_path );
-    if ( !in.good() )
+    const auto file = fnx::read_file( file_path );
+    if ( !file.is_open() )
     {
         FNX_ERROR( fnx::format_string( "Unable to load ui configuration file %s", file_path ) );
         return;
     }
-    ostringstream sout;
-    copy( istreambuf_iterator<char>( in ), istreambuf_iterator<char>(), ostreambuf_iterator<char>( sout ) );
-    layer_serializer().deserialize( stack, sout.str() );
+    layer_serializer().deserialize( stack, string( file.view() ) );
 }
 }
 }
\ No newline at end of file
@@ -11,12 +11,15 @@ layer::layer( const std::string& name )
     _root->inactivate();
     _root->set_visibility( false );
     auto [events, _] = singleton<event_manager>::acquire();
-    events.subscribe<widget_active_evt>( fnx::bind( *this, &layer::on_widget_active ) );
-    events.subscribe<widget_inactive_evt>( fnx::bind( *this, &layer::on_widget_inactive ) );
+    _active_token = events.subscribe<widget_active_evt>( fnx::bind( *this, &layer::on_widget_active ) );
+    _inactive_token = events.subscribe<widget_inactive_evt>( fnx::bind( *this, &layer::on_widget_inactive ) );
 }
 
 layer::~layer()
 {
+    auto [events, _] = singleton<event_manager>::acquire();
+    events.unsubscribe<widget_active_evt>( _active_token );
+    events.unsubscribe<widget_inactive_evt>( _inactive_token );
 }
 
 bool layer::on_widget_active( const widget_active_evt& evt )
@@ -303,9 +303,9 @@ void widget::add_widget( fnx::widget_handle widget )
     }
 }
 
-std::unordered_map<widget_id, widget_handle>& get_widget_map()
+fnx::flat_map<widget_id, widget_handle>& get_widget_map()
 {
-    static std::unordered_map<widget_id, widget_handle> map;
+    static fnx::flat_map<widget_id, widget_handle> map;
     return map;
 }
 
@@ -62,4 +62,166 @@ TEST(containers, bitset)
     EXPECT_TRUE(container.is_set(0));
     EXPECT_FALSE(container.is_set(1));
     EXPECT_TRUE(container.is_set(2));
-}
\ No newline at end of file
+}
+TEST(containers, bitset_words)
+{
+    fnx::bitset<130> container;
+    container.set();
+    EXPECT_EQ(130, container.count());
+    EXPECT_TRUE(container.all());
+    EXPECT_EQ(container.npos, container.find_first_unset());
+
+    container.reset();
+    EXPECT_TRUE(container.none());
+    EXPECT_EQ(container.npos, container.find_first_set());
+
+    container.set_range(60, 70);
+    EXPECT_EQ(10, container.count());
+    EXPECT_EQ(60, container.find_first_set());
+    EXPECT_EQ(65, container.find_first_set(65));
+    EXPECT_EQ(70, container.find_first_unset(60));
+
+    container.unset_range(62, 129);
+    EXPECT_EQ(2, container.count());
+
+    container.set(129);
+    size_t total = 0;
+    container.for_each_set([&](size_t index) { total += index; });
+    EXPECT_EQ(60 + 61 + 129, total);
+}
+
+TEST(containers, bitset_includes)
+{
+    fnx::bitset<70> set;
+    fnx::bitset<70> subset;
+    set.set(1).set(68);
+    subset.set(68);
+    EXPECT_TRUE(fnx::includes(set, subset));
+    subset.set(2);
+    EXPECT_FALSE(fnx::includes(set, subset));
+}
+
+TEST(containers, flat_map)
+{
+    fnx::flat_map<int, int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(map.find(1) == map.end());
+    for (auto i = 0; i < 1000; ++i)
+    {
+        map[i * 64] = i;
+    }
+    EXPECT_EQ(1000, map.size());
+    for (auto i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(i, map.at(i * 64));
+    }
+    EXPECT_FALSE(map.try_emplace(0, 5).second);
+    EXPECT_EQ(0, map[0]);
+
+    // remove every other element and make sure the shifted elements can still be found
+    for (auto i = 0; i < 1000; i += 2)
+    {
+        EXPECT_EQ(1, map.erase(i * 64));
+    }
+    EXPECT_EQ(0, map.erase(0));
+    EXPECT_EQ(500, map.size());
+    for (auto i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(i % 2 == 1, map.contains(i * 64));
+    }
+
+    auto total = 0;
+    for (const auto& pair : map)
+    {
+        total += pair.second;
+    }
+    EXPECT_EQ(250000, total);
+
+    auto copy = map;
+    for (auto it = map.begin(); it != map.end();)
+    {
+        it = map.erase(it);
+    }
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(500, copy.size());
+}
+
+TEST(containers, flat_map_heterogeneous)
+{
+    fnx::flat_map<std::string, int> map;
+    map["diffuse"] = 1;
+    map[std::string_view("specular")] = 2;
+    map.emplace(std::piecewise_construct, std::forward_as_tuple("normal"), std::forward_as_tuple(3));
+    const char* key = "specular";
+    EXPECT_EQ(2, map.find(key)->second);
+    EXPECT_EQ(1, map.count(std::string_view("diffuse")));
+    EXPECT_EQ(3, map.at("normal"));
+    EXPECT_FALSE(map.contains("ambient"));
+
+    fnx::flat_map<std::string, std::unique_ptr<int>> owners;
+    owners.try_emplace("a", std::make_unique<int>(4));
+    auto moved = std::move(owners);
+    EXPECT_EQ(4, *moved["a"]);
+    EXPECT_TRUE(owners.empty());
+}
+
+namespace
+{
+/// @brief Puts the keys starting with b a few slots after the other keys, at any capacity.
+struct adjacent_hash
+{
+    size_t operator()(const std::string& key) const
+    {
+        // multiplied by the fibonacci constant of flat_map the hash of b keys becomes 2^58
+        uint64_t inverse = 11400714819323198485ull;
+        for (int i = 0; i < 6; ++i)
+        {
+            inverse *= 2u - 11400714819323198485ull * inverse;
+        }
+        return key[0] == 'b' ? static_cast<size_t>((uint64_t{1} << 58) * inverse) : 0u;
+    }
+};
+
+std::string make_key(char group, int i)
+{
+    return std::string(1, group) + " key too long for the small string buffer " + std::to_string(i);
+}
+}
+
+TEST(containers, flat_map_grow_while_shifting)
+{
+    fnx::flat_map<std::string, int, adjacent_hash> map;
+    for (auto i = 0; i < 200; ++i)
+    {
+        map[make_key('b', i)] = i;
+    }
+    // each a key pushes the b keys a slot further from their bucket, so the table grows while shifting them
+    for (auto i = 0; i < 200; ++i)
+    {
+        auto key = make_key('a', i);
+        map[std::move(key)] = -i;
+    }
+    EXPECT_EQ(400, map.size());
+    for (auto i = 0; i < 200; ++i)
+    {
+        EXPECT_EQ(i, map.at(make_key('b', i)));
+        EXPECT_EQ(-i, map.at(make_key('a', i)));
+    }
+
+    // growing can't separate keys of the same hash
+    fnx::flat_map<std::string, int, adjacent_hash> same;
+    auto thrown = false;
+    try
+    {
+        for (auto i = 0; i < 300; ++i)
+        {
+            same[make_key('a', i)] = i;
+        }
+    }
+    catch (const std::length_error&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    EXPECT_EQ(254, same.size());
+}
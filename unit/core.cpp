@@ -1,3 +1,8 @@
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <thread>
+#include <tuple>
 #include "test.hpp"
 #include "fnx/fnx.hpp"
 
@@ -13,6 +18,23 @@ TEST(id_manager, reclaim)
 	EXPECT_EQ(2, id_manager.available().size());
 }
 
+TEST(id_manager, lowest_free)
+{
+    fnx::id_manager<unsigned int, 100> id_manager;
+    for (auto i = 0u; i < 100; ++i)
+    {
+        EXPECT_EQ(i, id_manager.get_handle());
+    }
+    EXPECT_EQ(id_manager.invalid_id, id_manager.get_handle());
+    id_manager.reclaim(70);
+    id_manager.reclaim(5);
+    EXPECT_EQ(2, id_manager.num_available());
+    EXPECT_EQ(5, id_manager.get_handle());
+    EXPECT_EQ(70, id_manager.get_handle());
+    id_manager.reclaim_all();
+    EXPECT_EQ(0, id_manager.get_handle());
+}
+
 TEST(singleton, simple)
 {
     {
@@ -42,4 +64,1350 @@ TEST(tween, float)
     EXPECT_ALMOST_EQ(3.3f, val.get(.33));
     EXPECT_ALMOST_EQ(5.f, val.get(.5));
     EXPECT_ALMOST_EQ(10.f, val.get(1.0));
-}
\ No newline at end of file
+}
+
+TEST(tween, baked)
+{
+    // uneven spacing so that the knots fall between samples
+    auto val = fnx::tween<float>(0.f, 10.f, 2.f, 7.f, 7.5f);
+    for (auto resolution : {5u, 17u, 64u, 256u})
+    {
+        val.bake(resolution);
+        EXPECT_EQ(resolution, val.get_resolution());
+        auto bound = val.max_bake_error();
+        if ((resolution - 1) % 4 == 0)
+        {
+            EXPECT_EQ(0.0, bound);
+        }
+        for (auto i = 0; i <= 1000; ++i)
+        {
+            auto t = i / 1000.0;
+            EXPECT_GTE(bound + 1e-5, std::abs(val.get_exact(t) - val.get(t)));
+        }
+    }
+
+    val.add(1.f);
+    EXPECT_EQ(256u, val.get_resolution());
+    EXPECT_ALMOST_EQ(1.f, val.get(1.0));
+    EXPECT_ALMOST_EQ(0.f, val.get(-1.0));
+
+    val.unbake();
+    EXPECT_FALSE(val.is_baked());
+    EXPECT_EQ(0.0, val.max_bake_error());
+}
+
+TEST(tween, batch)
+{
+    auto gradient = fnx::tween<fnx::vector4>(fnx::vector4(1.f, 0.f, 0.f, 1.f), fnx::vector4(0.f, 1.f, 0.f, 1.f),
+                                             fnx::vector4(0.f, 0.f, 1.f, .5f));
+    std::vector<float> t;
+    for (auto i = 0; i < 150; ++i)
+    {
+        t.emplace_back(i / 149.f);
+    }
+    std::vector<fnx::vector4> exact(t.size()), baked(t.size());
+    gradient.get(t, exact);
+    gradient.bake(257u);
+    gradient.get(t, baked);
+    for (size_t i = 0; i < t.size(); ++i)
+    {
+        EXPECT_GTE(1e-5f, (exact[i] - baked[i]).length());
+        EXPECT_GTE(1e-5f, (gradient.get(t[i]) - baked[i]).length());
+    }
+
+    auto fade = fnx::tween<float>(0.f, 1.f);
+    fade.bake();
+    std::vector<const fnx::tween<float>*> tweens(t.size(), &fade);
+    std::vector<float> faded(t.size());
+    fnx::evaluate<float>(tweens, t, faded);
+    for (size_t i = 0; i < t.size(); ++i)
+    {
+        EXPECT_ALMOST_EQ(t[i], faded[i]);
+    }
+}
+TEST(dispatcher, tokens)
+{
+    fnx::dispatcher<int> d;
+    int first = 0, second = 0;
+    auto a = d.subscribe([&first](const int& v) { first += v; return false; });
+    auto b = d.subscribe([&second](const int& v) { second += v; return false; });
+    EXPECT_NE(a, b);
+    EXPECT_EQ(2, d.count());
+
+    d.trigger_immediate(1, false);
+    d.unsubscribe(a);
+    d.trigger_immediate(1, false);
+    EXPECT_EQ(1, first);
+    EXPECT_EQ(2, second);
+    EXPECT_EQ(1, d.count());
+}
+
+TEST(dispatcher, unsubscribe_while_emitting)
+{
+    fnx::dispatcher<int> d;
+    int calls = 0;
+    fnx::subscription_token token = fnx::invalid_subscription;
+    // long enough to live on the heap, reading it after the subscriber is destroyed would be a use after free
+    std::string name = "first subscriber of the dispatcher";
+    std::string seen;
+    token = d.subscribe([&, name](const int&) { calls++; d.unsubscribe(token); seen = name; return false; });
+    d.subscribe([&](const int&) { calls++; return false; });
+
+    d.trigger_immediate(0, false);
+    EXPECT_EQ(2, calls);
+    EXPECT_EQ(1, d.count());
+    EXPECT_EQ(name, seen);
+    d.trigger_immediate(0, false);
+    EXPECT_EQ(3, calls);
+}
+
+TEST(string_id, hashing)
+{
+    using namespace fnx::literals;
+    constexpr fnx::string_id literal("ui_scale");
+    EXPECT_EQ(literal, "ui_scale"_sid);
+    EXPECT_EQ(literal, fnx::string_id(std::string("ui_scale")));
+    EXPECT_NE(literal, fnx::string_id("ui_scales"));
+    EXPECT_FALSE(fnx::string_id().is_valid());
+}
+
+TEST(string_id, intern)
+{
+    auto runtime = std::string("material_") + std::to_string(42);
+    auto id = fnx::intern(runtime);
+    EXPECT_EQ(runtime, id.str());
+    EXPECT_EQ(runtime, fnx::to_string(id));
+    EXPECT_TRUE(fnx::string_id("never interned").str().empty());
+}
+
+namespace
+{
+struct sized_asset : public fnx::asset
+{
+    sized_asset( const std::string& name, size_t bytes = 100u ) : asset( name ), _bytes( bytes ) {}
+
+    size_t get_memory_usage() const override
+    {
+        return _bytes;
+    }
+
+    size_t _bytes;
+};
+
+size_t num_destroyed = 0u;
+
+/// @brief Releases its memory in the destructor, like texture deletes its GL objects.
+struct released_asset : public sized_asset
+{
+    using sized_asset::sized_asset;
+
+    ~released_asset() override
+    {
+        num_destroyed++;
+    }
+};
+}
+
+TEST(asset_manager, budget_evicts_least_recently_used)
+{
+    fnx::asset_manager<sized_asset> manager;
+    manager.set_budget(250u);
+    auto a = manager.get("a");
+    manager.get("b");
+    manager.get("c");
+    EXPECT_EQ(200u, manager.memory_usage());
+    EXPECT_EQ(1u, manager.num_evictions());
+    EXPECT_TRUE(nullptr == manager.find(fnx::string_id("b")).get());
+
+    // referenced assets are kept even when they are the least recently used
+    EXPECT_TRUE(nullptr != manager.find(fnx::string_id("a")).get());
+
+    manager.get("b");
+    EXPECT_EQ(1u, manager.num_reloads());
+    EXPECT_EQ(2u, manager.num_evictions());
+    EXPECT_TRUE(nullptr == manager.find(fnx::string_id("c")).get());
+}
+
+TEST(asset_manager, eviction_order)
+{
+    fnx::asset_manager<sized_asset> manager;
+    for (auto name : {"a", "b", "c", "d", "e"})
+    {
+        manager.get(name);
+    }
+    // used again, so they are evicted last and in this order
+    manager.get("b");
+    auto held = manager.get("a");
+    manager.get("d");
+    manager.set_budget(300u);
+    EXPECT_TRUE(nullptr == manager.find(fnx::string_id("c")).get());
+    EXPECT_TRUE(nullptr == manager.find(fnx::string_id("e")).get());
+    manager.set_budget(200u);
+    EXPECT_TRUE(nullptr == manager.find(fnx::string_id("b")).get());
+    manager.set_budget(100u);
+    EXPECT_TRUE(nullptr == manager.find(fnx::string_id("d")).get());
+    EXPECT_TRUE(nullptr != manager.find(fnx::string_id("a")).get());
+    EXPECT_EQ(4u, manager.num_evictions());
+}
+
+TEST(asset_manager, eviction_destroys)
+{
+    fnx::asset_manager<released_asset> manager;
+    num_destroyed = 0u;
+    manager.get("a");
+    auto held = manager.get("b");
+    manager.set_budget(100u);
+    EXPECT_EQ(1u, manager.num_evictions());
+    EXPECT_EQ(1u, num_destroyed);
+    held.reset();
+    manager.set_budget(1u);
+    EXPECT_EQ(2u, num_destroyed);
+}
+
+TEST(asset_manager, refresh_after_filling)
+{
+    fnx::asset_manager<sized_asset> manager;
+    auto a = manager.get("a");
+    a->_bytes = 300u;
+    EXPECT_EQ(100u, manager.memory_usage());
+    manager.refresh(fnx::string_id("a"));
+    EXPECT_EQ(300u, manager.memory_usage());
+    manager.refresh(fnx::string_id("missing"));
+    EXPECT_EQ(300u, manager.memory_usage());
+}
+
+TEST(asset_manager, global_budget)
+{
+    auto [budget, _] = fnx::singleton<fnx::asset_budget>::acquire();
+    fnx::asset_manager<sized_asset> first;
+    fnx::asset_manager<sized_asset> second;
+    auto base = budget.memory_usage();
+    budget.set_budget(base + 150u);
+    first.get("a");
+    second.get("b");
+    EXPECT_EQ(1u, first.num_evictions());
+    EXPECT_EQ(0u, second.num_evictions());
+    EXPECT_EQ(base + 100u, budget.memory_usage());
+    budget.set_budget(0u);
+}
+
+namespace
+{
+struct staged_asset : public fnx::asset
+{
+    staged_asset(const std::string& name, std::vector<int>&& values) : asset(name), _values(std::move(values)) {}
+
+    std::vector<int> _values;
+};
+
+std::atomic<bool> read_on_main_thread{false};
+const auto main_thread = std::this_thread::get_id();
+}
+
+namespace fnx
+{
+template<>
+struct asset_staging<staged_asset>
+{
+    using staged = std::vector<int>;
+
+    static staged read(const std::string&, int count)
+    {
+        read_on_main_thread = read_on_main_thread || std::this_thread::get_id() == main_thread;
+        if (count < 0)
+        {
+            throw std::runtime_error("negative count");
+        }
+        return staged(static_cast<size_t>(count), 7);
+    }
+
+    static fnx::asset_handle<staged_asset> create(const std::string& name, staged&& values, int)
+    {
+        return fnx::make_shared_ref<staged_asset>(name, std::move(values));
+    }
+};
+}
+
+TEST(asset_manager, get_async)
+{
+    auto [loader, _] = fnx::singleton<fnx::asset_loader>::acquire();
+    fnx::asset_manager<staged_asset> manager;
+    auto a = manager.get_async("a", 3);
+    auto again = manager.get_async("a", 5);
+    auto bad = manager.get_async("bad", -1);
+    size_t calls = 0;
+    fnx::asset_handle<staged_asset> completed;
+    a.on_complete([&](const fnx::asset_handle<staged_asset>& asset) { ++calls; completed = asset; });
+
+    // nothing is created before the main thread asks for it
+    EXPECT_FALSE(a.is_loaded());
+    loader.finish();
+    EXPECT_EQ(0u, loader.num_pending());
+    EXPECT_FALSE(read_on_main_thread);
+    ASSERT_TRUE(a.is_loaded());
+    EXPECT_EQ(3u, a.get()->_values.size());
+    EXPECT_TRUE(a.get().get() == again.get().get());
+    EXPECT_EQ(1u, calls);
+    EXPECT_TRUE(completed.get() == a.get().get());
+    EXPECT_TRUE(fnx::load_state::failed == bad.get_state());
+    EXPECT_TRUE(nullptr == bad.get().get());
+
+    // loaded assets are handed out right away
+    auto loaded = manager.get_async("a", 1);
+    EXPECT_TRUE(loaded.is_loaded());
+    EXPECT_TRUE(manager.find(fnx::string_id("a")).get() == a.get().get());
+    loaded.on_complete([&](const fnx::asset_handle<staged_asset>&) { ++calls; });
+    EXPECT_EQ(2u, calls);
+
+    // a budget of zero still creates one asset per update
+    for (int i = 0; i < 3; ++i)
+    {
+        manager.get_async("b" + std::to_string(i), 1);
+    }
+    size_t created = 0;
+    while (created < 3)
+    {
+        const auto count = loader.update(std::chrono::microseconds(0));
+        EXPECT_GTE(1u, count);
+        created += count;
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(4u, manager.count());
+}
+
+TEST(upload_queue, oversized_first_upload)
+{
+    fnx::upload_queue uploads;
+    std::vector<std::shared_ptr<fnx::gpu_upload>> pending;
+    pending.emplace_back(uploads.push(10u << 20, []() {}));
+    for (int i = 0; i < 5; ++i)
+    {
+        pending.emplace_back(uploads.push(3u << 20, []() {}));
+    }
+    // the first upload runs on its own and leaves no budget for the others
+    auto stats = uploads.update(4u << 20, std::chrono::hours(1));
+    EXPECT_EQ(1u, stats.uploads);
+    EXPECT_EQ(10u << 20, stats.bytes);
+    EXPECT_EQ(5u, stats.depth);
+    stats = uploads.update(4u << 20, std::chrono::hours(1));
+    EXPECT_EQ(1u, stats.uploads);
+    EXPECT_EQ(4u, stats.depth);
+}
+
+TEST(upload_queue, budget)
+{
+    fnx::upload_queue uploads;
+    std::vector<int> order;
+    auto a = uploads.push(100, [&]() { order.emplace_back(0); });
+    auto b = uploads.push(100, [&]() { order.emplace_back(1); });
+    auto c = uploads.push(500, [&]() { order.emplace_back(2); });
+    auto d = uploads.push(100, [&]() { order.emplace_back(3); });
+    EXPECT_EQ(4u, uploads.get_queue_depth());
+
+    // bound for drawing, so it goes ahead of the others
+    d->set_priority(fnx::upload_priority::visible);
+    auto stats = uploads.update(250, std::chrono::hours(1));
+    EXPECT_EQ(2u, stats.uploads);
+    EXPECT_EQ(200u, stats.bytes);
+    EXPECT_EQ(2u, stats.depth);
+    EXPECT_EQ(600u, stats.queued_bytes);
+    ASSERT_EQ(2u, order.size());
+    EXPECT_EQ(3, order[0]);
+    EXPECT_EQ(0, order[1]);
+    EXPECT_TRUE(d->is_done());
+    EXPECT_FALSE(b->is_done());
+
+    // one upload runs even when it is larger than the budget
+    b.reset();
+    stats = uploads.update(10, std::chrono::hours(1));
+    EXPECT_EQ(1u, stats.uploads);
+    EXPECT_EQ(500u, stats.bytes);
+    EXPECT_EQ(0u, stats.depth);
+    EXPECT_EQ(3u, order.size());
+    EXPECT_EQ(2, order.back());
+
+    // released assets cancel their upload
+    EXPECT_EQ(0u, uploads.update().uploads);
+    EXPECT_EQ(0u, uploads.get_queue_depth());
+
+    for (int i = 0; i < 8; ++i)
+    {
+        a = uploads.push(1000, [&]() { order.emplace_back(4); });
+        c = uploads.push(1000, [&]() { order.emplace_back(4); });
+    }
+    stats = uploads.flush();
+    EXPECT_EQ(2u, stats.uploads);
+    EXPECT_EQ(0u, stats.depth);
+    EXPECT_EQ(5u, order.size());
+    EXPECT_GTE(uploads.get_total_stall().count(), stats.stall.count());
+}
+
+namespace
+{
+void expect_matrix_near(const fnx::matrix4x4& expected, const fnx::matrix4x4& actual, fnx::decimal tolerance = 1e-4f)
+{
+    for (auto i = 0; i < 16; ++i)
+    {
+        EXPECT_GTE(tolerance * std::max(fnx::decimal{1}, std::abs(expected.data()[i])),
+                   std::abs(expected.data()[i] - actual.data()[i]));
+    }
+}
+}
+
+TEST(camera, perspective_matrices)
+{
+    fnx::perspective_camera camera(fnx::angle{fnx::Degree(90.0)}, 1.f, 1.f, 100.f);
+    camera.set_position(1.f, 2.f, 3.f);
+    camera.set_front(0.f, 0.f, -1.f);
+    camera.set_up(fnx::vector3{0.f, 1.f, 0.f});
+    const auto& view = camera.get_view_matrix();
+    const auto& projection = camera.get_projection_matrix();
+    expect_matrix_near(fnx::matrix_look_at(fnx::vector3{1.f, 2.f, 3.f}, fnx::vector3{1.f, 2.f, 2.f}, fnx::vector3{0.f, 1.f, 0.f}), view);
+    expect_matrix_near(fnx::matrix_perspective(fnx::angle{fnx::Degree(90.0)}, 1.f, 1.f, 100.f), projection);
+    expect_matrix_near(view * projection, camera.get_view_projection_matrix());
+    expect_matrix_near(fnx::matrix4x4::identity(), view * camera.get_inverse_view_matrix());
+    expect_matrix_near(fnx::matrix4x4::identity(), projection * camera.get_inverse_projection_matrix());
+    expect_matrix_near(fnx::matrix4x4::identity(), camera.get_view_projection_matrix() * camera.get_inverse_view_projection_matrix());
+
+    // camera matrices are in OpenGL column order, transposed they map column vectors
+    auto eye = fnx::matrix_transpose(view) * fnx::vector4(1.f, 2.f, 3.f, 1.f);
+    EXPECT_ALMOST_EQ(0.f, eye.x);
+    EXPECT_ALMOST_EQ(0.f, eye.y);
+    EXPECT_ALMOST_EQ(0.f, eye.z);
+    auto clip = fnx::matrix_transpose(camera.get_view_projection_matrix()) * fnx::vector4(1.f, 2.f, -7.f, 1.f);
+    EXPECT_ALMOST_EQ(0.f, clip.x / clip.w);
+    EXPECT_ALMOST_EQ(0.f, clip.y / clip.w);
+    EXPECT_LT(-1.f, clip.z / clip.w);
+    EXPECT_GT(1.f, clip.z / clip.w);
+}
+
+TEST(camera, ortho_matrices)
+{
+    fnx::ortho_camera camera(2.f);
+    expect_matrix_near(fnx::matrix_ortho(-2.f, 2.f, -1.f, 1.f), camera.get_projection_matrix());
+    camera.set_position(3.f, 4.f, 0.f);
+    const auto& view = camera.get_view_matrix();
+    auto origin = view * fnx::vector4(3.f, 4.f, 0.f, 1.f);
+    EXPECT_ALMOST_EQ(0.f, origin.x);
+    EXPECT_ALMOST_EQ(0.f, origin.y);
+    expect_matrix_near(view * camera.get_projection_matrix(), camera.get_view_projection_matrix());
+    expect_matrix_near(fnx::matrix4x4::identity(), view * camera.get_inverse_view_matrix());
+    expect_matrix_near(fnx::matrix4x4::identity(), camera.get_view_projection_matrix() * camera.get_inverse_view_projection_matrix());
+
+    camera.set_aspect_ratio(1.f);
+    expect_matrix_near(fnx::matrix_ortho(-1.f, 1.f, -1.f, 1.f), camera.get_projection_matrix());
+}
+
+TEST(camera, version)
+{
+    fnx::ortho_camera camera;
+    fnx::ortho_camera other;
+    EXPECT_NE(camera.get_version(), other.get_version());
+    auto version = camera.get_version();
+    camera.get_view_projection_matrix();
+    EXPECT_EQ(version, camera.get_version());
+
+    // a change gives a new version and the matrices follow on the next read
+    camera.set_position(5.f, 0.f, 0.f);
+    EXPECT_NE(version, camera.get_version());
+    auto moved = camera.get_view_matrix() * fnx::vector4(5.f, 0.f, 0.f, 1.f);
+    EXPECT_ALMOST_EQ(0.f, moved.x);
+
+    fnx::ortho_camera copy = camera;
+    EXPECT_EQ(camera.get_version(), copy.get_version());
+    copy.rotate_z(fnx::angle{fnx::Degree(90.0)});
+    EXPECT_NE(camera.get_version(), copy.get_version());
+}
+
+TEST(obj_parser, faces)
+{
+    const char* text =
+        "# comment\n"
+        "mtllib first.mtl\n"
+        "v 0 0 0\n"
+        "v 1 0 0\n"
+        "v 1 1 0\n"
+        "v 0 1 +0\r\n"
+        "vt 0 0\n"
+        "vt 1 0\n"
+        "vt 1 1\n"
+        "vn 0 0 -1\n"
+        "o quad\n"
+        "usemtl red\n"
+        "f 1/1/1 2/2/1 3/3/1 4/3/1\n"
+        "o triangle\n"
+        "f -4 -3 -2\n"
+        "usemtl blue\n"
+        "f 1//1 3//1 4//1\n"
+        "f 1/1 2/x 3/1\n";
+    auto data = fnx::parse_obj(text);
+    ASSERT_EQ(3u, data.objects.size());
+    ASSERT_EQ(1u, data.material_libraries.size());
+    EXPECT_EQ(std::string("first.mtl"), data.material_libraries[0]);
+    EXPECT_TRUE(data.objects[0].name.empty());
+    EXPECT_TRUE(data.objects[0].vertices.empty());
+
+    // the quad is split into two triangles of position, uv and normal
+    const auto& quad = data.objects[1];
+    EXPECT_EQ(std::string("quad"), quad.name);
+    EXPECT_TRUE(quad.has_texture && quad.has_normal);
+    ASSERT_EQ(6u * 8u, quad.vertices.size());
+    const float third[] = {1.f, 1.f, 0.f, 1.f, 1.f, 0.f, 0.f, -1.f};
+    EXPECT_EQ(0, std::memcmp(third, &quad.vertices[2 * 8], sizeof(third)));
+    EXPECT_EQ(0, std::memcmp(&quad.vertices[0], &quad.vertices[3 * 8], 8 * sizeof(float)));
+    ASSERT_EQ(1u, quad.materials.size());
+    EXPECT_EQ(0, quad.materials.get_all()[0]._start);
+    EXPECT_EQ(6, quad.materials.get_all()[0]._end);
+    EXPECT_ALMOST_EQ(1.f, static_cast<float>(quad.aabb.getMax().y));
+
+    // relative indices, computed normals and the malformed face is skipped
+    const auto& triangle = data.objects[2];
+    EXPECT_FALSE(triangle.has_texture);
+    ASSERT_EQ(6u * 6u, triangle.vertices.size());
+    EXPECT_ALMOST_EQ(1.f, triangle.vertices[6]);
+    EXPECT_ALMOST_EQ(1.f, triangle.vertices[5]);
+    EXPECT_ALMOST_EQ(-1.f, triangle.vertices[3 * 6 + 5]);
+    ASSERT_EQ(1u, triangle.materials.size());
+    EXPECT_EQ(0, triangle.materials.get_all()[0]._start);
+    EXPECT_EQ(3, triangle.materials.get_all()[0]._end);
+}
+
+TEST(obj_parser, missing_file)
+{
+    EXPECT_FALSE(fnx::mapped_file("missing.obj").is_open());
+    bool thrown = false;
+    try
+    {
+        fnx::load_obj("missing.obj");
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+}
+
+TEST(obj_parser, threads)
+{
+    // objects, materials, relative indices and malformed records spread over many lines
+    std::string text = "mtllib a.mtl\nv 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 3\n";
+    for (int i = 0; i < 60; ++i)
+    {
+        auto n = std::to_string(i);
+        text += "v " + n + " 0 1\nv " + n + " 1 1\nvt 0." + n + " 1\nvn 0 1 0\nv bad\n";
+        text += i % 7 == 0 ? "o part" + n + "\n" : "";
+        text += i % 5 == 0 ? "usemtl m" + n + "\n" : "";
+        text += i % 3 == 0 ? "f -1/-1/-1 -2/-1/-1 1/-1/-1\n" : "f -1 -2 2 3\n";
+        text += i % 11 == 0 ? "mtllib b" + n + ".mtl\nf 1 2 99\n" : "";
+    }
+    auto expected = fnx::parse_obj(text);
+    EXPECT_EQ(10u, expected.objects.size());
+    for (size_t threads = 2; threads <= 16; ++threads)
+    {
+        auto data = fnx::parse_obj(text, threads);
+        EXPECT_TRUE(expected.material_libraries == data.material_libraries);
+        ASSERT_EQ(expected.objects.size(), data.objects.size());
+        for (size_t i = 0; i < data.objects.size(); ++i)
+        {
+            const auto& a = expected.objects[i];
+            const auto& b = data.objects[i];
+            EXPECT_EQ(a.name, b.name);
+            EXPECT_TRUE(a.vertices == b.vertices);
+            EXPECT_EQ(a.has_texture, b.has_texture);
+            EXPECT_TRUE(a.aabb.getMin() == b.aabb.getMin() && a.aabb.getMax() == b.aabb.getMax());
+            ASSERT_EQ(a.materials.size(), b.materials.size());
+            for (size_t m = 0; m < a.materials.size(); ++m)
+            {
+                EXPECT_EQ(a.materials.get_all()[m]._material_name, b.materials.get_all()[m]._material_name);
+                EXPECT_EQ(a.materials.get_all()[m]._start, b.materials.get_all()[m]._start);
+                EXPECT_EQ(a.materials.get_all()[m]._end, b.materials.get_all()[m]._end);
+            }
+        }
+    }
+}
+
+TEST(hash, bytes)
+{
+    // XXH64 reference values, the longer input goes through the four lanes
+    EXPECT_EQ(0xef46db3751d8e999ull, fnx::hash_bytes("", 0));
+    EXPECT_EQ(0x44bc2cf5ad770999ull, fnx::hash_bytes("abc", 3));
+    const std::string text = "Nobody inspects the spammish repetition";
+    EXPECT_EQ(0xfbcea83c8a378bf1ull, fnx::hash_bytes(text.data(), text.size()));
+    EXPECT_NE(fnx::hash_bytes(text.data(), text.size()), fnx::hash_bytes(text.data(), text.size(), 1u));
+}
+
+TEST(mesh_optimizer, index_vertices)
+{
+    // a quad of two triangles sharing an edge, stride of position and uv
+    const float quad[] = {0, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 1, 1, 0, 1, 1};
+    auto indexed = fnx::index_vertices(quad, 6, 5);
+    EXPECT_EQ(4u * 5u, indexed.vertices.size());
+    ASSERT_EQ(6u, indexed.get_num_indices());
+    EXPECT_TRUE(indexed.indices_32.empty());
+    const unsigned short expected[] = {0, 1, 2, 2, 1, 3};
+    EXPECT_EQ(0, std::memcmp(expected, indexed.indices.data(), sizeof(expected)));
+
+    // indices switch to 32 bits past 65535 distinct vertices
+    std::vector<float> strip;
+    for (size_t i = 0; i <= fnx::max_vertices_16; ++i)
+    {
+        strip.insert(strip.end(), {static_cast<float>(i), 0.f, 0.f});
+    }
+    indexed = fnx::index_vertices(strip.data(), fnx::max_vertices_16 + 1, 3);
+    EXPECT_TRUE(indexed.indices.empty());
+    ASSERT_EQ(fnx::max_vertices_16 + 1, indexed.indices_32.size());
+    EXPECT_EQ(fnx::max_vertices_16, indexed.indices_32.back());
+    EXPECT_TRUE(strip == indexed.vertices);
+}
+
+TEST(mesh_optimizer, optimize_mesh)
+{
+    // a 32x32 quad grid of position only vertices with its triangles shuffled
+    const size_t side = 33;
+    fnx::indexed_vertices mesh;
+    for (size_t i = 0; i < side * side; ++i)
+    {
+        mesh.vertices.insert(mesh.vertices.end(), {static_cast<float>(i % side), static_cast<float>(i / side), 0.f});
+    }
+    std::vector<std::array<unsigned short, 3>> triangles;
+    for (unsigned short y = 0; y + 1 < side; ++y)
+    {
+        for (unsigned short x = 0; x + 1 < side; ++x)
+        {
+            unsigned short a = y * side + x, b = a + 1, c = a + side, d = c + 1;
+            triangles.push_back({a, b, c});
+            triangles.push_back({c, b, d});
+        }
+    }
+    fnx::rng::default_engine engine(7u);
+    std::shuffle(triangles.begin(), triangles.end(), engine);
+    for (const auto& triangle : triangles)
+    {
+        mesh.indices.insert(mesh.indices.end(), triangle.begin(), triangle.end());
+    }
+    // the first hundred triangles use another material and must stay first
+    fnx::material_map materials;
+    materials.add_material_range("a", 0, 300);
+    materials.add_material_range("b", 300, static_cast<int>(mesh.indices.size()));
+    auto corners = [&](size_t start, size_t end)
+    {
+        std::vector<std::array<float, 9>> result;
+        for (size_t t = start; t < end; t += 3)
+        {
+            std::array<float, 9> triangle;
+            for (size_t k = 0; k < 9; ++k)
+            {
+                triangle[k] = mesh.vertices[mesh.indices[t + k / 3] * 3 + k % 3];
+            }
+            // the first corner may change but not the winding
+            while (std::lexicographical_compare(triangle.begin() + 3, triangle.begin() + 6, triangle.begin(), triangle.begin() + 3))
+            {
+                std::rotate(triangle.begin(), triangle.begin() + 3, triangle.end());
+            }
+            result.push_back(triangle);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    };
+    const auto first = corners(0, 300);
+    const auto rest = corners(300, mesh.indices.size());
+
+    auto report = fnx::optimize_mesh(mesh, 3, materials);
+    EXPECT_TRUE(first == corners(0, 300));
+    EXPECT_TRUE(rest == corners(300, mesh.indices.size()));
+    EXPECT_TRUE(report.input.acmr > 2.f);
+    EXPECT_TRUE(report.vertex_cache.acmr < 0.9f);
+    EXPECT_TRUE(report.overdraw.acmr < report.vertex_cache.acmr * 1.1f);
+    EXPECT_TRUE(report.overdraw.atvr < report.input.atvr);
+    EXPECT_TRUE(report.overfetch <= report.input_overfetch);
+    EXPECT_ALMOST_EQ(report.overdraw.acmr, fnx::analyze_vertex_cache(std::vector<unsigned int>(mesh.indices.begin(), mesh.indices.end()).data(), mesh.indices.size(), side * side).acmr);
+
+    // vertices are stored in the order they are first drawn
+    unsigned short next = 0;
+    for (auto index : mesh.indices)
+    {
+        EXPECT_TRUE(index <= next);
+        next = std::max<unsigned short>(next, index + 1);
+    }
+
+    // four vertices share a fetched line in any order, so they are not renumbered
+    fnx::indexed_vertices small;
+    small.vertices = {0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0};
+    small.indices = {3, 2, 1, 3, 1, 0};
+    const auto vertices = small.vertices;
+    report = fnx::optimize_mesh(small, 3, {});
+    EXPECT_TRUE(vertices == small.vertices);
+    EXPECT_EQ(report.input_overfetch, report.overfetch);
+}
+
+TEST(mesh_optimizer, build_lods)
+{
+    // a flat 32x32 quad grid split into two materials along x = 16
+    const size_t side = 33;
+    fnx::indexed_vertices mesh;
+    for (size_t i = 0; i < side * side; ++i)
+    {
+        mesh.vertices.insert(mesh.vertices.end(), {static_cast<float>(i % side), static_cast<float>(i / side), 0.f});
+    }
+    std::vector<unsigned short> left, right;
+    for (unsigned short y = 0; y + 1 < side; ++y)
+    {
+        for (unsigned short x = 0; x + 1 < side; ++x)
+        {
+            unsigned short a = y * side + x, b = a + 1, c = a + side, d = c + 1;
+            (x < 16 ? left : right).insert((x < 16 ? left : right).end(), {a, b, c, c, b, d});
+        }
+    }
+    mesh.indices = left;
+    mesh.indices.insert(mesh.indices.end(), right.begin(), right.end());
+    fnx::material_map materials;
+    materials.add_material_range("a", 0, static_cast<int>(left.size()));
+    materials.add_material_range("b", static_cast<int>(left.size()), static_cast<int>(mesh.indices.size()));
+    const auto num_indices = mesh.indices.size();
+
+    // twice the signed area and the x extent of a range, both kept while the borders are locked
+    auto measure = [&](size_t start, size_t end)
+    {
+        std::array<float, 3> result{0.f, 1000.f, -1000.f};
+        for (size_t t = start; t < end; t += 3)
+        {
+            const float* p[3];
+            for (size_t k = 0; k < 3; ++k)
+            {
+                p[k] = mesh.vertices.data() + mesh.indices[t + k] * 3;
+                result[1] = std::min(result[1], p[k][0]);
+                result[2] = std::max(result[2], p[k][0]);
+            }
+            result[0] += (p[1][0] - p[0][0]) * (p[2][1] - p[0][1]) - (p[1][1] - p[0][1]) * (p[2][0] - p[0][0]);
+        }
+        return result;
+    };
+
+    auto lods = fnx::build_lods(mesh, 3, materials);
+    ASSERT_EQ(3u, lods.size());
+    EXPECT_EQ(num_indices, lods[0].start);
+    size_t previous = num_indices;
+    for (const auto& lod : lods)
+    {
+        EXPECT_TRUE(lod.end - lod.start <= previous * 6 / 10);
+        EXPECT_EQ(0.f, lod.error);
+        ASSERT_EQ(2u, lod.materials.size());
+        const auto& a = lod.materials.get_all()[0];
+        const auto& b = lod.materials.get_all()[1];
+        EXPECT_EQ(static_cast<int>(lod.start), a._start);
+        EXPECT_EQ(a._end, b._start);
+        EXPECT_EQ(static_cast<int>(lod.end), b._end);
+        EXPECT_TRUE(measure(0, left.size()) == measure(a._start, a._end));
+        EXPECT_TRUE(measure(left.size(), num_indices) == measure(b._start, b._end));
+        previous = lod.end - lod.start;
+    }
+    EXPECT_EQ(lods.back().end, mesh.indices.size());
+
+    // bumps cost error, none are removed when no error is allowed
+    fnx::rng::default_engine engine(7u);
+    for (size_t i = 0; i < side * side; ++i)
+    {
+        mesh.vertices[i * 3 + 2] = fnx::rng::uniform(engine, 0.f, 0.5f);
+    }
+    std::vector<unsigned int> indices(mesh.indices.begin(), mesh.indices.begin() + num_indices);
+    float error = 1.f;
+    EXPECT_EQ(num_indices, fnx::simplify(indices.data(), num_indices, mesh.vertices.data(), side * side, 3, 0, 0.f, &error).size());
+    EXPECT_EQ(0.f, error);
+    EXPECT_TRUE(fnx::simplify(indices.data(), num_indices, mesh.vertices.data(), side * side, 3, 0, 1.f, &error).size() < num_indices / 2);
+    EXPECT_TRUE(error > 0.f && error <= 1.f);
+}
+
+TEST(image_processing, mips)
+{
+    // every level halves the size of the one above, rounded down, down to 1x1
+    std::vector<unsigned char> grey(5 * 3 * 3, 100);
+    for (auto filter : {fnx::mip_filter::box, fnx::mip_filter::kaiser})
+    {
+        fnx::image_options options;
+        options.filter = filter;
+        auto mips = fnx::build_mips(grey.data(), 5, 3, 3, options);
+        ASSERT_EQ(2u, mips.size());
+        EXPECT_EQ(2u, mips[0]._width);
+        EXPECT_EQ(1u, mips[0]._height);
+        EXPECT_EQ(1u, mips[1]._width);
+        EXPECT_EQ(1u, mips[1]._height);
+        for (const auto& mip : mips)
+        {
+            ASSERT_EQ(mip._width * mip._height * 3u, mip._data.size());
+            for (auto value : mip._data)
+            {
+                EXPECT_EQ(100, value);
+            }
+        }
+    }
+
+    // black and white average to half the light, not half the sRGB value
+    const unsigned char black_white[] = {0, 0, 0, 255, 255, 255, 255, 255};
+    fnx::image_options options;
+    options.filter = fnx::mip_filter::box;
+    auto linear = fnx::build_mips(black_white, 2, 1, 4, options);
+    options.srgb = true;
+    auto srgb = fnx::build_mips(black_white, 2, 1, 4, options);
+    ASSERT_EQ(1u, linear.size());
+    ASSERT_EQ(1u, srgb.size());
+    EXPECT_EQ(128, linear[0]._data[0]);
+    EXPECT_EQ(188, srgb[0]._data[0]);
+    EXPECT_EQ(255, srgb[0]._data[3]);
+}
+
+TEST(image_processing, alpha_coverage)
+{
+    constexpr uint32_t size = 64;
+    constexpr float cutoff = 0.8f;
+    fnx::rng::default_engine engine(3u);
+    std::vector<unsigned char> pixels(size * size * 4, 255);
+    for (size_t i = 0; i < size * size; ++i)
+    {
+        pixels[i * 4 + 3] = static_cast<unsigned char>(fnx::rng::uniform(engine, 0.f, 255.f));
+    }
+    const auto coverage = fnx::alpha_coverage(pixels.data(), size * size, cutoff);
+
+    fnx::image_options options;
+    auto faded = fnx::build_mips(pixels.data(), size, size, 4, options);
+    options.alpha_cutoff = cutoff;
+    auto kept = fnx::build_mips(pixels.data(), size, size, 4, options);
+    ASSERT_EQ(6u, kept.size());
+    for (size_t level = 0; level < 3; ++level)
+    {
+        const size_t num_pixels = kept[level]._width * kept[level]._height;
+        EXPECT_GTE(0.05f, std::abs(coverage - fnx::alpha_coverage(kept[level]._data.data(), num_pixels, cutoff)));
+    }
+    // without it the cutout fades out as the random alpha averages towards one half
+    EXPECT_GT(coverage * 0.5f, fnx::alpha_coverage(faded[1]._data.data(), 16 * 16, cutoff));
+
+    // premultiplied white keeps its colors equal to its scaled alpha
+    for (size_t i = 0; i < size * size; ++i)
+    {
+        std::fill_n(pixels.begin() + i * 4, 3, pixels[i * 4 + 3]);
+    }
+    options.premultiply_alpha = true;
+    auto premultiplied = fnx::build_mips(pixels.data(), size, size, 4, options);
+    for (size_t i = 0; i < 16 * 16; ++i)
+    {
+        EXPECT_GTE(1, std::abs(premultiplied[1]._data[i * 4] - premultiplied[1]._data[i * 4 + 3]));
+    }
+}
+
+TEST(image_processing, channels)
+{
+    unsigned char pixels[] = {10, 20, 30, 255, 200, 100, 50, 0};
+    fnx::swizzle_channels(pixels, 2, 4, {{2, 1, 0, 3}});
+    EXPECT_EQ(30, pixels[0]);
+    EXPECT_EQ(20, pixels[1]);
+    EXPECT_EQ(10, pixels[2]);
+    EXPECT_EQ(50, pixels[4]);
+
+    unsigned char half[] = {200, 100, 0, 128};
+    fnx::premultiply_alpha(half, 1, false);
+    EXPECT_EQ(100, half[0]);
+    EXPECT_EQ(50, half[1]);
+    EXPECT_EQ(0, half[2]);
+    EXPECT_EQ(128, half[3]);
+    fnx::premultiply_alpha(pixels, 2, true);
+    EXPECT_EQ(30, pixels[0]);
+    EXPECT_EQ(0, pixels[4]);
+}
+
+TEST(block_compression, formats)
+{
+    // a 4096^2 atlas takes 64 MB as RGBA8, partial blocks take a whole block
+    EXPECT_EQ(64u * 1024u * 1024u, fnx::get_compressed_size(fnx::block_format::none, 4096, 4096));
+    EXPECT_EQ(8u * 1024u * 1024u, fnx::get_compressed_size(fnx::block_format::bc1, 4096, 4096));
+    EXPECT_EQ(16u * 1024u * 1024u, fnx::get_compressed_size(fnx::block_format::bc7, 4096, 4096));
+    EXPECT_EQ(2u * 8u, fnx::get_compressed_size(fnx::block_format::bc4, 5, 3));
+    EXPECT_EQ(16u, fnx::get_compressed_size(fnx::block_format::bc5, 1, 1));
+
+    // smooth gradients with a little noise, like most texture content
+    constexpr uint32_t width = 37;
+    constexpr uint32_t height = 29;
+    fnx::rng::default_engine engine(5u);
+    std::vector<unsigned char> pixels(width * height * 4);
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            auto* pixel = &pixels[(y * width + x) * 4];
+            const auto noise = fnx::rng::uniform(engine, -3.f, 3.f);
+            pixel[0] = static_cast<unsigned char>(std::clamp(x * 6.f + noise, 0.f, 255.f));
+            pixel[1] = static_cast<unsigned char>(std::clamp(y * 8.f - noise, 0.f, 255.f));
+            pixel[2] = static_cast<unsigned char>(std::clamp(200.f - x * 3.f + y * 2.f, 0.f, 255.f));
+            pixel[3] = static_cast<unsigned char>(std::clamp(255.f - x * 2.f - y * 3.f, 0.f, 255.f));
+        }
+    }
+    // colors of a block lie along a line, the gradients across the block are what costs quality
+    const std::tuple<fnx::block_format, uint32_t, float> formats[] = {{fnx::block_format::bc3, 4, 34.f},
+        {fnx::block_format::bc4, 1, 40.f}, {fnx::block_format::bc5, 2, 40.f}, {fnx::block_format::bc7, 4, 35.f}};
+    for (const auto& [format, num_channels, psnr] : formats)
+    {
+        const auto blocks = fnx::compress_blocks(pixels.data(), width, height, format);
+        ASSERT_EQ(fnx::get_compressed_size(format, width, height), blocks.size());
+        const auto decoded = fnx::decompress_blocks(blocks.data(), width, height, format);
+        EXPECT_GT(fnx::compute_psnr(pixels.data(), decoded.data(), width * height, num_channels), psnr);
+    }
+    auto opaque = pixels;
+    for (size_t i = 3; i < opaque.size(); i += 4)
+    {
+        opaque[i] = 255;
+    }
+    const auto bc1 = fnx::compress_blocks(opaque.data(), width, height, fnx::block_format::bc1);
+    const auto decoded = fnx::decompress_blocks(bc1.data(), width, height, fnx::block_format::bc1);
+    EXPECT_GT(fnx::compute_psnr(opaque.data(), decoded.data(), width * height), 34.f);
+
+    // texels of low alpha are transparent black in BC1, the rest stays opaque
+    unsigned char cutout[16 * 4];
+    for (size_t i = 0; i < 16; ++i)
+    {
+        cutout[i * 4] = 255;
+        cutout[i * 4 + 1] = 0;
+        cutout[i * 4 + 2] = 0;
+        cutout[i * 4 + 3] = i % 3 == 0 ? 0 : 255;
+    }
+    const auto cutout_blocks = fnx::compress_blocks(cutout, 4, 4, fnx::block_format::bc1);
+    const auto cutout_decoded = fnx::decompress_blocks(cutout_blocks.data(), 4, 4, fnx::block_format::bc1);
+    for (size_t i = 0; i < 16; ++i)
+    {
+        EXPECT_EQ(cutout[i * 4 + 3], cutout_decoded[i * 4 + 3]);
+        EXPECT_EQ(i % 3 == 0 ? 0 : 255, cutout_decoded[i * 4]);
+    }
+    EXPECT_EQ(100.f, fnx::compute_psnr(cutout, cutout, 16));
+}
+
+TEST(texture_cache, round_trip)
+{
+    // a binary PPM image, which stb_image decodes
+    const std::string path = "texture_cache_test.ppm";
+    const auto cache_path = fnx::get_texture_cache_path(path, 4, {}, fnx::block_format::bc7);
+    std::remove(cache_path.c_str());
+    std::string file = "P6\n20 12\n255\n";
+    for (int i = 0; i < 20 * 12; ++i)
+    {
+        file += static_cast<char>(i % 20 * 12);
+        file += static_cast<char>(i / 20 * 20);
+        file += static_cast<char>(128);
+    }
+    std::ofstream(path, std::ios::binary) << file;
+
+    fnx::image_options options;
+    auto image = fnx::load_compressed_image(path, 4, options, fnx::block_format::bc7);
+    ASSERT_TRUE(image.get_info()._is_ok);
+    EXPECT_NULL(image.get_info()._data);
+    EXPECT_EQ(fnx::block_format::bc7, image.get_format());
+    EXPECT_EQ(20u, image.get_info()._width);
+    EXPECT_EQ(5u * 3u * 16u, image.get_blocks().size());
+    ASSERT_EQ(4u, image.get_mips().size());
+    for (const auto& mip : image.get_mips())
+    {
+        EXPECT_EQ(fnx::get_compressed_size(fnx::block_format::bc7, mip._width, mip._height), mip._data.size());
+    }
+    const auto decoded = fnx::decompress_blocks(image.get_blocks().data(), 20, 12, fnx::block_format::bc7);
+    EXPECT_GTE(4, std::abs(decoded[(5 * 20 + 7) * 4 + 2] - 128));
+    EXPECT_EQ(255, decoded[(5 * 20 + 7) * 4 + 3]);
+
+    // written on the first load and read afterwards, for the same file and options only
+    const auto key = fnx::texture_cache::get_key(file.data(), file.size(), 4, options, fnx::block_format::bc7);
+    fnx::mapped_file written(cache_path);
+    ASSERT_TRUE(written.is_open());
+    fnx::raw_image cached;
+    ASSERT_TRUE(fnx::texture_cache::read(written.data(), written.size(), key, cached));
+    EXPECT_TRUE(cached.get_blocks() == image.get_blocks());
+    ASSERT_EQ(4u, cached.get_mips().size());
+    EXPECT_TRUE(cached.get_mips()[3]._data == image.get_mips()[3]._data);
+    EXPECT_FALSE(fnx::texture_cache::read(written.data(), written.size(), key + 1u, cached));
+    EXPECT_FALSE(fnx::texture_cache::read(written.data(), written.size() - 16u, key, cached));
+    options.premultiply_alpha = true;
+    EXPECT_NE(key, fnx::texture_cache::get_key(file.data(), file.size(), 4, options, fnx::block_format::bc7));
+    EXPECT_NE(key, fnx::texture_cache::get_key(file.data(), file.size(), 4, {}, fnx::block_format::bc1));
+    written.close();
+
+    auto reloaded = fnx::load_compressed_image(path, 4, {}, fnx::block_format::bc7);
+    EXPECT_TRUE(reloaded.get_blocks() == image.get_blocks());
+
+    // other options have their own cache and leave this one in place
+    const auto premultiplied_path = fnx::get_texture_cache_path(path, 4, options, fnx::block_format::bc7);
+    EXPECT_NE(cache_path, premultiplied_path);
+    EXPECT_TRUE(fnx::load_compressed_image(path, 4, options, fnx::block_format::bc7).get_info()._is_ok);
+    written = fnx::mapped_file(cache_path);
+    ASSERT_TRUE(written.is_open());
+    EXPECT_TRUE(fnx::texture_cache::read(written.data(), written.size(), key, cached));
+    written.close();
+    std::remove(premultiplied_path.c_str());
+    EXPECT_FALSE(fnx::load_compressed_image("missing.ppm", 4, {}, fnx::block_format::bc7).get_info()._is_ok);
+    std::remove(path.c_str());
+    std::remove(cache_path.c_str());
+}
+
+TEST(rect_packer, pack)
+{
+    fnx::rect_packer packer(64u, 64u);
+    std::vector<fnx::packed_rect> rects;
+    fnx::packed_rect rect;
+    size_t area = 0u;
+    for (int i = 0; i < 40; i++)
+    {
+        const auto w = 4u + (i * 7u) % 12u;
+        const auto h = 4u + (i * 5u) % 12u;
+        if (packer.insert(w, h, rect))
+        {
+            EXPECT_EQ(w, rect.width);
+            EXPECT_EQ(h, rect.height);
+            rects.push_back(rect);
+            area += w * h;
+        }
+    }
+    ASSERT_GT(rects.size(), 10u);
+    EXPECT_ALMOST_EQ(area / (64.f * 64.f), packer.get_occupancy());
+    EXPECT_GT(packer.get_occupancy(), 0.6f);
+    for (size_t i = 0u; i < rects.size(); i++)
+    {
+        EXPECT_LTE(rects[i].x + rects[i].width, 64u);
+        EXPECT_LTE(rects[i].y + rects[i].height, 64u);
+        for (size_t j = i + 1u; j < rects.size(); j++)
+        {
+            const auto& a = rects[i];
+            const auto& b = rects[j];
+            EXPECT_FALSE(a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height);
+        }
+    }
+    EXPECT_FALSE(packer.insert(65u, 1u, rect));
+
+    // a freed rectangle takes the same image again
+    const auto freed = rects[rects.size() / 2u];
+    packer.free(freed);
+    ASSERT_TRUE(packer.insert(freed.width, freed.height, rect));
+    EXPECT_EQ(freed.x, rect.x);
+    EXPECT_EQ(freed.y, rect.y);
+
+    // an empty page is one free rectangle again
+    for (const auto& used : rects)
+    {
+        packer.free(used);
+    }
+    EXPECT_EQ(0.f, packer.get_occupancy());
+    ASSERT_EQ(1u, packer.get_free_rects().size());
+    EXPECT_TRUE(packer.insert(64u, 64u, rect));
+    packer.clear();
+    EXPECT_EQ(0.f, packer.get_occupancy());
+}
+
+TEST(lz4, round_trip)
+{
+    fnx::rng::default_engine engine(5u);
+    std::string text;
+    while (text.size() < 100000u)
+    {
+        text += "v " + std::to_string(text.size() % 97) + " 0.5 1.0\n";
+    }
+    std::string noise(5000u, ' ');
+    for (auto& c : noise)
+    {
+        c = static_cast<char>(fnx::rng::uniform(engine, 0.f, 255.f));
+    }
+    const std::string runs = std::string(70000u, 'a') + "abc" + std::string(300u, 'b');
+    for (const auto& input : {std::string(), std::string("abc"), text, noise, runs, noise + text + noise})
+    {
+        const auto blocks = fnx::lz4_compress(input.data(), input.size());
+        std::string output(input.size(), '\0');
+        ASSERT_TRUE(fnx::lz4_decompress(blocks.data(), blocks.size(), output.data(), output.size()));
+        EXPECT_TRUE(input == output);
+        EXPECT_LTE(blocks.size(), input.size() + input.size() / 255u + 16u);
+    }
+    const auto blocks = fnx::lz4_compress(text.data(), text.size());
+    EXPECT_LT(blocks.size(), text.size() / 4u);
+
+    // damaged blocks are refused rather than read past
+    std::string output(text.size(), '\0');
+    EXPECT_FALSE(fnx::lz4_decompress(blocks.data(), blocks.size() - 1u, output.data(), output.size()));
+    EXPECT_FALSE(fnx::lz4_decompress(blocks.data(), blocks.size(), output.data(), output.size() - 1u));
+    EXPECT_FALSE(fnx::lz4_decompress(blocks.data(), blocks.size() / 2u, output.data(), output.size()));
+}
+
+TEST(file_system, write_file_replacing)
+{
+    const std::string path = "write_file_replacing_test.bin";
+    ASSERT_TRUE(fnx::write_file_replacing(path, "first version", 13u));
+    ASSERT_TRUE(fnx::write_file_replacing(path, "second", 6u));
+    EXPECT_EQ(std::string("second"), std::string(fnx::read_file(path).view()));
+    EXPECT_FALSE(std::ifstream(path + ".tmp").good());
+    EXPECT_FALSE(fnx::write_file_replacing("missing_directory/file.bin", "x", 1u));
+    std::remove(path.c_str());
+
+    EXPECT_EQ(0u, fnx::align_offset(0u));
+    EXPECT_EQ(16u, fnx::align_offset(1u));
+    EXPECT_EQ(4096u, fnx::align_offset(33u, 4096u));
+}
+
+TEST(file_system, archive)
+{
+    const std::string path = "file_system_test.fnxpak";
+    std::string text;
+    while (text.size() < 20000u)
+    {
+        text += "newmtl material" + std::to_string(text.size() % 13) + "\nKd 1 0 0\n";
+    }
+    fnx::rng::default_engine engine(9u);
+    std::string noise(6000u, ' ');
+    for (auto& c : noise)
+    {
+        c = static_cast<char>(fnx::rng::uniform(engine, 0.f, 255.f));
+    }
+    const std::vector<fnx::archive_input> inputs{
+        {"res/materials.mtl", text.data(), text.size(), true},
+        {"res/noise.bin", noise.data(), noise.size(), true},
+        {"res/stored.mtl", text.data(), text.size(), false},
+        {"empty", nullptr, 0u, true}};
+    const auto bytes = fnx::archive::serialize(inputs);
+    EXPECT_LT(bytes.size(), text.size() + noise.size() + text.size());
+    std::ofstream(path, std::ios::binary).write(bytes.data(), bytes.size());
+
+    auto packed = std::make_shared<fnx::archive>(path);
+    ASSERT_TRUE(packed->is_open());
+    EXPECT_EQ(4u, packed->get_num_entries());
+    EXPECT_NULL(packed->find("res/missing.mtl"));
+    const auto* compressed = packed->find("res/materials.mtl");
+    ASSERT_NE(nullptr, compressed);
+    EXPECT_EQ(fnx::archive_compression::lz4, compressed->compression);
+    EXPECT_TRUE(packed->read(*compressed).view() == text);
+    const auto* noisy = packed->find("res/noise.bin");
+    ASSERT_NE(nullptr, noisy);
+    EXPECT_EQ(fnx::archive_compression::none, noisy->compression);
+    EXPECT_TRUE(packed->read(*noisy).view() == noise);
+
+    // content stored as is is a page aligned view of the mapping, which outlives the archive handle
+    auto stored = packed->read(*packed->find("res/stored.mtl"));
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(stored.data()) % fnx::archive::page_alignment);
+    packed.reset();
+    EXPECT_TRUE(stored.view() == text);
+    stored.close();
+
+    // mounted archives are read before the disk
+    {
+        auto [files, _] = fnx::singleton<fnx::file_system>::acquire();
+        ASSERT_TRUE(files.mount(path));
+        EXPECT_FALSE(files.mount("missing.fnxpak"));
+    }
+    auto file = fnx::read_file(".\\res\\materials.mtl");
+    ASSERT_TRUE(file.is_open());
+    EXPECT_TRUE(file.view() == text);
+    EXPECT_TRUE(fnx::read_file("empty").is_open());
+    EXPECT_EQ(bytes.size(), fnx::read_file(path).size());
+    EXPECT_FALSE(fnx::read_file("res/missing.mtl").is_open());
+    {
+        auto [files, _] = fnx::singleton<fnx::file_system>::acquire();
+        files.unmount_all();
+    }
+    EXPECT_FALSE(fnx::read_file("res/materials.mtl").is_open());
+
+    // a damaged archive is not mounted
+    std::ofstream(path, std::ios::binary).write(bytes.data(), bytes.size() - 1u);
+    EXPECT_FALSE(fnx::archive(path).is_open());
+    std::remove(path.c_str());
+}
+
+TEST(mtl, parse)
+{
+    const std::string text =
+        "# exported\r\n"
+        "Kd 1 1 1\n"
+        "newmtl red\r\n"
+        "Ns 96.078431\n"
+        "Kd 0.8 0 0\n"
+        "Ka 0.2\n"
+        "  d 0.5\n"
+        "illum 2\n"
+        "map_Kd -s 1 1 1 textures/red.png\r\n"
+        "Tf 1 1 1\n"
+        "\n"
+        "newmtl blue\n"
+        "Ke 0 0 +1\n"
+        "map_d blue_alpha.png\n";
+    const auto materials = fnx::parse_mtl(text);
+    ASSERT_EQ(2u, materials.size());
+    const auto& red = materials[0];
+    EXPECT_EQ(std::string("red"), std::string(red.name));
+    EXPECT_EQ(fnx::mtl_material::ns | fnx::mtl_material::kd | fnx::mtl_material::ka | fnx::mtl_material::d |
+              fnx::mtl_material::illum, red.parameters);
+    EXPECT_ALMOST_EQ(96.078431f, red.values.ns);
+    EXPECT_ALMOST_EQ(0.8f, red.values.kd[0]);
+    EXPECT_ALMOST_EQ(0.f, red.values.kd[2]);
+    EXPECT_ALMOST_EQ(0.2f, red.values.ka[2]);
+    EXPECT_ALMOST_EQ(0.5f, red.values.d);
+    EXPECT_ALMOST_EQ(2.f, red.values.illum);
+    EXPECT_EQ(std::string("textures/red.png"), std::string(red.maps[fnx::mtl_material::map_kd]));
+    EXPECT_TRUE(red.maps[fnx::mtl_material::map_d].empty());
+    const auto& blue = materials[1];
+    EXPECT_EQ(static_cast<uint32_t>(fnx::mtl_material::ke), blue.parameters);
+    EXPECT_ALMOST_EQ(1.f, blue.values.ke[2]);
+    EXPECT_EQ(std::string("blue_alpha.png"), std::string(blue.maps[fnx::mtl_material::map_d]));
+}
+
+TEST(material_cache, round_trip)
+{
+    const std::string path = "material_cache_test.mtl";
+    const auto cache_path = fnx::get_material_cache_path(path);
+    std::remove(cache_path.c_str());
+    std::string text;
+    for (int i = 0; i < 100; ++i)
+    {
+        text += "newmtl cached" + std::to_string(i) + "\nKd 0.5 0.25 " + std::to_string(i) +
+                "\nNs 10\nmap_Ka cached" + std::to_string(i) + ".png\n";
+    }
+    std::ofstream(path, std::ios::binary) << text;
+
+    auto check = [](const fnx::material_cache& cache) {
+        ASSERT_TRUE(cache.is_open());
+        ASSERT_EQ(100u, cache.get_materials().size());
+        const auto& material = cache.get_materials()[42];
+        EXPECT_EQ(std::string("cached42"), std::string(material.name));
+        EXPECT_EQ(fnx::mtl_material::kd | fnx::mtl_material::ns, material.parameters);
+        EXPECT_ALMOST_EQ(42.f, material.values.kd[2]);
+        EXPECT_EQ(std::string("cached42.png"), std::string(material.maps[fnx::mtl_material::map_ka]));
+    };
+    check(fnx::load_material_cache(path));
+    const auto hash = fnx::hash_bytes(text.data(), text.size());
+    check(fnx::material_cache(cache_path, hash));
+    EXPECT_FALSE(fnx::material_cache(cache_path, hash + 1u).is_open());
+    EXPECT_FALSE(fnx::load_material_cache("missing.mtl").is_open());
+
+    // a damaged cache is rebuilt
+    fnx::mapped_file written(cache_path);
+    std::string truncated(written.data(), written.size() - 4u);
+    written.close();
+    std::ofstream(cache_path, std::ios::binary) << truncated;
+    EXPECT_FALSE(fnx::material_cache(cache_path, hash).is_open());
+    check(fnx::load_material_cache(path));
+
+    // materials get their parameters, their textures are only loaded when first used
+    size_t num_textures = 0u;
+    {
+        auto [textures, _] = fnx::singleton<fnx::asset_manager<fnx::texture>>::acquire();
+        num_textures = textures.count();
+    }
+    fnx::parse_material_file(path);
+    {
+        auto [materials, _] = fnx::singleton<fnx::asset_manager<fnx::material>>::acquire();
+        auto material = materials.get("cached7");
+        float ns = 0.f;
+        fnx::vector3 kd;
+        EXPECT_TRUE(material->get(fnx::UNIFORM_MATERIAL_NS, ns));
+        EXPECT_ALMOST_EQ(10.f, ns);
+        EXPECT_TRUE(material->get(fnx::UNIFORM_MATERIAL_KD, kd));
+        EXPECT_ALMOST_EQ(7.f, kd.z);
+    }
+    {
+        auto [textures, _] = fnx::singleton<fnx::asset_manager<fnx::texture>>::acquire();
+        EXPECT_EQ(num_textures, textures.count());
+    }
+    std::remove(path.c_str());
+    std::remove(cache_path.c_str());
+}
+
+TEST(mesh_cache, get_async)
+{
+    const std::string path = "mesh_cache_async.obj";
+    std::ofstream(path, std::ios::binary) << "v 0 0 0\nv 1 0 0\nv 1 1 0\no first\nf 1 2 3\no second\nf 3 2 1\nf 1 2 3\n";
+    auto [loader, _] = fnx::singleton<fnx::asset_loader>::acquire();
+    fnx::asset_manager<fnx::raw_model> manager;
+    auto second = manager.get_async("second", path);
+    auto missing = manager.get_async("third", path);
+
+    // imported on a worker thread, copied out of the cache on the main thread
+    loader.finish();
+    ASSERT_TRUE(second.is_loaded());
+    EXPECT_EQ(6u, second.get()->get_indices().size());
+    // the triangles face opposite ways so they share no vertices, each has a position and a normal
+    EXPECT_EQ(6u * 6u, second.get()->get_vertices().size());
+    EXPECT_TRUE(second.get()->has_normal_data());
+    EXPECT_TRUE(fnx::load_state::failed == missing.get_state());
+    std::remove(path.c_str());
+    std::remove(fnx::get_mesh_cache_path(path).c_str());
+}
+
+TEST(mesh_cache, round_trip)
+{
+    const std::string path = "mesh_cache_test.obj";
+    const auto cache_path = fnx::get_mesh_cache_path(path);
+    std::remove(cache_path.c_str());
+    std::string text = "mtllib a.mtl\nv 0 0 0\nv 1 0 0\nv 1 1 0\nvt 0 1\no first\nusemtl red\nf 1/1 2/1 3/1\n"
+                       "o second\nf 3 2 1\nusemtl blue\nf 1 2 3\n";
+    std::ofstream(path, std::ios::binary) << text;
+
+    auto expected = fnx::parse_obj(text);
+    auto check = [&](const fnx::mesh_cache& cache)
+    {
+        ASSERT_TRUE(cache.is_open());
+        ASSERT_EQ(1u, cache.get_material_libraries().size());
+        EXPECT_EQ(std::string_view("a.mtl"), cache.get_material_libraries()[0]);
+        ASSERT_EQ(2u, cache.get_meshes().size());
+        for (size_t i = 0; i < 2; ++i)
+        {
+            const auto& object = expected.objects[i + 1];
+            const auto& mesh = cache.get_meshes()[i];
+            EXPECT_EQ(std::string_view(object.name), mesh.name);
+            // indexed, drawing the indices gives back the imported triangles
+            const size_t stride = object.has_texture ? 8u : 6u;
+            ASSERT_EQ(object.vertices.size() / stride, mesh.indices.size());
+            EXPECT_TRUE(mesh.indices_32.empty());
+            for (size_t k = 0; k < mesh.indices.size() * stride; ++k)
+            {
+                EXPECT_EQ(object.vertices[k], mesh.vertices[mesh.indices[k / stride] * stride + k % stride]);
+            }
+            EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(mesh.vertices.data()) % 16u);
+            EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(mesh.indices.data()) % 16u);
+            EXPECT_EQ(object.has_texture, (mesh.flags & fnx::raw_model::data_bit::texture) != 0);
+            EXPECT_TRUE(object.aabb.getMin() == mesh.aabb.getMin() && object.aabb.getMax() == mesh.aabb.getMax());
+            ASSERT_EQ(object.materials.size(), mesh.materials.size());
+            EXPECT_EQ(object.materials.get_all().back()._material_name, mesh.materials.get_all().back()._material_name);
+            EXPECT_EQ(object.materials.get_all().back()._end, mesh.materials.get_all().back()._end);
+        }
+    };
+
+    // imported and written on the first load, mapped afterwards
+    check(fnx::load_mesh_cache(path));
+    auto hash = fnx::hash_bytes(text.data(), text.size());
+    check(fnx::mesh_cache(cache_path, hash));
+    EXPECT_FALSE(fnx::mesh_cache(cache_path, hash + 1u).is_open());
+
+    // a damaged cache is rebuilt
+    fnx::mapped_file written(cache_path);
+    std::string truncated(written.data(), written.size() - 16u);
+    written.close();
+    std::ofstream(cache_path, std::ios::binary) << truncated;
+    EXPECT_FALSE(fnx::mesh_cache(cache_path, hash).is_open());
+    check(fnx::load_mesh_cache(path));
+
+    // so is the cache of a changed model, objects of the same name are merged
+    text += "o first\nusemtl green\nf 2/1 3/1 1/1\n";
+    std::ofstream(path, std::ios::binary) << text;
+    auto cache = fnx::load_mesh_cache(path);
+    ASSERT_EQ(2u, cache.get_meshes().size());
+    const auto& first = cache.get_meshes()[0];
+    EXPECT_EQ(6u, first.indices.size());
+    EXPECT_EQ(3u * 8u, first.vertices.size());
+    ASSERT_EQ(2u, first.materials.size());
+    EXPECT_EQ(std::string("green"), first.materials.get_all()[1]._material_name);
+    EXPECT_EQ(3, first.materials.get_all()[1]._start);
+    EXPECT_EQ(6, first.materials.get_all()[1]._end);
+    EXPECT_TRUE(fnx::mesh_cache(cache_path, fnx::hash_bytes(text.data(), text.size())).is_open());
+
+    // levels of detail keep their ranges, errors and materials
+    auto lod_mesh = first;
+    lod_mesh.lods.push_back({3u, 6u, 0.5f, {}});
+    lod_mesh.lods.back().materials.add_material_range("far", 3, 6);
+    fnx::mesh_cache lod_cache(fnx::mesh_cache::serialize(7u, {lod_mesh}, {}), 7u);
+    ASSERT_TRUE(lod_cache.is_open());
+    ASSERT_EQ(2u, lod_cache.get_meshes()[0].materials.size());
+    ASSERT_EQ(1u, lod_cache.get_meshes()[0].lods.size());
+    const auto& lod = lod_cache.get_meshes()[0].lods[0];
+    EXPECT_EQ(3u, lod.start);
+    EXPECT_EQ(6u, lod.end);
+    EXPECT_EQ(0.5f, lod.error);
+    ASSERT_EQ(1u, lod.materials.size());
+    EXPECT_EQ(std::string("far"), lod.materials.get_all()[0]._material_name);
+    std::remove(path.c_str());
+    std::remove(cache_path.c_str());
+}
@@ -102,11 +102,501 @@ TEST(matrix4x4, multiplication_quaternion)
 {
     fnx::matrix4x4 a(1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16);
     fnx::vector4 b(1,5,9,13);
-    fnx::matrix4x4 e(0,-2,-4,-9,
-                     2,0,-9,18,
-                     4,9,0,22,
-                     9,18,22,0);
-    //auto c = a * b;
-    // TODO
-    //EXPECT_EQ(e,c);
-}
\ No newline at end of file
+    fnx::vector4 e(90,202,314,426);
+    auto c = a * b;
+    EXPECT_EQ(e,c);
+}
+
+namespace
+{
+/// @brief Deterministic matrices with values in [-4, 4).
+fnx::matrix4x4 make_matrix(uint32_t& state)
+{
+    fnx::matrix4x4 m;
+    for (auto i = 0; i < 16; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        m.data()[i] = static_cast<fnx::decimal>((state >> 8) % 8192u) / 1024.f - 4.f;
+    }
+    return m;
+}
+
+/// @brief The vector kernels may round differently than the scalar ones when the compiler contracts to fma.
+void expect_near(const fnx::decimal* expected, const fnx::decimal* actual, size_t count, fnx::decimal tolerance)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        EXPECT_GTE(tolerance * std::max(fnx::decimal{1}, std::abs(expected[i])), std::abs(expected[i] - actual[i]));
+    }
+}
+}
+
+TEST(matrix4x4, simd_matches_scalar)
+{
+    uint32_t state = 11u;
+    for (auto n = 0; n < 64; ++n)
+    {
+        auto a = make_matrix(state);
+        auto b = make_matrix(state);
+        fnx::matrix4x4 expected;
+
+        fnx::simd::scalar::mat4_multiply(a.data(), b.data(), expected.data());
+        expect_near(expected.data(), (a * b).data(), 16, 1e-5f);
+
+        fnx::simd::scalar::mat4_transpose(a.data(), expected.data());
+        EXPECT_EQ(expected, fnx::matrix_transpose(a));
+        EXPECT_EQ(a, fnx::matrix_transpose(fnx::matrix_transpose(a)));
+
+        fnx::simd::scalar::mat4_scale_rows(a.data(), 2.f, -.5f, 3.f, expected.data());
+        EXPECT_EQ(expected, fnx::matrix_scale(a, 2.f, -.5f, 3.f));
+
+        fnx::vector4 v(b[0][0], b[1][1], b[2][2], b[3][3]);
+        fnx::vector4 expected_v;
+        fnx::simd::scalar::mat4_transform(a.data(), &v.x, &expected_v.x);
+        expect_near(&expected_v.x, &(a * v).x, 4, 1e-5f);
+    }
+    EXPECT_EQ(fnx::matrix4x4(1,5,9,13,2,6,10,14,3,7,11,15,4,8,12,16),
+              fnx::matrix_transpose(fnx::matrix4x4(1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16)));
+}
+
+TEST(matrix4x4, simd_inverse)
+{
+    for (auto n = 0; n < 64; ++n)
+    {
+        auto f = static_cast<fnx::decimal>(n);
+        auto m = fnx::calculate_transform_matrix(f - 30.f, 2.f * f, -f, f * 7.f, f * 13.f, f * 3.f,
+                                                 1.f + f / 16.f, 2.f, .5f + f / 32.f);
+        fnx::matrix4x4 expected;
+        fnx::simd::scalar::mat4_inverse(m.data(), expected.data());
+        auto inverse = fnx::matrix_inverse(m);
+        expect_near(expected.data(), inverse.data(), 16, 1e-4f);
+        expect_near(fnx::matrix4x4::identity().data(), (m * inverse).data(), 16, 1e-4f);
+    }
+}
+
+TEST(matrix4x4, affine_compose)
+{
+    uint32_t state = 5u;
+    for (auto n = 0; n < 64; ++n)
+    {
+        auto a = make_matrix(state);
+        auto b = make_matrix(state);
+        a[3][0] = a[3][1] = a[3][2] = b[3][0] = b[3][1] = b[3][2] = 0.f;
+        a[3][3] = b[3][3] = 1.f;
+        EXPECT_EQ(a * b, fnx::matrix_affine_multiply(a, b));
+
+        fnx::vector3 position{b[0][0], b[1][1], b[2][2]};
+        expect_near((a * fnx::matrix_translate(position)).data(), fnx::matrix_translate(a, position).data(), 16, 1e-5f);
+    }
+}
+TEST(transform, points)
+{
+    uint32_t state = 7u;
+    auto m = fnx::calculate_transform_matrix(1.f, -2.f, 3.f, 30.f, 45.f, 60.f, 2.f, 1.f, .5f);
+    // every count up to a few full batches so that the remainder loop is covered
+    for (size_t count = 0; count < 19; ++count)
+    {
+        std::vector<fnx::vector3> points;
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto r = make_matrix(state);
+            points.emplace_back(r.data()[0], r.data()[1], r.data()[2]);
+        }
+        std::vector<fnx::vector3> out(count);
+        fnx::transform_points(m, points, out);
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto expected = m * fnx::vector4(points[i].x, points[i].y, points[i].z, 1.f);
+            expect_near(&expected.x, &out[i].x, 3, 1e-5f);
+        }
+
+        fnx::transform_points(m, points, points);
+        for (size_t i = 0; i < count; ++i)
+        {
+            expect_near(&out[i].x, &points[i].x, 3, 0.f);
+        }
+    }
+}
+
+TEST(transform, matrices)
+{
+    uint32_t state = 11u;
+    std::vector<fnx::matrix4x4> parents, locals;
+    for (size_t i = 0; i < 9; ++i)
+    {
+        parents.emplace_back(make_matrix(state));
+        locals.emplace_back(make_matrix(state));
+    }
+    std::vector<fnx::matrix4x4> out(parents.size());
+    fnx::transform_matrices(parents, locals, out);
+    for (size_t i = 0; i < parents.size(); ++i)
+    {
+        expect_near((parents[i] * locals[i]).data(), out[i].data(), 16, 1e-5f);
+    }
+
+    fnx::transform_matrices(parents, locals, locals);
+    for (size_t i = 0; i < parents.size(); ++i)
+    {
+        expect_near(out[i].data(), locals[i].data(), 16, 0.f);
+    }
+}
+
+TEST(transform, aabbs)
+{
+    uint32_t state = 13u;
+    auto m = fnx::calculate_transform_matrix(4.f, 5.f, -6.f, 10.f, 20.f, 75.f, 1.f, 3.f, 2.f);
+    std::vector<reactphysics3d::AABB> boxes;
+    for (size_t i = 0; i < 11; ++i)
+    {
+        auto r = make_matrix(state);
+        fnx::vector3 min{r.data()[0], r.data()[1], r.data()[2]};
+        boxes.emplace_back(min, min + fnx::vector3{std::abs(r.data()[3]), std::abs(r.data()[4]), std::abs(r.data()[5])});
+    }
+    std::vector<reactphysics3d::AABB> out(boxes.size());
+    fnx::transform_aabbs(m, boxes, out);
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        // the bounds of the eight transformed corners
+        const auto& lo = boxes[i].getMin();
+        const auto& hi = boxes[i].getMax();
+        fnx::vector3 expected_min, expected_max;
+        for (auto corner = 0; corner < 8; ++corner)
+        {
+            auto p = m * fnx::vector4(corner & 1 ? hi.x : lo.x, corner & 2 ? hi.y : lo.y, corner & 4 ? hi.z : lo.z, 1.f);
+            for (auto k = 0; k < 3; ++k)
+            {
+                expected_min[k] = corner == 0 ? (&p.x)[k] : std::min(expected_min[k], (&p.x)[k]);
+                expected_max[k] = corner == 0 ? (&p.x)[k] : std::max(expected_max[k], (&p.x)[k]);
+            }
+        }
+        expect_near(&expected_min.x, &out[i].getMin().x, 3, 1e-4f);
+        expect_near(&expected_max.x, &out[i].getMax().x, 3, 1e-4f);
+    }
+}
+
+TEST(transform, filter_kernels)
+{
+    uint32_t state = 5u;
+    // every count up to a few full vectors so that the remainder loops are covered
+    for (size_t count = 0; count < 19; ++count)
+    {
+        std::vector<float> in, weights;
+        for (size_t i = 0; i < count * 4; ++i)
+        {
+            in.emplace_back(make_matrix(state).data()[0]);
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            weights.emplace_back(make_matrix(state).data()[0]);
+        }
+        std::vector<float> out(count * 4, 1.f), expected(count * 4, 1.f);
+        fnx::simd::multiply_add(in.data(), .25f, out.data(), out.size());
+        fnx::simd::scalar::multiply_add(in.data(), .25f, expected.data(), expected.size());
+        expect_near(expected.data(), out.data(), out.size(), 1e-5f);
+
+        float sum[4], expected_sum[4];
+        fnx::simd::weighted_sum4(in.data(), weights.data(), count, sum);
+        fnx::simd::scalar::weighted_sum4(in.data(), weights.data(), count, expected_sum);
+        expect_near(expected_sum, sum, 4, 1e-4f);
+    }
+}
+
+namespace
+{
+/// @brief Camera at the origin looking down -z with a 90 degree field of view, near 1 and far 100.
+fnx::frustum make_frustum()
+{
+    auto view = fnx::matrix_look_at(fnx::vector3{0.f, 0.f, 0.f}, fnx::vector3{0.f, 0.f, -1.f}, fnx::vector3{0.f, 1.f, 0.f});
+    auto projection = fnx::matrix_perspective(fnx::angle{fnx::Degree(90.0)}, 1.f, 1.f, 100.f);
+    // camera matrices are in OpenGL column order, so projection * view is view * projection here
+    return fnx::frustum::from_view_projection(view * projection);
+}
+}
+
+TEST(frustum, planes)
+{
+    auto frustum = make_frustum();
+    EXPECT_TRUE(frustum.contains(fnx::vector3{0.f, 0.f, -5.f}));
+    EXPECT_TRUE(frustum.contains(fnx::vector3{4.f, -4.f, -5.f}));
+    EXPECT_FALSE(frustum.contains(fnx::vector3{0.f, 0.f, 5.f}));
+    EXPECT_FALSE(frustum.contains(fnx::vector3{6.f, 0.f, -5.f}));
+    EXPECT_FALSE(frustum.contains(fnx::vector3{0.f, 0.f, -.5f}));
+    EXPECT_FALSE(frustum.contains(fnx::vector3{0.f, 0.f, -101.f}));
+    for (size_t i = 0; i < fnx::frustum::plane_count; ++i)
+    {
+        const auto& plane = frustum.get_plane(i);
+        EXPECT_ALMOST_EQ(1.f, std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z));
+    }
+    // boxes and spheres reaching into the volume are kept
+    EXPECT_TRUE(frustum.intersects(reactphysics3d::AABB{fnx::vector3{4.5f, 0.f, -5.f}, fnx::vector3{7.f, 1.f, -4.f}}));
+    EXPECT_FALSE(frustum.intersects(reactphysics3d::AABB{fnx::vector3{6.f, 0.f, -5.f}, fnx::vector3{7.f, 1.f, -4.f}}));
+    EXPECT_TRUE(frustum.intersects(fnx::vector3{0.f, 0.f, 2.f}, 3.f));
+    EXPECT_FALSE(frustum.intersects(fnx::vector3{0.f, 0.f, 2.f}, 1.f));
+    // the default frustum contains everything
+    EXPECT_TRUE(fnx::frustum{}.contains(fnx::vector3{1e6f, -1e6f, 1e6f}));
+}
+
+TEST(frustum, placed_bounds)
+{
+    // a renderable is skipped once its transform moves its bounds out of view
+    auto frustum = make_frustum();
+    reactphysics3d::AABB bounds{fnx::vector3{-1.f, -1.f, -1.f}, fnx::vector3{1.f, 1.f, 1.f}};
+    EXPECT_TRUE(frustum.intersects(bounds, fnx::matrix_translate(fnx::vector3{0.f, 0.f, -5.f})));
+    EXPECT_FALSE(frustum.intersects(bounds, fnx::matrix_translate(fnx::vector3{0.f, 0.f, 5.f})));
+    EXPECT_FALSE(frustum.intersects(bounds, fnx::matrix_translate(fnx::vector3{20.f, 0.f, -5.f})));
+    // scaled up it reaches into the view again
+    EXPECT_TRUE(frustum.intersects(bounds, fnx::matrix_translate(fnx::vector3{20.f, 0.f, -5.f}) * fnx::matrix_scale(fnx::vector3{30.f, 1.f, 1.f})));
+}
+
+TEST(frustum, cull_aabbs)
+{
+    auto frustum = make_frustum();
+    uint32_t state = 7u;
+    std::vector<reactphysics3d::AABB> boxes;
+    for (size_t i = 0; i < 103; ++i)
+    {
+        // centers spread over twice the size of the volume
+        auto r = make_matrix(state);
+        fnx::vector3 min{r.data()[0] * 10.f, r.data()[1] * 10.f, r.data()[2] * 25.f - 50.f};
+        boxes.emplace_back(min, min + fnx::vector3{std::abs(r.data()[3]), std::abs(r.data()[4]), std::abs(r.data()[5])});
+    }
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < boxes.size(); ++i)
+    {
+        if (frustum.intersects(boxes[i]))
+        {
+            expected.push_back(i);
+        }
+    }
+    EXPECT_LT(10u, expected.size());
+    EXPECT_GT(boxes.size() - 10u, expected.size());
+    std::vector<uint32_t> visible;
+    EXPECT_EQ(expected.size(), fnx::cull_aabbs(frustum, boxes, visible));
+    EXPECT_TRUE(expected == visible);
+}
+
+TEST(frustum, cull_spheres)
+{
+    auto frustum = make_frustum();
+    uint32_t state = 11u;
+    std::vector<fnx::vector4> spheres;
+    for (size_t i = 0; i < 103; ++i)
+    {
+        auto r = make_matrix(state);
+        spheres.emplace_back(r.data()[0] * 10.f, r.data()[1] * 10.f, r.data()[2] * 25.f - 50.f, std::abs(r.data()[3]));
+    }
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < spheres.size(); ++i)
+    {
+        if (frustum.intersects(fnx::vector3{spheres[i].x, spheres[i].y, spheres[i].z}, spheres[i].w))
+        {
+            expected.push_back(i);
+        }
+    }
+    EXPECT_LT(10u, expected.size());
+    EXPECT_GT(spheres.size() - 10u, expected.size());
+    std::vector<uint32_t> visible;
+    EXPECT_EQ(expected.size(), fnx::cull_spheres(frustum, spheres, visible));
+    EXPECT_TRUE(expected == visible);
+}
+
+TEST(rng, reference_sequences)
+{
+    // published first outputs of pcg32 seeded with 42 on stream 54
+    fnx::rng::pcg32 pcg(42u, 54u);
+    const uint32_t expected_pcg[] = {0xa15c02b7u, 0x7b47f409u, 0xba1d3330u, 0x83d2f293u, 0xbfa4784bu, 0xcbed606eu};
+    for (auto expected : expected_pcg)
+    {
+        EXPECT_EQ(expected, pcg());
+    }
+
+    fnx::rng::xoshiro256ss xoshiro(1u, 2u, 3u, 4u);
+    EXPECT_EQ(0x2d00u, xoshiro());
+    EXPECT_EQ(0x0u, xoshiro());
+    EXPECT_EQ(0x5a007080u, xoshiro());
+}
+
+TEST(rng, deterministic)
+{
+    std::vector<float> a(37), b(37);
+    fnx::rng::seed(1234u);
+    auto first = fnx::random(0., 1.);
+    fnx::rng::fill_uniform(a);
+    fnx::rng::seed(1234u);
+    EXPECT_EQ(first, fnx::random(0., 1.));
+    fnx::rng::fill_uniform(b);
+    EXPECT_TRUE(a == b);
+
+    fnx::rng::xoshiro256ss engine(99u);
+    auto split = engine;
+    split.jump();
+    EXPECT_NE(engine(), split());
+}
+
+TEST(rng, uniform)
+{
+    fnx::rng::pcg32 engine(7u);
+    for (auto i = 0; i < 1000; ++i)
+    {
+        auto f = fnx::rng::uniform(engine, -2.f, 3.f);
+        EXPECT_TRUE(f >= -2.f && f < 3.f);
+        EXPECT_GT(10u, fnx::rng::uniform_index(engine, 10u));
+    }
+    EXPECT_EQ(0u, fnx::rng::uniform_index(engine, 1u));
+
+    auto val = fnx::random(25, 75);
+    EXPECT_TRUE(val >= 25 && val < 75);
+}
+
+TEST(rng, fill_uniform)
+{
+    // every count up to a few full batches so that the remainder is covered
+    for (size_t count = 0; count < 27; ++count)
+    {
+        fnx::rng::batch_engine engine(count), reference(count);
+        std::vector<float> values(count), expected(count);
+        for (auto pass = 0; pass < 3; ++pass)
+        {
+            fnx::rng::fill_uniform(engine, values, -1.f, 4.f);
+            fnx::simd::scalar::fill_uniform(reference.data(), expected.data(), count, -1.f, 4.f);
+            expect_near(expected.data(), values.data(), count, 1e-6f);
+            for (auto v : values)
+            {
+                EXPECT_TRUE(v >= -1.f && v < 4.f);
+            }
+        }
+    }
+}
+
+TEST(rng, fill_normal)
+{
+    fnx::rng::batch_engine engine(5u);
+    std::vector<float> values(20001);
+    fnx::rng::fill_normal(engine, values, 3.f, 2.f);
+    double sum = 0., sum_sq = 0.;
+    for (auto v : values)
+    {
+        sum += v;
+        sum_sq += v * v;
+    }
+    auto mean = sum / values.size();
+    auto stddev = std::sqrt(sum_sq / values.size() - mean * mean);
+    EXPECT_GT(0.05, std::abs(mean - 3.));
+    EXPECT_GT(0.05, std::abs(stddev - 2.));
+}
+
+TEST(quantize, half)
+{
+    // values with an exact half representation survive the round trip
+    for (auto f : {0.f, -0.f, 1.f, -2.f, .5f, 65504.f, -65504.f, 6.103515625e-05f, 5.9604645e-08f, 1024.f, .333251953125f})
+    {
+        EXPECT_EQ(f, fnx::quantize::from_half(fnx::quantize::to_half(f)));
+    }
+    EXPECT_EQ(0x3c00u, fnx::quantize::to_half(1.f));
+    EXPECT_EQ(0x7c00u, fnx::quantize::to_half(1e6f));
+    EXPECT_EQ(0xfc00u, fnx::quantize::to_half(-1e6f));
+    // ties round to even, 1 + 2^-11 is halfway between 1 and the next half
+    EXPECT_EQ(0x3c00u, fnx::quantize::to_half(1.f + 1.f / 2048.f));
+    EXPECT_EQ(0x3c02u, fnx::quantize::to_half(1.f + 3.f / 2048.f));
+    for (auto f = -100.f; f < 100.f; f += .37f)
+    {
+        EXPECT_GT(std::abs(f) / 1024.f + 1e-7f, std::abs(f - fnx::quantize::from_half(fnx::quantize::to_half(f))));
+    }
+}
+
+TEST(quantize, normalized)
+{
+    EXPECT_EQ(0u, fnx::quantize::to_unorm16(-1.f));
+    EXPECT_EQ(65535u, fnx::quantize::to_unorm16(2.f));
+    EXPECT_EQ(32767, fnx::quantize::to_snorm16(1.f));
+    EXPECT_EQ(-32767, fnx::quantize::to_snorm16(-1.f));
+    EXPECT_EQ(-1.f, fnx::quantize::from_snorm16(-32768));
+    EXPECT_EQ(255u, fnx::quantize::to_unorm8(1.f));
+    for (auto f = 0.f; f <= 1.f; f += .01f)
+    {
+        EXPECT_GT(.5f / 65535.f + 1e-7f, std::abs(f - fnx::quantize::from_unorm16(fnx::quantize::to_unorm16(f))));
+        EXPECT_GT(.5f / 32767.f + 1e-7f, std::abs(f - fnx::quantize::from_snorm16(fnx::quantize::to_snorm16(f))));
+        EXPECT_GT(.5f / 32767.f + 1e-7f, std::abs(-f - fnx::quantize::from_snorm16(fnx::quantize::to_snorm16(-f))));
+        EXPECT_GT(.5f / 255.f + 1e-7f, std::abs(f - fnx::quantize::from_unorm8(fnx::quantize::to_unorm8(f))));
+    }
+}
+
+TEST(quantize, normals)
+{
+    fnx::rng::pcg32 engine(11u);
+    float worst_octahedral = 0.f, worst_packed = 0.f;
+    for (auto i = 0; i < 2000; ++i)
+    {
+        fnx::vector3 n{fnx::rng::uniform(engine, -1.f, 1.f), fnx::rng::uniform(engine, -1.f, 1.f), fnx::rng::uniform(engine, -1.f, 1.f)};
+        if (n.length() < 1e-3f)
+        {
+            continue;
+        }
+        n.normalize();
+
+        float uv[2], decoded[4];
+        fnx::quantize::to_octahedral(n.x, n.y, n.z, uv);
+        fnx::quantize::from_octahedral(fnx::quantize::from_snorm16(fnx::quantize::to_snorm16(uv[0])),
+                                       fnx::quantize::from_snorm16(fnx::quantize::to_snorm16(uv[1])), decoded);
+        worst_octahedral = std::max(worst_octahedral, 1.f - (n.x * decoded[0] + n.y * decoded[1] + n.z * decoded[2]));
+
+        fnx::quantize::from_snorm_10_10_10_2(fnx::quantize::to_snorm_10_10_10_2(n.x, n.y, n.z, -1.f), decoded);
+        EXPECT_EQ(-1.f, decoded[3]);
+        for (auto k = 0; k < 3; ++k)
+        {
+            worst_packed = std::max(worst_packed, std::abs((&n.x)[k] - decoded[k]));
+        }
+    }
+    // 1 - cos of 0.08 degrees, and half a step of 10 bits
+    EXPECT_GT(1e-6f, worst_octahedral);
+    EXPECT_GT(.5f / 511.f + 1e-6f, worst_packed);
+
+    float decoded[3];
+    float uv[2];
+    fnx::quantize::to_octahedral(0.f, 0.f, -1.f, uv);
+    fnx::quantize::from_octahedral(uv[0], uv[1], decoded);
+    EXPECT_EQ(-1.f, decoded[2]);
+}
+
+TEST(quantize, pack_vertices)
+{
+    // two vertices with position, uv, normal and color, 12 floats each
+    const float vertices[] = {-2.f, 0.f, 4.f, 0.f, 1.f, 0.f, 1.f, 0.f, 1.f, 0.f, 0.f, 1.f,
+                              6.f, 1.f, 8.f, 1.f, .25f, 0.f, 0.f, -1.f, .5f, .5f, .5f, .5f};
+    const float min[3] = {-2.f, 0.f, 4.f};
+    const float max[3] = {6.f, 1.f, 8.f};
+
+    auto plain = fnx::pack_vertices(vertices, 2u, true, true, true, fnx::vertex_layout{}, min, max);
+    EXPECT_EQ(48u, plain.stride);
+    EXPECT_EQ(0, std::memcmp(vertices, plain.data.data(), sizeof(vertices)));
+
+    auto packed = fnx::pack_vertices(vertices, 2u, true, true, true, fnx::vertex_layout::compact(), min, max);
+    EXPECT_EQ(20u, packed.stride);
+    EXPECT_EQ(40u, packed.data.size());
+    EXPECT_EQ(8u, packed.uv.offset);
+    EXPECT_EQ(12u, packed.normal.offset);
+    EXPECT_EQ(16u, packed.color.offset);
+    EXPECT_TRUE(packed.normal.is_normalized());
+
+    // decode the second vertex like the GPU and the position decode would
+    const uint8_t* second = packed.data.data() + packed.stride;
+    uint16_t position[4];
+    std::memcpy(position, second, sizeof(position));
+    for (auto k = 0; k < 3; ++k)
+    {
+        auto decoded = packed.position_offset[k] + packed.position_scale[k] * fnx::quantize::from_unorm16(position[k]);
+        EXPECT_GT(1e-3f, std::abs(vertices[12 + k] - decoded));
+    }
+    EXPECT_EQ(65535u, position[3]);
+    uint32_t normal;
+    std::memcpy(&normal, second + packed.normal.offset, sizeof(normal));
+    float decoded_normal[4];
+    fnx::quantize::from_snorm_10_10_10_2(normal, decoded_normal);
+    EXPECT_EQ(-1.f, decoded_normal[2]);
+    EXPECT_EQ(128u, second[packed.color.offset]);
+
+    // without normals or colors the attributes are absent
+    auto partial = fnx::pack_vertices(vertices, 1u, false, false, false, fnx::vertex_layout::compact(), min, max);
+    EXPECT_EQ(8u, partial.stride);
+    EXPECT_FALSE(partial.normal.is_enabled());
+}
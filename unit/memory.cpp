@@ -188,3 +188,60 @@ TEST(heap_indexed_pool, access)
 	ASSERT_EQ((intptr_t)b, (intptr_t)foo_pool[1]);
 	ASSERT_EQ((intptr_t)c, (intptr_t)foo_pool[2]);
 }
+
+TEST(inplace_function, lambda)
+{
+	int total = 0;
+	fnx::inplace_function<void(int)> func = [&total](int x) { total += x; };
+	func(40);
+	func(2);
+	EXPECT_EQ(42, total);
+}
+
+TEST(inplace_function, owns_temporary)
+{
+	fnx::inplace_function<int()> func;
+	EXPECT_FALSE(static_cast<bool>(func));
+	{
+		auto offset = 1300;
+		func = [offset]() { return offset + 37; };
+	}
+	EXPECT_TRUE(static_cast<bool>(func));
+	EXPECT_EQ(1337, func());
+}
+
+TEST(inplace_function, member)
+{
+	tester::foo obj;
+	fnx::inplace_function<void(int)> func(obj, &tester::foo::set_x);
+	func(456);
+	EXPECT_EQ(456, obj.x);
+
+	fnx::inplace_function<void(int)> from_ref = fnx::bind(obj, &tester::foo::set_y);
+	from_ref(789);
+	EXPECT_EQ(789, obj.y);
+}
+
+TEST(inplace_function, move_only)
+{
+	auto value = std::make_unique<int>(42);
+	fnx::unique_inplace_function<int()> func = [v = std::move(value)]() { return *v; };
+	auto moved = std::move(func);
+	EXPECT_FALSE(static_cast<bool>(func));
+	EXPECT_EQ(42, moved());
+	EXPECT_FALSE(std::is_copy_constructible<fnx::unique_inplace_function<int()>>::value);
+	EXPECT_FALSE(std::is_copy_assignable<fnx::unique_inplace_function<int()>>::value);
+	EXPECT_TRUE(std::is_copy_constructible<fnx::inplace_function<int()>>::value);
+}
+
+TEST(inplace_function, copy)
+{
+	int calls = 0;
+	fnx::inplace_function<void()> original = [&calls]() { calls++; };
+	auto clone1(original);
+	auto clone2 = original;
+	original();
+	clone1();
+	clone2();
+	EXPECT_EQ(3, calls);
+}